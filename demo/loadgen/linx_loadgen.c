@@ -0,0 +1,768 @@
+/**
+ * @file linx_loadgen.c
+ * @brief Linx SDK 多设备压测工具
+ *
+ * 在一个进程内模拟 N 台设备：每台设备通过 linx_sdk_create/linx_sdk_connect 建立会话，
+ * 按实时节奏用 linx_sdk_send_audio 上行预录的 Opus 帧，每轮上行结束后发送 listen stop
+ * 并等待下行 TTS。运行结束后以 JSON 输出：
+ * - 连接耗时（connect 调用到服务器 hello）
+ * - 上行抖动（实际发送时刻相对计划时刻的偏差）
+ * - 下行首包时延 TTFA（listen stop 到第一帧下行音频）
+ * - 每 1000 会话的 CPU 与 RSS 开销
+ *
+ * 配合 sdk/protocols/test/linx_mock_server 可在本机完成回归测试。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "linx_sdk.h"
+#include "protocols/linx_runtime.h"
+#include "cjson/cJSON.h"
+#include "log/linx_log.h"
+
+// ==================== 常量与类型 ====================
+
+#define LOADGEN_MAX_FRAME_SIZE      4000    // 单帧 Opus 数据上限
+#define LOADGEN_MAX_SLEEP_US        5000    // 发送线程单次最长休眠，保证及时感知状态变化
+#define LOADGEN_SESSIONS_PER_PACER  2000    // 默认每个发送线程负责的会话数
+
+/* 设备状态，由事件回调与发送线程共同推进（原子访问） */
+enum {
+    DEVICE_IDLE = 0,            // 尚未发起连接
+    DEVICE_CONNECTING,          // 已调用 linx_sdk_connect，等待 hello
+    DEVICE_STREAMING,           // 正在按节奏上行音频
+    DEVICE_WAIT_TTS,            // 已发送 listen stop，等待下行 TTS 结束
+    DEVICE_CLOSED               // 连接断开或创建失败
+};
+
+/**
+ * @brief 固定桶宽的直方图，多线程原子累加
+ */
+typedef struct {
+    uint32_t* buckets;
+    size_t bucket_count;
+    uint64_t width_us;          // 桶宽（微秒），超出范围的样本计入最后一个桶
+    uint64_t samples;
+    uint64_t sum_us;
+    uint64_t max_us;
+} loadgen_hist_t;
+
+/**
+ * @brief 命令行选项
+ */
+typedef struct {
+    const char* url;
+    size_t sessions;            // 模拟设备数
+    int ramp_rate;              // 每秒发起的连接数
+    int duration_s;             // 全部连接发起后的稳态运行时长
+    int frame_ms;               // 每帧时长
+    int frame_bytes;            // 合成帧大小
+    int turn_frames;            // 每轮上行帧数，之后发送 listen stop
+    int tts_timeout_ms;         // 等待 TTS 的超时
+    int protocol_version;
+    int shards;                 // 运行时分片数，0 表示按 CPU 数
+    bool per_device_thread;     // 不使用共享运行时，每个 SDK 实例自建事件线程
+    int pacers;                 // 发送线程数，0 表示按会话数自动选择
+    bool barge_in;              // 收到首帧 TTS 后立即打断并恢复上行
+    int batch_frames;           // 上行每条消息打包的帧数，0 表示逐帧发送
+    const char* input_path;     // 预录帧文件
+    const char* output_path;    // JSON 输出路径，NULL 输出到 stdout
+} loadgen_options_t;
+
+/**
+ * @brief 单台模拟设备
+ */
+typedef struct {
+    LinxSdk* sdk;
+    size_t index;
+    int state;                          // DEVICE_*（原子访问）
+    char session_id[64];                // hello 中的会话 ID，进入 STREAMING 前写入
+    uint64_t connect_start_us;
+    uint64_t stop_sent_us;              // 本轮 listen stop 的发送时刻
+    int awaiting_audio;                 // 等待本轮首帧下行音频（原子访问）
+    int barge_pending;                  // 首帧已到，等待发送线程打断（原子访问）
+
+    /* 以下字段只由负责该设备的发送线程访问 */
+    uint64_t next_due_us;               // 下一帧计划发送时刻，0 表示尚未开始本轮
+    size_t frame_pos;                   // 预录帧读取位置
+    int turn_frames_sent;
+} loadgen_device_t;
+
+/**
+ * @brief 全局压测状态
+ */
+typedef struct {
+    loadgen_options_t opts;
+    loadgen_device_t* devices;
+    size_t devices_started;             // 已发起连接的设备数（原子访问）
+
+    /* 预录帧 */
+    uint8_t* frame_data;
+    uint32_t* frame_sizes;
+    size_t* frame_offsets;
+    size_t frame_count;
+
+    linx_runtime_t* runtime;
+
+    /* 统计 */
+    loadgen_hist_t connect_hist;
+    loadgen_hist_t jitter_hist;
+    loadgen_hist_t ttfa_hist;
+    uint64_t established, disconnects, errors;
+    uint64_t frames_sent, send_errors, audio_frames, turns, tts_timeouts, barge_ins;
+
+    /* 控制消息时延，销毁 SDK 前从各会话的发送统计汇总 */
+    uint64_t control_frames, control_latency_us, control_latency_max_us;
+} loadgen_t;
+
+static volatile sig_atomic_t g_running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+// ==================== 工具函数 ====================
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void sleep_us(uint64_t us) {
+    struct timespec ts = { (time_t)(us / 1000000ULL), (long)(us % 1000000ULL) * 1000L };
+    nanosleep(&ts, NULL);
+}
+
+static void counter_add(uint64_t* counter, uint64_t value) {
+    __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+
+static bool hist_init(loadgen_hist_t* hist, uint64_t width_us, size_t bucket_count) {
+    memset(hist, 0, sizeof(*hist));
+    hist->buckets = calloc(bucket_count, sizeof(uint32_t));
+    hist->bucket_count = bucket_count;
+    hist->width_us = width_us;
+    return hist->buckets != NULL;
+}
+
+static void hist_free(loadgen_hist_t* hist) {
+    free(hist->buckets);
+    hist->buckets = NULL;
+}
+
+static void hist_add(loadgen_hist_t* hist, uint64_t value_us) {
+    size_t bucket = (size_t)(value_us / hist->width_us);
+    if (bucket >= hist->bucket_count) {
+        bucket = hist->bucket_count - 1;
+    }
+    __atomic_fetch_add(&hist->buckets[bucket], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hist->samples, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hist->sum_us, value_us, __ATOMIC_RELAXED);
+
+    uint64_t max = __atomic_load_n(&hist->max_us, __ATOMIC_RELAXED);
+    while (value_us > max &&
+           !__atomic_compare_exchange_n(&hist->max_us, &max, value_us, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+/* 返回分位数所在桶的上沿（毫秒） */
+static double hist_percentile_ms(const loadgen_hist_t* hist, double p) {
+    if (hist->samples == 0) {
+        return 0.0;
+    }
+    uint64_t target = (uint64_t)(p * (double)hist->samples + 0.999999);
+    if (target == 0) {
+        target = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < hist->bucket_count; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) {
+            return (double)((i + 1) * hist->width_us) / 1000.0;
+        }
+    }
+    return (double)hist->max_us / 1000.0;
+}
+
+static cJSON* hist_to_json(const loadgen_hist_t* hist) {
+    cJSON* obj = cJSON_CreateObject();
+    cJSON_AddNumberToObject(obj, "samples", (double)hist->samples);
+    cJSON_AddNumberToObject(obj, "avg", hist->samples ? (double)hist->sum_us / hist->samples / 1000.0 : 0.0);
+    cJSON_AddNumberToObject(obj, "p50", hist_percentile_ms(hist, 0.50));
+    cJSON_AddNumberToObject(obj, "p90", hist_percentile_ms(hist, 0.90));
+    cJSON_AddNumberToObject(obj, "p99", hist_percentile_ms(hist, 0.99));
+    cJSON_AddNumberToObject(obj, "max", (double)hist->max_us / 1000.0);
+    return obj;
+}
+
+/* 进程 CPU 时间（微秒） */
+static uint64_t process_cpu_us(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL +
+           (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/* 当前常驻内存（字节），Linux 读取 /proc，其他平台退化为峰值 RSS */
+static uint64_t process_rss_bytes(void) {
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if (fp) {
+        unsigned long size = 0, resident = 0;
+        int matched = fscanf(fp, "%lu %lu", &size, &resident);
+        fclose(fp);
+        if (matched == 2) {
+            return (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE);
+        }
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return (uint64_t)usage.ru_maxrss;
+#else
+    return (uint64_t)usage.ru_maxrss * 1024ULL;
+#endif
+}
+
+// ==================== 预录帧 ====================
+
+/*
+ * 预录帧文件格式：依次存放每一帧，帧前为 2 字节大端长度。
+ * 未指定文件时合成固定大小的帧：TOC 按帧时长选择 CELT 配置，其余字节填充。
+ */
+static bool load_frames(loadgen_t* lg) {
+    const loadgen_options_t* opts = &lg->opts;
+    size_t capacity = 0;
+
+    if (!opts->input_path) {
+        int count = opts->frame_ms / 20;
+        int size = opts->frame_bytes;
+        lg->frame_count = 1;
+        lg->frame_data = calloc(1, LOADGEN_MAX_FRAME_SIZE);
+        lg->frame_sizes = calloc(1, sizeof(uint32_t));
+        lg->frame_offsets = calloc(1, sizeof(size_t));
+        if (!lg->frame_data || !lg->frame_sizes || !lg->frame_offsets) {
+            return false;
+        }
+        if (count <= 1) {
+            lg->frame_data[0] = opts->frame_ms == 10 ? 0xF0 : 0xF8;
+        } else {
+            lg->frame_data[0] = 0xFB;               // code 3，CBR 多帧包
+            lg->frame_data[1] = (uint8_t)count;
+            size = 2 + ((size - 2) / count) * count;
+        }
+        memset(lg->frame_data + (count <= 1 ? 1 : 2), 0x55, (size_t)size - (count <= 1 ? 1 : 2));
+        lg->frame_sizes[0] = (uint32_t)size;
+        return true;
+    }
+
+    FILE* fp = fopen(opts->input_path, "rb");
+    if (!fp) {
+        fprintf(stderr, "❌ 无法打开预录帧文件: %s\n", opts->input_path);
+        return false;
+    }
+
+    size_t data_len = 0, data_cap = 0;
+    uint8_t header[2];
+    while (fread(header, 1, sizeof(header), fp) == sizeof(header)) {
+        size_t size = ((size_t)header[0] << 8) | header[1];
+        if (size == 0 || size > LOADGEN_MAX_FRAME_SIZE) {
+            break;
+        }
+        if (data_len + size > data_cap) {
+            data_cap = data_cap ? data_cap * 2 : 64 * 1024;
+            uint8_t* data = realloc(lg->frame_data, data_cap);
+            if (!data) {
+                break;
+            }
+            lg->frame_data = data;
+        }
+        if (lg->frame_count == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            uint32_t* sizes = realloc(lg->frame_sizes, capacity * sizeof(uint32_t));
+            size_t* offsets = sizes ? realloc(lg->frame_offsets, capacity * sizeof(size_t)) : NULL;
+            if (sizes) {
+                lg->frame_sizes = sizes;
+            }
+            if (!offsets) {
+                break;
+            }
+            lg->frame_offsets = offsets;
+        }
+        if (fread(lg->frame_data + data_len, 1, size, fp) != size) {
+            break;
+        }
+        lg->frame_offsets[lg->frame_count] = data_len;
+        lg->frame_sizes[lg->frame_count] = (uint32_t)size;
+        lg->frame_count++;
+        data_len += size;
+    }
+    fclose(fp);
+
+    if (lg->frame_count == 0) {
+        fprintf(stderr, "❌ 预录帧文件为空或格式错误: %s\n", opts->input_path);
+        return false;
+    }
+    return true;
+}
+
+// ==================== 事件回调 ====================
+
+static loadgen_t g_loadgen;
+
+static void on_device_event(const LinxEvent* event, void* user_data) {
+    loadgen_device_t* dev = (loadgen_device_t*)user_data;
+    loadgen_t* lg = &g_loadgen;
+    int expected;
+
+    switch (event->type) {
+        case LINX_EVENT_SESSION_ESTABLISHED:
+            if (event->data.session_established.session_id) {
+                snprintf(dev->session_id, sizeof(dev->session_id), "%s",
+                         event->data.session_established.session_id);
+            }
+            expected = DEVICE_CONNECTING;
+            if (__atomic_compare_exchange_n(&dev->state, &expected, DEVICE_STREAMING, false,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                hist_add(&lg->connect_hist, now_us() - dev->connect_start_us);
+                counter_add(&lg->established, 1);
+            }
+            break;
+
+        case LINX_EVENT_AUDIO_DATA:
+            counter_add(&lg->audio_frames, 1);
+            expected = 1;
+            if (__atomic_compare_exchange_n(&dev->awaiting_audio, &expected, 0, false,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                hist_add(&lg->ttfa_hist, now_us() - dev->stop_sent_us);
+                if (lg->opts.barge_in) {
+                    __atomic_store_n(&dev->barge_pending, 1, __ATOMIC_RELEASE);
+                }
+            }
+            break;
+
+        case LINX_EVENT_TTS_STOPPED:
+            /* SDK 在 tts stop 时会自动重新开始监听，这里恢复上行 */
+            expected = DEVICE_WAIT_TTS;
+            if (__atomic_compare_exchange_n(&dev->state, &expected, DEVICE_STREAMING, false,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                counter_add(&lg->turns, 1);
+            }
+            break;
+
+        case LINX_EVENT_WEBSOCKET_DISCONNECTED:
+            if (__atomic_exchange_n(&dev->state, DEVICE_CLOSED, __ATOMIC_RELAXED) != DEVICE_CLOSED) {
+                counter_add(&lg->disconnects, 1);
+            }
+            break;
+
+        case LINX_EVENT_ERROR:
+            counter_add(&lg->errors, 1);
+            break;
+
+        default:
+            break;
+    }
+}
+
+// ==================== 发送线程 ====================
+
+typedef struct {
+    loadgen_t* lg;
+    size_t begin, end;          // 负责的设备区间 [begin, end)
+    pthread_t thread;
+} loadgen_pacer_t;
+
+static void pacer_end_turn(loadgen_t* lg, loadgen_device_t* dev, uint64_t now) {
+    char message[160];
+    snprintf(message, sizeof(message), "{\"session_id\":\"%s\",\"type\":\"listen\",\"state\":\"stop\"}",
+             dev->session_id);
+
+    dev->next_due_us = 0;
+    dev->turn_frames_sent = 0;
+    dev->stop_sent_us = now;
+    __atomic_store_n(&dev->awaiting_audio, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&dev->state, DEVICE_WAIT_TTS, __ATOMIC_RELEASE);
+    if (linx_sdk_send_text(dev->sdk, message) != LINX_SDK_SUCCESS) {
+        counter_add(&lg->send_errors, 1);
+    }
+}
+
+static void* pacer_thread(void* arg) {
+    loadgen_pacer_t* pacer = (loadgen_pacer_t*)arg;
+    loadgen_t* lg = pacer->lg;
+    const uint64_t frame_us = (uint64_t)lg->opts.frame_ms * 1000ULL;
+    const uint64_t tts_timeout_us = (uint64_t)lg->opts.tts_timeout_ms * 1000ULL;
+
+    while (g_running) {
+        uint64_t now = now_us();
+        uint64_t wake = now + LOADGEN_MAX_SLEEP_US;
+        size_t started = __atomic_load_n(&lg->devices_started, __ATOMIC_ACQUIRE);
+        size_t end = pacer->end < started ? pacer->end : started;
+
+        for (size_t i = pacer->begin; i < end; i++) {
+            loadgen_device_t* dev = &lg->devices[i];
+            int state = __atomic_load_n(&dev->state, __ATOMIC_ACQUIRE);
+
+            if (state == DEVICE_WAIT_TTS) {
+                if (__atomic_exchange_n(&dev->barge_pending, 0, __ATOMIC_ACQ_REL)) {
+                    /* 模拟用户插话：打断播报并立即恢复上行，abort 与后续音频竞争同一条连接 */
+                    if (linx_sdk_abort_speaking(dev->sdk, LINX_ABORT_REASON_NONE) == LINX_SDK_SUCCESS) {
+                        counter_add(&lg->barge_ins, 1);
+                    } else {
+                        counter_add(&lg->send_errors, 1);
+                    }
+                    __atomic_store_n(&dev->state, DEVICE_STREAMING, __ATOMIC_RELEASE);
+                } else if (now - dev->stop_sent_us > tts_timeout_us) {
+                    __atomic_store_n(&dev->awaiting_audio, 0, __ATOMIC_RELAXED);
+                    __atomic_store_n(&dev->state, DEVICE_STREAMING, __ATOMIC_RELEASE);
+                    counter_add(&lg->tts_timeouts, 1);
+                }
+                continue;
+            }
+            if (state != DEVICE_STREAMING) {
+                continue;
+            }
+
+            if (dev->next_due_us == 0) {
+                /* 新一轮开始：按设备序号错开发送相位，避免所有会话同时上行 */
+                dev->next_due_us = now + (uint64_t)dev->index * frame_us / lg->opts.sessions;
+            }
+
+            if (now >= dev->next_due_us) {
+                uint64_t lateness = now - dev->next_due_us;
+                size_t pos = dev->frame_pos;
+                hist_add(&lg->jitter_hist, lateness);
+
+                if (linx_sdk_send_audio(dev->sdk, lg->frame_data + lg->frame_offsets[pos],
+                                        lg->frame_sizes[pos]) == LINX_SDK_SUCCESS) {
+                    counter_add(&lg->frames_sent, 1);
+                } else {
+                    counter_add(&lg->send_errors, 1);
+                }
+                dev->frame_pos = (pos + 1) % lg->frame_count;
+
+                /* 落后超过一帧时重新对齐，不补发 */
+                dev->next_due_us = lateness > frame_us ? now + frame_us : dev->next_due_us + frame_us;
+
+                if (lg->opts.turn_frames > 0 && ++dev->turn_frames_sent >= lg->opts.turn_frames) {
+                    pacer_end_turn(lg, dev, now);
+                    continue;
+                }
+            }
+
+            if (dev->next_due_us < wake) {
+                wake = dev->next_due_us;
+            }
+        }
+
+        now = now_us();
+        if (wake > now) {
+            sleep_us(wake - now);
+        }
+    }
+    return NULL;
+}
+
+// ==================== 报告 ====================
+
+static void write_report(loadgen_t* lg, double wall_s, uint64_t cpu_us, uint64_t rss_bytes) {
+    const loadgen_options_t* opts = &lg->opts;
+    double established = (double)lg->established;
+    double cpu_percent = wall_s > 0 ? (double)cpu_us / (wall_s * 1e6) * 100.0 : 0.0;
+    double rss_mb = (double)rss_bytes / (1024.0 * 1024.0);
+
+    cJSON* root = cJSON_CreateObject();
+
+    cJSON* config = cJSON_CreateObject();
+    cJSON_AddStringToObject(config, "url", opts->url);
+    cJSON_AddNumberToObject(config, "sessions", (double)opts->sessions);
+    cJSON_AddNumberToObject(config, "ramp_rate", opts->ramp_rate);
+    cJSON_AddNumberToObject(config, "duration_s", opts->duration_s);
+    cJSON_AddNumberToObject(config, "frame_ms", opts->frame_ms);
+    cJSON_AddNumberToObject(config, "turn_frames", opts->turn_frames);
+    cJSON_AddNumberToObject(config, "protocol_version", opts->protocol_version);
+    cJSON_AddNumberToObject(config, "batch_frames", opts->batch_frames);
+    cJSON_AddNumberToObject(config, "shards", lg->runtime ? (double)linx_runtime_get_shard_count(lg->runtime) : 0);
+    cJSON_AddItemToObject(root, "config", config);
+
+    cJSON* sessions = cJSON_CreateObject();
+    cJSON_AddNumberToObject(sessions, "requested", (double)opts->sessions);
+    cJSON_AddNumberToObject(sessions, "established", established);
+    cJSON_AddNumberToObject(sessions, "disconnects", (double)lg->disconnects);
+    cJSON_AddNumberToObject(sessions, "errors", (double)lg->errors);
+    cJSON_AddItemToObject(sessions, "connect_ms", hist_to_json(&lg->connect_hist));
+    cJSON_AddItemToObject(root, "sessions", sessions);
+
+    cJSON* uplink = cJSON_CreateObject();
+    cJSON_AddNumberToObject(uplink, "frames_sent", (double)lg->frames_sent);
+    cJSON_AddNumberToObject(uplink, "send_errors", (double)lg->send_errors);
+    cJSON_AddItemToObject(uplink, "jitter_ms", hist_to_json(&lg->jitter_hist));
+    cJSON_AddItemToObject(root, "uplink", uplink);
+
+    cJSON* downlink = cJSON_CreateObject();
+    cJSON_AddNumberToObject(downlink, "audio_frames", (double)lg->audio_frames);
+    cJSON_AddNumberToObject(downlink, "turns", (double)lg->turns);
+    cJSON_AddNumberToObject(downlink, "tts_timeouts", (double)lg->tts_timeouts);
+    cJSON_AddItemToObject(downlink, "ttfa_ms", hist_to_json(&lg->ttfa_hist));
+    cJSON_AddItemToObject(root, "downlink", downlink);
+
+    cJSON* control = cJSON_CreateObject();
+    cJSON_AddNumberToObject(control, "barge_ins", (double)lg->barge_ins);
+    cJSON_AddNumberToObject(control, "frames", (double)lg->control_frames);
+    cJSON_AddNumberToObject(control, "to_wire_avg_ms",
+                            lg->control_frames > 0 ? (double)lg->control_latency_us / (double)lg->control_frames / 1000.0 : 0.0);
+    cJSON_AddNumberToObject(control, "to_wire_max_ms", (double)lg->control_latency_max_us / 1000.0);
+    cJSON_AddItemToObject(root, "control", control);
+
+    cJSON* resources = cJSON_CreateObject();
+    cJSON_AddNumberToObject(resources, "wall_s", wall_s);
+    cJSON_AddNumberToObject(resources, "cpu_percent", cpu_percent);
+    cJSON_AddNumberToObject(resources, "rss_mb", rss_mb);
+    cJSON_AddNumberToObject(resources, "cpu_percent_per_1k", established > 0 ? cpu_percent * 1000.0 / established : 0.0);
+    cJSON_AddNumberToObject(resources, "rss_mb_per_1k", established > 0 ? rss_mb * 1000.0 / established : 0.0);
+    cJSON_AddItemToObject(root, "resources", resources);
+
+    char* text = cJSON_Print(root);
+    if (text) {
+        FILE* out = opts->output_path ? fopen(opts->output_path, "w") : stdout;
+        if (out) {
+            fprintf(out, "%s\n", text);
+            if (out != stdout) {
+                fclose(out);
+            }
+        } else {
+            fprintf(stderr, "❌ 无法写入报告: %s\n", opts->output_path);
+        }
+        free(text);
+    }
+    cJSON_Delete(root);
+}
+
+// ==================== 主函数 ====================
+
+static void print_usage(const char* prog) {
+    fprintf(stderr, "用法: %s [选项]\n", prog);
+    fprintf(stderr, "  -u URL     服务器地址 (默认 ws://127.0.0.1:8765)\n");
+    fprintf(stderr, "  -n N       模拟设备数 (默认 100)\n");
+    fprintf(stderr, "  -r RATE    每秒发起的连接数 (默认 200)\n");
+    fprintf(stderr, "  -d SEC     全部连接发起后的运行时长 (默认 30)\n");
+    fprintf(stderr, "  -f MS      帧时长，10 或 20 的整数倍 (默认 60)\n");
+    fprintf(stderr, "  -b BYTES   合成帧大小 (默认 120)\n");
+    fprintf(stderr, "  -i FILE    预录 Opus 帧文件 (每帧 2 字节大端长度 + 数据)\n");
+    fprintf(stderr, "  -k N       每轮上行帧数，之后发送 listen stop，0 表示持续上行 (默认 50)\n");
+    fprintf(stderr, "  -w MS      等待 TTS 超时 (默认 10000)\n");
+    fprintf(stderr, "  -V VER     协议版本 1/2/3 (默认 1)\n");
+    fprintf(stderr, "  -s N       运行时分片数，0 按 CPU 数 (默认 0)\n");
+    fprintf(stderr, "  -x         不使用共享运行时，每个设备独立事件线程\n");
+    fprintf(stderr, "  -j N       发送线程数，0 自动 (默认 0)\n");
+    fprintf(stderr, "  -g N       上行每条消息最多打包 N 帧，需 -V 2/3 且服务器支持 (默认 0)\n");
+    fprintf(stderr, "  -a         收到首帧 TTS 后立即打断 (abort) 并恢复上行，测量控制消息时延\n");
+    fprintf(stderr, "  -o FILE    JSON 报告输出路径 (默认 stdout)\n");
+    fprintf(stderr, "  -h         显示帮助\n");
+}
+
+int main(int argc, char* argv[]) {
+    loadgen_t* lg = &g_loadgen;
+    loadgen_options_t* opts = &lg->opts;
+    int exit_code = 1;
+
+    opts->url = "ws://127.0.0.1:8765";
+    opts->sessions = 100;
+    opts->ramp_rate = 200;
+    opts->duration_s = 30;
+    opts->frame_ms = 60;
+    opts->frame_bytes = 120;
+    opts->turn_frames = 50;
+    opts->tts_timeout_ms = 10000;
+    opts->protocol_version = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "u:n:r:d:f:b:i:k:w:V:s:xj:ag:o:h")) != -1) {
+        switch (opt) {
+            case 'u': opts->url = optarg; break;
+            case 'n': opts->sessions = (size_t)strtoul(optarg, NULL, 10); break;
+            case 'r': opts->ramp_rate = atoi(optarg); break;
+            case 'd': opts->duration_s = atoi(optarg); break;
+            case 'f': opts->frame_ms = atoi(optarg); break;
+            case 'b': opts->frame_bytes = atoi(optarg); break;
+            case 'i': opts->input_path = optarg; break;
+            case 'k': opts->turn_frames = atoi(optarg); break;
+            case 'w': opts->tts_timeout_ms = atoi(optarg); break;
+            case 'V': opts->protocol_version = atoi(optarg); break;
+            case 's': opts->shards = atoi(optarg); break;
+            case 'x': opts->per_device_thread = true; break;
+            case 'j': opts->pacers = atoi(optarg); break;
+            case 'a': opts->barge_in = true; break;
+            case 'g': opts->batch_frames = atoi(optarg); break;
+            case 'o': opts->output_path = optarg; break;
+            case 'h': print_usage(argv[0]); return 0;
+            default: print_usage(argv[0]); return 1;
+        }
+    }
+
+    if (opts->sessions == 0 || opts->ramp_rate <= 0 || opts->duration_s < 0 ||
+        (opts->frame_ms != 10 && (opts->frame_ms % 20 != 0 || opts->frame_ms > 120)) ||
+        opts->frame_bytes < 8 || opts->frame_bytes > LOADGEN_MAX_FRAME_SIZE ||
+        opts->protocol_version < 1 || opts->protocol_version > 3 || opts->shards < 0 || opts->batch_frames < 0) {
+        fprintf(stderr, "❌ 参数无效\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    lg->devices = calloc(opts->sessions, sizeof(loadgen_device_t));
+    if (!lg->devices || !load_frames(lg) ||
+        !hist_init(&lg->connect_hist, 1000, 60000) ||      // 1ms 精度，最长 60s
+        !hist_init(&lg->ttfa_hist, 1000, 60000) ||
+        !hist_init(&lg->jitter_hist, 50, 40000)) {         // 50us 精度，最长 2s
+        fprintf(stderr, "❌ 内存分配失败\n");
+        goto cleanup;
+    }
+
+    if (!opts->per_device_thread) {
+        linx_runtime_config_t rt_config = { .shard_count = (size_t)opts->shards };
+        lg->runtime = linx_runtime_create(&rt_config);
+        if (!lg->runtime) {
+            fprintf(stderr, "❌ 运行时创建失败\n");
+            goto cleanup;
+        }
+    }
+
+    /* 启动发送线程，每个线程负责一段连续的设备 */
+    size_t pacer_count = opts->pacers > 0 ? (size_t)opts->pacers
+                                          : (opts->sessions + LOADGEN_SESSIONS_PER_PACER - 1) / LOADGEN_SESSIONS_PER_PACER;
+    if (pacer_count > opts->sessions) {
+        pacer_count = opts->sessions;
+    }
+    loadgen_pacer_t* pacers = calloc(pacer_count, sizeof(loadgen_pacer_t));
+    size_t pacers_running = 0;
+    if (!pacers) {
+        fprintf(stderr, "❌ 内存分配失败\n");
+        goto cleanup;
+    }
+    for (size_t i = 0; i < pacer_count; i++) {
+        pacers[i].lg = lg;
+        pacers[i].begin = opts->sessions * i / pacer_count;
+        pacers[i].end = opts->sessions * (i + 1) / pacer_count;
+        if (pthread_create(&pacers[i].thread, NULL, pacer_thread, &pacers[i]) != 0) {
+            fprintf(stderr, "❌ 发送线程创建失败\n");
+            g_running = 0;
+            break;
+        }
+        pacers_running++;
+    }
+
+    fprintf(stderr, "🚀 压测开始: %zu 个设备 -> %s (%s)\n", opts->sessions, opts->url,
+            lg->runtime ? "共享运行时" : "独立事件线程");
+
+    /* 按速率逐个发起连接 */
+    LinxSdkConfig config;
+    memset(&config, 0, sizeof(config));
+    snprintf(config.server_url, sizeof(config.server_url), "%s", opts->url);
+    config.sample_rate = 16000;
+    config.channels = 1;
+    config.protocol_version = (uint32_t)opts->protocol_version;
+    config.listening_mode = LINX_LISTENING_MODE_MANUAL_STOP;
+    config.runtime = lg->runtime;
+    config.audio_batch_frames = (uint32_t)opts->batch_frames;
+
+    uint64_t ramp_start = now_us();
+    for (size_t i = 0; i < opts->sessions && g_running; i++) {
+        uint64_t due = ramp_start + (uint64_t)i * 1000000ULL / (uint64_t)opts->ramp_rate;
+        uint64_t now = now_us();
+        if (due > now) {
+            sleep_us(due - now);
+        }
+
+        loadgen_device_t* dev = &lg->devices[i];
+        dev->index = i;
+        snprintf(config.device_id, sizeof(config.device_id), "loadgen-%06zu", i);
+        snprintf(config.client_id, sizeof(config.client_id), "loadgen-client-%06zu", i);
+
+        dev->sdk = linx_sdk_create(&config);
+        log_set_level(LOG_LEVEL_ERROR);
+        if (dev->sdk) {
+            linx_sdk_set_event_callback(dev->sdk, on_device_event, dev);
+            dev->connect_start_us = now_us();
+            dev->state = DEVICE_CONNECTING;
+            if (linx_sdk_connect(dev->sdk) != LINX_SDK_SUCCESS) {
+                dev->state = DEVICE_CLOSED;
+                counter_add(&lg->errors, 1);
+            }
+        } else {
+            dev->state = DEVICE_CLOSED;
+            counter_add(&lg->errors, 1);
+        }
+        __atomic_store_n(&lg->devices_started, i + 1, __ATOMIC_RELEASE);
+    }
+
+    /* 稳态阶段：只统计这一段的 CPU 与内存 */
+    uint64_t steady_start = now_us();
+    uint64_t cpu_start = process_cpu_us();
+    fprintf(stderr, "⏱️  连接发起完成 (%.1fs)，稳态运行 %d 秒...\n",
+            (double)(steady_start - ramp_start) / 1e6, opts->duration_s);
+    while (g_running && now_us() - steady_start < (uint64_t)opts->duration_s * 1000000ULL) {
+        sleep_us(100000);
+    }
+    uint64_t steady_end = now_us();
+    uint64_t cpu_used = process_cpu_us() - cpu_start;
+    uint64_t rss = process_rss_bytes();
+
+    g_running = 0;
+    for (size_t i = 0; i < pacers_running; i++) {
+        pthread_join(pacers[i].thread, NULL);
+    }
+    free(pacers);
+
+    /* 汇总控制消息从调用到写入套接字的时延 */
+    size_t started = __atomic_load_n(&lg->devices_started, __ATOMIC_ACQUIRE);
+    for (size_t i = 0; i < started; i++) {
+        LinxSdkSendStats send;
+        if (lg->devices[i].sdk && linx_sdk_get_send_stats(lg->devices[i].sdk, &send) == LINX_SDK_SUCCESS) {
+            lg->control_frames += send.control_frames;
+            lg->control_latency_us += send.total_control_latency_us;
+            if (send.max_control_latency_us > lg->control_latency_max_us) {
+                lg->control_latency_max_us = send.max_control_latency_us;
+            }
+        }
+    }
+
+    write_report(lg, (double)(steady_end - steady_start) / 1e6, cpu_used, rss);
+    exit_code = 0;
+
+cleanup:
+    if (lg->devices) {
+        size_t started = lg->devices_started;
+        for (size_t i = 0; i < started; i++) {
+            if (lg->devices[i].sdk) {
+                linx_sdk_destroy(lg->devices[i].sdk);
+            }
+        }
+        free(lg->devices);
+    }
+    if (lg->runtime) {
+        linx_runtime_destroy(lg->runtime);
+    }
+    hist_free(&lg->connect_hist);
+    hist_free(&lg->ttfa_hist);
+    hist_free(&lg->jitter_hist);
+    free(lg->frame_data);
+    free(lg->frame_sizes);
+    free(lg->frame_offsets);
+    return exit_code;
+}
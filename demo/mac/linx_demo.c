@@ -28,7 +28,6 @@
 #include "../sdk/protocols/linx_protocol.h"
 #include "../sdk/audio/audio_interface.h"
 #include "../sdk/audio/portaudio_mac.h"
-#include "../sdk/codecs/audio_codec.h"
 #include "../sdk/mcp/mcp_server.h"
 #include "../sdk/log/linx_log.h"
 
@@ -36,8 +35,6 @@
 typedef struct {
     LinxSdk* sdk;
     AudioInterface* audio_interface;
-    audio_codec_t* opus_encoder;
-    audio_codec_t* opus_decoder;
     mcp_server_t* mcp_server;
     
     bool running;
@@ -74,7 +71,6 @@ static void* audio_thread_func(void* arg);
 static void* websocket_thread_func(void* arg);
 static void start_recording(void);
 static void stop_recording(void);
-static void play_audio(const uint8_t* data, size_t size);
 static void setup_mcp_tools(void);
 static void interactive_mode(void);
 static void print_usage(const char* program_name);
@@ -135,11 +131,6 @@ static void event_handler(const LinxEvent* event, void* user_data) {
             printf("✗ 错误: %s\n", event->data.error.message);
             break;
             
-        case LINX_EVENT_AUDIO_DATA:
-            printf("♪ 收到音频数据: %zu 字节\n", event->data.audio_data.size);
-            play_audio(event->data.audio_data.data, event->data.audio_data.size);
-            break;
-            
         case LINX_EVENT_TEXT_MESSAGE:
             printf("💬 AI回复: %s\n", event->data.text_message.text);
             break;
@@ -193,6 +184,20 @@ static bool init_demo(const char* server_url) {
         return false;
     }
     
+    // 初始化音频接口 - 使用PortAudio Mac实现
+    g_demo.audio_interface = portaudio_mac_create();
+    if (!g_demo.audio_interface) {
+        printf("✗ 创建音频接口失败\n");
+        return false;
+    }
+    
+    // 配置音频参数
+    audio_interface_set_config(g_demo.audio_interface, g_demo.sample_rate, g_demo.frame_size, 
+                              g_demo.channels, 2, 1024, 256);
+    
+    audio_interface_init(g_demo.audio_interface);
+    audio_interface_play(g_demo.audio_interface);
+    
     // 初始化SDK
     LinxSdkConfig config = {0};
     strncpy(config.server_url, server_url, sizeof(config.server_url) - 1);
@@ -207,6 +212,10 @@ static bool init_demo(const char* server_url) {
     strncpy(config.client_id, "test-client", sizeof(config.client_id) - 1);
     config.protocol_version = 1;
     
+    // 下行音频由SDK解码，并按设备采样率每20ms写入一个周期（上行编码同样由SDK完成）
+    config.playback_device = g_demo.audio_interface;
+    config.playback_period_ms = 20;
+    
     g_demo.sdk = linx_sdk_create(&config);
     if (!g_demo.sdk) {
         printf("✗ 创建SDK实例失败\n");
@@ -215,40 +224,6 @@ static bool init_demo(const char* server_url) {
     
     linx_sdk_set_event_callback(g_demo.sdk, event_handler, NULL);
     
-    // 初始化音频接口 - 使用PortAudio Mac实现
-    g_demo.audio_interface = portaudio_mac_create();
-    if (!g_demo.audio_interface) {
-        printf("✗ 创建音频接口失败\n");
-        return false;
-    }
-    
-    // 配置音频参数
-    audio_interface_set_config(g_demo.audio_interface, g_demo.sample_rate, g_demo.frame_size, 
-                              g_demo.channels, 2, 1024, 256);
-    
-    audio_interface_init(g_demo.audio_interface);
-    
-    // 初始化Opus编解码器
-    audio_format_t format = {0};
-    format.sample_rate = g_demo.sample_rate;
-    format.channels = g_demo.channels;
-    format.bits_per_sample = 16;
-    
-    g_demo.opus_encoder = codec_factory_create(CODEC_TYPE_OPUS);
-    g_demo.opus_decoder = codec_factory_create(CODEC_TYPE_OPUS);
-    
-    if (!g_demo.opus_encoder || !g_demo.opus_decoder) {
-        printf("✗ Opus编解码器创建失败\n");
-        return false;
-    }
-    
-    // 初始化编解码器
-    if (g_demo.opus_encoder->vtable->init_encoder(g_demo.opus_encoder, &format) != CODEC_SUCCESS ||
-        g_demo.opus_decoder->vtable->init_decoder(g_demo.opus_decoder, &format) != CODEC_SUCCESS) {
-        printf("✗ 初始化Opus编解码器失败\n");
-        return false;
-    }
-    
     // 设置MCP工具
     setup_mcp_tools();
     
@@ -300,7 +275,6 @@ static void setup_mcp_tools(void) {
  */
 static void* audio_thread_func(void* arg) {
     short audio_buffer[AUDIO_BUFFER_SIZE];
-    uint8_t encoded_buffer[AUDIO_BUFFER_SIZE];
     
     while (g_demo.running) {
         pthread_mutex_lock(&g_demo.audio_mutex);
@@ -316,23 +290,13 @@ static void* audio_thread_func(void* arg) {
         
         pthread_mutex_unlock(&g_demo.audio_mutex);
         
-        // 录制音频
+        // 录制音频（阻塞到采集到一个周期），PCM直接交给SDK编码发送
         bool read_success = audio_interface_read(g_demo.audio_interface, 
                                                audio_buffer, g_demo.frame_size);
         
         if (read_success && g_demo.connected) {
-            // 编码音频
-            size_t encoded_size = 0;
-            if (g_demo.opus_encoder->vtable->encode(g_demo.opus_encoder, (int16_t*)audio_buffer, 
-                                  g_demo.frame_size,
-                                  encoded_buffer, sizeof(encoded_buffer), &encoded_size) == CODEC_SUCCESS) {
-                
-                // 发送编码后的音频
-                linx_sdk_send_audio(g_demo.sdk, encoded_buffer, encoded_size);
-            }
+            linx_sdk_send_pcm(g_demo.sdk, (const int16_t*)audio_buffer, (size_t)g_demo.frame_size);
         }
-        
-        usleep(10000); // 10ms
     }
     
     return NULL;
@@ -390,24 +354,6 @@ static void stop_recording(void) {
     printf("🎤 停止录音\n");
 }
 
-/**
- * 播放音频
- */
-static void play_audio(const uint8_t* data, size_t size) {
-    if (!data || size == 0) return;
-    
-    short decoded_buffer[AUDIO_BUFFER_SIZE];
-    size_t decoded_size = 0;
-    
-    // 解码音频
-    if (g_demo.opus_decoder->vtable->decode(g_demo.opus_decoder, data, size,
-                         (int16_t*)decoded_buffer, sizeof(decoded_buffer)/sizeof(int16_t), &decoded_size) == CODEC_SUCCESS) {
-        
-        // 播放解码后的音频
-        audio_interface_write(g_demo.audio_interface, decoded_buffer, decoded_size / sizeof(short));
-    }
-}
-
 /**
  * 交互模式
  */
@@ -500,14 +446,6 @@ static void cleanup_demo(void) {
         audio_interface_destroy(g_demo.audio_interface);
     }
     
-    if (g_demo.opus_encoder) {
-        codec_factory_destroy(g_demo.opus_encoder);
-    }
-    
-    if (g_demo.opus_decoder) {
-        codec_factory_destroy(g_demo.opus_decoder);
-    }
-    
     if (g_demo.mcp_server) {
         mcp_server_destroy(g_demo.mcp_server);
     }
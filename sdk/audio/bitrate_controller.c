@@ -0,0 +1,215 @@
+#include "bitrate_controller.h"
+#include "../log/linx_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BITRATE_CONTROLLER_DEFAULT_QUEUE_HIGH    4
+#define BITRATE_CONTROLLER_DEFAULT_QUEUE_LOW     1
+#define BITRATE_CONTROLLER_DEFAULT_RTT_INFLATION 300
+
+// Speech ladder for VoIP: narrowband at the bottom, the encoder defaults at the top
+static const bitrate_level_t default_levels[] = {
+    {6000, 5, 4000},
+    {10000, 7, 6000},
+    {16000, 9, 8000},
+    {24000, 10, 8000},
+    {32000, 10, 12000},
+    {64000, 10, 20000},
+};
+
+bitrate_controller_t* bitrate_controller_create(const bitrate_controller_config_t* config) {
+    bitrate_controller_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    if (config) {
+        cfg = *config;
+    } else {
+        cfg.initial_level = SIZE_MAX;
+    }
+    if (!cfg.levels || cfg.level_count == 0) {
+        cfg.levels = default_levels;
+        cfg.level_count = sizeof(default_levels) / sizeof(default_levels[0]);
+    }
+    while (cfg.max_bitrate > 0 && cfg.level_count > 1 && cfg.levels[cfg.level_count - 1].bitrate > cfg.max_bitrate) {
+        cfg.level_count--;
+    }
+    if (cfg.initial_level >= cfg.level_count) {
+        cfg.initial_level = cfg.level_count - 1;
+    }
+    if (!cfg.interval_ms) cfg.interval_ms = BITRATE_CONTROLLER_DEFAULT_INTERVAL_MS;
+    if (!cfg.queue_high) cfg.queue_high = BITRATE_CONTROLLER_DEFAULT_QUEUE_HIGH;
+    if (!cfg.queue_low) cfg.queue_low = BITRATE_CONTROLLER_DEFAULT_QUEUE_LOW;
+    if (cfg.queue_low >= cfg.queue_high) {
+        cfg.queue_low = cfg.queue_high - 1;
+    }
+    if (!cfg.rtt_inflation_ms) cfg.rtt_inflation_ms = BITRATE_CONTROLLER_DEFAULT_RTT_INFLATION;
+    if (!cfg.probe_intervals) cfg.probe_intervals = BITRATE_CONTROLLER_DEFAULT_PROBE_INTERVALS;
+
+    bitrate_controller_t* controller = (bitrate_controller_t*)calloc(1, sizeof(bitrate_controller_t));
+    if (!controller) {
+        LOG_ERROR("Failed to allocate bitrate controller");
+        return NULL;
+    }
+    controller->config = cfg;
+    controller->probe_intervals = cfg.probe_intervals;
+    controller->stats.level = cfg.initial_level;
+    controller->stats.bitrate = cfg.levels[cfg.initial_level].bitrate;
+    controller->stats.probe_intervals = cfg.probe_intervals;
+    pthread_mutex_init(&controller->mutex, NULL);
+
+    LOG_INFO("Bitrate controller: %zu levels, starting at %d bps", cfg.level_count,
+             cfg.levels[cfg.initial_level].bitrate);
+    return controller;
+}
+
+void bitrate_controller_destroy(bitrate_controller_t* controller) {
+    if (!controller) {
+        return;
+    }
+    pthread_mutex_destroy(&controller->mutex);
+    free(controller);
+}
+
+bool bitrate_controller_is_due(bitrate_controller_t* controller, uint64_t now_ms) {
+    if (!controller) {
+        return false;
+    }
+    pthread_mutex_lock(&controller->mutex);
+    bool due = !controller->started || now_ms >= controller->next_eval_ms;
+    pthread_mutex_unlock(&controller->mutex);
+    return due;
+}
+
+bool bitrate_controller_update(bitrate_controller_t* controller, uint64_t now_ms,
+                               const bitrate_controller_input_t* input, bitrate_level_t* level) {
+    if (!controller || !input) {
+        return false;
+    }
+
+    pthread_mutex_lock(&controller->mutex);
+    const bitrate_controller_config_t* cfg = &controller->config;
+
+    // The first sample only establishes the counter baselines
+    if (!controller->started) {
+        controller->started = true;
+        controller->next_eval_ms = now_ms + cfg->interval_ms;
+        controller->last_dropped = input->dropped_frames;
+        controller->last_rtt_samples = input->rtt_samples;
+        pthread_mutex_unlock(&controller->mutex);
+        return false;
+    }
+    if (now_ms < controller->next_eval_ms) {
+        pthread_mutex_unlock(&controller->mutex);
+        return false;
+    }
+    controller->next_eval_ms = now_ms + cfg->interval_ms;
+    controller->stats.evaluations++;
+
+    // Counters restart with the connection; a decrease is a new baseline, not drops
+    uint64_t drops = input->dropped_frames >= controller->last_dropped
+                         ? input->dropped_frames - controller->last_dropped : 0;
+    controller->last_dropped = input->dropped_frames;
+    bool fresh_rtt = input->rtt_samples != controller->last_rtt_samples;
+    controller->last_rtt_samples = input->rtt_samples;
+
+    bool queued = input->congested || input->queue_depth >= cfg->queue_high;
+    bool rtt_inflated = input->rtt_us > 0 && input->rtt_min_us > 0 &&
+                        input->rtt_us > input->rtt_min_us + cfg->rtt_inflation_ms * 1000u;
+
+    size_t old_level = controller->stats.level;
+    size_t new_level = old_level;
+    const char* reason = NULL;
+
+    // A stale RTT sample still blocks probing but only a fresh one steps down
+    if (queued || drops > 0 || (rtt_inflated && fresh_rtt)) {
+        if (queued) {
+            controller->stats.queue_triggers++;
+            reason = "send queue";
+        } else if (drops > 0) {
+            controller->stats.drop_triggers++;
+            reason = "dropped frames";
+        } else {
+            controller->stats.rtt_triggers++;
+            reason = "RTT";
+        }
+        controller->clean_intervals = 0;
+        if (controller->probing) {
+            controller->probing = false;
+            controller->stats.failed_probes++;
+            controller->probe_intervals *= 2;
+            if (controller->probe_intervals > BITRATE_CONTROLLER_MAX_PROBE_INTERVALS) {
+                controller->probe_intervals = BITRATE_CONTROLLER_MAX_PROBE_INTERVALS;
+            }
+        }
+        if (new_level > 0) {
+            new_level--;
+            controller->stats.step_downs++;
+        }
+    } else if (input->queue_depth <= cfg->queue_low && !rtt_inflated) {
+        controller->clean_intervals++;
+        if (controller->probing && controller->clean_intervals >= controller->probe_intervals) {
+            // The last step-up held for a full probe wait
+            controller->probing = false;
+            controller->probe_intervals = cfg->probe_intervals;
+        }
+        if (new_level + 1 < cfg->level_count && controller->clean_intervals >= controller->probe_intervals) {
+            new_level++;
+            controller->clean_intervals = 0;
+            controller->probing = true;
+            controller->stats.step_ups++;
+            reason = "clean network";
+        }
+    } else {
+        controller->clean_intervals = 0;
+    }
+
+    controller->stats.level = new_level;
+    controller->stats.bitrate = cfg->levels[new_level].bitrate;
+    controller->stats.probe_intervals = controller->probe_intervals;
+    bitrate_level_t current = cfg->levels[new_level];
+    pthread_mutex_unlock(&controller->mutex);
+
+    if (new_level == old_level) {
+        return false;
+    }
+    LOG_INFO("Uplink bitrate %d -> %d bps (%s: queue %zu, drops %llu, RTT %u us)",
+             cfg->levels[old_level].bitrate, current.bitrate, reason, input->queue_depth,
+             (unsigned long long)drops, input->rtt_us);
+    if (level) {
+        *level = current;
+    }
+    return true;
+}
+
+bitrate_level_t bitrate_controller_get_level(bitrate_controller_t* controller) {
+    bitrate_level_t level;
+    memset(&level, 0, sizeof(level));
+    if (!controller) {
+        return level;
+    }
+    pthread_mutex_lock(&controller->mutex);
+    level = controller->config.levels[controller->stats.level];
+    pthread_mutex_unlock(&controller->mutex);
+    return level;
+}
+
+void bitrate_controller_reset(bitrate_controller_t* controller) {
+    if (!controller) {
+        return;
+    }
+    pthread_mutex_lock(&controller->mutex);
+    controller->started = false;
+    controller->clean_intervals = 0;
+    controller->probing = false;
+    controller->probe_intervals = controller->config.probe_intervals;
+    controller->stats.probe_intervals = controller->probe_intervals;
+    pthread_mutex_unlock(&controller->mutex);
+}
+
+void bitrate_controller_get_stats(bitrate_controller_t* controller, bitrate_controller_stats_t* stats) {
+    if (!controller || !stats) {
+        return;
+    }
+    pthread_mutex_lock(&controller->mutex);
+    *stats = controller->stats;
+    pthread_mutex_unlock(&controller->mutex);
+}
@@ -0,0 +1,148 @@
+#ifndef BITRATE_CONTROLLER_H
+#define BITRATE_CONTROLLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default evaluation period (ms)
+ */
+#define BITRATE_CONTROLLER_DEFAULT_INTERVAL_MS 1000
+
+/**
+ * Default clean periods required before stepping up
+ */
+#define BITRATE_CONTROLLER_DEFAULT_PROBE_INTERVALS 5
+
+/**
+ * Upper bound of the probe wait after repeated failed step-ups
+ */
+#define BITRATE_CONTROLLER_MAX_PROBE_INTERVALS 60
+
+/**
+ * One rung of the encoder ladder
+ */
+typedef struct {
+    int bitrate;                    // bits per second
+    int complexity;                 // 0-10
+    int bandwidth_hz;               // Audio bandwidth cap (4000, 6000, 8000, 12000 or 20000)
+} bitrate_level_t;
+
+/**
+ * Controller configuration; zero fields take the defaults
+ */
+typedef struct {
+    const bitrate_level_t* levels;  // Ascending ladder kept by the caller, NULL for the built-in one
+    size_t level_count;
+    int max_bitrate;                // Rungs above this bitrate are left out, 0 for no cap
+    size_t initial_level;           // Index into levels, ignored (top level) when out of range
+    uint32_t interval_ms;           // Evaluation period
+    size_t queue_high;              // Queued frames that count as congestion (default 4)
+    size_t queue_low;               // Queued frames at or below which a period is clean (default 1)
+    uint32_t rtt_inflation_ms;      // RTT above the window minimum that counts as queueing (default 300)
+    uint32_t probe_intervals;       // Clean periods before stepping up
+} bitrate_controller_config_t;
+
+/**
+ * Network feedback for one evaluation
+ */
+typedef struct {
+    size_t queue_depth;             // Frames waiting to be written to the socket
+    bool congested;                 // Send buffer above its limit
+    uint64_t dropped_frames;        // Cumulative uplink frames dropped anywhere on the path
+    uint64_t rtt_samples;           // Cumulative RTT samples, to tell a fresh sample from a stale one
+    uint32_t rtt_us;                // Latest RTT, 0 when unknown
+    uint32_t rtt_min_us;            // Baseline RTT, 0 when unknown
+} bitrate_controller_input_t;
+
+/**
+ * Controller metrics
+ */
+typedef struct {
+    uint64_t evaluations;
+    uint64_t step_downs;
+    uint64_t step_ups;
+    uint64_t queue_triggers;        // Congested periods flagged by queue depth or the send buffer
+    uint64_t drop_triggers;         // Congested periods flagged by dropped frames
+    uint64_t rtt_triggers;          // Congested periods flagged by RTT inflation
+    uint64_t failed_probes;         // Step-downs shortly after a step-up
+    size_t level;
+    int bitrate;
+    uint32_t probe_intervals;       // Current clean periods required before stepping up
+} bitrate_controller_stats_t;
+
+/**
+ * Adaptive uplink bitrate controller
+ *
+ * Walks a ladder of encoder settings from network feedback sampled once per
+ * interval. Any congestion signal steps down one rung at once; stepping up
+ * needs several consecutive clean periods, and a step-up that is followed by
+ * a step-down before it proved itself doubles that wait. Periods that are
+ * neither congested nor clean hold the current rung.
+ */
+typedef struct {
+    bitrate_controller_config_t config;
+    pthread_mutex_t mutex;
+    bool started;
+    uint64_t next_eval_ms;
+    uint64_t last_dropped;
+    uint64_t last_rtt_samples;
+    uint32_t clean_intervals;
+    uint32_t probe_intervals;       // Current step-up wait
+    bool probing;                   // Last change was a step-up not yet confirmed
+    bitrate_controller_stats_t stats;
+} bitrate_controller_t;
+
+/**
+ * Create a controller
+ * @param config configuration, NULL for the defaults starting at the top rung
+ * @return controller or NULL on failure
+ */
+bitrate_controller_t* bitrate_controller_create(const bitrate_controller_config_t* config);
+
+/**
+ * Free a controller
+ */
+void bitrate_controller_destroy(bitrate_controller_t* controller);
+
+/**
+ * Whether an evaluation is due; lets callers skip gathering feedback
+ */
+bool bitrate_controller_is_due(bitrate_controller_t* controller, uint64_t now_ms);
+
+/**
+ * Evaluate feedback
+ * @param now_ms monotonic time (ms)
+ * @param input feedback for the period that just ended
+ * @param level receives the rung to apply when the result is true
+ * @return true when the rung changed
+ */
+bool bitrate_controller_update(bitrate_controller_t* controller, uint64_t now_ms,
+                               const bitrate_controller_input_t* input, bitrate_level_t* level);
+
+/**
+ * Current rung
+ */
+bitrate_level_t bitrate_controller_get_level(bitrate_controller_t* controller);
+
+/**
+ * Forget feedback baselines, e.g. after a reconnect; the rung is kept
+ */
+void bitrate_controller_reset(bitrate_controller_t* controller);
+
+/**
+ * Snapshot metrics
+ */
+void bitrate_controller_get_stats(bitrate_controller_t* controller, bitrate_controller_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BITRATE_CONTROLLER_H
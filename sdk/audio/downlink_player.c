@@ -0,0 +1,396 @@
+#include "downlink_player.h"
+#include "../log/linx_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Attempts to hand a period to a full device before dropping it
+#define DOWNLINK_PLAYER_WRITE_ATTEMPTS 4
+
+// Longest Opus packet; the server may send these regardless of the advertised frame duration
+#define DOWNLINK_PLAYER_MAX_PACKET_MS 120
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void sleep_us(uint64_t us) {
+    struct timespec ts = {
+        .tv_sec = (time_t)(us / 1000000ULL),
+        .tv_nsec = (long)(us % 1000000ULL) * 1000L
+    };
+    nanosleep(&ts, NULL);
+}
+
+downlink_player_t* downlink_player_create(jitter_buffer_t* jitter, audio_codec_t* decoder) {
+    if (!jitter || !decoder || !decoder->vtable) {
+        LOG_ERROR("Invalid parameters for downlink player");
+        return NULL;
+    }
+
+    downlink_player_t* player = (downlink_player_t*)calloc(1, sizeof(downlink_player_t));
+    if (!player) {
+        LOG_ERROR("Failed to allocate downlink player");
+        return NULL;
+    }
+    player->jitter = jitter;
+    player->decoder = decoder;
+    pthread_mutex_init(&player->mutex, NULL);
+    return player;
+}
+
+void downlink_player_destroy(downlink_player_t* player) {
+    if (!player) {
+        return;
+    }
+
+    downlink_player_stop(player);
+    pthread_mutex_destroy(&player->mutex);
+    resampler_destroy(player->resampler);
+    free(player->decoded);
+    free(player->frame);
+    free(player);
+}
+
+static bool reserve_samples(int16_t** buffer, size_t* capacity, size_t samples) {
+    if (samples <= *capacity) {
+        return true;
+    }
+    int16_t* grown = (int16_t*)realloc(*buffer, samples * sizeof(int16_t));
+    if (!grown) {
+        LOG_ERROR("Failed to allocate downlink frame buffer");
+        return false;
+    }
+    *buffer = grown;
+    *capacity = samples;
+    return true;
+}
+
+// Channels of the periods; called with the mutex held
+static int output_channels(const downlink_player_t* player) {
+    return player->output_channels > 0 ? player->output_channels : player->format.channels;
+}
+
+// Size the buffers and rebuild the resampler for the decode format and
+// output rate; called with the mutex held
+static bool configure_output(downlink_player_t* player) {
+    const audio_format_t* format = &player->format;
+    player->frame_samples = 0;
+    player->frame_offset = 0;
+    resampler_destroy(player->resampler);
+    player->resampler = NULL;
+
+    // Room for the longest packet the server may send at this rate
+    int packet_ms = format->frame_size_ms > DOWNLINK_PLAYER_MAX_PACKET_MS ? format->frame_size_ms
+                                                                          : DOWNLINK_PLAYER_MAX_PACKET_MS;
+    size_t packet_frames = (size_t)format->sample_rate * (size_t)packet_ms / 1000;
+    size_t channels = (size_t)format->channels;
+    // Remixing happens in place in the frame buffer, so it fits the wider layout
+    size_t frame_channels = (size_t)output_channels(player);
+    if (frame_channels < channels) {
+        frame_channels = channels;
+    }
+
+    if (player->output_rate <= 0 || player->output_rate == format->sample_rate) {
+        return reserve_samples(&player->frame, &player->frame_capacity, packet_frames * frame_channels);
+    }
+
+    player->resampler = resampler_create(format->sample_rate, player->output_rate, format->channels);
+    if (!player->resampler) {
+        return false;
+    }
+    size_t output_frames = resampler_max_output(player->resampler, packet_frames);
+    return reserve_samples(&player->decoded, &player->decoded_capacity, packet_frames * channels) &&
+           reserve_samples(&player->frame, &player->frame_capacity, output_frames * frame_channels);
+}
+
+// Convert `frames` interleaved frames in place: extra output channels repeat
+// the last decoded one, a mono output averages all decoded channels
+static void remix_frame(int16_t* pcm, size_t frames, int from, int to) {
+    if (from == to) {
+        return;
+    }
+    if (to > from) {
+        // Walk backwards so no frame is overwritten before it is read
+        for (size_t f = frames; f-- > 0;) {
+            for (int c = to - 1; c >= 0; c--) {
+                pcm[f * (size_t)to + (size_t)c] = pcm[f * (size_t)from + (size_t)(c < from ? c : from - 1)];
+            }
+        }
+        return;
+    }
+    for (size_t f = 0; f < frames; f++) {
+        const int16_t* in = pcm + f * (size_t)from;
+        if (to == 1) {
+            int32_t sum = 0;
+            for (int c = 0; c < from; c++) {
+                sum += in[c];
+            }
+            pcm[f] = (int16_t)(sum / from);
+        } else {
+            memmove(pcm + f * (size_t)to, in, (size_t)to * sizeof(int16_t));
+        }
+    }
+}
+
+bool downlink_player_set_format(downlink_player_t* player, int sample_rate, int channels, int frame_duration_ms) {
+    if (!player || sample_rate <= 0 || channels <= 0 || frame_duration_ms <= 0) {
+        return false;
+    }
+
+    pthread_mutex_lock(&player->mutex);
+    if (player->decoder->decoder_initialized && player->format.sample_rate == sample_rate &&
+        player->format.channels == channels && player->format.frame_size_ms == frame_duration_ms) {
+        pthread_mutex_unlock(&player->mutex);
+        return true;
+    }
+
+    audio_format_t format;
+    audio_format_init(&format, sample_rate, channels, 16, frame_duration_ms);
+    bool ok = player->decoder->vtable->init_decoder(player->decoder, &format) == CODEC_SUCCESS;
+    if (ok) {
+        player->format = format;
+        ok = configure_output(player);
+    }
+    pthread_mutex_unlock(&player->mutex);
+
+    if (ok) {
+        LOG_INFO("Downlink player decoding %d Hz, %d channels, %d ms frames", sample_rate, channels, frame_duration_ms);
+    } else {
+        LOG_ERROR("Downlink player: failed to initialize decoder for %d Hz, %d channels", sample_rate, channels);
+    }
+    return ok;
+}
+
+bool downlink_player_set_output_rate(downlink_player_t* player, int sample_rate) {
+    if (!player || sample_rate < 0) {
+        return false;
+    }
+
+    pthread_mutex_lock(&player->mutex);
+    bool ok = true;
+    if (sample_rate != player->output_rate) {
+        player->output_rate = sample_rate;
+        if (player->format.sample_rate > 0) {
+            ok = configure_output(player);
+        }
+    }
+    bool resampling = player->resampler != NULL;
+    pthread_mutex_unlock(&player->mutex);
+
+    if (resampling) {
+        LOG_INFO("Downlink player resampling to %d Hz", sample_rate);
+    }
+    return ok;
+}
+
+size_t downlink_player_read(downlink_player_t* player, int16_t* pcm, size_t samples, uint32_t* timestamp) {
+    if (!player || !pcm || samples == 0) {
+        return 0;
+    }
+
+    size_t filled = 0;
+    bool stamped = false;
+
+    pthread_mutex_lock(&player->mutex);
+    while (filled < samples && player->decoder->decoder_initialized) {
+        if (player->frame_offset == player->frame_samples) {
+            size_t decoded = 0;
+            uint32_t frame_timestamp = 0;
+            resampler_t* resampler = player->resampler;
+            int channels = player->format.channels;
+            int out_channels = output_channels(player);
+            // Frames that still fit the frame buffer once remixed
+            size_t frame_room = player->frame_capacity / (size_t)(out_channels > channels ? out_channels : channels);
+            jitter_buffer_result_t result = jitter_buffer_decode(player->jitter, player->decoder,
+                                                                 resampler ? player->decoded : player->frame,
+                                                                 resampler ? player->decoded_capacity
+                                                                           : frame_room * (size_t)channels,
+                                                                 &decoded, &frame_timestamp);
+            if ((result != JITTER_BUFFER_OK && result != JITTER_BUFFER_LOST) || decoded == 0) {
+                break;
+            }
+            if (result == JITTER_BUFFER_OK) {
+                player->stats.frames_decoded++;
+            } else {
+                player->stats.frames_concealed++;
+            }
+            size_t frames = decoded / (size_t)channels;
+            if (resampler) {
+                frames = resampler_process(resampler, player->decoded, frames, player->frame, frame_room);
+                if (frames == 0) {
+                    continue;
+                }
+            }
+            remix_frame(player->frame, frames, channels, out_channels);
+            player->frame_samples = frames * (size_t)out_channels;
+            player->frame_offset = 0;
+            player->frame_timestamp = frame_timestamp;
+        }
+
+        if (!stamped) {
+            // Timestamp of the sample that starts the period, rounded down to its frame
+            if (timestamp) {
+                *timestamp = player->frame_timestamp;
+            }
+            stamped = true;
+        }
+
+        size_t chunk = player->frame_samples - player->frame_offset;
+        if (chunk > samples - filled) {
+            chunk = samples - filled;
+        }
+        memcpy(pcm + filled, player->frame + player->frame_offset, chunk * sizeof(int16_t));
+        player->frame_offset += chunk;
+        filled += chunk;
+    }
+    if (filled > 0) {
+        player->stats.periods_played++;
+    } else {
+        player->stats.periods_silent++;
+    }
+    pthread_mutex_unlock(&player->mutex);
+
+    if (filled < samples) {
+        memset(pcm + filled, 0, (samples - filled) * sizeof(int16_t));
+    }
+    return filled;
+}
+
+static void* playback_thread(void* arg) {
+    downlink_player_t* player = (downlink_player_t*)arg;
+    uint64_t period_us = (uint64_t)player->period_ms * 1000ULL;
+    int channels = player->device->channels > 0 ? player->device->channels : 1;
+    int16_t* period = (int16_t*)malloc(player->period_samples * sizeof(int16_t));
+    if (!period) {
+        LOG_ERROR("Failed to allocate playback period");
+        return NULL;
+    }
+
+    bool audible = false;
+    uint64_t deadline = now_us();
+    while (__atomic_load_n(&player->running, __ATOMIC_ACQUIRE)) {
+        uint32_t timestamp = 0;
+        size_t filled = downlink_player_read(player, period, player->period_samples, &timestamp);
+
+        if (filled > 0) {
+            int attempt = 0;
+            while (!audio_interface_write(player->device, period, player->period_samples / (size_t)channels)) {
+                if (++attempt >= DOWNLINK_PLAYER_WRITE_ATTEMPTS) {
+                    pthread_mutex_lock(&player->mutex);
+                    player->stats.device_overruns++;
+                    pthread_mutex_unlock(&player->mutex);
+                    break;
+                }
+                sleep_us(period_us / DOWNLINK_PLAYER_WRITE_ATTEMPTS);
+            }
+            if (player->played) {
+                player->played(timestamp, player->played_user_data);
+            }
+            // Give the device one period of headroom when audio starts after silence
+            if (!audible) {
+                audible = true;
+                continue;
+            }
+        } else {
+            audible = false;
+        }
+
+        deadline += period_us;
+        uint64_t now = now_us();
+        if (now > deadline) {
+            uint64_t late = now - deadline;
+            pthread_mutex_lock(&player->mutex);
+            if (late > player->stats.max_wakeup_late_us) {
+                player->stats.max_wakeup_late_us = late;
+            }
+            pthread_mutex_unlock(&player->mutex);
+            // Do not try to catch up on periods that were missed entirely
+            if (late > period_us) {
+                deadline = now;
+            }
+        } else {
+            sleep_us(deadline - now);
+        }
+    }
+
+    free(period);
+    return NULL;
+}
+
+bool downlink_player_start(downlink_player_t* player, AudioInterface* device, uint32_t period_ms,
+                           downlink_player_played_callback_t played, void* user_data) {
+    if (!player || !device || __atomic_load_n(&player->running, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    int channels = device->channels > 0 ? device->channels : 1;
+    pthread_mutex_lock(&player->mutex);
+    int sample_rate = player->output_rate > 0 ? player->output_rate : player->format.sample_rate;
+    if (period_ms == 0) {
+        period_ms = (uint32_t)player->format.frame_size_ms;
+    }
+    bool ok = sample_rate > 0 && period_ms > 0;
+    // Periods follow the device layout whatever the decoder produces
+    if (ok && channels != player->output_channels) {
+        player->output_channels = channels;
+        ok = configure_output(player);
+    }
+    pthread_mutex_unlock(&player->mutex);
+    if (sample_rate <= 0 || period_ms == 0) {
+        LOG_ERROR("Downlink player: set a format before starting playback");
+        return false;
+    }
+    if (!ok) {
+        return false;
+    }
+
+    player->device = device;
+    player->period_ms = period_ms;
+    player->period_samples = (size_t)sample_rate * period_ms / 1000 * (size_t)channels;
+    player->played = played;
+    player->played_user_data = user_data;
+    __atomic_store_n(&player->running, true, __ATOMIC_RELEASE);
+    if (pthread_create(&player->thread, NULL, playback_thread, player) != 0) {
+        LOG_ERROR("Failed to start playback thread");
+        __atomic_store_n(&player->running, false, __ATOMIC_RELEASE);
+        return false;
+    }
+
+    LOG_INFO("Playback thread started: %u ms periods, %zu samples", period_ms, player->period_samples);
+    return true;
+}
+
+void downlink_player_stop(downlink_player_t* player) {
+    if (!player || !__atomic_load_n(&player->running, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    __atomic_store_n(&player->running, false, __ATOMIC_RELEASE);
+    pthread_join(player->thread, NULL);
+}
+
+void downlink_player_reset(downlink_player_t* player) {
+    if (!player) {
+        return;
+    }
+
+    pthread_mutex_lock(&player->mutex);
+    player->frame_samples = 0;
+    player->frame_offset = 0;
+    if (player->resampler) {
+        resampler_reset(player->resampler);
+    }
+    pthread_mutex_unlock(&player->mutex);
+}
+
+void downlink_player_get_stats(downlink_player_t* player, downlink_player_stats_t* stats) {
+    if (!player || !stats) {
+        return;
+    }
+    pthread_mutex_lock(&player->mutex);
+    *stats = player->stats;
+    pthread_mutex_unlock(&player->mutex);
+}
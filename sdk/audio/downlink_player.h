@@ -0,0 +1,140 @@
+#ifndef DOWNLINK_PLAYER_H
+#define DOWNLINK_PLAYER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "audio_interface.h"
+#include "jitter_buffer.h"
+#include "resampler.h"
+#include "../codecs/audio_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Called after a period containing decoded audio was handed to the device
+ * @param timestamp downlink timestamp of the first frame in the period
+ */
+typedef void (*downlink_player_played_callback_t)(uint32_t timestamp, void* user_data);
+
+/**
+ * Downlink player statistics
+ */
+typedef struct {
+    uint64_t periods_played;        // Periods that carried decoded audio
+    uint64_t periods_silent;        // Periods with nothing to play
+    uint64_t frames_decoded;
+    uint64_t frames_concealed;      // Frames produced by packet loss concealment
+    uint64_t device_overruns;       // Periods dropped because the device stayed full
+    uint64_t max_wakeup_late_us;    // Worst lateness of the playback thread
+} downlink_player_stats_t;
+
+/**
+ * Downlink player
+ *
+ * Decodes frames from a jitter buffer and re-chunks them into fixed-size
+ * PCM periods. Periods are either pulled by the application's device
+ * callback with downlink_player_read(), or pushed to an AudioInterface by
+ * a playback thread at device cadence.
+ */
+typedef struct {
+    jitter_buffer_t* jitter;        // Source of encoded frames, not owned
+    audio_codec_t* decoder;         // Not owned; re-initialized on format change
+    audio_format_t format;          // Current decode format
+    int16_t* frame;                 // Decoded (resampled, remixed) frame being drained into periods
+    size_t frame_capacity;
+    size_t frame_samples;
+    size_t frame_offset;
+    uint32_t frame_timestamp;
+    int output_rate;                // Rate of the periods, 0 for the decode rate
+    int output_channels;            // Channels of the periods, 0 for the decode channels
+    resampler_t* resampler;         // Decode rate -> output_rate, NULL when they match
+    int16_t* decoded;               // Decoder output before resampling
+    size_t decoded_capacity;
+    pthread_mutex_t mutex;
+
+    AudioInterface* device;         // Playback thread target, not owned
+    size_t period_samples;          // Interleaved samples per period
+    uint32_t period_ms;
+    downlink_player_played_callback_t played;
+    void* played_user_data;
+    pthread_t thread;
+    bool running;                   // Accessed atomically
+
+    downlink_player_stats_t stats;
+} downlink_player_t;
+
+/**
+ * Create a player
+ * @param jitter jitter buffer the network thread feeds
+ * @param decoder decoder instance, initialized by downlink_player_set_format()
+ * @return player or NULL on failure
+ */
+downlink_player_t* downlink_player_create(jitter_buffer_t* jitter, audio_codec_t* decoder);
+
+/**
+ * Stop the playback thread if running and free the player
+ */
+void downlink_player_destroy(downlink_player_t* player);
+
+/**
+ * Configure the decoder; a no-op when the format is unchanged
+ * @param sample_rate output sample rate
+ * @param channels output channels
+ * @param frame_duration_ms frame duration advertised by the server; the decode
+ *        buffer also fits longer multi-frame packets of up to 120 ms
+ * @return true on success
+ */
+bool downlink_player_set_format(downlink_player_t* player, int sample_rate, int channels, int frame_duration_ms);
+
+/**
+ * Produce periods at a rate other than the decode rate by resampling
+ * decoded frames; a no-op when unchanged
+ * @param sample_rate period sample rate, 0 for the decode rate
+ * @return true on success
+ */
+bool downlink_player_set_output_rate(downlink_player_t* player, int sample_rate);
+
+/**
+ * Fill exactly one period of PCM, padding with silence when the buffer runs dry
+ * @param pcm output buffer of at least `samples` interleaved samples at the output rate and channels
+ * @param samples period length in interleaved samples
+ * @param timestamp downlink timestamp of the first audible frame, may be NULL
+ * @return number of decoded (non padding) samples written
+ */
+size_t downlink_player_read(downlink_player_t* player, int16_t* pcm, size_t samples, uint32_t* timestamp);
+
+/**
+ * Start a thread that writes one period to `device` every period_ms; decoded
+ * frames are remixed to the device channel count
+ * @param device initialized playback device
+ * @param period_ms period length, 0 for the decode frame duration
+ * @param played called on the playback thread after each audible period, may be NULL
+ * @return true if the thread was started
+ */
+bool downlink_player_start(downlink_player_t* player, AudioInterface* device, uint32_t period_ms,
+                           downlink_player_played_callback_t played, void* user_data);
+
+/**
+ * Stop the playback thread
+ */
+void downlink_player_stop(downlink_player_t* player);
+
+/**
+ * Drop the partially played frame
+ */
+void downlink_player_reset(downlink_player_t* player);
+
+/**
+ * Snapshot statistics
+ */
+void downlink_player_get_stats(downlink_player_t* player, downlink_player_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DOWNLINK_PLAYER_H
@@ -0,0 +1,428 @@
+#include "jitter_buffer.h"
+#include "../log/linx_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define JITTER_BUFFER_DEFAULT_FRAME_MS   60
+#define JITTER_BUFFER_DEFAULT_MAX_MS     600
+#define JITTER_BUFFER_DEFAULT_CAPACITY   32
+#define JITTER_BUFFER_DEFAULT_FRAME_SIZE 1275
+
+// Timestamps wrap after ~49 days, compare them as serial numbers
+static int32_t ts_diff(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b);
+}
+
+static uint32_t clamp_delay(const jitter_buffer_t* jb, uint32_t delay_ms) {
+    if (delay_ms < jb->config.min_delay_ms) {
+        return jb->config.min_delay_ms;
+    }
+    if (delay_ms > jb->config.max_delay_ms) {
+        return jb->config.max_delay_ms;
+    }
+    return delay_ms;
+}
+
+// Target depth: one frame plus the worst recent lateness plus the underrun boost
+static void update_target(jitter_buffer_t* jb) {
+    uint32_t peak = 0;
+    for (size_t i = 0; i < jb->lateness_count; i++) {
+        if (jb->lateness[i] > peak) {
+            peak = jb->lateness[i];
+        }
+    }
+    jb->stats.target_ms = clamp_delay(jb, jb->config.frame_duration_ms + peak + jb->boost_ms);
+}
+
+static void update_depth(jitter_buffer_t* jb) {
+    jb->stats.depth_ms = jb->buffered_ms;
+    if (jb->buffered_ms > jb->stats.max_depth_ms) {
+        jb->stats.max_depth_ms = jb->buffered_ms;
+    }
+}
+
+// Start a new stream: timestamps and arrival anchor no longer relate to the old one
+static void restart_stream(jitter_buffer_t* jb) {
+    jb->playing = false;
+    jb->draining = false;
+    jb->started = false;
+    jb->has_last = false;
+    jb->last_duration_ms = jb->config.frame_duration_ms;
+}
+
+// Record how late a frame arrived relative to the best-case transit of its stream.
+// Frames that arrive early (a server sending faster than real time) only move the
+// anchor and never inflate the target.
+static void track_arrival(jitter_buffer_t* jb, uint32_t timestamp, uint32_t arrival_ms) {
+    int32_t delay = ts_diff(arrival_ms, timestamp);
+
+    if (!jb->has_last) {
+        jb->anchor_delay_ms = delay;
+    } else {
+        int32_t d = ts_diff(arrival_ms, jb->last_arrival_ms) - ts_diff(timestamp, jb->last_timestamp);
+        if (d < 0) {
+            d = -d;
+        }
+        jb->jitter_q4 += (uint32_t)d - ((jb->jitter_q4 + 8) >> 4);
+        if (delay < jb->anchor_delay_ms) {
+            jb->anchor_delay_ms = delay;
+        }
+    }
+
+    jb->lateness[jb->lateness_head] = (uint32_t)(delay - jb->anchor_delay_ms);
+    jb->lateness_head = (jb->lateness_head + 1) % JITTER_BUFFER_HISTORY;
+    if (jb->lateness_count < JITTER_BUFFER_HISTORY) {
+        jb->lateness_count++;
+    }
+    update_target(jb);
+}
+
+void jitter_buffer_config_default(jitter_buffer_config_t* config) {
+    if (!config) {
+        return;
+    }
+    memset(config, 0, sizeof(*config));
+    config->frame_duration_ms = JITTER_BUFFER_DEFAULT_FRAME_MS;
+    config->min_delay_ms = JITTER_BUFFER_DEFAULT_FRAME_MS;
+    config->max_delay_ms = JITTER_BUFFER_DEFAULT_MAX_MS;
+    config->capacity = JITTER_BUFFER_DEFAULT_CAPACITY;
+    config->max_frame_size = JITTER_BUFFER_DEFAULT_FRAME_SIZE;
+    config->timestamped = false;
+}
+
+jitter_buffer_t* jitter_buffer_create(const jitter_buffer_config_t* config) {
+    jitter_buffer_config_t cfg;
+    jitter_buffer_config_default(&cfg);
+    if (config) {
+        cfg.timestamped = config->timestamped;
+        if (config->frame_duration_ms) cfg.frame_duration_ms = config->frame_duration_ms;
+        cfg.min_delay_ms = config->min_delay_ms ? config->min_delay_ms : cfg.frame_duration_ms;
+        if (config->max_delay_ms) cfg.max_delay_ms = config->max_delay_ms;
+        if (config->capacity) cfg.capacity = config->capacity;
+        if (config->max_frame_size) cfg.max_frame_size = config->max_frame_size;
+    }
+    if (cfg.max_delay_ms < cfg.min_delay_ms) {
+        cfg.max_delay_ms = cfg.min_delay_ms;
+    }
+
+    jitter_buffer_t* jb = (jitter_buffer_t*)calloc(1, sizeof(jitter_buffer_t));
+    if (!jb) {
+        LOG_ERROR("Failed to allocate jitter buffer");
+        return NULL;
+    }
+    jb->config = cfg;
+    jb->slots = (jitter_buffer_slot_t*)calloc(cfg.capacity, sizeof(jitter_buffer_slot_t));
+    jb->pool = (uint8_t*)malloc(cfg.capacity * cfg.max_frame_size);
+    jb->order = (size_t*)malloc(cfg.capacity * sizeof(size_t));
+    jb->free_slots = (size_t*)malloc(cfg.capacity * sizeof(size_t));
+    jb->scratch = (uint8_t*)malloc(cfg.max_frame_size);
+    if (!jb->slots || !jb->pool || !jb->order || !jb->free_slots || !jb->scratch) {
+        LOG_ERROR("Failed to allocate jitter buffer slots");
+        free(jb->slots);
+        free(jb->pool);
+        free(jb->order);
+        free(jb->free_slots);
+        free(jb->scratch);
+        free(jb);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < cfg.capacity; i++) {
+        jb->slots[i].data = jb->pool + i * cfg.max_frame_size;
+        jb->free_slots[i] = cfg.capacity - 1 - i;
+    }
+    jb->free_count = cfg.capacity;
+    pthread_mutex_init(&jb->mutex, NULL);
+    restart_stream(jb);
+    update_target(jb);
+
+    LOG_INFO("Jitter buffer created: %u ms frames, target %u-%u ms, %zu slots, %s",
+             cfg.frame_duration_ms, cfg.min_delay_ms, cfg.max_delay_ms, cfg.capacity,
+             cfg.timestamped ? "timestamped" : "arrival ordered");
+    return jb;
+}
+
+void jitter_buffer_destroy(jitter_buffer_t* jb) {
+    if (!jb) {
+        return;
+    }
+    pthread_mutex_destroy(&jb->mutex);
+    free(jb->slots);
+    free(jb->pool);
+    free(jb->order);
+    free(jb->free_slots);
+    free(jb->scratch);
+    free(jb);
+}
+
+jitter_buffer_result_t jitter_buffer_put(jitter_buffer_t* jb, uint32_t timestamp, uint32_t duration_ms,
+                                         const uint8_t* data, size_t size, uint32_t arrival_ms) {
+    if (!jb || (!data && size > 0)) {
+        return JITTER_BUFFER_INVALID_PARAMETER;
+    }
+    if (size > jb->config.max_frame_size) {
+        LOG_WARN("Jitter buffer: frame of %zu bytes exceeds slot size %zu", size, jb->config.max_frame_size);
+        return JITTER_BUFFER_INVALID_PARAMETER;
+    }
+    if (duration_ms == 0) {
+        duration_ms = jb->config.frame_duration_ms;
+    }
+
+    pthread_mutex_lock(&jb->mutex);
+    jb->stats.frames_received++;
+
+    if (!jb->config.timestamped) {
+        timestamp = jb->has_last ? jb->last_timestamp + jb->last_put_duration_ms : arrival_ms;
+    }
+
+    if (jb->started && ts_diff(timestamp, jb->next_timestamp) < 0) {
+        jb->stats.late_frames++;
+        pthread_mutex_unlock(&jb->mutex);
+        return JITTER_BUFFER_LATE;
+    }
+
+    // Find the insertion point from the tail, frames normally arrive in order
+    size_t pos = jb->count;
+    while (pos > 0 && ts_diff(jb->slots[jb->order[pos - 1]].timestamp, timestamp) > 0) {
+        pos--;
+    }
+    if (pos > 0 && jb->slots[jb->order[pos - 1]].timestamp == timestamp) {
+        jb->stats.duplicate_frames++;
+        pthread_mutex_unlock(&jb->mutex);
+        return JITTER_BUFFER_DUPLICATE;
+    }
+    if (jb->free_count == 0) {
+        jb->stats.overflow_frames++;
+        pthread_mutex_unlock(&jb->mutex);
+        return JITTER_BUFFER_FULL;
+    }
+
+    track_arrival(jb, timestamp, arrival_ms);
+    if (!jb->has_last || ts_diff(timestamp, jb->last_timestamp) > 0) {
+        jb->last_timestamp = timestamp;
+        jb->last_put_duration_ms = duration_ms;
+    }
+    jb->last_arrival_ms = arrival_ms;
+    jb->has_last = true;
+
+    size_t index = jb->free_slots[--jb->free_count];
+    jitter_buffer_slot_t* slot = &jb->slots[index];
+    slot->timestamp = timestamp;
+    slot->duration_ms = duration_ms;
+    slot->size = size;
+    if (size > 0) {
+        memcpy(slot->data, data, size);
+    }
+    memmove(&jb->order[pos + 1], &jb->order[pos], (jb->count - pos) * sizeof(size_t));
+    jb->order[pos] = index;
+    jb->count++;
+    jb->buffered_ms += duration_ms;
+    update_depth(jb);
+
+    pthread_mutex_unlock(&jb->mutex);
+    return JITTER_BUFFER_OK;
+}
+
+jitter_buffer_result_t jitter_buffer_get(jitter_buffer_t* jb, uint8_t* buffer, size_t buffer_size,
+                                         size_t* frame_size, uint32_t* timestamp) {
+    if (!jb || !buffer || !frame_size) {
+        return JITTER_BUFFER_INVALID_PARAMETER;
+    }
+    *frame_size = 0;
+
+    pthread_mutex_lock(&jb->mutex);
+
+    // Prebuffer until the target depth is reached (or the stream has ended)
+    if (!jb->playing) {
+        if (jb->count == 0 || (!jb->draining && jb->buffered_ms < jb->stats.target_ms)) {
+            pthread_mutex_unlock(&jb->mutex);
+            return JITTER_BUFFER_EMPTY;
+        }
+        uint32_t head = jb->slots[jb->order[0]].timestamp;
+        // After an underrun the silence already covered the gap, resume at the first frame
+        if (!jb->started || ts_diff(head, jb->next_timestamp) > 0) {
+            jb->next_timestamp = head;
+            jb->started = true;
+        }
+        jb->playing = true;
+    }
+
+    if (jb->count == 0) {
+        jb->playing = false;
+        if (jb->draining) {
+            restart_stream(jb);
+        } else {
+            jb->stats.underruns++;
+            jb->stable_frames = 0;
+            if (jb->boost_ms < jb->config.max_delay_ms) {
+                jb->boost_ms += jb->config.frame_duration_ms;
+            }
+            update_target(jb);
+            LOG_DEBUG("Jitter buffer underrun, target now %u ms", jb->stats.target_ms);
+        }
+        pthread_mutex_unlock(&jb->mutex);
+        return JITTER_BUFFER_EMPTY;
+    }
+
+    size_t index = jb->order[0];
+    jitter_buffer_slot_t* slot = &jb->slots[index];
+    int32_t ahead = ts_diff(slot->timestamp, jb->next_timestamp);
+
+    if (ahead > (int32_t)jb->config.max_delay_ms) {
+        // Sender skipped far ahead, concealing the whole gap would only add latency
+        jb->next_timestamp = slot->timestamp;
+    } else if (ahead > 0 && ahead >= (int32_t)(jb->last_duration_ms / 2)) {
+        if (timestamp) {
+            *timestamp = jb->next_timestamp;
+        }
+        jb->next_timestamp += jb->last_duration_ms;
+        jb->stats.frames_concealed++;
+        pthread_mutex_unlock(&jb->mutex);
+        return JITTER_BUFFER_LOST;
+    }
+
+    if (slot->size > buffer_size) {
+        pthread_mutex_unlock(&jb->mutex);
+        LOG_ERROR("Jitter buffer: output buffer too small (%zu < %zu)", buffer_size, slot->size);
+        return JITTER_BUFFER_INVALID_PARAMETER;
+    }
+
+    memcpy(buffer, slot->data, slot->size);
+    *frame_size = slot->size;
+    if (timestamp) {
+        *timestamp = slot->timestamp;
+    }
+    jb->next_timestamp = slot->timestamp + slot->duration_ms;
+    jb->last_duration_ms = slot->duration_ms;
+
+    jb->count--;
+    memmove(&jb->order[0], &jb->order[1], jb->count * sizeof(size_t));
+    jb->free_slots[jb->free_count++] = index;
+    jb->buffered_ms -= slot->duration_ms;
+    update_depth(jb);
+
+    jb->stats.frames_played++;
+    if (++jb->stable_frames >= JITTER_BUFFER_DECAY_FRAMES && jb->boost_ms > 0) {
+        jb->boost_ms = jb->boost_ms > jb->config.frame_duration_ms ?
+                       jb->boost_ms - jb->config.frame_duration_ms : 0;
+        jb->stable_frames = 0;
+        update_target(jb);
+    }
+
+    pthread_mutex_unlock(&jb->mutex);
+    return JITTER_BUFFER_OK;
+}
+
+// Copy the frame that directly follows a hole, whose in-band FEC may carry the lost audio
+static size_t peek_next(jitter_buffer_t* jb, uint8_t* buffer, size_t buffer_size) {
+    size_t size = 0;
+    pthread_mutex_lock(&jb->mutex);
+    if (jb->count > 0) {
+        const jitter_buffer_slot_t* slot = &jb->slots[jb->order[0]];
+        if (slot->timestamp == jb->next_timestamp && slot->size > 0 && slot->size <= buffer_size) {
+            memcpy(buffer, slot->data, slot->size);
+            size = slot->size;
+        }
+    }
+    pthread_mutex_unlock(&jb->mutex);
+    return size;
+}
+
+// Fill one frame of concealment: FEC from the next frame when given, codec
+// PLC otherwise, silence when the codec has neither
+static void conceal(jitter_buffer_t* jb, audio_codec_t* decoder, const uint8_t* next, size_t next_size,
+                    int16_t* pcm, size_t pcm_size, size_t* decoded_size) {
+    pthread_mutex_lock(&jb->mutex);
+    uint32_t duration_ms = jb->last_duration_ms;
+    pthread_mutex_unlock(&jb->mutex);
+
+    size_t lost_samples = (size_t)decoder->decoder_format.sample_rate * duration_ms / 1000;
+    if (decoder->vtable->decode_lost &&
+        decoder->vtable->decode_lost(decoder, next, next_size, lost_samples, pcm, pcm_size,
+                                     decoded_size) == CODEC_SUCCESS &&
+        *decoded_size > 0) {
+        if (next) {
+            pthread_mutex_lock(&jb->mutex);
+            jb->stats.frames_recovered++;
+            pthread_mutex_unlock(&jb->mutex);
+        }
+        return;
+    }
+
+    size_t samples = lost_samples * (decoder->decoder_format.channels > 0 ? (size_t)decoder->decoder_format.channels : 1);
+    if (samples > pcm_size) {
+        samples = pcm_size;
+    }
+    memset(pcm, 0, samples * sizeof(int16_t));
+    *decoded_size = samples;
+}
+
+jitter_buffer_result_t jitter_buffer_decode(jitter_buffer_t* jb, audio_codec_t* decoder,
+                                            int16_t* pcm, size_t pcm_size,
+                                            size_t* decoded_size, uint32_t* timestamp) {
+    if (!jb || !decoder || !decoder->vtable || !pcm || !decoded_size) {
+        return JITTER_BUFFER_INVALID_PARAMETER;
+    }
+    *decoded_size = 0;
+
+    size_t frame_size = 0;
+    jitter_buffer_result_t result = jitter_buffer_get(jb, jb->scratch, jb->config.max_frame_size,
+                                                      &frame_size, timestamp);
+    if (result == JITTER_BUFFER_OK) {
+        if (decoder->vtable->decode(decoder, jb->scratch, frame_size, pcm, pcm_size,
+                                    decoded_size) == CODEC_SUCCESS) {
+            return JITTER_BUFFER_OK;
+        }
+        LOG_WARN("Jitter buffer: undecodable frame of %zu bytes, concealing", frame_size);
+        pthread_mutex_lock(&jb->mutex);
+        jb->stats.frames_concealed++;
+        pthread_mutex_unlock(&jb->mutex);
+        conceal(jb, decoder, NULL, 0, pcm, pcm_size, decoded_size);
+        return JITTER_BUFFER_LOST;
+    }
+    if (result != JITTER_BUFFER_LOST) {
+        return result;
+    }
+
+    size_t next_size = peek_next(jb, jb->scratch, jb->config.max_frame_size);
+    conceal(jb, decoder, next_size > 0 ? jb->scratch : NULL, next_size, pcm, pcm_size, decoded_size);
+    return JITTER_BUFFER_LOST;
+}
+
+void jitter_buffer_drain(jitter_buffer_t* jb) {
+    if (!jb) {
+        return;
+    }
+    pthread_mutex_lock(&jb->mutex);
+    if (jb->count > 0) {
+        jb->draining = true;
+    } else {
+        restart_stream(jb);
+    }
+    pthread_mutex_unlock(&jb->mutex);
+}
+
+void jitter_buffer_reset(jitter_buffer_t* jb) {
+    if (!jb) {
+        return;
+    }
+    pthread_mutex_lock(&jb->mutex);
+    for (size_t i = 0; i < jb->count; i++) {
+        jb->free_slots[jb->free_count++] = jb->order[i];
+    }
+    jb->count = 0;
+    jb->buffered_ms = 0;
+    update_depth(jb);
+    restart_stream(jb);
+    pthread_mutex_unlock(&jb->mutex);
+}
+
+void jitter_buffer_get_stats(jitter_buffer_t* jb, jitter_buffer_stats_t* stats) {
+    if (!jb || !stats) {
+        return;
+    }
+    pthread_mutex_lock(&jb->mutex);
+    *stats = jb->stats;
+    stats->jitter_ms = jb->jitter_q4 >> 4;
+    pthread_mutex_unlock(&jb->mutex);
+}
@@ -0,0 +1,188 @@
+#ifndef JITTER_BUFFER_H
+#define JITTER_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "../codecs/audio_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of recent frames whose lateness drives the target depth
+ */
+#define JITTER_BUFFER_HISTORY 64
+
+/**
+ * Frames played without an underrun before the underrun boost shrinks by one frame
+ */
+#define JITTER_BUFFER_DECAY_FRAMES 50
+
+/**
+ * Jitter buffer result codes
+ */
+typedef enum {
+    JITTER_BUFFER_OK = 0,           // put: frame queued; get: frame returned
+    JITTER_BUFFER_LOST,             // get: the next frame is missing, conceal it
+    JITTER_BUFFER_EMPTY,            // get: prebuffering or underrun, play silence
+    JITTER_BUFFER_LATE,             // put: frame arrived after its playout time, discarded
+    JITTER_BUFFER_DUPLICATE,        // put: frame with this timestamp already queued
+    JITTER_BUFFER_FULL,             // put: all slots in use, frame discarded
+    JITTER_BUFFER_INVALID_PARAMETER
+} jitter_buffer_result_t;
+
+/**
+ * Jitter buffer configuration
+ */
+typedef struct {
+    uint32_t frame_duration_ms;     // Nominal frame duration, used for concealed frames (default 60)
+    uint32_t min_delay_ms;          // Lower bound of the target depth (default one frame)
+    uint32_t max_delay_ms;          // Upper bound of the target depth (default 600)
+    size_t capacity;                // Frame slots (default 32)
+    size_t max_frame_size;          // Bytes per frame slot (default 1275, one Opus frame)
+    bool timestamped;               // Frames carry sender timestamps (protocol v2);
+                                    // otherwise they are sequenced in arrival order
+} jitter_buffer_config_t;
+
+/**
+ * Jitter buffer statistics
+ */
+typedef struct {
+    uint32_t depth_ms;              // Audio currently buffered
+    uint32_t max_depth_ms;          // Largest depth seen
+    uint32_t target_ms;             // Current adaptive target depth
+    uint32_t jitter_ms;             // Smoothed interarrival jitter (RFC 3550)
+    uint64_t frames_received;
+    uint64_t frames_played;
+    uint64_t frames_concealed;      // Holes and undecodable frames handed to PLC
+    uint64_t frames_recovered;      // Holes decoded from the next frame's in-band FEC
+    uint64_t late_frames;
+    uint64_t duplicate_frames;
+    uint64_t overflow_frames;
+    uint64_t underruns;             // Buffer ran dry in the middle of a stream
+} jitter_buffer_stats_t;
+
+/**
+ * Buffered frame
+ */
+typedef struct {
+    uint32_t timestamp;
+    uint32_t duration_ms;
+    size_t size;
+    uint8_t* data;                  // Points into the slot pool
+} jitter_buffer_slot_t;
+
+/**
+ * Adaptive jitter buffer for downlink audio frames
+ *
+ * put() is called by the network thread and get()/decode() by the playback
+ * thread at device cadence; all state is guarded by one mutex. Frames are
+ * kept ordered by timestamp in preallocated slots, so the steady state does
+ * not allocate.
+ */
+typedef struct {
+    jitter_buffer_config_t config;
+    pthread_mutex_t mutex;
+
+    jitter_buffer_slot_t* slots;
+    uint8_t* pool;                  // capacity * max_frame_size bytes
+    size_t* order;                  // Occupied slot indices sorted by timestamp
+    size_t* free_slots;
+    size_t count;
+    size_t free_count;
+    uint32_t buffered_ms;
+    uint8_t* scratch;               // Encoded frame for decode(), consumer side only
+
+    // Playout state
+    bool playing;                   // false while prebuffering
+    bool draining;                  // Stream ended, play out without waiting for the target
+    bool started;                   // next_timestamp is valid for this stream
+    uint32_t next_timestamp;        // Timestamp due at the next get()
+    uint32_t last_duration_ms;      // Duration of the last frame played
+
+    // Arrival tracking for the current stream
+    bool has_last;
+    uint32_t last_timestamp;        // Last frame queued (sequencing and RFC 3550 jitter)
+    uint32_t last_arrival_ms;
+    uint32_t last_put_duration_ms;
+    int32_t anchor_delay_ms;        // Smallest (arrival - timestamp) seen, the best-case transit
+
+    // Adaptation
+    uint32_t lateness[JITTER_BUFFER_HISTORY];
+    size_t lateness_count;
+    size_t lateness_head;
+    uint32_t jitter_q4;             // RFC 3550 jitter estimate, 1/16 ms units
+    uint32_t boost_ms;              // Extra depth added after underruns
+    uint32_t stable_frames;
+
+    jitter_buffer_stats_t stats;
+} jitter_buffer_t;
+
+/**
+ * Fill a configuration with defaults
+ */
+void jitter_buffer_config_default(jitter_buffer_config_t* config);
+
+/**
+ * Create a jitter buffer, zero fields in config take their defaults
+ * @return jitter buffer or NULL on failure
+ */
+jitter_buffer_t* jitter_buffer_create(const jitter_buffer_config_t* config);
+
+/**
+ * Destroy a jitter buffer
+ */
+void jitter_buffer_destroy(jitter_buffer_t* jb);
+
+/**
+ * Queue a received frame
+ * @param timestamp sender timestamp in ms, ignored when the buffer is not timestamped
+ * @param duration_ms frame duration, 0 for the configured nominal duration
+ * @param arrival_ms local monotonic arrival time
+ */
+jitter_buffer_result_t jitter_buffer_put(jitter_buffer_t* jb, uint32_t timestamp, uint32_t duration_ms,
+                                         const uint8_t* data, size_t size, uint32_t arrival_ms);
+
+/**
+ * Take the next frame due for playout
+ * @return JITTER_BUFFER_OK with the frame copied to buffer, JITTER_BUFFER_LOST
+ *         for a hole the caller should conceal, or JITTER_BUFFER_EMPTY
+ */
+jitter_buffer_result_t jitter_buffer_get(jitter_buffer_t* jb, uint8_t* buffer, size_t buffer_size,
+                                         size_t* frame_size, uint32_t* timestamp);
+
+/**
+ * Take the next frame and decode it, running packet-loss concealment for holes
+ * and undecodable frames. A hole directly followed by a buffered frame is
+ * rebuilt from that frame's in-band FEC; other holes use the codec's PLC
+ * (silence for codecs without decode_lost)
+ * @param decoded_size decoded samples, 0 on JITTER_BUFFER_EMPTY
+ */
+jitter_buffer_result_t jitter_buffer_decode(jitter_buffer_t* jb, audio_codec_t* decoder,
+                                            int16_t* pcm, size_t pcm_size,
+                                            size_t* decoded_size, uint32_t* timestamp);
+
+/**
+ * Mark the end of the current stream: queued frames play out without waiting
+ * for the target depth, and the next put() starts a new stream
+ */
+void jitter_buffer_drain(jitter_buffer_t* jb);
+
+/**
+ * Drop all queued frames and start a new stream; adaptation state is kept
+ */
+void jitter_buffer_reset(jitter_buffer_t* jb);
+
+/**
+ * Snapshot statistics
+ */
+void jitter_buffer_get_stats(jitter_buffer_t* jb, jitter_buffer_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JITTER_BUFFER_H
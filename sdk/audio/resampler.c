@@ -0,0 +1,234 @@
+#include "resampler.h"
+#include "../log/linx_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if !defined(RESAMPLER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define RESAMPLER_SSE2 1
+#elif !defined(RESAMPLER_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define RESAMPLER_NEON 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Largest interpolation factor accepted; bounds the filter table size
+#define RESAMPLER_MAX_PHASES 1024
+
+// Passband edge as a fraction of the lower Nyquist frequency
+#define RESAMPLER_CUTOFF 0.92
+
+#define RESAMPLER_HISTORY_FRAMES (RESAMPLER_TAPS - 1 + RESAMPLER_BLOCK_FRAMES)
+
+static int gcd(int a, int b) {
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static float dot_product(const float* a, const float* b) {
+#if defined(RESAMPLER_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    for (int i = 0; i < RESAMPLER_TAPS; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    return _mm_cvtss_f32(acc);
+#elif defined(RESAMPLER_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (int i = 0; i < RESAMPLER_TAPS; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float32x2_t sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#else
+    float acc = 0.0f;
+    for (int i = 0; i < RESAMPLER_TAPS; i++) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+#endif
+}
+
+// Blackman-windowed sinc prototype at the upsampled rate, split into
+// reversed branches so each output is a forward dot product over history
+static void design_filter(resampler_t* resampler) {
+    int up = resampler->up;
+    size_t length = (size_t)up * RESAMPLER_TAPS;
+    int lower_rate = resampler->in_rate < resampler->out_rate ? resampler->in_rate : resampler->out_rate;
+    double cutoff = RESAMPLER_CUTOFF * 0.5 * lower_rate / ((double)resampler->in_rate * up);
+    double center = (double)(length - 1) / 2.0;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        double x = (double)i - center;
+        double sinc = x == 0.0 ? 1.0 : sin(2.0 * M_PI * cutoff * x) / (2.0 * M_PI * cutoff * x);
+        double window = 0.42 - 0.5 * cos(2.0 * M_PI * i / (length - 1)) + 0.08 * cos(4.0 * M_PI * i / (length - 1));
+        double h = 2.0 * cutoff * sinc * window;
+        int phase = (int)(i % (size_t)up);
+        int tap = (int)(i / (size_t)up);
+        resampler->filter[(size_t)phase * RESAMPLER_TAPS + (RESAMPLER_TAPS - 1 - tap)] = (float)h;
+        sum += h;
+    }
+
+    // Unity DC gain per branch: zero stuffing divides the signal by `up`
+    float gain = (float)(up / sum);
+    for (size_t i = 0; i < length; i++) {
+        resampler->filter[i] *= gain;
+    }
+}
+
+resampler_t* resampler_create(int in_rate, int out_rate, int channels) {
+    if (in_rate <= 0 || out_rate <= 0 || channels <= 0) {
+        LOG_ERROR("Invalid resampler parameters: %d -> %d Hz, %d channels", in_rate, out_rate, channels);
+        return NULL;
+    }
+
+    int divisor = gcd(in_rate, out_rate);
+    int up = out_rate / divisor;
+    int down = in_rate / divisor;
+    if (up > RESAMPLER_MAX_PHASES || down > up * (RESAMPLER_TAPS - 1)) {
+        LOG_ERROR("Unsupported resampling ratio %d -> %d Hz", in_rate, out_rate);
+        return NULL;
+    }
+
+    resampler_t* resampler = (resampler_t*)calloc(1, sizeof(resampler_t));
+    if (!resampler) {
+        LOG_ERROR("Failed to allocate resampler");
+        return NULL;
+    }
+    resampler->in_rate = in_rate;
+    resampler->out_rate = out_rate;
+    resampler->channels = channels;
+    resampler->up = up;
+    resampler->down = down;
+
+    if (in_rate != out_rate) {
+        resampler->filter = (float*)malloc((size_t)up * RESAMPLER_TAPS * sizeof(float));
+        resampler->history = (float*)malloc((size_t)channels * RESAMPLER_HISTORY_FRAMES * sizeof(float));
+        if (!resampler->filter || !resampler->history) {
+            LOG_ERROR("Failed to allocate resampler filter");
+            resampler_destroy(resampler);
+            return NULL;
+        }
+        design_filter(resampler);
+    }
+    resampler_reset(resampler);
+
+    LOG_INFO("Resampler %d -> %d Hz (%d/%d, %d taps, %s)", in_rate, out_rate, up, down, RESAMPLER_TAPS,
+             resampler_is_vectorized() ? "SIMD" : "scalar");
+    return resampler;
+}
+
+void resampler_destroy(resampler_t* resampler) {
+    if (!resampler) {
+        return;
+    }
+    free(resampler->filter);
+    free(resampler->history);
+    free(resampler);
+}
+
+size_t resampler_max_output(const resampler_t* resampler, size_t in_frames) {
+    if (!resampler) {
+        return 0;
+    }
+    return (in_frames * (size_t)resampler->up + (size_t)resampler->down - 1) / (size_t)resampler->down + 1;
+}
+
+size_t resampler_process(resampler_t* resampler, const int16_t* input, size_t in_frames,
+                         int16_t* output, size_t out_capacity) {
+    if (!resampler || !input || !output) {
+        return 0;
+    }
+
+    size_t channels = (size_t)resampler->channels;
+    if (resampler->in_rate == resampler->out_rate) {
+        size_t frames = in_frames < out_capacity ? in_frames : out_capacity;
+        memcpy(output, input, frames * channels * sizeof(int16_t));
+        return frames;
+    }
+
+    size_t written = 0;
+    size_t consumed = 0;
+    while (consumed < in_frames) {
+        size_t block = in_frames - consumed;
+        if (block > RESAMPLER_BLOCK_FRAMES) {
+            block = RESAMPLER_BLOCK_FRAMES;
+        }
+
+        // Append the block to each channel's history, deinterleaved
+        for (size_t ch = 0; ch < channels; ch++) {
+            float* history = resampler->history + ch * RESAMPLER_HISTORY_FRAMES + resampler->history_frames;
+            const int16_t* in = input + consumed * channels + ch;
+            for (size_t i = 0; i < block; i++) {
+                history[i] = (float)in[i * channels];
+            }
+        }
+        resampler->history_frames += block;
+        consumed += block;
+
+        while (resampler->next_input < resampler->history_frames) {
+            const float* branch = resampler->filter + (size_t)resampler->phase * RESAMPLER_TAPS;
+            size_t start = resampler->next_input - (RESAMPLER_TAPS - 1);
+            if (written < out_capacity) {
+                for (size_t ch = 0; ch < channels; ch++) {
+                    float sample = dot_product(branch, resampler->history + ch * RESAMPLER_HISTORY_FRAMES + start);
+                    long rounded = lrintf(sample);
+                    if (rounded > INT16_MAX) {
+                        rounded = INT16_MAX;
+                    } else if (rounded < INT16_MIN) {
+                        rounded = INT16_MIN;
+                    }
+                    output[written * channels + ch] = (int16_t)rounded;
+                }
+                written++;
+            }
+            resampler->phase += resampler->down;
+            resampler->next_input += (size_t)(resampler->phase / resampler->up);
+            resampler->phase %= resampler->up;
+        }
+
+        // Keep only the taps the next output still needs
+        size_t keep_from = resampler->next_input - (RESAMPLER_TAPS - 1);
+        if (keep_from > 0) {
+            size_t keep = resampler->history_frames > keep_from ? resampler->history_frames - keep_from : 0;
+            for (size_t ch = 0; ch < channels; ch++) {
+                float* history = resampler->history + ch * RESAMPLER_HISTORY_FRAMES;
+                memmove(history, history + keep_from, keep * sizeof(float));
+            }
+            resampler->history_frames = keep;
+            resampler->next_input -= keep_from;
+        }
+    }
+    return written;
+}
+
+void resampler_reset(resampler_t* resampler) {
+    if (!resampler) {
+        return;
+    }
+    if (resampler->history) {
+        memset(resampler->history, 0, (size_t)resampler->channels * RESAMPLER_HISTORY_FRAMES * sizeof(float));
+    }
+    // Start with a zeroed window so the first input sample is the newest tap
+    resampler->history_frames = RESAMPLER_TAPS - 1;
+    resampler->next_input = RESAMPLER_TAPS - 1;
+    resampler->phase = 0;
+}
+
+bool resampler_is_vectorized(void) {
+#if defined(RESAMPLER_SSE2) || defined(RESAMPLER_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
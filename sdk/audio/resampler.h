@@ -0,0 +1,88 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Filter taps per polyphase branch, a multiple of the SIMD width
+ */
+#define RESAMPLER_TAPS 32
+
+/**
+ * Input frames converted per internal block
+ */
+#define RESAMPLER_BLOCK_FRAMES 480
+
+/**
+ * Polyphase resampler
+ *
+ * Converts interleaved 16-bit PCM between any two rates by the rational
+ * ratio up/down. A windowed-sinc low-pass prototype is split into `up`
+ * branches of RESAMPLER_TAPS coefficients; every output sample is one dot
+ * product of a branch with the most recent input history, vectorized with
+ * SSE2 or NEON when the target has them. State carries across calls, so
+ * PCM can be fed in chunks of any size.
+ */
+typedef struct {
+    int in_rate;
+    int out_rate;
+    int channels;
+    int up;                         // Interpolation factor (out_rate / gcd)
+    int down;                       // Decimation factor (in_rate / gcd)
+    float* filter;                  // up * RESAMPLER_TAPS, each branch reversed
+    float* history;                 // Per channel: RESAMPLER_TAPS - 1 + RESAMPLER_BLOCK_FRAMES samples
+    size_t history_frames;          // Valid frames in each channel's history
+    size_t next_input;              // History index of the newest input tap of the next output
+    int phase;                      // Branch of the next output
+} resampler_t;
+
+/**
+ * Create a resampler
+ * @param in_rate input sample rate
+ * @param out_rate output sample rate
+ * @param channels interleaved channels
+ * @return resampler or NULL on failure
+ */
+resampler_t* resampler_create(int in_rate, int out_rate, int channels);
+
+/**
+ * Free a resampler
+ */
+void resampler_destroy(resampler_t* resampler);
+
+/**
+ * Upper bound of output frames produced for `in_frames` input frames
+ */
+size_t resampler_max_output(const resampler_t* resampler, size_t in_frames);
+
+/**
+ * Convert a chunk of PCM
+ * @param input interleaved input, `in_frames` frames
+ * @param output interleaved output of at least resampler_max_output(in_frames) frames
+ * @param out_capacity output capacity in frames; output beyond it is discarded
+ * @return number of frames written
+ */
+size_t resampler_process(resampler_t* resampler, const int16_t* input, size_t in_frames,
+                         int16_t* output, size_t out_capacity);
+
+/**
+ * Clear the filter history, e.g. between unrelated streams
+ */
+void resampler_reset(resampler_t* resampler);
+
+/**
+ * Whether the dot product runs on SSE2/NEON in this build
+ */
+bool resampler_is_vectorized(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RESAMPLER_H
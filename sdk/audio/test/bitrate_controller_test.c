@@ -0,0 +1,258 @@
+/**
+ * 码率控制器单元测试
+ *
+ * 覆盖发送队列积压、拥塞、丢帧与RTT膨胀触发的降档、连续空闲周期后的升档、
+ * 升档失败后的等待加倍、码率上限、计数器回绕以及重置后的基线重建。
+ */
+
+#include "../bitrate_controller.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+// 三档的自定义码率表
+static const bitrate_level_t g_levels[] = {
+    {8000, 5, 4000},
+    {16000, 8, 8000},
+    {32000, 10, 20000},
+};
+
+static bitrate_controller_input_t idle_input(void) {
+    bitrate_controller_input_t input;
+    memset(&input, 0, sizeof(input));
+    return input;
+}
+
+// 测试各类拥塞信号立即降一档，且每个周期只评估一次
+static void test_step_down(void) {
+    printf("Testing step down...\n");
+
+    bitrate_controller_t* controller = bitrate_controller_create(NULL);
+    assert(controller != NULL);
+    bitrate_level_t level = bitrate_controller_get_level(controller);
+    assert(level.bitrate == 64000 && level.complexity == 10 && level.bandwidth_hz == 20000);
+
+    // 首次调用只记录基线
+    bitrate_controller_input_t input = idle_input();
+    assert(bitrate_controller_is_due(controller, 0));
+    assert(!bitrate_controller_update(controller, 0, &input, &level));
+    assert(!bitrate_controller_is_due(controller, 500));
+
+    // 队列积压
+    input.queue_depth = 5;
+    assert(bitrate_controller_update(controller, 1000, &input, &level));
+    assert(level.bitrate == 32000);
+    assert(!bitrate_controller_update(controller, 1500, &input, &level));
+
+    // 发送缓冲区拥塞
+    input.queue_depth = 0;
+    input.congested = true;
+    assert(bitrate_controller_update(controller, 2000, &input, &level));
+    assert(level.bitrate == 24000);
+
+    // 丢帧只按增量计算
+    input.congested = false;
+    input.dropped_frames = 3;
+    assert(bitrate_controller_update(controller, 3000, &input, &level));
+    assert(level.bitrate == 16000 && level.bandwidth_hz == 8000);
+    assert(!bitrate_controller_update(controller, 4000, &input, &level));
+
+    bitrate_controller_stats_t stats;
+    bitrate_controller_get_stats(controller, &stats);
+    assert(stats.evaluations == 4 && stats.step_downs == 3 && stats.step_ups == 0);
+    assert(stats.queue_triggers == 2 && stats.drop_triggers == 1 && stats.rtt_triggers == 0);
+    assert(stats.level == 2 && stats.bitrate == 16000);
+
+    bitrate_controller_destroy(controller);
+    printf("Step down test passed!\n");
+}
+
+// 测试升档需要连续空闲周期，升档后很快拥塞会使等待加倍
+static void test_step_up_hysteresis(void) {
+    printf("Testing step up hysteresis...\n");
+
+    bitrate_controller_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.levels = g_levels;
+    config.level_count = 3;
+    config.initial_level = 0;
+    config.probe_intervals = 3;
+    bitrate_controller_t* controller = bitrate_controller_create(&config);
+    assert(controller != NULL);
+
+    bitrate_controller_input_t input = idle_input();
+    bitrate_level_t level;
+    uint64_t now = 0;
+    assert(!bitrate_controller_update(controller, now, &input, &level));
+
+    // 介于高低水位之间的周期清零空闲计数
+    assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    input.queue_depth = 2;
+    assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    input.queue_depth = 1;
+    assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    assert(bitrate_controller_update(controller, now += 1000, &input, &level));
+    assert(level.bitrate == 16000);
+
+    // 试探失败：降档并把等待加倍到 6 个周期
+    input.queue_depth = 4;
+    assert(bitrate_controller_update(controller, now += 1000, &input, &level));
+    assert(level.bitrate == 8000);
+    bitrate_controller_stats_t stats;
+    bitrate_controller_get_stats(controller, &stats);
+    assert(stats.failed_probes == 1 && stats.probe_intervals == 6);
+
+    input.queue_depth = 0;
+    for (int i = 0; i < 5; i++) {
+        assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    }
+    assert(bitrate_controller_update(controller, now += 1000, &input, &level));
+    assert(level.bitrate == 16000);
+
+    // 新档位稳定一个等待周期后恢复默认等待并继续升档
+    for (int i = 0; i < 5; i++) {
+        assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    }
+    assert(bitrate_controller_update(controller, now += 1000, &input, &level));
+    assert(level.bitrate == 32000);
+    bitrate_controller_get_stats(controller, &stats);
+    assert(stats.probe_intervals == 3 && stats.step_ups == 3);
+
+    // 最高档不再升档
+    for (int i = 0; i < 10; i++) {
+        assert(!bitrate_controller_update(controller, now += 1000, &input, &level));
+    }
+
+    bitrate_controller_destroy(controller);
+    printf("Step up hysteresis test passed!\n");
+}
+
+// 测试只有新的RTT样本才触发降档，陈旧样本仍阻止升档
+static void test_rtt(void) {
+    printf("Testing RTT inflation...\n");
+
+    bitrate_controller_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.levels = g_levels;
+    config.level_count = 3;
+    config.initial_level = 1;
+    config.probe_intervals = 1;
+    bitrate_controller_t* controller = bitrate_controller_create(&config);
+    assert(controller != NULL);
+
+    bitrate_controller_input_t input = idle_input();
+    bitrate_level_t level;
+    input.rtt_samples = 1;
+    input.rtt_us = 60000;
+    input.rtt_min_us = 50000;
+    assert(!bitrate_controller_update(controller, 0, &input, &level));
+
+    input.rtt_samples = 2;
+    input.rtt_us = 500000;
+    assert(bitrate_controller_update(controller, 1000, &input, &level));
+    assert(level.bitrate == 8000);
+
+    // 陈旧的膨胀样本：既不降档也不升档
+    assert(!bitrate_controller_update(controller, 2000, &input, &level));
+    assert(!bitrate_controller_update(controller, 3000, &input, &level));
+
+    // RTT 回落后升档
+    input.rtt_samples = 3;
+    input.rtt_us = 70000;
+    assert(bitrate_controller_update(controller, 4000, &input, &level));
+    assert(level.bitrate == 16000);
+
+    bitrate_controller_stats_t stats;
+    bitrate_controller_get_stats(controller, &stats);
+    assert(stats.rtt_triggers == 1 && stats.step_downs == 1 && stats.step_ups == 1);
+
+    bitrate_controller_destroy(controller);
+    printf("RTT inflation test passed!\n");
+}
+
+// 测试码率上限裁掉更高的档位，默认从上限内的最高档开始
+static void test_max_bitrate(void) {
+    printf("Testing max bitrate...\n");
+
+    bitrate_controller_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.max_bitrate = 12000;
+    config.initial_level = 100;
+    config.probe_intervals = 1;
+    bitrate_controller_t* controller = bitrate_controller_create(&config);
+    assert(controller != NULL);
+    assert(bitrate_controller_get_level(controller).bitrate == 10000);
+
+    bitrate_controller_input_t input = idle_input();
+    bitrate_level_t level;
+    assert(!bitrate_controller_update(controller, 0, &input, &level));
+    for (uint64_t now = 1000; now <= 5000; now += 1000) {
+        assert(!bitrate_controller_update(controller, now, &input, &level));
+    }
+    bitrate_controller_destroy(controller);
+
+    // 上限低于最低档时仍保留最低档
+    config.max_bitrate = 1000;
+    controller = bitrate_controller_create(&config);
+    assert(controller != NULL);
+    assert(bitrate_controller_get_level(controller).bitrate == 6000);
+    bitrate_controller_destroy(controller);
+    printf("Max bitrate test passed!\n");
+}
+
+// 测试重连后计数器回落不被当作丢帧，重置保留当前档位
+static void test_reset(void) {
+    printf("Testing reset...\n");
+
+    bitrate_controller_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.levels = g_levels;
+    config.level_count = 3;
+    config.initial_level = 7;
+    bitrate_controller_t* controller = bitrate_controller_create(&config);
+    assert(controller != NULL);
+    assert(bitrate_controller_get_level(controller).bitrate == 32000);
+
+    bitrate_controller_input_t input = idle_input();
+    bitrate_level_t level;
+    input.dropped_frames = 10;
+    assert(!bitrate_controller_update(controller, 0, &input, &level));
+    input.dropped_frames = 4;
+    assert(!bitrate_controller_update(controller, 1000, &input, &level));
+    input.dropped_frames = 5;
+    assert(bitrate_controller_update(controller, 2000, &input, &level));
+    assert(level.bitrate == 16000);
+
+    // 重置后首次调用重新建立基线
+    bitrate_controller_reset(controller);
+    assert(bitrate_controller_is_due(controller, 2100));
+    input.dropped_frames = 0;
+    assert(!bitrate_controller_update(controller, 2100, &input, &level));
+    assert(!bitrate_controller_is_due(controller, 2200));
+    assert(bitrate_controller_get_level(controller).bitrate == 16000);
+
+    // 最低档继续拥塞时保持不变
+    input.queue_depth = 8;
+    assert(bitrate_controller_update(controller, 3100, &input, &level));
+    assert(!bitrate_controller_update(controller, 4100, &input, &level));
+    bitrate_controller_stats_t stats;
+    bitrate_controller_get_stats(controller, &stats);
+    assert(stats.level == 0 && stats.step_downs == 2 && stats.queue_triggers == 2);
+
+    bitrate_controller_destroy(controller);
+    printf("Reset test passed!\n");
+}
+
+int main(void) {
+    printf("=== bitrate controller tests ===\n");
+
+    test_step_down();
+    test_step_up_hysteresis();
+    test_rtt();
+    test_max_bitrate();
+    test_reset();
+
+    printf("All bitrate controller tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,320 @@
+/**
+ * 下行播放单元测试
+ *
+ * 使用存根编解码器（载荷即PCM）与内存中的播放设备，覆盖按固定周期切分解码帧、
+ * 缓冲为空时补静音、周期跨帧时的时间戳、重置、播放线程按设备节奏写入以及
+ * 单声道解码输出到立体声设备。
+ */
+
+#include "../downlink_player.h"
+#include "../../codecs/codec_stub.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+
+#define SAMPLE_RATE   16000
+#define FRAME_MS      20
+#define FRAME_SAMPLES (SAMPLE_RATE * FRAME_MS / 1000)
+
+static jitter_buffer_t* create_jitter(void) {
+    jitter_buffer_config_t config;
+    jitter_buffer_config_default(&config);
+    config.frame_duration_ms = FRAME_MS;
+    config.min_delay_ms = FRAME_MS;
+    config.timestamped = true;
+    config.max_frame_size = 6 * FRAME_SAMPLES * sizeof(int16_t);  // 存根载荷即PCM，最长120ms
+    jitter_buffer_t* jb = jitter_buffer_create(&config);
+    assert(jb != NULL);
+    return jb;
+}
+
+// 放入一帧，所有样本取值为 value
+static void put_frame(jitter_buffer_t* jb, uint32_t timestamp, int16_t value) {
+    int16_t pcm[FRAME_SAMPLES];
+    for (int i = 0; i < FRAME_SAMPLES; i++) {
+        pcm[i] = value;
+    }
+    assert(jitter_buffer_put(jb, timestamp, FRAME_MS, (const uint8_t*)pcm, sizeof(pcm), timestamp) ==
+           JITTER_BUFFER_OK);
+}
+
+// 测试解码帧被切分成固定大小的周期
+static void test_periods(void) {
+    printf("Testing fixed-size periods...\n");
+
+    jitter_buffer_t* jb = create_jitter();
+    audio_codec_t* decoder = codec_stub_create();
+    downlink_player_t* player = downlink_player_create(jb, decoder);
+    assert(player != NULL);
+
+    // 未设置格式前只输出静音
+    int16_t period[240];
+    uint32_t timestamp = 0;
+    assert(downlink_player_read(player, period, 240, &timestamp) == 0);
+    assert(downlink_player_set_format(player, SAMPLE_RATE, 1, FRAME_MS));
+    assert(downlink_player_set_format(player, SAMPLE_RATE, 1, FRAME_MS));
+
+    put_frame(jb, 1000, 1);
+    put_frame(jb, 1020, 2);
+    jitter_buffer_drain(jb);
+
+    // 15ms 周期：第二个周期跨越两帧，时间戳取周期首样本所在帧
+    assert(downlink_player_read(player, period, 240, &timestamp) == 240);
+    assert(timestamp == 1000 && period[0] == 1 && period[239] == 1);
+    assert(downlink_player_read(player, period, 240, &timestamp) == 240);
+    assert(timestamp == 1000 && period[0] == 1 && period[79] == 1 && period[80] == 2);
+
+    // 最后不足一个周期的部分补静音
+    memset(period, 0x7f, sizeof(period));
+    assert(downlink_player_read(player, period, 240, &timestamp) == 160);
+    assert(timestamp == 1020 && period[159] == 2 && period[160] == 0 && period[239] == 0);
+    assert(downlink_player_read(player, period, 240, &timestamp) == 0);
+    assert(period[0] == 0);
+
+    downlink_player_stats_t stats;
+    downlink_player_get_stats(player, &stats);
+    assert(stats.frames_decoded == 2 && stats.frames_concealed == 0);
+    assert(stats.periods_played == 3 && stats.periods_silent == 2);
+
+    // 重置丢弃正在播放的帧剩余部分
+    put_frame(jb, 2000, 3);
+    put_frame(jb, 2020, 4);
+    jitter_buffer_drain(jb);
+    assert(downlink_player_read(player, period, 80, &timestamp) == 80 && period[0] == 3);
+    downlink_player_reset(player);
+    assert(downlink_player_read(player, period, 80, &timestamp) == 80);
+    assert(period[0] == 4 && timestamp == 2020);
+
+    downlink_player_destroy(player);
+    decoder->vtable->destroy(decoder);
+    jitter_buffer_destroy(jb);
+    printf("Period test passed!\n");
+}
+
+// 测试长于声明帧长的多帧数据包按实际时长解码
+static void test_long_packets(void) {
+    printf("Testing packets longer than the advertised frame...\n");
+
+    jitter_buffer_t* jb = create_jitter();
+    audio_codec_t* decoder = codec_stub_create();
+    downlink_player_t* player = downlink_player_create(jb, decoder);
+    assert(player != NULL);
+    assert(downlink_player_set_format(player, SAMPLE_RATE, 1, FRAME_MS));
+
+    // 120ms 数据包（六帧）后接一个普通帧
+    static int16_t packet[6 * FRAME_SAMPLES];
+    for (int i = 0; i < 6 * FRAME_SAMPLES; i++) {
+        packet[i] = (int16_t)(i / FRAME_SAMPLES + 1);
+    }
+    assert(jitter_buffer_put(jb, 1000, 6 * FRAME_MS, (const uint8_t*)packet, sizeof(packet), 1000) ==
+           JITTER_BUFFER_OK);
+    put_frame(jb, 1120, 9);
+    jitter_buffer_drain(jb);
+
+    int16_t period[FRAME_SAMPLES];
+    uint32_t timestamp = 0;
+    for (int16_t f = 1; f <= 6; f++) {
+        assert(downlink_player_read(player, period, FRAME_SAMPLES, &timestamp) == FRAME_SAMPLES);
+        assert(timestamp == 1000 && period[0] == f && period[FRAME_SAMPLES - 1] == f);
+    }
+    assert(downlink_player_read(player, period, FRAME_SAMPLES, &timestamp) == FRAME_SAMPLES);
+    assert(timestamp == 1120 && period[0] == 9);
+
+    downlink_player_stats_t stats;
+    downlink_player_get_stats(player, &stats);
+    assert(stats.frames_decoded == 2 && stats.frames_concealed == 0);
+
+    downlink_player_destroy(player);
+    decoder->vtable->destroy(decoder);
+    jitter_buffer_destroy(jb);
+    printf("Long packet test passed!\n");
+}
+
+// 测试按输出采样率重采样后再切分周期
+static void test_output_rate(void) {
+    printf("Testing output resampling...\n");
+
+    jitter_buffer_t* jb = create_jitter();
+    audio_codec_t* decoder = codec_stub_create();
+    downlink_player_t* player = downlink_player_create(jb, decoder);
+    assert(player != NULL);
+    assert(downlink_player_set_output_rate(player, 48000));
+    assert(downlink_player_set_format(player, SAMPLE_RATE, 1, FRAME_MS));
+
+    for (int i = 0; i < 5; i++) {
+        put_frame(jb, 100 + (uint32_t)(i * FRAME_MS), 1000);
+    }
+    jitter_buffer_drain(jb);
+
+    // 五帧 16kHz 音频变为 100ms 的 48kHz 周期，滤波器起振后保持原电平
+    int16_t period[480];
+    uint32_t timestamp = 0;
+    size_t total = 0;
+    for (int i = 0; i < 10; i++) {
+        size_t filled = downlink_player_read(player, period, 480, &timestamp);
+        if (i >= 2 && i < 8) {
+            assert(filled == 480);
+            assert(period[0] > 990 && period[0] < 1010 && period[479] > 990 && period[479] < 1010);
+        }
+        total += filled;
+    }
+    assert(total == 5 * 960);
+
+    downlink_player_stats_t stats;
+    downlink_player_get_stats(player, &stats);
+    assert(stats.frames_decoded == 5);
+
+    // 恢复为解码采样率后不再重采样
+    assert(downlink_player_set_output_rate(player, 0));
+    assert(player->resampler == NULL);
+
+    downlink_player_destroy(player);
+    decoder->vtable->destroy(decoder);
+    jitter_buffer_destroy(jb);
+    printf("Output resampling test passed!\n");
+}
+
+// 内存中的播放设备，记录每次写入的首帧（前两个样本）
+typedef struct {
+    int16_t first[64];
+    int16_t second[64];
+    size_t frames[64];
+    size_t writes;
+} test_device_t;
+
+static test_device_t g_device;
+
+static bool device_write(AudioInterface* self, short* buffer, size_t frame_size) {
+    (void)self;
+    if (g_device.writes < 64) {
+        g_device.first[g_device.writes] = buffer[0];
+        g_device.second[g_device.writes] = buffer[1];
+        g_device.frames[g_device.writes] = frame_size;
+    }
+    g_device.writes++;
+    return true;
+}
+
+static const AudioInterfaceVTable device_vtable = {
+    .write = device_write
+};
+
+static uint32_t g_played[64];
+static size_t g_played_count;
+
+static void on_played(uint32_t timestamp, void* user_data) {
+    (void)user_data;
+    if (g_played_count < 64) {
+        g_played[g_played_count] = timestamp;
+    }
+    g_played_count++;
+}
+
+// 测试播放线程按周期把音频写入设备
+static void test_playback_thread(void) {
+    printf("Testing playback thread...\n");
+
+    jitter_buffer_t* jb = create_jitter();
+    audio_codec_t* decoder = codec_stub_create();
+    downlink_player_t* player = downlink_player_create(jb, decoder);
+    assert(player != NULL);
+
+    AudioInterface device;
+    memset(&device, 0, sizeof(device));
+    device.vtable = &device_vtable;
+    device.sample_rate = SAMPLE_RATE;
+    device.channels = 1;
+
+    // 格式未设置时无法启动
+    assert(!downlink_player_start(player, &device, 10, on_played, NULL));
+    assert(downlink_player_set_format(player, SAMPLE_RATE, 1, FRAME_MS));
+
+    memset(&g_device, 0, sizeof(g_device));
+    g_played_count = 0;
+    for (int i = 0; i < 3; i++) {
+        put_frame(jb, 100 + (uint32_t)(i * FRAME_MS), (int16_t)(i + 1));
+    }
+    jitter_buffer_drain(jb);
+
+    assert(downlink_player_start(player, &device, 10, on_played, NULL));
+    assert(!downlink_player_start(player, &device, 10, on_played, NULL));
+    usleep(200000);
+    downlink_player_stop(player);
+
+    // 三帧共六个 10ms 周期，之后只有静音不再写入设备
+    assert(g_device.writes == 6 && g_played_count == 6);
+    for (size_t i = 0; i < 6; i++) {
+        assert(g_device.frames[i] == FRAME_SAMPLES / 2);
+        assert(g_device.first[i] == (int16_t)(i / 2 + 1));
+        assert(g_played[i] == 100 + (uint32_t)(i / 2) * FRAME_MS);
+    }
+
+    downlink_player_destroy(player);
+    decoder->vtable->destroy(decoder);
+    jitter_buffer_destroy(jb);
+    printf("Playback thread test passed!\n");
+}
+
+// 测试单声道解码输出到立体声设备时逐帧上混，周期时长与时间戳不变
+static void test_stereo_device(void) {
+    printf("Testing stereo playback device...\n");
+
+    jitter_buffer_t* jb = create_jitter();
+    audio_codec_t* decoder = codec_stub_create();
+    downlink_player_t* player = downlink_player_create(jb, decoder);
+    assert(player != NULL);
+    assert(downlink_player_set_format(player, SAMPLE_RATE, 1, FRAME_MS));
+
+    AudioInterface device;
+    memset(&device, 0, sizeof(device));
+    device.vtable = &device_vtable;
+    device.sample_rate = SAMPLE_RATE;
+    device.channels = 2;
+
+    memset(&g_device, 0, sizeof(g_device));
+    g_played_count = 0;
+    for (int i = 0; i < 3; i++) {
+        put_frame(jb, 100 + (uint32_t)(i * FRAME_MS), (int16_t)(i + 1));
+    }
+    jitter_buffer_drain(jb);
+
+    assert(downlink_player_start(player, &device, 10, on_played, NULL));
+    assert(player->period_samples == FRAME_SAMPLES);
+    usleep(200000);
+    downlink_player_stop(player);
+
+    // 仍是六个 10ms 周期，每个周期的左右声道取同一个解码样本
+    assert(g_device.writes == 6 && g_played_count == 6);
+    for (size_t i = 0; i < 6; i++) {
+        assert(g_device.frames[i] == FRAME_SAMPLES / 2);
+        assert(g_device.first[i] == (int16_t)(i / 2 + 1) && g_device.second[i] == g_device.first[i]);
+        assert(g_played[i] == 100 + (uint32_t)(i / 2) * FRAME_MS);
+    }
+
+    // 拉取接口随之输出立体声交织样本
+    put_frame(jb, 200, 7);
+    jitter_buffer_drain(jb);
+    int16_t period[2 * FRAME_SAMPLES];
+    uint32_t timestamp = 0;
+    assert(downlink_player_read(player, period, 2 * FRAME_SAMPLES, &timestamp) == 2 * FRAME_SAMPLES);
+    assert(timestamp == 200 && period[0] == 7 && period[1] == 7 && period[2 * FRAME_SAMPLES - 1] == 7);
+
+    downlink_player_destroy(player);
+    decoder->vtable->destroy(decoder);
+    jitter_buffer_destroy(jb);
+    printf("Stereo device test passed!\n");
+}
+
+int main(void) {
+    printf("=== downlink player tests ===\n");
+
+    test_periods();
+    test_long_packets();
+    test_output_rate();
+    test_playback_thread();
+    test_stereo_device();
+
+    printf("All downlink player tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,348 @@
+/**
+ * 抖动缓冲单元测试
+ *
+ * 覆盖预缓冲、乱序重排、丢帧补偿（PLC与带内FEC）、迟到/重复帧丢弃、欠载后目标深度自适应、
+ * 流结束排空以及按到达顺序编号的模式。
+ */
+
+#include "../jitter_buffer.h"
+#include "../../codecs/codec_stub.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define FRAME_MS 60
+
+static jitter_buffer_t* create_buffer(bool timestamped, uint32_t min_ms, uint32_t max_ms) {
+    jitter_buffer_config_t config;
+    jitter_buffer_config_default(&config);
+    config.frame_duration_ms = FRAME_MS;
+    config.min_delay_ms = min_ms;
+    config.max_delay_ms = max_ms;
+    config.capacity = 8;
+    config.max_frame_size = 16;
+    config.timestamped = timestamped;
+    jitter_buffer_t* jb = jitter_buffer_create(&config);
+    assert(jb != NULL);
+    return jb;
+}
+
+// 帧内容取时间戳低字节，方便核对顺序
+static jitter_buffer_result_t put(jitter_buffer_t* jb, uint32_t timestamp, uint32_t arrival_ms) {
+    uint8_t data[2] = {(uint8_t)(timestamp / FRAME_MS), 0xAB};
+    return jitter_buffer_put(jb, timestamp, 0, data, sizeof(data), arrival_ms);
+}
+
+static jitter_buffer_result_t get(jitter_buffer_t* jb, uint32_t* timestamp) {
+    uint8_t buffer[16];
+    size_t size = 0;
+    jitter_buffer_result_t result = jitter_buffer_get(jb, buffer, sizeof(buffer), &size, timestamp);
+    if (result == JITTER_BUFFER_OK) {
+        assert(size == 2 && buffer[0] == (uint8_t)(*timestamp / FRAME_MS));
+    } else {
+        assert(size == 0);
+    }
+    return result;
+}
+
+// 测试预缓冲与乱序重排
+static void test_reorder(void) {
+    printf("Testing prebuffer and reordering...\n");
+
+    jitter_buffer_t* jb = create_buffer(true, 2 * FRAME_MS, 600);
+    uint32_t ts = 0;
+
+    assert(put(jb, 1000, 5000) == JITTER_BUFFER_OK);
+    // 未达到目标深度前只输出静音
+    assert(get(jb, &ts) == JITTER_BUFFER_EMPTY);
+
+    assert(put(jb, 1000 + 2 * FRAME_MS, 5000 + 2 * FRAME_MS) == JITTER_BUFFER_OK);
+    assert(put(jb, 1000 + FRAME_MS, 5000 + 2 * FRAME_MS) == JITTER_BUFFER_OK);
+
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 1000);
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 1000 + FRAME_MS);
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 1000 + 2 * FRAME_MS);
+
+    jitter_buffer_stats_t stats;
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.frames_received == 3 && stats.frames_played == 3);
+    assert(stats.depth_ms == 0 && stats.max_depth_ms == 3 * FRAME_MS);
+
+    jitter_buffer_destroy(jb);
+    printf("Reorder test passed!\n");
+}
+
+// 测试空洞补偿、迟到帧与重复帧
+static void test_loss_and_late(void) {
+    printf("Testing loss, late and duplicate frames...\n");
+
+    jitter_buffer_t* jb = create_buffer(true, FRAME_MS, 600);
+    uint32_t ts = 0;
+
+    assert(put(jb, 0, 100) == JITTER_BUFFER_OK);
+    assert(put(jb, 2 * FRAME_MS, 100 + 2 * FRAME_MS) == JITTER_BUFFER_OK);
+    assert(put(jb, 2 * FRAME_MS, 100 + 2 * FRAME_MS) == JITTER_BUFFER_DUPLICATE);
+
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 0);
+    // 第二帧缺失，交给调用方做丢包补偿
+    assert(get(jb, &ts) == JITTER_BUFFER_LOST && ts == FRAME_MS);
+    // 补偿之后才到达的帧已经错过播放时刻
+    assert(put(jb, FRAME_MS, 100 + 3 * FRAME_MS) == JITTER_BUFFER_LATE);
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 2 * FRAME_MS);
+
+    jitter_buffer_stats_t stats;
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.frames_concealed == 1);
+    assert(stats.late_frames == 1 && stats.duplicate_frames == 1);
+
+    // 发送端大幅跳跃时直接追上，不逐帧补偿
+    assert(put(jb, 10000, 20000) == JITTER_BUFFER_OK);
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 10000);
+
+    jitter_buffer_destroy(jb);
+    printf("Loss and late test passed!\n");
+}
+
+// 测试欠载后目标深度增长，稳定播放后回落
+static void test_underrun_adapt(void) {
+    printf("Testing underrun adaptation...\n");
+
+    jitter_buffer_t* jb = create_buffer(true, FRAME_MS, 600);
+    uint32_t ts = 0;
+    jitter_buffer_stats_t stats;
+
+    assert(put(jb, 0, 0) == JITTER_BUFFER_OK);
+    assert(get(jb, &ts) == JITTER_BUFFER_OK);
+    assert(get(jb, &ts) == JITTER_BUFFER_EMPTY);
+
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.underruns == 1);
+    assert(stats.target_ms == 2 * FRAME_MS);
+
+    // 恢复时需要重新攒够目标深度
+    assert(put(jb, 3 * FRAME_MS, 3 * FRAME_MS) == JITTER_BUFFER_OK);
+    assert(get(jb, &ts) == JITTER_BUFFER_EMPTY);
+    assert(put(jb, 4 * FRAME_MS, 4 * FRAME_MS) == JITTER_BUFFER_OK);
+    // 欠载期间已播放静音，从第一帧继续而不是补偿整个空缺
+    assert(get(jb, &ts) == JITTER_BUFFER_OK && ts == 3 * FRAME_MS);
+
+    // 持续稳定播放后额外深度逐步回落
+    uint32_t next = 5 * FRAME_MS;
+    for (int i = 0; i < JITTER_BUFFER_DECAY_FRAMES + 1; i++) {
+        assert(put(jb, next, next) == JITTER_BUFFER_OK);
+        next += FRAME_MS;
+        assert(get(jb, &ts) == JITTER_BUFFER_OK);
+    }
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.underruns == 1);
+    assert(stats.target_ms == FRAME_MS);
+
+    jitter_buffer_destroy(jb);
+    printf("Underrun adaptation test passed!\n");
+}
+
+// 测试到达抖动抬高目标深度，提前到达不抬高
+static void test_jitter_target(void) {
+    printf("Testing jitter driven target...\n");
+
+    jitter_buffer_t* jb = create_buffer(true, FRAME_MS, 300);
+    jitter_buffer_stats_t stats;
+
+    // 发送端快于实时下发，只会刷新基准
+    for (uint32_t i = 0; i < 4; i++) {
+        assert(put(jb, i * FRAME_MS, 1000 + i * 10) == JITTER_BUFFER_OK);
+    }
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.target_ms == FRAME_MS);
+
+    // 一帧迟到100ms
+    assert(put(jb, 4 * FRAME_MS, 1000 + 30 + FRAME_MS + 100) == JITTER_BUFFER_OK);
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.target_ms == FRAME_MS + 100);
+    assert(stats.jitter_ms > 0);
+
+    // 超过上限时被截断
+    assert(put(jb, 5 * FRAME_MS, 5000) == JITTER_BUFFER_OK);
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.target_ms == 300);
+
+    jitter_buffer_destroy(jb);
+    printf("Jitter target test passed!\n");
+}
+
+// 测试流结束排空、按到达编号与容量上限
+static void test_drain_and_sequence(void) {
+    printf("Testing drain and arrival sequencing...\n");
+
+    jitter_buffer_t* jb = create_buffer(false, 3 * FRAME_MS, 600);
+    uint32_t ts = 0;
+    uint8_t data[2] = {0, 0};
+
+    // 无时间戳时按到达顺序编号，传入的时间戳被忽略
+    assert(jitter_buffer_put(jb, 0, 0, data, sizeof(data), 7000) == JITTER_BUFFER_OK);
+    assert(jitter_buffer_put(jb, 0, 0, data, sizeof(data), 7001) == JITTER_BUFFER_OK);
+    uint8_t buffer[16];
+    size_t size = 0;
+    assert(jitter_buffer_get(jb, buffer, sizeof(buffer), &size, &ts) == JITTER_BUFFER_EMPTY);
+
+    // 流结束后不再等待目标深度
+    jitter_buffer_drain(jb);
+    assert(jitter_buffer_get(jb, buffer, sizeof(buffer), &size, &ts) == JITTER_BUFFER_OK && ts == 7000);
+    assert(jitter_buffer_get(jb, buffer, sizeof(buffer), &size, &ts) == JITTER_BUFFER_OK && ts == 7000 + FRAME_MS);
+    assert(jitter_buffer_get(jb, buffer, sizeof(buffer), &size, &ts) == JITTER_BUFFER_EMPTY);
+
+    jitter_buffer_stats_t stats;
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.underruns == 0);
+
+    // 新一轮重新编号
+    for (int i = 0; i < 8; i++) {
+        assert(jitter_buffer_put(jb, 0, 0, data, sizeof(data), 9000) == JITTER_BUFFER_OK);
+    }
+    assert(jitter_buffer_put(jb, 0, 0, data, sizeof(data), 9000) == JITTER_BUFFER_FULL);
+    assert(jitter_buffer_get(jb, buffer, sizeof(buffer), &size, &ts) == JITTER_BUFFER_OK && ts == 9000);
+
+    jitter_buffer_reset(jb);
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.depth_ms == 0 && stats.overflow_frames == 1);
+    assert(jitter_buffer_get(jb, buffer, sizeof(buffer), &size, &ts) == JITTER_BUFFER_EMPTY);
+
+    // 非法参数
+    uint8_t big[32] = {0};
+    assert(jitter_buffer_put(jb, 0, 0, big, sizeof(big), 0) == JITTER_BUFFER_INVALID_PARAMETER);
+    assert(jitter_buffer_put(NULL, 0, 0, data, sizeof(data), 0) == JITTER_BUFFER_INVALID_PARAMETER);
+
+    jitter_buffer_destroy(jb);
+    printf("Drain and sequence test passed!\n");
+}
+
+// 测试解码路径：缺帧时解码器不支持PLC则补静音
+static void test_decode(void) {
+    printf("Testing decode with concealment...\n");
+
+    audio_codec_t* decoder = codec_stub_create();
+    assert(decoder != NULL);
+    audio_format_t format;
+    audio_format_init(&format, 16000, 1, 16, FRAME_MS);
+    assert(decoder->vtable->init_decoder(decoder, &format) == CODEC_SUCCESS);
+
+    jitter_buffer_t* jb = create_buffer(true, FRAME_MS, 600);
+    int16_t pcm[2048];
+    size_t decoded = 0;
+    uint32_t ts = 0;
+
+    const int16_t samples[4] = {1, -2, 3, -4};
+    assert(jitter_buffer_put(jb, 0, 0, (const uint8_t*)samples, sizeof(samples), 0) == JITTER_BUFFER_OK);
+    assert(jitter_buffer_put(jb, 2 * FRAME_MS, 0, (const uint8_t*)samples, sizeof(samples), 2 * FRAME_MS) == JITTER_BUFFER_OK);
+
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_OK);
+    assert(ts == 0 && decoded == 4 && pcm[3] == -4);
+
+    pcm[0] = 99;
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_LOST);
+    assert(ts == FRAME_MS && decoded == 16000 * FRAME_MS / 1000 && pcm[0] == 0);
+
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_OK);
+    assert(ts == 2 * FRAME_MS);
+
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_EMPTY);
+    assert(decoded == 0);
+
+    jitter_buffer_destroy(jb);
+    decoder->vtable->destroy(decoder);
+    printf("Decode test passed!\n");
+}
+
+// 记录丢帧解码方式的测试编解码器：FEC 输出后续数据包的首样本值，PLC 输出 7
+static audio_codec_vtable_t g_lost_vtable;
+static size_t g_fec_calls;
+static size_t g_plc_calls;
+
+static codec_error_t record_decode_lost(audio_codec_t* codec, const uint8_t* next_packet, size_t next_size,
+                                        size_t lost_samples, int16_t* output, size_t output_size,
+                                        size_t* decoded_size) {
+    (void)codec;
+    if (lost_samples > output_size) {
+        return CODEC_BUFFER_TOO_SMALL;
+    }
+    int16_t value = 7;
+    if (next_packet) {
+        assert(next_size >= sizeof(value));
+        memcpy(&value, next_packet, sizeof(value));
+        g_fec_calls++;
+    } else {
+        g_plc_calls++;
+    }
+    for (size_t i = 0; i < lost_samples; i++) {
+        output[i] = value;
+    }
+    *decoded_size = lost_samples;
+    return CODEC_SUCCESS;
+}
+
+// 测试缺帧时按后续帧是否已到达选择带内FEC或PLC
+static void test_decode_lost(void) {
+    printf("Testing FEC and PLC for holes...\n");
+
+    audio_codec_t* decoder = codec_stub_create();
+    assert(decoder != NULL);
+    g_lost_vtable = *decoder->vtable;
+    g_lost_vtable.decode_lost = record_decode_lost;
+    decoder->vtable = &g_lost_vtable;
+    audio_format_t format;
+    audio_format_init(&format, 16000, 1, 16, FRAME_MS);
+    assert(decoder->vtable->init_decoder(decoder, &format) == CODEC_SUCCESS);
+
+    jitter_buffer_t* jb = create_buffer(true, FRAME_MS, 600);
+    int16_t pcm[2048];
+    size_t decoded = 0;
+    uint32_t ts = 0;
+
+    // 缺少 60 和 120 两帧
+    const uint32_t stamps[3] = {0, 3 * FRAME_MS, 4 * FRAME_MS};
+    for (int i = 0; i < 3; i++) {
+        int16_t samples[4] = {(int16_t)(stamps[i] / FRAME_MS + 1), 0, 0, 0};
+        assert(jitter_buffer_put(jb, stamps[i], 0, (const uint8_t*)samples, sizeof(samples), stamps[i]) ==
+               JITTER_BUFFER_OK);
+    }
+    jitter_buffer_drain(jb);
+
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_OK && ts == 0);
+
+    // 第一个缺帧之后仍是缺帧，只能做PLC
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_LOST);
+    assert(ts == FRAME_MS && decoded == 16000 * FRAME_MS / 1000 && pcm[0] == 7);
+    assert(g_plc_calls == 1 && g_fec_calls == 0);
+
+    // 第二个缺帧紧邻已到达的帧，用其带内FEC恢复，该帧随后照常解码
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_LOST);
+    assert(ts == 2 * FRAME_MS && decoded == 16000 * FRAME_MS / 1000 && pcm[0] == 4);
+    assert(g_plc_calls == 1 && g_fec_calls == 1);
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_OK);
+    assert(ts == 3 * FRAME_MS && decoded == 4 && pcm[0] == 4);
+    assert(jitter_buffer_decode(jb, decoder, pcm, 2048, &decoded, &ts) == JITTER_BUFFER_OK);
+    assert(ts == 4 * FRAME_MS && pcm[0] == 5);
+
+    jitter_buffer_stats_t stats;
+    jitter_buffer_get_stats(jb, &stats);
+    assert(stats.frames_concealed == 2 && stats.frames_recovered == 1);
+
+    jitter_buffer_destroy(jb);
+    decoder->vtable->destroy(decoder);
+    printf("FEC and PLC test passed!\n");
+}
+
+int main(void) {
+    printf("=== jitter buffer tests ===\n");
+
+    test_reorder();
+    test_loss_and_late();
+    test_underrun_adapt();
+    test_jitter_target();
+    test_drain_and_sequence();
+    test_decode();
+    test_decode_lost();
+
+    printf("All jitter buffer tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * 重采样单元测试
+ *
+ * 覆盖常见采样率转换的输出长度、频率与幅度保持、抗混叠、分块输入与整块输入
+ * 结果一致、多声道互不干扰、同采样率直通以及非法参数。
+ */
+
+#include "../resampler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// 生成 seconds 秒的正弦波，channels 声道中只有第 0 声道有信号
+static int16_t* make_tone(int rate, int channels, double frequency, double seconds, size_t* frames) {
+    *frames = (size_t)(rate * seconds);
+    int16_t* pcm = (int16_t*)calloc(*frames * (size_t)channels, sizeof(int16_t));
+    assert(pcm != NULL);
+    for (size_t i = 0; i < *frames; i++) {
+        pcm[i * (size_t)channels] = (int16_t)(sin(2.0 * M_PI * frequency * (double)i / rate) * 10000.0);
+    }
+    return pcm;
+}
+
+// 按 chunk 帧一块送入重采样器
+static size_t run_chunked(resampler_t* resampler, const int16_t* input, size_t frames, size_t chunk,
+                          int16_t* output, size_t capacity) {
+    size_t written = 0;
+    int channels = resampler->channels;
+    for (size_t offset = 0; offset < frames; offset += chunk) {
+        size_t n = frames - offset < chunk ? frames - offset : chunk;
+        written += resampler_process(resampler, input + offset * (size_t)channels, n,
+                                     output + written * (size_t)channels, capacity - written);
+    }
+    return written;
+}
+
+static double rms(const int16_t* pcm, size_t frames, int channels, int channel) {
+    double sum = 0.0;
+    for (size_t i = 0; i < frames; i++) {
+        double s = pcm[i * (size_t)channels + (size_t)channel];
+        sum += s * s;
+    }
+    return sqrt(sum / (double)frames);
+}
+
+// 上升沿过零次数估计频率
+static double measure_frequency(const int16_t* pcm, size_t frames, int channels, int rate) {
+    size_t crossings = 0;
+    for (size_t i = 1; i < frames; i++) {
+        if (pcm[(i - 1) * (size_t)channels] < 0 && pcm[i * (size_t)channels] >= 0) {
+            crossings++;
+        }
+    }
+    return (double)crossings * rate / (double)frames;
+}
+
+// 测试常见采样率转换
+static void test_conversion(int in_rate, int out_rate, int channels) {
+    printf("Testing %d -> %d Hz, %d channels...\n", in_rate, out_rate, channels);
+
+    size_t frames = 0;
+    int16_t* input = make_tone(in_rate, channels, 1000.0, 1.0, &frames);
+    resampler_t* resampler = resampler_create(in_rate, out_rate, channels);
+    assert(resampler != NULL);
+
+    size_t capacity = resampler_max_output(resampler, frames);
+    int16_t* output = (int16_t*)malloc(capacity * (size_t)channels * sizeof(int16_t));
+    assert(output != NULL);
+    size_t written = run_chunked(resampler, input, frames, 137, output, capacity);
+
+    // 一秒输入产生约一秒输出（滤波器时延不会多出样本）
+    assert(written <= capacity);
+    assert(written + 2 >= (size_t)out_rate && written <= (size_t)out_rate + 1);
+
+    // 跳过滤波器起始的过渡段后检查频率与幅度
+    size_t skip = (size_t)out_rate / 10;
+    double frequency = measure_frequency(output + skip * (size_t)channels, written - skip, channels, out_rate);
+    double level = rms(output + skip * (size_t)channels, written - skip, channels, 0);
+    double expected = rms(input, frames, channels, 0);
+    printf("  %zu frames, %.1f Hz, level %.1f (input %.1f)\n", written, frequency, level, expected);
+    assert(fabs(frequency - 1000.0) < 5.0);
+    assert(fabs(level - expected) < expected * 0.03);
+
+    // 其他声道保持静音
+    for (int ch = 1; ch < channels; ch++) {
+        assert(rms(output, written, channels, ch) == 0.0);
+    }
+
+    free(output);
+    free(input);
+    resampler_destroy(resampler);
+}
+
+// 测试降采样时滤除高于新奈奎斯特频率的成分
+static void test_anti_aliasing(void) {
+    printf("Testing anti-aliasing...\n");
+
+    size_t frames = 0;
+    int16_t* input = make_tone(48000, 1, 12000.0, 0.5, &frames);
+    resampler_t* resampler = resampler_create(48000, 16000, 1);
+    assert(resampler != NULL);
+
+    size_t capacity = resampler_max_output(resampler, frames);
+    int16_t* output = (int16_t*)malloc(capacity * sizeof(int16_t));
+    size_t written = resampler_process(resampler, input, frames, output, capacity);
+
+    // 12kHz 在 16kHz 下会混叠到 4kHz，应被衰减 40dB 以上
+    double level = rms(output + 800, written - 800, 1, 0);
+    printf("  aliased level %.1f\n", level);
+    assert(level < rms(input, frames, 1, 0) * 0.01);
+
+    free(output);
+    free(input);
+    resampler_destroy(resampler);
+}
+
+// 测试分块送入与整块送入结果逐样本一致，重置后重新开始
+static void test_chunking(void) {
+    printf("Testing chunked input...\n");
+
+    size_t frames = 0;
+    int16_t* input = make_tone(44100, 2, 440.0, 0.3, &frames);
+    resampler_t* whole = resampler_create(44100, 16000, 2);
+    resampler_t* chunked = resampler_create(44100, 16000, 2);
+    assert(whole != NULL && chunked != NULL);
+
+    size_t capacity = resampler_max_output(whole, frames);
+    int16_t* expected = (int16_t*)malloc(capacity * 2 * sizeof(int16_t));
+    int16_t* actual = (int16_t*)malloc(capacity * 2 * sizeof(int16_t));
+    size_t expected_frames = resampler_process(whole, input, frames, expected, capacity);
+    size_t actual_frames = run_chunked(chunked, input, frames, 7, actual, capacity);
+    assert(expected_frames == actual_frames);
+    assert(memcmp(expected, actual, expected_frames * 2 * sizeof(int16_t)) == 0);
+
+    resampler_reset(chunked);
+    actual_frames = run_chunked(chunked, input, frames, 1000, actual, capacity);
+    assert(expected_frames == actual_frames);
+    assert(memcmp(expected, actual, expected_frames * 2 * sizeof(int16_t)) == 0);
+
+    // 输出空间不足时多余的输出被丢弃
+    resampler_reset(chunked);
+    assert(resampler_process(chunked, input, frames, actual, 10) == 10);
+
+    free(expected);
+    free(actual);
+    free(input);
+    resampler_destroy(whole);
+    resampler_destroy(chunked);
+}
+
+// 测试同采样率直通与非法参数
+static void test_passthrough(void) {
+    printf("Testing passthrough and invalid parameters...\n");
+
+    int16_t input[64];
+    int16_t output[64];
+    for (int i = 0; i < 64; i++) {
+        input[i] = (int16_t)(i * 100);
+    }
+    resampler_t* resampler = resampler_create(16000, 16000, 1);
+    assert(resampler != NULL);
+    assert(resampler_process(resampler, input, 64, output, 64) == 64);
+    assert(memcmp(input, output, sizeof(input)) == 0);
+    resampler_destroy(resampler);
+
+    assert(resampler_create(0, 16000, 1) == NULL);
+    assert(resampler_create(16000, 48000, 0) == NULL);
+    assert(resampler_create(44100, 47999, 1) == NULL);
+}
+
+int main(void) {
+    printf("=== resampler tests (%s) ===\n", resampler_is_vectorized() ? "SIMD" : "scalar");
+
+    test_conversion(48000, 16000, 1);
+    test_conversion(16000, 48000, 1);
+    test_conversion(44100, 48000, 1);
+    test_conversion(48000, 44100, 1);
+    test_conversion(24000, 44100, 2);
+    test_conversion(44100, 16000, 1);
+    test_anti_aliasing();
+    test_chunking();
+    test_passthrough();
+
+    printf("All resampler tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,267 @@
+/**
+ * 上行编码单元测试
+ *
+ * 使用存根编解码器（原样复制PCM）与内存中的发送端，覆盖任意大小的PCM块
+ * 拼帧、帧时间戳、环形缓冲写满时的丢弃、发送端无空位时的跳帧以及重置。
+ */
+
+#include "../uplink_encoder.h"
+#include "../../codecs/codec_stub.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+
+#define SAMPLE_RATE   16000
+#define FRAME_MS      20
+#define FRAME_SAMPLES (SAMPLE_RATE * FRAME_MS / 1000)
+#define MAX_FRAMES    32
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool accept;                    // false 模拟发送队列已满
+    bool blocked;                   // true 时 reserve 阻塞，模拟编码线程被占住
+    uint8_t storage[MAX_FRAMES][FRAME_SAMPLES * 2];
+    size_t sizes[MAX_FRAMES];
+    uint32_t timestamps[MAX_FRAMES];
+    size_t reserved;
+    size_t committed;
+} test_sink_t;
+
+static void* sink_reserve(void* user_data, size_t size, uint8_t** buffer) {
+    test_sink_t* sink = (test_sink_t*)user_data;
+    pthread_mutex_lock(&sink->mutex);
+    while (sink->blocked) {
+        pthread_cond_wait(&sink->cond, &sink->mutex);
+    }
+    void* handle = NULL;
+    if (sink->accept && sink->reserved < MAX_FRAMES && size >= sizeof(sink->storage[0])) {
+        *buffer = sink->storage[sink->reserved];
+        handle = &sink->sizes[sink->reserved++];
+    }
+    pthread_mutex_unlock(&sink->mutex);
+    return handle;
+}
+
+static bool sink_commit(void* user_data, void* handle, size_t size, uint32_t timestamp) {
+    test_sink_t* sink = (test_sink_t*)user_data;
+    pthread_mutex_lock(&sink->mutex);
+    size_t index = (size_t)((size_t*)handle - sink->sizes);
+    sink->sizes[index] = size;
+    sink->timestamps[index] = timestamp;
+    sink->committed++;
+    pthread_cond_broadcast(&sink->cond);
+    pthread_mutex_unlock(&sink->mutex);
+    return size > 0;
+}
+
+static void sink_init(test_sink_t* sink) {
+    memset(sink, 0, sizeof(*sink));
+    pthread_mutex_init(&sink->mutex, NULL);
+    pthread_cond_init(&sink->cond, NULL);
+    sink->accept = true;
+}
+
+static void sink_set_blocked(test_sink_t* sink, bool blocked) {
+    pthread_mutex_lock(&sink->mutex);
+    sink->blocked = blocked;
+    pthread_cond_broadcast(&sink->cond);
+    pthread_mutex_unlock(&sink->mutex);
+}
+
+// 等待编码线程处理完指定帧数（发布或跳过）
+static void wait_processed(uplink_encoder_t* encoder, uint64_t frames) {
+    for (int i = 0; i < 2000; i++) {
+        uplink_encoder_stats_t stats;
+        uplink_encoder_get_stats(encoder, &stats);
+        if (stats.frames_encoded + stats.sink_drops + stats.encode_errors >= frames) {
+            return;
+        }
+        usleep(1000);
+    }
+    assert(!"encoder thread did not catch up");
+}
+
+static audio_codec_t* create_codec(void) {
+    audio_codec_t* codec = codec_stub_create();
+    assert(codec != NULL);
+    audio_format_t format;
+    audio_format_init(&format, SAMPLE_RATE, 1, 16, FRAME_MS);
+    assert(codec->vtable->init_encoder(codec, &format) == CODEC_SUCCESS);
+    return codec;
+}
+
+// 测试任意大小的PCM块被拼成完整编码帧，时间戳对应帧首样本
+static void test_framing(void) {
+    printf("Testing framing of arbitrary chunks...\n");
+
+    audio_codec_t* codec = create_codec();
+    test_sink_t sink;
+    sink_init(&sink);
+    uplink_encoder_sink_t target = {sink_reserve, sink_commit, &sink};
+    uplink_encoder_t* encoder = uplink_encoder_create(codec, 4, 0, &target);
+    assert(encoder != NULL && encoder->frame_samples == FRAME_SAMPLES);
+
+    // 三帧的样本按 144 样本（9ms）一块写入，帧边界落在块中间
+    int16_t pcm[3 * FRAME_SAMPLES];
+    for (int i = 0; i < 3 * FRAME_SAMPLES; i++) {
+        pcm[i] = (int16_t)i;
+    }
+    for (size_t offset = 0; offset < 3 * FRAME_SAMPLES; offset += 144) {
+        size_t chunk = 3 * FRAME_SAMPLES - offset < 144 ? 3 * FRAME_SAMPLES - offset : 144;
+        uint32_t capture_ms = 5000 + (uint32_t)(offset / 16);
+        assert(uplink_encoder_write(encoder, pcm + offset, chunk, capture_ms) == chunk);
+    }
+    wait_processed(encoder, 3);
+
+    assert(sink.committed == 3);
+    for (int f = 0; f < 3; f++) {
+        assert(sink.sizes[f] == FRAME_SAMPLES * 2);
+        assert(sink.timestamps[f] == 5000 + (uint32_t)(f * FRAME_MS));
+        int16_t first;
+        memcpy(&first, sink.storage[f], sizeof(first));
+        assert(first == (int16_t)(f * FRAME_SAMPLES));
+    }
+
+    // 不足一帧的尾部留在环形缓冲中等待后续数据
+    assert(uplink_encoder_write(encoder, pcm, 10, 6000) == 10);
+    usleep(10000);
+    uplink_encoder_stats_t stats;
+    uplink_encoder_get_stats(encoder, &stats);
+    assert(stats.frames_encoded == 3 && stats.frames_sent == 3);
+    assert(stats.samples_dropped == 0);
+
+    uplink_encoder_destroy(encoder);
+    codec->vtable->destroy(codec);
+    printf("Framing test passed!\n");
+}
+
+// 测试环形缓冲写满与发送端无空位
+static void test_overflow(void) {
+    printf("Testing ring overflow and sink drops...\n");
+
+    audio_codec_t* codec = create_codec();
+    test_sink_t sink;
+    sink_init(&sink);
+    uplink_encoder_sink_t target = {sink_reserve, sink_commit, &sink};
+    uplink_encoder_t* encoder = uplink_encoder_create(codec, 2, 0, &target);
+    assert(encoder != NULL);
+
+    static int16_t pcm[4 * FRAME_SAMPLES];
+    memset(pcm, 0, sizeof(pcm));
+
+    // 编码线程卡在发送端时，环形缓冲只能容纳两帧
+    sink_set_blocked(&sink, true);
+    assert(uplink_encoder_write(encoder, pcm, 4 * FRAME_SAMPLES, 0) == 2 * FRAME_SAMPLES);
+    uplink_encoder_stats_t stats;
+    uplink_encoder_get_stats(encoder, &stats);
+    assert(stats.samples_dropped == 2 * FRAME_SAMPLES);
+
+    // 发送队列满时跳过该帧而不是阻塞编码线程
+    pthread_mutex_lock(&sink.mutex);
+    sink.accept = false;
+    pthread_mutex_unlock(&sink.mutex);
+    sink_set_blocked(&sink, false);
+    wait_processed(encoder, 2);
+    uplink_encoder_get_stats(encoder, &stats);
+    assert(stats.sink_drops == 2 && stats.frames_encoded == 0);
+
+    uplink_encoder_destroy(encoder);
+    codec->vtable->destroy(codec);
+    printf("Overflow test passed!\n");
+}
+
+// 测试输入采样率与编码采样率不同时先重采样再拼帧
+static void test_input_rate(void) {
+    printf("Testing input resampling...\n");
+
+    audio_codec_t* codec = create_codec();
+    test_sink_t sink;
+    sink_init(&sink);
+    uplink_encoder_sink_t target = {sink_reserve, sink_commit, &sink};
+    uplink_encoder_t* encoder = uplink_encoder_create(codec, 4, 0, &target);
+    assert(encoder != NULL);
+    assert(uplink_encoder_set_input_rate(encoder, 48000));
+
+    // 48kHz 的三帧时长按 10ms 一块写入，编码端收到三个 16kHz 帧
+    static int16_t pcm[3 * FRAME_SAMPLES * 3];
+    for (size_t i = 0; i < sizeof(pcm) / sizeof(pcm[0]); i++) {
+        pcm[i] = 2000;
+    }
+    for (size_t offset = 0; offset < 3 * FRAME_SAMPLES * 3; offset += 480) {
+        assert(uplink_encoder_write(encoder, pcm + offset, 480, 7000 + (uint32_t)(offset / 48)) == 480);
+    }
+    wait_processed(encoder, 3);
+
+    assert(sink.committed == 3);
+    for (int f = 0; f < 3; f++) {
+        assert(sink.sizes[f] == FRAME_SAMPLES * 2);
+        assert(sink.timestamps[f] == 7000 + (uint32_t)(f * FRAME_MS));
+    }
+    // 滤波器起振后保持原电平
+    int16_t sample;
+    memcpy(&sample, sink.storage[2] + FRAME_SAMPLES, sizeof(sample));
+    assert(sample > 1990 && sample < 2010);
+
+    // 恢复为编码采样率后直接写入
+    assert(uplink_encoder_set_input_rate(encoder, SAMPLE_RATE));
+    assert(encoder->resampler == NULL);
+
+    uplink_encoder_destroy(encoder);
+    codec->vtable->destroy(codec);
+    printf("Input resampling test passed!\n");
+}
+
+// 测试重置丢弃尚未编码的数据
+static void test_reset(void) {
+    printf("Testing reset...\n");
+
+    audio_codec_t* codec = create_codec();
+    test_sink_t sink;
+    sink_init(&sink);
+    uplink_encoder_sink_t target = {sink_reserve, sink_commit, &sink};
+    uplink_encoder_t* encoder = uplink_encoder_create(codec, 4, 0, &target);
+    assert(encoder != NULL);
+
+    static int16_t pcm[3 * FRAME_SAMPLES];
+    memset(pcm, 0, sizeof(pcm));
+
+    // 编码线程占住第一帧，其余两帧和半帧被重置丢弃
+    sink_set_blocked(&sink, true);
+    assert(uplink_encoder_write(encoder, pcm, 3 * FRAME_SAMPLES - FRAME_SAMPLES / 2, 0) ==
+           3 * FRAME_SAMPLES - FRAME_SAMPLES / 2);
+    uplink_encoder_reset(encoder);
+    sink_set_blocked(&sink, false);
+    wait_processed(encoder, 1);
+    usleep(10000);
+
+    uplink_encoder_stats_t stats;
+    uplink_encoder_get_stats(encoder, &stats);
+    assert(stats.frames_encoded == 1);
+
+    // 重置后重新从帧边界开始拼帧
+    assert(uplink_encoder_write(encoder, pcm, FRAME_SAMPLES, 100) == FRAME_SAMPLES);
+    wait_processed(encoder, 2);
+    assert(sink.committed == 2 && sink.timestamps[1] == 100);
+
+    // 非法参数
+    assert(uplink_encoder_write(encoder, NULL, 10, 0) == 0);
+    assert(uplink_encoder_create(NULL, 0, 0, &target) == NULL);
+
+    uplink_encoder_destroy(encoder);
+    codec->vtable->destroy(codec);
+    printf("Reset test passed!\n");
+}
+
+int main(void) {
+    printf("=== uplink encoder tests ===\n");
+
+    test_framing();
+    test_overflow();
+    test_input_rate();
+    test_reset();
+
+    printf("All uplink encoder tests passed!\n");
+    return 0;
+}
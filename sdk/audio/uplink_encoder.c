@@ -0,0 +1,274 @@
+#include "uplink_encoder.h"
+#include "../log/linx_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void* encoder_thread(void* arg) {
+    uplink_encoder_t* encoder = (uplink_encoder_t*)arg;
+    size_t capacity = encoder->ring_frames * encoder->frame_samples;
+
+    pthread_mutex_lock(&encoder->mutex);
+    for (;;) {
+        while (encoder->running && encoder->write_pos - encoder->read_pos < encoder->frame_samples) {
+            pthread_cond_wait(&encoder->cond, &encoder->mutex);
+        }
+        if (!encoder->running) {
+            break;
+        }
+
+        // The producer never writes into [read_pos, read_pos + frame_samples) until read_pos moves
+        size_t frame_index = (encoder->read_pos / encoder->frame_samples) % encoder->ring_frames;
+        const int16_t* pcm = encoder->ring + (encoder->read_pos % capacity);
+        uint32_t timestamp = encoder->timestamps[frame_index];
+        pthread_mutex_unlock(&encoder->mutex);
+
+        uint8_t* buffer = NULL;
+        void* handle = encoder->sink.reserve(encoder->sink.user_data, encoder->max_packet_size, &buffer);
+        bool encoded = false, sent = false;
+        uint64_t elapsed_us = 0;
+        if (handle) {
+            size_t size = 0;
+            uint64_t start_us = now_us();
+            encoded = encoder->codec->vtable->encode(encoder->codec, pcm, encoder->frame_samples,
+                                                     buffer, encoder->max_packet_size, &size) == CODEC_SUCCESS;
+            elapsed_us = now_us() - start_us;
+            sent = encoder->sink.commit(encoder->sink.user_data, handle, encoded ? size : 0, timestamp);
+        }
+
+        pthread_mutex_lock(&encoder->mutex);
+        encoder->read_pos += encoder->frame_samples;
+        if (!handle) {
+            encoder->stats.sink_drops++;
+        } else if (!encoded) {
+            encoder->stats.encode_errors++;
+        } else {
+            encoder->stats.frames_encoded++;
+            encoder->stats.total_encode_us += elapsed_us;
+            if (elapsed_us > encoder->stats.max_encode_us) {
+                encoder->stats.max_encode_us = elapsed_us;
+            }
+            if (sent) {
+                encoder->stats.frames_sent++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&encoder->mutex);
+    return NULL;
+}
+
+uplink_encoder_t* uplink_encoder_create(audio_codec_t* codec, size_t ring_frames, size_t max_packet_size,
+                                        const uplink_encoder_sink_t* sink) {
+    if (!codec || !codec->vtable || !codec->encoder_initialized || !sink || !sink->reserve || !sink->commit) {
+        LOG_ERROR("Invalid parameters for uplink encoder");
+        return NULL;
+    }
+
+    int frame_size = codec->vtable->get_input_frame_size(codec);
+    int channels = codec->encoder_format.channels > 0 ? codec->encoder_format.channels : 1;
+    if (frame_size <= 0 || codec->encoder_format.sample_rate <= 0) {
+        LOG_ERROR("Uplink encoder: codec reports no input frame size");
+        return NULL;
+    }
+    if (max_packet_size == 0) {
+        int max_output = codec->vtable->get_max_output_size(codec);
+        if (max_output <= 0) {
+            LOG_ERROR("Uplink encoder: codec reports no output size");
+            return NULL;
+        }
+        max_packet_size = (size_t)max_output;
+    }
+
+    uplink_encoder_t* encoder = (uplink_encoder_t*)calloc(1, sizeof(uplink_encoder_t));
+    if (!encoder) {
+        LOG_ERROR("Failed to allocate uplink encoder");
+        return NULL;
+    }
+    encoder->codec = codec;
+    encoder->sink = *sink;
+    encoder->frame_samples = (size_t)frame_size * (size_t)channels;
+    encoder->ring_frames = ring_frames ? ring_frames : UPLINK_ENCODER_DEFAULT_RING_FRAMES;
+    encoder->max_packet_size = max_packet_size;
+    encoder->ring = (int16_t*)malloc(encoder->ring_frames * encoder->frame_samples * sizeof(int16_t));
+    encoder->timestamps = (uint32_t*)calloc(encoder->ring_frames, sizeof(uint32_t));
+    if (!encoder->ring || !encoder->timestamps) {
+        LOG_ERROR("Failed to allocate uplink encoder ring");
+        free(encoder->ring);
+        free(encoder->timestamps);
+        free(encoder);
+        return NULL;
+    }
+
+    pthread_mutex_init(&encoder->mutex, NULL);
+    pthread_cond_init(&encoder->cond, NULL);
+    encoder->running = true;
+    if (pthread_create(&encoder->thread, NULL, encoder_thread, encoder) != 0) {
+        LOG_ERROR("Failed to start uplink encoder thread");
+        pthread_cond_destroy(&encoder->cond);
+        pthread_mutex_destroy(&encoder->mutex);
+        free(encoder->ring);
+        free(encoder->timestamps);
+        free(encoder);
+        return NULL;
+    }
+
+    LOG_INFO("Uplink encoder started: %zu samples per frame, %zu frame ring, %zu byte packets",
+             encoder->frame_samples, encoder->ring_frames, encoder->max_packet_size);
+    return encoder;
+}
+
+void uplink_encoder_destroy(uplink_encoder_t* encoder) {
+    if (!encoder) {
+        return;
+    }
+
+    pthread_mutex_lock(&encoder->mutex);
+    encoder->running = false;
+    pthread_cond_signal(&encoder->cond);
+    pthread_mutex_unlock(&encoder->mutex);
+    pthread_join(encoder->thread, NULL);
+
+    pthread_cond_destroy(&encoder->cond);
+    pthread_mutex_destroy(&encoder->mutex);
+    resampler_destroy(encoder->resampler);
+    free(encoder->resampled);
+    free(encoder->ring);
+    free(encoder->timestamps);
+    free(encoder);
+}
+
+bool uplink_encoder_set_input_rate(uplink_encoder_t* encoder, int sample_rate) {
+    if (!encoder || sample_rate <= 0) {
+        return false;
+    }
+
+    resampler_destroy(encoder->resampler);
+    free(encoder->resampled);
+    encoder->resampler = NULL;
+    encoder->resampled = NULL;
+    encoder->resampled_frames = 0;
+
+    const audio_format_t* format = &encoder->codec->encoder_format;
+    if (sample_rate == format->sample_rate) {
+        return true;
+    }
+
+    int channels = format->channels > 0 ? format->channels : 1;
+    encoder->resampler = resampler_create(sample_rate, format->sample_rate, channels);
+    if (!encoder->resampler) {
+        return false;
+    }
+    encoder->resampled_frames = resampler_max_output(encoder->resampler, RESAMPLER_BLOCK_FRAMES);
+    encoder->resampled = (int16_t*)malloc(encoder->resampled_frames * (size_t)channels * sizeof(int16_t));
+    if (!encoder->resampled) {
+        LOG_ERROR("Failed to allocate uplink resampling buffer");
+        resampler_destroy(encoder->resampler);
+        encoder->resampler = NULL;
+        return false;
+    }
+    return true;
+}
+
+static size_t write_ring(uplink_encoder_t* encoder, const int16_t* pcm, size_t samples, uint32_t capture_ms) {
+    size_t capacity = encoder->ring_frames * encoder->frame_samples;
+    size_t fs = encoder->frame_samples;
+    uint64_t samples_per_second = (uint64_t)encoder->codec->encoder_format.sample_rate *
+                                  (uint64_t)(encoder->codec->encoder_format.channels > 0 ? encoder->codec->encoder_format.channels : 1);
+
+    pthread_mutex_lock(&encoder->mutex);
+    size_t room = capacity - (encoder->write_pos - encoder->read_pos);
+    size_t accepted = samples < room ? samples : room;
+    size_t start = encoder->write_pos;
+    size_t completed = start / fs;
+
+    // Stamp every frame that starts inside this chunk with its first sample's capture time
+    for (size_t boundary = (start + fs - 1) / fs * fs; boundary < start + accepted; boundary += fs) {
+        encoder->timestamps[(boundary / fs) % encoder->ring_frames] =
+            capture_ms + (uint32_t)((uint64_t)(boundary - start) * 1000 / samples_per_second);
+    }
+
+    size_t copied = 0;
+    while (copied < accepted) {
+        size_t offset = encoder->write_pos % capacity;
+        size_t chunk = accepted - copied;
+        if (chunk > capacity - offset) {
+            chunk = capacity - offset;
+        }
+        memcpy(encoder->ring + offset, pcm + copied, chunk * sizeof(int16_t));
+        encoder->write_pos += chunk;
+        copied += chunk;
+    }
+
+    if (accepted < samples) {
+        encoder->stats.samples_dropped += samples - accepted;
+    }
+    if (encoder->write_pos / fs > completed) {
+        pthread_cond_signal(&encoder->cond);
+    }
+    pthread_mutex_unlock(&encoder->mutex);
+
+    if (accepted < samples) {
+        LOG_WARN("Uplink encoder ring full, dropped %zu samples", samples - accepted);
+    }
+    return accepted;
+}
+
+size_t uplink_encoder_write(uplink_encoder_t* encoder, const int16_t* pcm, size_t samples, uint32_t capture_ms) {
+    if (!encoder || !pcm || samples == 0) {
+        return 0;
+    }
+    if (!encoder->resampler) {
+        return write_ring(encoder, pcm, samples, capture_ms);
+    }
+
+    // Resample block by block into the scratch buffer, then append at the codec rate
+    resampler_t* resampler = encoder->resampler;
+    size_t channels = (size_t)resampler->channels;
+    size_t frames = samples / channels;
+    size_t dropped = 0;
+    for (size_t offset = 0; offset < frames; offset += RESAMPLER_BLOCK_FRAMES) {
+        size_t block = frames - offset < RESAMPLER_BLOCK_FRAMES ? frames - offset : RESAMPLER_BLOCK_FRAMES;
+        size_t out = resampler_process(resampler, pcm + offset * channels, block,
+                                       encoder->resampled, encoder->resampled_frames);
+        if (out == 0) {
+            continue;
+        }
+        uint32_t block_ms = capture_ms + (uint32_t)((uint64_t)offset * 1000 / (uint64_t)resampler->in_rate);
+        dropped += out * channels - write_ring(encoder, encoder->resampled, out * channels, block_ms);
+    }
+
+    // Report drops in input samples
+    size_t dropped_input = (size_t)((uint64_t)dropped * (uint64_t)resampler->in_rate / (uint64_t)resampler->out_rate);
+    return dropped_input < samples ? samples - dropped_input : 0;
+}
+
+void uplink_encoder_reset(uplink_encoder_t* encoder) {
+    if (!encoder) {
+        return;
+    }
+
+    pthread_mutex_lock(&encoder->mutex);
+    // Keep the frame the encoder may be working on, drop everything after it
+    size_t pending = encoder->write_pos - encoder->read_pos;
+    if (pending > encoder->frame_samples) {
+        encoder->write_pos = encoder->read_pos + encoder->frame_samples;
+    } else if (pending < encoder->frame_samples) {
+        encoder->write_pos = encoder->read_pos;
+    }
+    pthread_mutex_unlock(&encoder->mutex);
+}
+
+void uplink_encoder_get_stats(uplink_encoder_t* encoder, uplink_encoder_stats_t* stats) {
+    if (!encoder || !stats) {
+        return;
+    }
+    pthread_mutex_lock(&encoder->mutex);
+    *stats = encoder->stats;
+    pthread_mutex_unlock(&encoder->mutex);
+}
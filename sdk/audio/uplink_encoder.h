@@ -0,0 +1,126 @@
+#ifndef UPLINK_ENCODER_H
+#define UPLINK_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "../codecs/audio_codec.h"
+#include "resampler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default number of codec frames the PCM ring can hold
+ */
+#define UPLINK_ENCODER_DEFAULT_RING_FRAMES 8
+
+/**
+ * Destination for encoded frames
+ *
+ * reserve() returns an opaque handle and points *buffer at storage of at
+ * least `size` bytes that the encoder writes into directly; commit() then
+ * publishes `size` bytes (0 abandons the reservation). Both are called on
+ * the encoder thread only.
+ */
+typedef struct {
+    void* (*reserve)(void* user_data, size_t size, uint8_t** buffer);
+    bool (*commit)(void* user_data, void* handle, size_t size, uint32_t timestamp);
+    void* user_data;
+} uplink_encoder_sink_t;
+
+/**
+ * Uplink encoder statistics
+ */
+typedef struct {
+    uint64_t frames_encoded;
+    uint64_t frames_sent;
+    uint64_t samples_dropped;       // PCM rejected because the ring was full
+    uint64_t sink_drops;            // Frames skipped because the sink had no room
+    uint64_t encode_errors;
+    uint64_t total_encode_us;
+    uint64_t max_encode_us;
+} uplink_encoder_stats_t;
+
+/**
+ * PCM uplink encoder
+ *
+ * The producer writes PCM chunks of any size into a preallocated ring whose
+ * capacity is a whole number of codec frames, so every frame is contiguous
+ * and is encoded in place. A dedicated thread encodes each completed frame
+ * straight into storage reserved from the sink.
+ */
+typedef struct {
+    audio_codec_t* codec;           // Initialized encoder, not owned
+    uplink_encoder_sink_t sink;
+    size_t frame_samples;           // Interleaved samples per codec frame
+    size_t ring_frames;
+    size_t max_packet_size;
+    int16_t* ring;                  // ring_frames * frame_samples samples
+    uint32_t* timestamps;           // Capture time of each ring frame's first sample
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+    bool running;
+    size_t write_pos;               // Total samples written (monotonic)
+    size_t read_pos;                // Total samples encoded (monotonic)
+
+    resampler_t* resampler;         // Input rate -> codec rate, NULL when they match
+    int16_t* resampled;             // Producer-side scratch for one resampler block
+    size_t resampled_frames;
+
+    uplink_encoder_stats_t stats;
+} uplink_encoder_t;
+
+/**
+ * Create an uplink encoder and start its thread
+ * @param codec encoder already initialized with init_encoder()
+ * @param ring_frames ring capacity in codec frames, 0 for the default
+ * @param max_packet_size bytes reserved per encoded frame, 0 for the codec maximum
+ * @param sink destination for encoded frames
+ * @return encoder or NULL on failure
+ */
+uplink_encoder_t* uplink_encoder_create(audio_codec_t* codec, size_t ring_frames, size_t max_packet_size,
+                                        const uplink_encoder_sink_t* sink);
+
+/**
+ * Stop the encoder thread and free the encoder; the codec is left to the caller
+ */
+void uplink_encoder_destroy(uplink_encoder_t* encoder);
+
+/**
+ * Accept PCM at a rate other than the codec's and resample it on write
+ *
+ * Call before the first uplink_encoder_write(), from the producer thread.
+ * @param sample_rate rate of the PCM passed to uplink_encoder_write()
+ * @return true on success
+ */
+bool uplink_encoder_set_input_rate(uplink_encoder_t* encoder, int sample_rate);
+
+/**
+ * Append captured PCM
+ * @param pcm interleaved 16-bit samples at the input rate
+ * @param samples number of interleaved samples
+ * @param capture_ms capture time of the first sample (ms)
+ * @return samples accepted; less than samples when the ring is full
+ */
+size_t uplink_encoder_write(uplink_encoder_t* encoder, const int16_t* pcm, size_t samples, uint32_t capture_ms);
+
+/**
+ * Discard buffered PCM that has not reached the encoder yet
+ */
+void uplink_encoder_reset(uplink_encoder_t* encoder);
+
+/**
+ * Snapshot statistics
+ */
+void uplink_encoder_get_stats(uplink_encoder_t* encoder, uplink_encoder_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UPLINK_ENCODER_H
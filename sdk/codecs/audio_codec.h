@@ -29,6 +29,24 @@ typedef struct {
     int frame_size_ms;      // 帧大小 (毫秒)
 } audio_format_t;
 
+// 编码档位：按设备能力在音质、延迟、CPU与带宽之间取舍，具体参数由各编解码器决定
+typedef enum {
+    CODEC_PROFILE_DEFAULT = 0,      // 音质优先
+    CODEC_PROFILE_LOW_LATENCY,      // 低算法延迟、短帧
+    CODEC_PROFILE_LOW_CPU,          // 低复杂度，适合低端ARM板
+    CODEC_PROFILE_BANDWIDTH_SAVER,  // 低码率，静音时几乎不发数据(DTX)
+    CODEC_PROFILE_COUNT
+} codec_profile_t;
+
+// 编码档位的通用参数，与具体编解码器无关；各编解码器按此映射到自身的参数
+typedef struct {
+    int frame_duration_ms;  // 建议的帧时长（毫秒），由调用方传给init_encoder
+    int bitrate;            // 比特率上限 (bps)
+    int complexity;         // 复杂度上限 (0-10)
+    int max_bandwidth_hz;   // 音频带宽上限 (Hz)
+    bool use_dtx;           // 静音时是否只发送DTX帧
+} codec_profile_params_t;
+
 // 前向声明
 typedef struct audio_codec audio_codec_t;
 
@@ -58,6 +76,55 @@ typedef struct {
     codec_error_t (*decode)(audio_codec_t* codec, const uint8_t* input, size_t input_size,
                            int16_t* output, size_t output_size, size_t* decoded_size);
     
+    // 批量编码（可为NULL，此时codec_encode_batch逐帧调用encode）
+    // input: frame_count 帧首尾相接的PCM，每帧 get_input_frame_size() * 声道数 个样本
+    // output: 各帧编码结果首尾相接写入
+    // output_size: 输出缓冲区大小（字节数）
+    // frame_sizes: 每帧编码后的字节数（frame_count 个）
+    // encoded_size: 实际编码的总字节数，出错时为出错前已完成的帧的字节数
+    codec_error_t (*encode_batch)(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                 uint8_t* output, size_t output_size, size_t* frame_sizes, size_t* encoded_size);
+    
+    // 批量解码（可为NULL，此时codec_decode_batch逐帧调用decode）
+    // input: 各帧编码数据首尾相接
+    // frame_sizes: 每帧的字节数（frame_count 个）
+    // output: 解码后的PCM首尾相接写入
+    // output_size: 输出缓冲区大小（样本数）
+    // decoded_size: 实际解码的总样本数，出错时为出错前已完成的帧的样本数
+    codec_error_t (*decode_batch)(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                 size_t frame_count, int16_t* output, size_t output_size, size_t* decoded_size);
+    
+    // 解码丢失的帧（可为NULL，此时codec_decode_lost输出静音）
+    // next_packet: 丢失帧之后的数据包，非NULL时用其中的带内FEC恢复丢失帧，NULL时做丢包隐藏(PLC)
+    // next_size: next_packet的字节数
+    // lost_samples: 丢失帧的每声道样本数
+    // output/output_size/decoded_size: 同decode
+    codec_error_t (*decode_lost)(audio_codec_t* codec, const uint8_t* next_packet, size_t next_size,
+                                size_t lost_samples, int16_t* output, size_t output_size, size_t* decoded_size);
+    
+    // 查询数据包解码后的每声道样本数（可为NULL，此时按decoder_format.frame_size_ms计算）
+    // 服务器可能下发多帧或时长不定的数据包，调用方据此确定输出缓冲区与帧时长
+    // 返回值: 每声道样本数，数据包无效时返回负的codec_error_t
+    int (*get_packet_samples)(const audio_codec_t* codec, const uint8_t* input, size_t input_size);
+    
+    // 应用编码档位（可为NULL，此时codec_set_profile不做任何事）
+    // 编码器已初始化时立即生效，必要时按当前编码格式重建编码器
+    codec_error_t (*set_profile)(audio_codec_t* codec, codec_profile_t profile);
+    
+    // 码率控制（均可为NULL，此时对应的codec_set_*不做任何事），编码器已初始化时立即生效
+    // bitrate: 目标比特率 (bps)
+    // complexity: 复杂度 (0-10)
+    // bandwidth_hz: 音频带宽上限 (Hz)，由编解码器换算为自身支持的档位
+    // enable: 非0时启用带内FEC / DTX
+    codec_error_t (*set_bitrate)(audio_codec_t* codec, int bitrate);
+    codec_error_t (*set_complexity)(audio_codec_t* codec, int complexity);
+    codec_error_t (*set_max_bandwidth)(audio_codec_t* codec, int bandwidth_hz);
+    codec_error_t (*set_inband_fec)(audio_codec_t* codec, int enable);
+    codec_error_t (*set_dtx)(audio_codec_t* codec, int enable);
+    
+    // 获取当前目标比特率（可为NULL，此时codec_get_bitrate返回0）
+    int (*get_bitrate)(const audio_codec_t* codec);
+    
     // 获取编码器名称
     const char* (*get_codec_name)(const audio_codec_t* codec);
     
@@ -79,7 +146,8 @@ struct audio_codec {
     const audio_codec_vtable_t* vtable;
     void* impl_data;  // 实现特定的数据
     
-    audio_format_t format;
+    audio_format_t encoder_format;   // 编码格式，由init_encoder设置
+    audio_format_t decoder_format;   // 解码格式，由init_decoder设置，与编码格式互不影响
     bool encoder_initialized;
     bool decoder_initialized;
 };
@@ -102,6 +170,36 @@ void codec_factory_destroy(audio_codec_t* codec);
 const char* codec_factory_get_name(codec_type_t type);
 int codec_factory_get_supported_count(void);
 codec_type_t* codec_factory_get_supported_types(void);
+const char* codec_profile_get_name(codec_profile_t profile);
+
+// 查询编码档位的通用参数，未知档位返回false
+bool codec_profile_get_params(codec_profile_t profile, codec_profile_params_t* params);
+
+// 应用编码档位：未知档位返回CODEC_INVALID_PARAMETER，编解码器未实现set_profile时忽略
+codec_error_t codec_set_profile(audio_codec_t* codec, codec_profile_t profile);
+
+// 批量编解码：参数同vtable中的encode_batch/decode_batch，编解码器未实现时逐帧回退
+codec_error_t codec_encode_batch(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                 uint8_t* output, size_t output_size, size_t* frame_sizes, size_t* encoded_size);
+codec_error_t codec_decode_batch(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                 size_t frame_count, int16_t* output, size_t output_size, size_t* decoded_size);
+
+// 解码丢失的帧：参数同vtable中的decode_lost，编解码器未实现时输出lost_samples的静音
+codec_error_t codec_decode_lost(audio_codec_t* codec, const uint8_t* next_packet, size_t next_size,
+                                size_t lost_samples, int16_t* output, size_t output_size, size_t* decoded_size);
+
+// 数据包解码后的每声道样本数，编解码器未实现get_packet_samples时按解码格式的帧长计算
+int codec_get_packet_samples(const audio_codec_t* codec, const uint8_t* input, size_t input_size);
+
+// 码率控制：参数同vtable中的对应项，编解码器未实现时忽略并返回CODEC_SUCCESS
+codec_error_t codec_set_bitrate(audio_codec_t* codec, int bitrate);
+codec_error_t codec_set_complexity(audio_codec_t* codec, int complexity);
+codec_error_t codec_set_max_bandwidth(audio_codec_t* codec, int bandwidth_hz);
+codec_error_t codec_set_inband_fec(audio_codec_t* codec, int enable);
+codec_error_t codec_set_dtx(audio_codec_t* codec, int enable);
+
+// 当前目标比特率 (bps)，编解码器未实现get_bitrate时返回0
+int codec_get_bitrate(const audio_codec_t* codec);
 
 // 便利函数
 static inline void audio_format_init(audio_format_t* format, int sample_rate, 
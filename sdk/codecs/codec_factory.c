@@ -19,6 +19,22 @@ static const char* codec_names[] = {
     [CODEC_TYPE_STUB] = "Stub Codec (No-op)"
 };
 
+// 编码档位名称
+static const char* profile_names[] = {
+    [CODEC_PROFILE_DEFAULT] = "DEFAULT",
+    [CODEC_PROFILE_LOW_LATENCY] = "LOW_LATENCY",
+    [CODEC_PROFILE_LOW_CPU] = "LOW_CPU",
+    [CODEC_PROFILE_BANDWIDTH_SAVER] = "BANDWIDTH_SAVER"
+};
+
+// 编码档位通用参数：帧时长、码率、复杂度、带宽上限、DTX
+static const codec_profile_params_t profile_params[CODEC_PROFILE_COUNT] = {
+    [CODEC_PROFILE_DEFAULT] = { 60, 64000, 10, 20000, false },
+    [CODEC_PROFILE_LOW_LATENCY] = { 10, 32000, 5, 20000, false },
+    [CODEC_PROFILE_LOW_CPU] = { 60, 24000, 2, 8000, false },
+    [CODEC_PROFILE_BANDWIDTH_SAVER] = { 60, 12000, 8, 8000, true }
+};
+
 // 创建编解码器实例
 audio_codec_t* codec_factory_create(codec_type_t type) {
     switch (type) {
@@ -64,6 +80,79 @@ const char* codec_factory_get_name(codec_type_t type) {
     return "Unknown";
 }
 
+// 获取编码档位名称
+const char* codec_profile_get_name(codec_profile_t profile) {
+    if (profile >= 0 && profile < CODEC_PROFILE_COUNT) {
+        return profile_names[profile];
+    }
+    return "Unknown";
+}
+
+// 获取编码档位的通用参数
+bool codec_profile_get_params(codec_profile_t profile, codec_profile_params_t* params) {
+    if (profile < 0 || profile >= CODEC_PROFILE_COUNT || !params) {
+        return false;
+    }
+    *params = profile_params[profile];
+    return true;
+}
+
+// 应用编码档位，编解码器未实现set_profile时忽略
+codec_error_t codec_set_profile(audio_codec_t* codec, codec_profile_t profile) {
+    if (!codec || !codec->vtable || profile < 0 || profile >= CODEC_PROFILE_COUNT) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    if (!codec->vtable->set_profile) {
+        return CODEC_SUCCESS;
+    }
+    return codec->vtable->set_profile(codec, profile);
+}
+
+// 码率控制，编解码器未实现对应项时忽略
+codec_error_t codec_set_bitrate(audio_codec_t* codec, int bitrate) {
+    if (!codec || !codec->vtable) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    return codec->vtable->set_bitrate ? codec->vtable->set_bitrate(codec, bitrate) : CODEC_SUCCESS;
+}
+
+codec_error_t codec_set_complexity(audio_codec_t* codec, int complexity) {
+    if (!codec || !codec->vtable) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    return codec->vtable->set_complexity ? codec->vtable->set_complexity(codec, complexity) : CODEC_SUCCESS;
+}
+
+codec_error_t codec_set_max_bandwidth(audio_codec_t* codec, int bandwidth_hz) {
+    if (!codec || !codec->vtable) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    return codec->vtable->set_max_bandwidth ? codec->vtable->set_max_bandwidth(codec, bandwidth_hz) : CODEC_SUCCESS;
+}
+
+codec_error_t codec_set_inband_fec(audio_codec_t* codec, int enable) {
+    if (!codec || !codec->vtable) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    return codec->vtable->set_inband_fec ? codec->vtable->set_inband_fec(codec, enable) : CODEC_SUCCESS;
+}
+
+codec_error_t codec_set_dtx(audio_codec_t* codec, int enable) {
+    if (!codec || !codec->vtable) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    return codec->vtable->set_dtx ? codec->vtable->set_dtx(codec, enable) : CODEC_SUCCESS;
+}
+
+// 获取当前目标比特率，未知时返回0
+int codec_get_bitrate(const audio_codec_t* codec) {
+    if (!codec || !codec->vtable || !codec->vtable->get_bitrate) {
+        return 0;
+    }
+    int bitrate = codec->vtable->get_bitrate(codec);
+    return bitrate > 0 ? bitrate : 0;
+}
+
 // 获取支持的编解码器数量
 int codec_factory_get_supported_count(void) {
     return sizeof(supported_codecs) / sizeof(supported_codecs[0]);
@@ -78,4 +167,97 @@ codec_type_t* codec_factory_get_supported_types(void) {
     }
     
     return types;
-}
\ No newline at end of file
+}
+
+// 批量编码，编解码器未实现encode_batch时逐帧编码
+codec_error_t codec_encode_batch(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                 uint8_t* output, size_t output_size, size_t* frame_sizes, size_t* encoded_size) {
+    if (!codec || !codec->vtable || !input || !output || !frame_sizes || !encoded_size) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    
+    if (codec->vtable->encode_batch) {
+        return codec->vtable->encode_batch(codec, input, frame_count, output, output_size, frame_sizes, encoded_size);
+    }
+    
+    int frame_size = codec->vtable->get_input_frame_size(codec);
+    if (frame_size <= 0) {
+        return CODEC_INITIALIZATION_FAILED;
+    }
+    size_t frame_samples = (size_t)frame_size * (size_t)(codec->encoder_format.channels > 0 ? codec->encoder_format.channels : 1);
+    
+    *encoded_size = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        codec_error_t result = codec->vtable->encode(codec, input + i * frame_samples, frame_samples,
+                                                     output + *encoded_size, output_size - *encoded_size,
+                                                     &frame_sizes[i]);
+        if (result != CODEC_SUCCESS) {
+            return result;
+        }
+        *encoded_size += frame_sizes[i];
+    }
+    return CODEC_SUCCESS;
+}
+
+// 批量解码，编解码器未实现decode_batch时逐帧解码
+codec_error_t codec_decode_batch(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                 size_t frame_count, int16_t* output, size_t output_size, size_t* decoded_size) {
+    if (!codec || !codec->vtable || !input || !frame_sizes || !output || !decoded_size) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    
+    if (codec->vtable->decode_batch) {
+        return codec->vtable->decode_batch(codec, input, frame_sizes, frame_count, output, output_size, decoded_size);
+    }
+    
+    *decoded_size = 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        size_t samples = 0;
+        codec_error_t result = codec->vtable->decode(codec, input + offset, frame_sizes[i],
+                                                     output + *decoded_size, output_size - *decoded_size, &samples);
+        if (result != CODEC_SUCCESS) {
+            return result;
+        }
+        offset += frame_sizes[i];
+        *decoded_size += samples;
+    }
+    return CODEC_SUCCESS;
+}
+
+// 解码丢失的帧，编解码器不支持丢包隐藏时补静音
+codec_error_t codec_decode_lost(audio_codec_t* codec, const uint8_t* next_packet, size_t next_size,
+                                size_t lost_samples, int16_t* output, size_t output_size, size_t* decoded_size) {
+    if (!codec || !codec->vtable || !output || !decoded_size) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    
+    if (codec->vtable->decode_lost) {
+        return codec->vtable->decode_lost(codec, next_packet, next_size, lost_samples,
+                                          output, output_size, decoded_size);
+    }
+    
+    size_t samples = lost_samples * (size_t)(codec->decoder_format.channels > 0 ? codec->decoder_format.channels : 1);
+    if (samples > output_size) {
+        return CODEC_BUFFER_TOO_SMALL;
+    }
+    memset(output, 0, samples * sizeof(int16_t));
+    *decoded_size = samples;
+    return CODEC_SUCCESS;
+}
+
+// 查询数据包时长，编解码器无法从数据包得知时长时使用固定帧长
+int codec_get_packet_samples(const audio_codec_t* codec, const uint8_t* input, size_t input_size) {
+    if (!codec || !codec->vtable || !input || input_size == 0) {
+        return -(int)CODEC_INVALID_PARAMETER;
+    }
+    
+    if (codec->vtable->get_packet_samples) {
+        return codec->vtable->get_packet_samples(codec, input, input_size);
+    }
+    
+    if (!codec->decoder_initialized) {
+        return -(int)CODEC_INITIALIZATION_FAILED;
+    }
+    return codec->decoder_format.sample_rate * codec->decoder_format.frame_size_ms / 1000;
+}
@@ -10,6 +10,14 @@ static codec_error_t stub_encode(audio_codec_t* codec, const int16_t* input, siz
                                 uint8_t* output, size_t output_size, size_t* encoded_size);
 static codec_error_t stub_decode(audio_codec_t* codec, const uint8_t* input, size_t input_size,
                                 int16_t* output, size_t output_size, size_t* decoded_size);
+static codec_error_t stub_encode_batch(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                      uint8_t* output, size_t output_size, size_t* frame_sizes, size_t* encoded_size);
+static codec_error_t stub_decode_batch(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                      size_t frame_count, int16_t* output, size_t output_size, size_t* decoded_size);
+static int stub_get_packet_samples(const audio_codec_t* codec, const uint8_t* input, size_t input_size);
+static codec_error_t stub_set_profile(audio_codec_t* codec, codec_profile_t profile);
+static codec_error_t stub_set_param(audio_codec_t* codec, int value);
+static int stub_get_bitrate(const audio_codec_t* codec);
 static const char* stub_get_codec_name(const audio_codec_t* codec);
 static codec_error_t stub_reset(audio_codec_t* codec);
 static int stub_get_input_frame_size(const audio_codec_t* codec);
@@ -22,6 +30,16 @@ static const audio_codec_vtable_t stub_vtable = {
     .init_decoder = stub_init_decoder,
     .encode = stub_encode,
     .decode = stub_decode,
+    .encode_batch = stub_encode_batch,
+    .decode_batch = stub_decode_batch,
+    .get_packet_samples = stub_get_packet_samples,
+    .set_profile = stub_set_profile,
+    .set_bitrate = stub_set_param,
+    .set_complexity = stub_set_param,
+    .set_max_bandwidth = stub_set_param,
+    .set_inband_fec = stub_set_param,
+    .set_dtx = stub_set_param,
+    .get_bitrate = stub_get_bitrate,
     .get_codec_name = stub_get_codec_name,
     .reset = stub_reset,
     .get_input_frame_size = stub_get_input_frame_size,
@@ -61,7 +79,8 @@ audio_codec_t* codec_stub_create(void) {
     impl->total_decoded_samples = 0;
 
     // 设置默认音频格式
-    audio_format_default(&codec->format);
+    audio_format_default(&codec->encoder_format);
+    audio_format_default(&codec->decoder_format);
 
     LOG_INFO("Stub codec created successfully");
     return codec;
@@ -80,7 +99,7 @@ static codec_error_t stub_init_encoder(audio_codec_t* codec, const audio_format_
 
     impl->encoder_ready = true;
     codec->encoder_initialized = true;
-    codec->format = *format;
+    codec->encoder_format = *format;
 
     return CODEC_SUCCESS;
 }
@@ -98,7 +117,7 @@ static codec_error_t stub_init_decoder(audio_codec_t* codec, const audio_format_
 
     impl->decoder_ready = true;
     codec->decoder_initialized = true;
-    codec->format = *format;
+    codec->decoder_format = *format;
 
     return CODEC_SUCCESS;
 }
@@ -175,6 +194,101 @@ static codec_error_t stub_decode(audio_codec_t* codec, const uint8_t* input, siz
     return CODEC_SUCCESS;
 }
 
+// 批量编码：所有帧一次复制，统计与日志每批一次
+static codec_error_t stub_encode_batch(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                      uint8_t* output, size_t output_size, size_t* frame_sizes, size_t* encoded_size) {
+    if (!codec || !codec->impl_data || !input || !output || !frame_sizes || !encoded_size) {
+        return CODEC_INVALID_PARAMETER;
+    }
+
+    CodecStubData* impl = (CodecStubData*)codec->impl_data;
+    
+    if (!impl->encoder_ready) {
+        return CODEC_INITIALIZATION_FAILED;
+    }
+
+    size_t frame_bytes = (size_t)stub_get_max_output_size(codec);
+    *encoded_size = 0;
+    if (frame_bytes * frame_count > output_size) {
+        LOG_WARN("Stub encoder: output buffer too small (%zu > %zu)", frame_bytes * frame_count, output_size);
+        return CODEC_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(output, input, frame_bytes * frame_count);
+    for (size_t i = 0; i < frame_count; i++) {
+        frame_sizes[i] = frame_bytes;
+    }
+    *encoded_size = frame_bytes * frame_count;
+
+    impl->frame_count += (int)frame_count;
+    impl->total_encoded_bytes += (int)*encoded_size;
+
+    LOG_DEBUG("Stub encoder: batch of %zu frames -> %zu bytes", frame_count, *encoded_size);
+    return CODEC_SUCCESS;
+}
+
+// 批量解码：参数检查、统计与日志每批一次
+static codec_error_t stub_decode_batch(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                      size_t frame_count, int16_t* output, size_t output_size, size_t* decoded_size) {
+    if (!codec || !codec->impl_data || !input || !frame_sizes || !output || !decoded_size) {
+        return CODEC_INVALID_PARAMETER;
+    }
+
+    CodecStubData* impl = (CodecStubData*)codec->impl_data;
+    
+    if (!impl->decoder_ready) {
+        return CODEC_INITIALIZATION_FAILED;
+    }
+
+    *decoded_size = 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        size_t samples = frame_sizes[i] / sizeof(int16_t);
+        if (samples > output_size - *decoded_size) {
+            LOG_WARN("Stub decoder: output buffer too small for frame %zu of batch", i);
+            return CODEC_BUFFER_TOO_SMALL;
+        }
+        memcpy(output + *decoded_size, input + offset, samples * sizeof(int16_t));
+        offset += frame_sizes[i];
+        *decoded_size += samples;
+    }
+
+    impl->frame_count += (int)frame_count;
+    impl->total_decoded_samples += (int)*decoded_size;
+
+    LOG_DEBUG("Stub decoder: batch of %zu frames -> %zu samples", frame_count, *decoded_size);
+    return CODEC_SUCCESS;
+}
+
+// 数据包即PCM，时长由字节数决定
+static int stub_get_packet_samples(const audio_codec_t* codec, const uint8_t* input, size_t input_size) {
+    if (!codec || !input) {
+        return -(int)CODEC_INVALID_PARAMETER;
+    }
+    int channels = codec->decoder_format.channels > 0 ? codec->decoder_format.channels : 1;
+    return (int)(input_size / sizeof(int16_t)) / channels;
+}
+
+// PCM直通没有可调参数，编码档位只校验实例
+static codec_error_t stub_set_profile(audio_codec_t* codec, codec_profile_t profile) {
+    (void)profile;
+    return codec && codec->impl_data ? CODEC_SUCCESS : CODEC_INVALID_PARAMETER;
+}
+
+// 码率控制参数对PCM直通无效，只校验实例
+static codec_error_t stub_set_param(audio_codec_t* codec, int value) {
+    (void)value;
+    return codec && codec->impl_data ? CODEC_SUCCESS : CODEC_INVALID_PARAMETER;
+}
+
+// 比特率即编码格式的PCM比特率
+static int stub_get_bitrate(const audio_codec_t* codec) {
+    if (!codec) {
+        return 0;
+    }
+    return codec->encoder_format.sample_rate * codec->encoder_format.channels * codec->encoder_format.bits_per_sample;
+}
+
 // 获取编解码器名称
 static const char* stub_get_codec_name(const audio_codec_t* codec) {
     (void)codec;
@@ -211,7 +325,7 @@ static int stub_get_input_frame_size(const audio_codec_t* codec) {
     }
     
     // 返回基于音频格式的标准帧大小
-    return codec->format.sample_rate * codec->format.frame_size_ms / 1000;
+    return codec->encoder_format.sample_rate * codec->encoder_format.frame_size_ms / 1000;
 }
 
 // 获取最大输出缓冲区大小
@@ -222,7 +336,7 @@ static int stub_get_max_output_size(const audio_codec_t* codec) {
     
     // Stub 编解码器输出大小与输入相同（无压缩）
     int frame_size = stub_get_input_frame_size(codec);
-    return frame_size * codec->format.channels * sizeof(int16_t);
+    return frame_size * codec->encoder_format.channels * sizeof(int16_t);
 }
 
 // 销毁编解码器
@@ -10,6 +10,17 @@ static codec_error_t opus_codec_encode_impl(audio_codec_t* codec, const int16_t*
                                             uint8_t* output, size_t output_size, size_t* encoded_size);
 static codec_error_t opus_codec_decode_impl(audio_codec_t* codec, const uint8_t* input, size_t input_size,
                                             int16_t* output, size_t output_size, size_t* decoded_size);
+static codec_error_t opus_codec_encode_batch_impl(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                                  uint8_t* output, size_t output_size, size_t* frame_sizes,
+                                                  size_t* encoded_size);
+static codec_error_t opus_codec_decode_batch_impl(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                                  size_t frame_count, int16_t* output, size_t output_size,
+                                                  size_t* decoded_size);
+static codec_error_t opus_codec_decode_lost_impl(audio_codec_t* codec, const uint8_t* next_packet, size_t next_size,
+                                                 size_t lost_samples, int16_t* output, size_t output_size,
+                                                 size_t* decoded_size);
+static int opus_get_packet_samples(const audio_codec_t* codec, const uint8_t* input, size_t input_size);
+static codec_error_t opus_set_max_bandwidth_hz(audio_codec_t* codec, int bandwidth_hz);
 static const char* opus_get_codec_name(const audio_codec_t* codec);
 static codec_error_t opus_reset(audio_codec_t* codec);
 static int opus_get_input_frame_size(const audio_codec_t* codec);
@@ -22,6 +33,17 @@ static const audio_codec_vtable_t opus_vtable = {
     .init_decoder = opus_init_decoder,
     .encode = opus_codec_encode_impl,
     .decode = opus_codec_decode_impl,
+    .encode_batch = opus_codec_encode_batch_impl,
+    .decode_batch = opus_codec_decode_batch_impl,
+    .decode_lost = opus_codec_decode_lost_impl,
+    .get_packet_samples = opus_get_packet_samples,
+    .set_profile = opus_codec_set_profile,
+    .set_bitrate = opus_codec_set_bitrate,
+    .set_complexity = opus_codec_set_complexity,
+    .set_max_bandwidth = opus_set_max_bandwidth_hz,
+    .set_inband_fec = opus_codec_set_inband_fec,
+    .set_dtx = opus_codec_set_dtx,
+    .get_bitrate = opus_codec_get_bitrate,
     .get_codec_name = opus_get_codec_name,
     .reset = opus_reset,
     .get_input_frame_size = opus_get_input_frame_size,
@@ -67,9 +89,11 @@ audio_codec_t* opus_codec_create(void) {
     impl->prediction_disabled = 0;
     impl->use_inband_fec = 0;
     impl->use_dtx = 0;
+    impl->last_packet_samples = 0;
 
     // 设置默认音频格式
-    audio_format_default(&codec->format);
+    audio_format_default(&codec->encoder_format);
+    audio_format_default(&codec->decoder_format);
 
     LOG_INFO("Opus codec created successfully");
     return codec;
@@ -113,7 +137,7 @@ static codec_error_t opus_init_encoder(audio_codec_t* codec, const audio_format_
     opus_encoder_ctl(impl->encoder, OPUS_SET_INBAND_FEC(impl->use_inband_fec));
     opus_encoder_ctl(impl->encoder, OPUS_SET_DTX(impl->use_dtx));
 
-    codec->format = *format;
+    codec->encoder_format = *format;
     codec->encoder_initialized = true;
 
     LOG_INFO("Opus encoder initialized: %d Hz, %d channels, %d kbps", 
@@ -144,8 +168,9 @@ static codec_error_t opus_init_decoder(audio_codec_t* codec, const audio_format_
         return CODEC_INITIALIZATION_FAILED;
     }
 
-    codec->format = *format;
+    codec->decoder_format = *format;
     codec->decoder_initialized = true;
+    impl->last_packet_samples = 0;
 
     LOG_INFO("Opus decoder initialized: %d Hz, %d channels", 
              format->sample_rate, format->channels);
@@ -168,11 +193,11 @@ static codec_error_t opus_codec_encode_impl(audio_codec_t* codec, const int16_t*
     opus_codec_impl_t* impl = (opus_codec_impl_t*)codec->impl_data;
     
     // 计算帧大小（样本数）
-    int frame_size = codec->format.sample_rate * codec->format.frame_size_ms / 1000;
+    int frame_size = codec->encoder_format.sample_rate * codec->encoder_format.frame_size_ms / 1000;
     
-    if ((int)input_size != frame_size * codec->format.channels) {
+    if ((int)input_size != frame_size * codec->encoder_format.channels) {
         LOG_ERROR("Invalid input size for Opus encoding: expected %d, got %zu", 
-                  frame_size * codec->format.channels, input_size);
+                  frame_size * codec->encoder_format.channels, input_size);
         return CODEC_INVALID_PARAMETER;
     }
 
@@ -187,6 +212,20 @@ static codec_error_t opus_codec_encode_impl(audio_codec_t* codec, const int16_t*
     return CODEC_SUCCESS;
 }
 
+// 数据包解码后的每声道样本数
+// 服务器可能下发多帧（最长120ms）或与hello声明时长不同的数据包，按包头而不是decoder_format.frame_size_ms计算；
+// 没有数据包（丢包隐藏）时沿用上一个数据包的时长
+static int opus_packet_frame_size(const audio_codec_t* codec, const opus_codec_impl_t* impl,
+                                  const uint8_t* input, size_t input_size) {
+    if (input && input_size > 0) {
+        return opus_packet_get_nb_samples(input, (opus_int32)input_size, codec->decoder_format.sample_rate);
+    }
+    if (impl->last_packet_samples > 0) {
+        return impl->last_packet_samples;
+    }
+    return codec->decoder_format.sample_rate * codec->decoder_format.frame_size_ms / 1000;
+}
+
 // 解码音频数据
 static codec_error_t opus_codec_decode_impl(audio_codec_t* codec, const uint8_t* input, size_t input_size,
                                             int16_t* output, size_t output_size, size_t* decoded_size) {
@@ -202,26 +241,163 @@ static codec_error_t opus_codec_decode_impl(audio_codec_t* codec, const uint8_t*
 
     opus_codec_impl_t* impl = (opus_codec_impl_t*)codec->impl_data;
     
-    // 计算最大帧大小
-    int max_frame_size = codec->format.sample_rate * codec->format.frame_size_ms / 1000;
+    int frame_size = opus_packet_frame_size(codec, impl, input, input_size);
+    if (frame_size < 0) {
+        LOG_ERROR("Invalid Opus packet of %zu bytes: %s", input_size, opus_strerror(frame_size));
+        return CODEC_DECODING_FAILED;
+    }
     
-    if (output_size < (size_t)(max_frame_size * codec->format.channels)) {
-        LOG_ERROR("Output buffer too small for Opus decoding");
+    if (output_size < (size_t)(frame_size * codec->decoder_format.channels)) {
+        LOG_ERROR("Output buffer too small for Opus packet of %d samples", frame_size);
         return CODEC_BUFFER_TOO_SMALL;
     }
 
     // 解码
     int result = opus_decode(impl->decoder, input, (opus_int32)input_size, 
-                            output, max_frame_size, 0);
+                            output, frame_size, 0);
     if (result < 0) {
         LOG_ERROR("Opus decoding failed: %s", opus_strerror(result));
         return CODEC_DECODING_FAILED;
     }
 
-    *decoded_size = (size_t)(result * codec->format.channels);
+    impl->last_packet_samples = result;
+    *decoded_size = (size_t)(result * codec->decoder_format.channels);
+    return CODEC_SUCCESS;
+}
+
+// 批量编码：参数只检查一次，逐帧直接调用opus_encode
+static codec_error_t opus_codec_encode_batch_impl(audio_codec_t* codec, const int16_t* input, size_t frame_count,
+                                                  uint8_t* output, size_t output_size, size_t* frame_sizes,
+                                                  size_t* encoded_size) {
+    if (!codec || !codec->impl_data || !input || !output || !frame_sizes || !encoded_size) {
+        LOG_ERROR("Invalid parameters for Opus batch encoding");
+        return CODEC_INVALID_PARAMETER;
+    }
+
+    if (!codec->encoder_initialized) {
+        LOG_ERROR("Opus encoder not initialized");
+        return CODEC_INITIALIZATION_FAILED;
+    }
+
+    OpusEncoder* encoder = ((opus_codec_impl_t*)codec->impl_data)->encoder;
+    int frame_size = codec->encoder_format.sample_rate * codec->encoder_format.frame_size_ms / 1000;
+    size_t frame_samples = (size_t)frame_size * (size_t)codec->encoder_format.channels;
+
+    *encoded_size = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        size_t room = output_size - *encoded_size;
+        if (room == 0) {
+            LOG_ERROR("Output buffer too small for Opus batch encoding at frame %zu", i);
+            return CODEC_BUFFER_TOO_SMALL;
+        }
+        int result = opus_encode(encoder, input + i * frame_samples, frame_size, output + *encoded_size,
+                                 (opus_int32)(room < 4000 ? room : 4000));
+        if (result < 0) {
+            LOG_ERROR("Opus batch encoding failed at frame %zu: %s", i, opus_strerror(result));
+            return result == OPUS_BUFFER_TOO_SMALL ? CODEC_BUFFER_TOO_SMALL : CODEC_ENCODING_FAILED;
+        }
+        frame_sizes[i] = (size_t)result;
+        *encoded_size += (size_t)result;
+    }
+    return CODEC_SUCCESS;
+}
+
+// 批量解码：参数只检查一次，逐帧直接调用opus_decode
+static codec_error_t opus_codec_decode_batch_impl(audio_codec_t* codec, const uint8_t* input, const size_t* frame_sizes,
+                                                  size_t frame_count, int16_t* output, size_t output_size,
+                                                  size_t* decoded_size) {
+    if (!codec || !codec->impl_data || !input || !frame_sizes || !output || !decoded_size) {
+        LOG_ERROR("Invalid parameters for Opus batch decoding");
+        return CODEC_INVALID_PARAMETER;
+    }
+
+    if (!codec->decoder_initialized) {
+        LOG_ERROR("Opus decoder not initialized");
+        return CODEC_INITIALIZATION_FAILED;
+    }
+
+    opus_codec_impl_t* impl = (opus_codec_impl_t*)codec->impl_data;
+    int channels = codec->decoder_format.channels;
+
+    *decoded_size = 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        int frame_size = opus_packet_frame_size(codec, impl, input + offset, frame_sizes[i]);
+        if (frame_size < 0) {
+            LOG_ERROR("Invalid Opus packet at frame %zu: %s", i, opus_strerror(frame_size));
+            return CODEC_DECODING_FAILED;
+        }
+        size_t room = (output_size - *decoded_size) / (size_t)channels;
+        if (room < (size_t)frame_size) {
+            LOG_ERROR("Output buffer too small for Opus batch decoding at frame %zu", i);
+            return CODEC_BUFFER_TOO_SMALL;
+        }
+        int result = opus_decode(impl->decoder, input + offset, (opus_int32)frame_sizes[i],
+                                 output + *decoded_size, frame_size, 0);
+        if (result < 0) {
+            LOG_ERROR("Opus batch decoding failed at frame %zu: %s", i, opus_strerror(result));
+            return CODEC_DECODING_FAILED;
+        }
+        impl->last_packet_samples = result;
+        offset += frame_sizes[i];
+        *decoded_size += (size_t)result * (size_t)channels;
+    }
+    return CODEC_SUCCESS;
+}
+
+// 解码丢失的帧：有后续数据包时用其带内FEC恢复（decode_fec=1），否则做丢包隐藏
+// 后续数据包随后仍需正常解码；没有FEC数据时libopus自动退化为丢包隐藏
+static codec_error_t opus_codec_decode_lost_impl(audio_codec_t* codec, const uint8_t* next_packet, size_t next_size,
+                                                 size_t lost_samples, int16_t* output, size_t output_size,
+                                                 size_t* decoded_size) {
+    if (!codec || !codec->impl_data || !output || !decoded_size) {
+        LOG_ERROR("Invalid parameters for Opus loss concealment");
+        return CODEC_INVALID_PARAMETER;
+    }
+
+    if (!codec->decoder_initialized) {
+        LOG_ERROR("Opus decoder not initialized");
+        return CODEC_INITIALIZATION_FAILED;
+    }
+
+    opus_codec_impl_t* impl = (opus_codec_impl_t*)codec->impl_data;
+    int channels = codec->decoder_format.channels;
+
+    // 补帧长度必须是2.5ms的整数倍
+    int quantum = codec->decoder_format.sample_rate / 400;
+    int frame_size = quantum > 0 ? (int)lost_samples / quantum * quantum : 0;
+    if (frame_size <= 0) {
+        frame_size = opus_packet_frame_size(codec, impl, NULL, 0);
+    }
+    if (output_size < (size_t)(frame_size * channels)) {
+        LOG_ERROR("Output buffer too small for Opus loss concealment of %d samples", frame_size);
+        return CODEC_BUFFER_TOO_SMALL;
+    }
+
+    int fec = next_packet && next_size > 0 ? 1 : 0;
+    int result = opus_decode(impl->decoder, fec ? next_packet : NULL, fec ? (opus_int32)next_size : 0,
+                             output, frame_size, fec);
+    if (result < 0) {
+        LOG_WARN("Opus %s failed: %s", fec ? "FEC decoding" : "loss concealment", opus_strerror(result));
+        return CODEC_DECODING_FAILED;
+    }
+
+    *decoded_size = (size_t)(result * channels);
     return CODEC_SUCCESS;
 }
 
+// 查询数据包时长，调用方据此准备输出缓冲区
+static int opus_get_packet_samples(const audio_codec_t* codec, const uint8_t* input, size_t input_size) {
+    if (!codec || !input || input_size == 0) {
+        return -(int)CODEC_INVALID_PARAMETER;
+    }
+    if (!codec->decoder_initialized) {
+        return -(int)CODEC_INITIALIZATION_FAILED;
+    }
+    int samples = opus_packet_get_nb_samples(input, (opus_int32)input_size, codec->decoder_format.sample_rate);
+    return samples < 0 ? -(int)CODEC_DECODING_FAILED : samples;
+}
+
 // 获取编码器名称
 static const char* opus_get_codec_name(const audio_codec_t* codec) {
     (void)codec; // 避免未使用参数警告
@@ -244,6 +420,7 @@ static codec_error_t opus_reset(audio_codec_t* codec) {
     if (impl->decoder && codec->decoder_initialized) {
         opus_decoder_ctl(impl->decoder, OPUS_RESET_STATE);
     }
+    impl->last_packet_samples = 0;
 
     LOG_INFO("Opus codec reset");
     return CODEC_SUCCESS;
@@ -256,7 +433,7 @@ static int opus_get_input_frame_size(const audio_codec_t* codec) {
     }
     
     // 返回每个声道的样本数
-    return codec->format.sample_rate * codec->format.frame_size_ms / 1000;
+    return codec->encoder_format.sample_rate * codec->encoder_format.frame_size_ms / 1000;
 }
 
 // 获取最大输出缓冲区大小（字节数）
@@ -293,6 +470,95 @@ static void opus_destroy(audio_codec_t* codec) {
     LOG_INFO("Opus codec destroyed");
 }
 
+// 音频带宽（Hz）换算为Opus带宽档位
+static int opus_bandwidth_from_hz(int bandwidth_hz) {
+    if (bandwidth_hz <= 4000) {
+        return OPUS_BANDWIDTH_NARROWBAND;
+    }
+    if (bandwidth_hz <= 6000) {
+        return OPUS_BANDWIDTH_MEDIUMBAND;
+    }
+    if (bandwidth_hz <= 8000) {
+        return OPUS_BANDWIDTH_WIDEBAND;
+    }
+    if (bandwidth_hz <= 12000) {
+        return OPUS_BANDWIDTH_SUPERWIDEBAND;
+    }
+    return OPUS_BANDWIDTH_FULLBAND;
+}
+
+// 通用接口的带宽上限以Hz给出
+static codec_error_t opus_set_max_bandwidth_hz(audio_codec_t* codec, int bandwidth_hz) {
+    if (bandwidth_hz <= 0) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    return opus_codec_set_max_bandwidth(codec, opus_bandwidth_from_hz(bandwidth_hz));
+}
+
+// 编码档位的Opus专有参数：应用类型与信号类型，其余取codec_profile_get_params()
+static const struct {
+    int application;
+    int signal_type;
+} opus_profiles[CODEC_PROFILE_COUNT] = {
+    [CODEC_PROFILE_DEFAULT] = { OPUS_APPLICATION_VOIP, OPUS_AUTO },
+    // 只用CELT，算法延迟约5ms，配合10ms短帧
+    [CODEC_PROFILE_LOW_LATENCY] = { OPUS_APPLICATION_RESTRICTED_LOWDELAY, OPUS_SIGNAL_VOICE },
+    // 低复杂度SILK，宽带上限，长帧摊薄每帧开销
+    [CODEC_PROFILE_LOW_CPU] = { OPUS_APPLICATION_VOIP, OPUS_SIGNAL_VOICE },
+    // 低码率宽带语音，静音段只发送DTX帧
+    [CODEC_PROFILE_BANDWIDTH_SAVER] = { OPUS_APPLICATION_VOIP, OPUS_SIGNAL_VOICE }
+};
+
+bool opus_codec_get_profile_params(codec_profile_t profile, opus_codec_profile_params_t* params) {
+    codec_profile_params_t common;
+    if (!params || !codec_profile_get_params(profile, &common)) {
+        return false;
+    }
+    params->application = opus_profiles[profile].application;
+    params->bitrate = common.bitrate;
+    params->complexity = common.complexity;
+    params->max_bandwidth = opus_bandwidth_from_hz(common.max_bandwidth_hz);
+    params->signal_type = opus_profiles[profile].signal_type;
+    params->use_dtx = common.use_dtx ? 1 : 0;
+    params->frame_duration_ms = common.frame_duration_ms;
+    return true;
+}
+
+codec_error_t opus_codec_set_profile(audio_codec_t* codec, codec_profile_t profile) {
+    if (!codec || !codec->impl_data || profile < 0 || profile >= CODEC_PROFILE_COUNT) {
+        return CODEC_INVALID_PARAMETER;
+    }
+    
+    opus_codec_impl_t* impl = (opus_codec_impl_t*)codec->impl_data;
+    opus_codec_profile_params_t params;
+    opus_codec_get_profile_params(profile, &params);
+    bool application_changed = impl->application != params.application;
+    impl->application = params.application;
+    impl->bitrate = params.bitrate;
+    impl->complexity = params.complexity;
+    impl->max_bandwidth = params.max_bandwidth;
+    impl->signal_type = params.signal_type;
+    impl->use_dtx = params.use_dtx;
+    
+    LOG_INFO("Opus profile %s: %d kbps, complexity %d", codec_profile_get_name(profile),
+             params.bitrate / 1000, params.complexity);
+    if (!impl->encoder || !codec->encoder_initialized) {
+        return CODEC_SUCCESS;
+    }
+    
+    // 应用类型只能在创建编码器时指定
+    if (application_changed) {
+        audio_format_t format = codec->encoder_format;
+        return opus_init_encoder(codec, &format);
+    }
+    opus_encoder_ctl(impl->encoder, OPUS_SET_BITRATE(impl->bitrate));
+    opus_encoder_ctl(impl->encoder, OPUS_SET_COMPLEXITY(impl->complexity));
+    opus_encoder_ctl(impl->encoder, OPUS_SET_MAX_BANDWIDTH(impl->max_bandwidth));
+    opus_encoder_ctl(impl->encoder, OPUS_SET_SIGNAL(impl->signal_type));
+    opus_encoder_ctl(impl->encoder, OPUS_SET_DTX(impl->use_dtx));
+    return CODEC_SUCCESS;
+}
+
 // Opus编解码器参数设置函数
 codec_error_t opus_codec_set_bitrate(audio_codec_t* codec, int bitrate) {
     if (!codec || !codec->impl_data) {
@@ -25,11 +25,29 @@ typedef struct {
     int prediction_disabled; // 预测禁用
     int use_inband_fec;   // 使用带内FEC
     int use_dtx;          // 使用DTX
+    int last_packet_samples; // 上一个数据包的每声道样本数，丢包隐藏按此时长补帧
 } opus_codec_impl_t;
 
+// 编码档位对应的Opus参数
+typedef struct {
+    int application;        // 应用类型，改变时需重建编码器
+    int bitrate;            // 比特率
+    int complexity;         // 复杂度 (0-10)
+    int max_bandwidth;      // 最大带宽
+    int signal_type;        // 信号类型
+    int use_dtx;            // 使用DTX
+    int frame_duration_ms;  // 建议的帧时长（毫秒），由调用方传给init_encoder
+} opus_codec_profile_params_t;
+
 // 创建Opus编解码器实例
 audio_codec_t* opus_codec_create(void);
 
+// 查询编码档位的参数，未知档位返回false
+bool opus_codec_get_profile_params(codec_profile_t profile, opus_codec_profile_params_t* params);
+
+// 应用编码档位；编码器已初始化且应用类型改变时按当前编码格式重建编码器
+codec_error_t opus_codec_set_profile(audio_codec_t* codec, codec_profile_t profile);
+
 // Opus编解码器特定函数
 codec_error_t opus_codec_set_bitrate(audio_codec_t* codec, int bitrate);
 codec_error_t opus_codec_set_complexity(audio_codec_t* codec, int complexity);
@@ -0,0 +1,222 @@
+#include "audio_codec.h"
+#include "opus_codec.h"
+#include "../log/linx_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#define SAMPLE_RATE 16000
+#define CHANNELS 1
+#define FRAME_SIZE_MS 20
+#define FRAME_SIZE (SAMPLE_RATE * FRAME_SIZE_MS / 1000)  // 320 samples
+#define MAX_PACKET_SIZE 4000
+#define NUM_FRAMES 500
+#define BATCH_FRAMES 10
+#define PROFILE_SECONDS 4
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+// 生成测试音频（频率逐帧变化的正弦波）
+static void generate_test_audio(int16_t* buffer, size_t frames) {
+    for (size_t f = 0; f < frames; f++) {
+        double frequency = 440.0 + (double)(f % 10) * 110.0;
+        for (size_t i = 0; i < FRAME_SIZE * CHANNELS; i++) {
+            double t = (double)i / SAMPLE_RATE;
+            buffer[f * FRAME_SIZE * CHANNELS + i] = (int16_t)(sin(2.0 * M_PI * frequency * t) * 16000.0);
+        }
+    }
+}
+
+// 对一种编解码器分别测量逐帧与批量编解码的每帧耗时
+static void bench_codec(codec_type_t type, const int16_t* pcm) {
+    audio_codec_t* codec = codec_factory_create(type);
+    if (!codec) {
+        return;
+    }
+
+    // 被测调用不放在assert中，NDEBUG下也要真正执行；结果在计时区间之后检查
+    audio_format_t format;
+    audio_format_init(&format, SAMPLE_RATE, CHANNELS, 16, FRAME_SIZE_MS);
+    size_t failures = 0;
+    failures += codec->vtable->init_encoder(codec, &format) != CODEC_SUCCESS;
+    failures += codec->vtable->init_decoder(codec, &format) != CODEC_SUCCESS;
+    assert(failures == 0);
+
+    size_t frame_bytes = (size_t)codec->vtable->get_max_output_size(codec);
+    uint8_t* packets = (uint8_t*)malloc(frame_bytes * NUM_FRAMES);
+    size_t* sizes = (size_t*)malloc(NUM_FRAMES * sizeof(size_t));
+    int16_t* decoded = (int16_t*)malloc(FRAME_SIZE * CHANNELS * NUM_FRAMES * sizeof(int16_t));
+    assert(packets && sizes && decoded);
+
+    // 逐帧编码
+    double start = now_us();
+    size_t offset = 0;
+    for (size_t i = 0; i < NUM_FRAMES; i++) {
+        sizes[i] = 0;
+        failures += codec->vtable->encode(codec, pcm + i * FRAME_SIZE * CHANNELS, FRAME_SIZE * CHANNELS,
+                                          packets + offset, frame_bytes, &sizes[i]) != CODEC_SUCCESS;
+        offset += sizes[i];
+    }
+    double encode_single = (now_us() - start) / NUM_FRAMES;
+    assert(failures == 0);
+
+    // 逐帧解码
+    start = now_us();
+    offset = 0;
+    size_t total_samples = 0;
+    for (size_t i = 0; i < NUM_FRAMES; i++) {
+        size_t samples = 0;
+        failures += codec->vtable->decode(codec, packets + offset, sizes[i], decoded + i * FRAME_SIZE * CHANNELS,
+                                          FRAME_SIZE * CHANNELS, &samples) != CODEC_SUCCESS;
+        total_samples += samples;
+        offset += sizes[i];
+    }
+    double decode_single = (now_us() - start) / NUM_FRAMES;
+    assert(failures == 0);
+    assert(total_samples == FRAME_SIZE * CHANNELS * NUM_FRAMES);
+
+    failures += codec->vtable->init_encoder(codec, &format) != CODEC_SUCCESS;
+    failures += codec->vtable->init_decoder(codec, &format) != CODEC_SUCCESS;
+    assert(failures == 0);
+
+    // 批量编码
+    start = now_us();
+    offset = 0;
+    for (size_t i = 0; i < NUM_FRAMES; i += BATCH_FRAMES) {
+        size_t encoded = 0;
+        failures += codec_encode_batch(codec, pcm + i * FRAME_SIZE * CHANNELS, BATCH_FRAMES, packets + offset,
+                                       frame_bytes * (NUM_FRAMES - i), &sizes[i], &encoded) != CODEC_SUCCESS;
+        offset += encoded;
+    }
+    double encode_batch = (now_us() - start) / NUM_FRAMES;
+    assert(failures == 0);
+
+    // 批量解码
+    start = now_us();
+    offset = 0;
+    total_samples = 0;
+    for (size_t i = 0; i < NUM_FRAMES; i += BATCH_FRAMES) {
+        size_t samples = 0;
+        size_t batch_bytes = 0;
+        for (size_t j = 0; j < BATCH_FRAMES; j++) {
+            batch_bytes += sizes[i + j];
+        }
+        failures += codec_decode_batch(codec, packets + offset, &sizes[i], BATCH_FRAMES,
+                                       decoded + i * FRAME_SIZE * CHANNELS,
+                                       FRAME_SIZE * CHANNELS * BATCH_FRAMES, &samples) != CODEC_SUCCESS;
+        total_samples += samples;
+        offset += batch_bytes;
+    }
+    double decode_batch = (now_us() - start) / NUM_FRAMES;
+    assert(failures == 0);
+    assert(total_samples == FRAME_SIZE * CHANNELS * NUM_FRAMES);
+    (void)failures;
+    (void)total_samples;
+
+    printf("%-24s encode %8.2f -> %8.2f us/frame   decode %8.2f -> %8.2f us/frame\n",
+           codec->vtable->get_codec_name(codec), encode_single, encode_batch, decode_single, decode_batch);
+
+    free(packets);
+    free(sizes);
+    free(decoded);
+    codec_factory_destroy(codec);
+}
+
+// 测量一个编码档位按其建议帧长的每帧编解码耗时与平均码率；奇数秒为静音，用于体现DTX
+static void bench_profile(codec_profile_t profile) {
+    opus_codec_profile_params_t params;
+    if (!opus_codec_get_profile_params(profile, &params)) {
+        return;
+    }
+    
+    audio_codec_t* codec = opus_codec_create();
+    assert(codec != NULL);
+    size_t failures = 0;
+    failures += opus_codec_set_profile(codec, profile) != CODEC_SUCCESS;
+    audio_format_t format;
+    audio_format_init(&format, SAMPLE_RATE, CHANNELS, 16, params.frame_duration_ms);
+    failures += codec->vtable->init_encoder(codec, &format) != CODEC_SUCCESS;
+    failures += codec->vtable->init_decoder(codec, &format) != CODEC_SUCCESS;
+    assert(failures == 0);
+    
+    size_t frame_samples = (size_t)(SAMPLE_RATE * params.frame_duration_ms / 1000 * CHANNELS);
+    size_t frames = (size_t)(PROFILE_SECONDS * 1000 / params.frame_duration_ms);
+    int16_t* pcm = (int16_t*)malloc(frame_samples * frames * sizeof(int16_t));
+    int16_t* decoded = (int16_t*)malloc(frame_samples * sizeof(int16_t));
+    uint8_t packet[MAX_PACKET_SIZE];
+    assert(pcm && decoded);
+    for (size_t i = 0; i < frame_samples * frames; i++) {
+        size_t second = i / (SAMPLE_RATE * CHANNELS);
+        double t = (double)i / (SAMPLE_RATE * CHANNELS);
+        pcm[i] = second % 2 ? 0 : (int16_t)(sin(2.0 * M_PI * (440.0 + 110.0 * (double)second) * t) * 16000.0);
+    }
+    
+    double encode_us = 0.0;
+    double decode_us = 0.0;
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < frames; i++) {
+        size_t packet_size = 0;
+        size_t samples = 0;
+        double start = now_us();
+        codec_error_t encoded = codec->vtable->encode(codec, pcm + i * frame_samples, frame_samples, packet,
+                                                      sizeof(packet), &packet_size);
+        encode_us += now_us() - start;
+        assert(encoded == CODEC_SUCCESS);
+        total_bytes += packet_size;
+        
+        start = now_us();
+        codec_error_t decoded_result = codec->vtable->decode(codec, packet, packet_size, decoded, frame_samples,
+                                                             &samples);
+        decode_us += now_us() - start;
+        assert(decoded_result == CODEC_SUCCESS);
+        (void)encoded;
+        (void)decoded_result;
+    }
+    (void)failures;
+    
+    // 编码负载：编码耗时占音频时长的比例
+    printf("%-16s %3d ms  encode %8.2f us/frame  decode %8.2f us/frame  %6.1f kbps  encode load %5.2f%%\n",
+           codec_profile_get_name(profile), params.frame_duration_ms, encode_us / (double)frames,
+           decode_us / (double)frames, (double)total_bytes * 8.0 / (PROFILE_SECONDS * 1000.0),
+           encode_us / (PROFILE_SECONDS * 1e6) * 100.0);
+    
+    free(pcm);
+    free(decoded);
+    codec->vtable->destroy(codec);
+}
+
+int main(void) {
+    // 编解码日志会淹没计时结果
+    log_config_t log_config = LOG_DEFAULT_CONFIG;
+    log_config.level = LOG_LEVEL_ERROR;
+    log_init(&log_config);
+
+    int16_t* pcm = (int16_t*)malloc(FRAME_SIZE * CHANNELS * NUM_FRAMES * sizeof(int16_t));
+    assert(pcm != NULL);
+    generate_test_audio(pcm, NUM_FRAMES);
+
+    printf("%d frames of %d ms at %d Hz, batches of %d frames (single -> batch)\n",
+           NUM_FRAMES, FRAME_SIZE_MS, SAMPLE_RATE, BATCH_FRAMES);
+
+    int count = codec_factory_get_supported_count();
+    codec_type_t* types = codec_factory_get_supported_types();
+    for (int i = 0; i < count; i++) {
+        bench_codec(types[i], pcm);
+    }
+
+    printf("\nOpus encoder profiles, %d s at %d Hz (every other second silent)\n", PROFILE_SECONDS, SAMPLE_RATE);
+    for (int profile = 0; profile < CODEC_PROFILE_COUNT; profile++) {
+        bench_profile((codec_profile_t)profile);
+    }
+    
+    free(pcm);
+    log_cleanup();
+    return 0;
+}
@@ -228,6 +228,23 @@ int test_opus_codec_parameters(void) {
     assert(result == CODEC_SUCCESS);
     assert(opus_codec_get_dtx(codec) == 1);
     
+    // 通用码率控制接口，带宽上限以Hz给出
+    assert(codec_set_bitrate(codec, 24000) == CODEC_SUCCESS);
+    assert(codec_get_bitrate(codec) == 24000);
+    assert(codec_set_complexity(codec, 3) == CODEC_SUCCESS);
+    assert(opus_codec_get_complexity(codec) == 3);
+    assert(codec_set_max_bandwidth(codec, 8000) == CODEC_SUCCESS);
+    assert(opus_codec_get_max_bandwidth(codec) == OPUS_BANDWIDTH_WIDEBAND);
+    assert(codec_set_dtx(codec, 0) == CODEC_SUCCESS);
+    assert(opus_codec_get_dtx(codec) == 0);
+    
+    // stub编解码器忽略码率控制
+    audio_codec_t* stub = codec_factory_create(CODEC_TYPE_STUB);
+    assert(stub != NULL);
+    assert(codec_set_bitrate(stub, 24000) == CODEC_SUCCESS);
+    assert(codec_set_inband_fec(stub, 1) == CODEC_SUCCESS);
+    codec_factory_destroy(stub);
+    
     printf("Bitrate: %d bps\n", opus_codec_get_bitrate(codec));
     printf("Complexity: %d\n", opus_codec_get_complexity(codec));
     printf("VBR: %d\n", opus_codec_get_vbr(codec));
@@ -241,6 +258,253 @@ int test_opus_codec_parameters(void) {
     return 0;
 }
 
+// 测试Opus批量编解码
+int test_opus_codec_batch(void) {
+    printf("Testing Opus codec batch encode/decode...\n");
+    
+    audio_codec_t* codec = opus_codec_create();
+    assert(codec != NULL);
+    
+    audio_format_t format;
+    audio_format_init(&format, SAMPLE_RATE, CHANNELS, 16, FRAME_SIZE_MS);
+    assert(codec->vtable->init_encoder(codec, &format) == CODEC_SUCCESS);
+    assert(codec->vtable->init_decoder(codec, &format) == CODEC_SUCCESS);
+    
+    // 一次编码10帧，每帧长度单独返回
+    const size_t batch = 10;
+    int16_t* input = (int16_t*)malloc(FRAME_SIZE * CHANNELS * batch * sizeof(int16_t));
+    int16_t* decoded = (int16_t*)malloc(FRAME_SIZE * CHANNELS * batch * sizeof(int16_t));
+    uint8_t* packets = (uint8_t*)malloc(MAX_PACKET_SIZE * batch);
+    size_t frame_sizes[10];
+    assert(input && decoded && packets);
+    generate_test_audio(input, FRAME_SIZE * CHANNELS * batch, 440.0);
+    
+    size_t encoded_size = 0;
+    codec_error_t result = codec_encode_batch(codec, input, batch, packets, MAX_PACKET_SIZE * batch,
+                                              frame_sizes, &encoded_size);
+    assert(result == CODEC_SUCCESS);
+    size_t total = 0;
+    for (size_t i = 0; i < batch; i++) {
+        assert(frame_sizes[i] > 0);
+        total += frame_sizes[i];
+    }
+    assert(total == encoded_size);
+    printf("Batch encoded %zu frames into %zu bytes\n", batch, encoded_size);
+    
+    size_t decoded_size = 0;
+    result = codec_decode_batch(codec, packets, frame_sizes, batch, decoded,
+                                FRAME_SIZE * CHANNELS * batch, &decoded_size);
+    assert(result == CODEC_SUCCESS);
+    assert(decoded_size == FRAME_SIZE * CHANNELS * batch);
+    
+    // 输出缓冲区不足以容纳全部帧时返回错误
+    result = codec_decode_batch(codec, packets, frame_sizes, batch, decoded,
+                                FRAME_SIZE * CHANNELS * (batch - 1), &decoded_size);
+    assert(result == CODEC_BUFFER_TOO_SMALL);
+    
+    // 编码输出空间耗尽时同样返回缓冲区不足，而不是编码失败
+    result = codec_encode_batch(codec, input, batch, packets, 0, frame_sizes, &encoded_size);
+    assert(result == CODEC_BUFFER_TOO_SMALL);
+    
+    free(input);
+    free(decoded);
+    free(packets);
+    codec->vtable->destroy(codec);
+    
+    printf("Opus codec batch test passed!\n\n");
+    return 0;
+}
+
+// 测试按数据包实际时长解码（服务器下发的包长于解码格式声明的帧长）
+int test_opus_codec_packet_duration(void) {
+    printf("Testing Opus packet-aware decoding...\n");
+    
+    // 编码端使用60ms帧，解码端按20ms配置
+    audio_codec_t* encoder = opus_codec_create();
+    audio_codec_t* decoder = opus_codec_create();
+    assert(encoder != NULL && decoder != NULL);
+    
+    audio_format_t long_format;
+    audio_format_init(&long_format, SAMPLE_RATE, CHANNELS, 16, 60);
+    assert(encoder->vtable->init_encoder(encoder, &long_format) == CODEC_SUCCESS);
+    
+    audio_format_t format;
+    audio_format_init(&format, SAMPLE_RATE, CHANNELS, 16, FRAME_SIZE_MS);
+    assert(decoder->vtable->init_decoder(decoder, &format) == CODEC_SUCCESS);
+    
+    const size_t long_samples = SAMPLE_RATE * 60 / 1000 * CHANNELS;
+    int16_t* input = (int16_t*)malloc(long_samples * sizeof(int16_t));
+    int16_t* decoded = (int16_t*)malloc(long_samples * sizeof(int16_t));
+    uint8_t packet[MAX_PACKET_SIZE];
+    assert(input && decoded);
+    generate_test_audio(input, long_samples, 440.0);
+    
+    size_t packet_size = 0;
+    assert(encoder->vtable->encode(encoder, input, long_samples, packet, sizeof(packet), &packet_size) == CODEC_SUCCESS);
+    
+    // 包头给出的时长
+    assert(codec_get_packet_samples(decoder, packet, packet_size) == SAMPLE_RATE * 60 / 1000);
+    
+    // 输出缓冲区只够声明帧长时返回错误，足够时解码整个数据包
+    size_t decoded_size = 0;
+    codec_error_t result = decoder->vtable->decode(decoder, packet, packet_size, decoded, FRAME_SIZE * CHANNELS,
+                                                   &decoded_size);
+    assert(result == CODEC_BUFFER_TOO_SMALL);
+    result = decoder->vtable->decode(decoder, packet, packet_size, decoded, long_samples, &decoded_size);
+    assert(result == CODEC_SUCCESS);
+    assert(decoded_size == long_samples);
+    
+    // 丢包隐藏沿用上一个数据包的时长
+    result = decoder->vtable->decode(decoder, NULL, 0, decoded, long_samples, &decoded_size);
+    assert(result == CODEC_SUCCESS);
+    assert(decoded_size == long_samples);
+    
+    // 无效数据包
+    uint8_t invalid[2] = {0xFF, 0xFF};
+    assert(codec_get_packet_samples(decoder, invalid, sizeof(invalid)) < 0);
+    
+    free(input);
+    free(decoded);
+    encoder->vtable->destroy(encoder);
+    decoder->vtable->destroy(decoder);
+    
+    printf("Opus packet-aware decoding test passed!\n\n");
+    return 0;
+}
+
+// 测试丢包隐藏：有后续数据包时用其带内FEC恢复，否则做PLC
+int test_opus_codec_decode_lost(void) {
+    printf("Testing Opus loss concealment...\n");
+    
+    audio_codec_t* codec = opus_codec_create();
+    assert(codec != NULL);
+    
+    audio_format_t format;
+    audio_format_init(&format, SAMPLE_RATE, CHANNELS, 16, FRAME_SIZE_MS);
+    assert(codec->vtable->init_encoder(codec, &format) == CODEC_SUCCESS);
+    assert(codec->vtable->init_decoder(codec, &format) == CODEC_SUCCESS);
+    assert(opus_codec_set_inband_fec(codec, 1) == CODEC_SUCCESS);
+    assert(opus_codec_set_packet_loss_perc(codec, 20) == CODEC_SUCCESS);
+    
+    int16_t input[FRAME_SIZE];
+    int16_t decoded[FRAME_SIZE * 3];
+    uint8_t packets[3][MAX_PACKET_SIZE];
+    size_t sizes[3];
+    size_t decoded_size = 0;
+    for (int i = 0; i < 3; i++) {
+        generate_test_audio(input, FRAME_SIZE, 440.0);
+        assert(codec->vtable->encode(codec, input, FRAME_SIZE, packets[i], MAX_PACKET_SIZE,
+                                     &sizes[i]) == CODEC_SUCCESS);
+    }
+    
+    // 第二个数据包丢失，用第三个数据包的FEC恢复一帧
+    assert(codec->vtable->decode(codec, packets[0], sizes[0], decoded, FRAME_SIZE, &decoded_size) == CODEC_SUCCESS);
+    assert(codec_decode_lost(codec, packets[2], sizes[2], FRAME_SIZE, decoded, FRAME_SIZE,
+                             &decoded_size) == CODEC_SUCCESS);
+    assert(decoded_size == FRAME_SIZE);
+    assert(codec->vtable->decode(codec, packets[2], sizes[2], decoded, FRAME_SIZE, &decoded_size) == CODEC_SUCCESS);
+    
+    // 没有后续数据包时按请求的时长做PLC
+    assert(codec_decode_lost(codec, NULL, 0, FRAME_SIZE * 2, decoded, FRAME_SIZE * 3,
+                             &decoded_size) == CODEC_SUCCESS);
+    assert(decoded_size == FRAME_SIZE * 2);
+    assert(codec_decode_lost(codec, NULL, 0, FRAME_SIZE * 2, decoded, FRAME_SIZE,
+                             &decoded_size) == CODEC_BUFFER_TOO_SMALL);
+    
+    codec->vtable->destroy(codec);
+    
+    printf("Opus loss concealment test passed!\n\n");
+    return 0;
+}
+
+// 测试编码档位：参数写入编码器，切换应用类型时重建编码器，短帧可正常编码
+int test_opus_codec_profiles(void) {
+    printf("Testing Opus encoder profiles...\n");
+    
+    audio_codec_t* codec = opus_codec_create();
+    assert(codec != NULL);
+    
+    opus_codec_profile_params_t params;
+    assert(opus_codec_get_profile_params(CODEC_PROFILE_DEFAULT, &params));
+    assert(params.bitrate == opus_codec_get_bitrate(codec));
+    assert(params.complexity == opus_codec_get_complexity(codec));
+    assert(!opus_codec_get_profile_params(CODEC_PROFILE_COUNT, &params));
+    assert(opus_codec_set_profile(codec, CODEC_PROFILE_COUNT) == CODEC_INVALID_PARAMETER);
+    
+    assert(opus_codec_set_profile(codec, CODEC_PROFILE_LOW_CPU) == CODEC_SUCCESS);
+    assert(opus_codec_get_complexity(codec) <= 3);
+    assert(opus_codec_get_max_bandwidth(codec) == OPUS_BANDWIDTH_WIDEBAND);
+    
+    // 编码器初始化后切换到低延迟档位
+    audio_format_t format;
+    assert(opus_codec_get_profile_params(CODEC_PROFILE_LOW_LATENCY, &params));
+    audio_format_init(&format, SAMPLE_RATE, CHANNELS, 16, params.frame_duration_ms);
+    assert(codec->vtable->init_encoder(codec, &format) == CODEC_SUCCESS);
+    assert(opus_codec_set_profile(codec, CODEC_PROFILE_LOW_LATENCY) == CODEC_SUCCESS);
+    assert(codec->encoder_initialized);
+    assert(codec->vtable->get_input_frame_size(codec) == SAMPLE_RATE / 100);
+    
+    int16_t input[SAMPLE_RATE / 100];
+    uint8_t packet[MAX_PACKET_SIZE];
+    size_t packet_size = 0;
+    generate_test_audio(input, SAMPLE_RATE / 100, 440.0);
+    assert(codec->vtable->encode(codec, input, SAMPLE_RATE / 100, packet, sizeof(packet),
+                                 &packet_size) == CODEC_SUCCESS);
+    assert(packet_size > 0);
+    
+    // 通过通用接口切换到DTX档位；静音包的实际大小取决于libopus，这里只检查参数
+    codec_profile_params_t common;
+    assert(codec_profile_get_params(CODEC_PROFILE_BANDWIDTH_SAVER, &common));
+    assert(common.use_dtx && common.frame_duration_ms == 60);
+    assert(codec_set_profile(codec, CODEC_PROFILE_BANDWIDTH_SAVER) == CODEC_SUCCESS);
+    assert(opus_codec_get_dtx(codec) == 1);
+    assert(opus_codec_get_bitrate(codec) == common.bitrate);
+    assert(opus_codec_get_max_bandwidth(codec) == OPUS_BANDWIDTH_WIDEBAND);
+    
+    codec->vtable->destroy(codec);
+    
+    printf("Opus encoder profile test passed!\n\n");
+    return 0;
+}
+
+// 测试同一实例的编码与解码格式互不影响
+int test_opus_codec_independent_formats(void) {
+    printf("Testing independent encoder/decoder formats...\n");
+    
+    audio_codec_t* codec = opus_codec_create();
+    assert(codec != NULL);
+    
+    // 上行16kHz编码，下行24kHz解码
+    audio_format_t encoder_format;
+    audio_format_t decoder_format;
+    audio_format_init(&encoder_format, 16000, 1, 16, 20);
+    audio_format_init(&decoder_format, 24000, 1, 16, 60);
+    assert(codec->vtable->init_encoder(codec, &encoder_format) == CODEC_SUCCESS);
+    assert(codec->vtable->init_decoder(codec, &decoder_format) == CODEC_SUCCESS);
+    assert(codec->encoder_format.sample_rate == 16000);
+    assert(codec->decoder_format.sample_rate == 24000);
+    assert(codec->vtable->get_input_frame_size(codec) == 320);
+    
+    int16_t input[320];
+    int16_t decoded[24000 * 60 / 1000];
+    uint8_t packet[MAX_PACKET_SIZE];
+    generate_test_audio(input, 320, 440.0);
+    
+    size_t packet_size = 0;
+    size_t decoded_size = 0;
+    assert(codec->vtable->encode(codec, input, 320, packet, sizeof(packet), &packet_size) == CODEC_SUCCESS);
+    
+    // 20ms 的数据包按解码端 24kHz 输出 480 个样本
+    assert(codec->vtable->decode(codec, packet, packet_size, decoded, 24000 * 60 / 1000,
+                                 &decoded_size) == CODEC_SUCCESS);
+    assert(decoded_size == 480);
+    
+    codec->vtable->destroy(codec);
+    
+    printf("Independent format test passed!\n\n");
+    return 0;
+}
+
 // 测试错误处理
 int test_error_handling(void) {
     printf("Testing error handling...\n");
@@ -277,6 +541,11 @@ int main(void) {
     if (test_opus_codec_basic() != 0) return 1;
     if (test_opus_codec_encode_decode() != 0) return 1;
     if (test_opus_codec_parameters() != 0) return 1;
+    if (test_opus_codec_batch() != 0) return 1;
+    if (test_opus_codec_packet_duration() != 0) return 1;
+    if (test_opus_codec_decode_lost() != 0) return 1;
+    if (test_opus_codec_profiles() != 0) return 1;
+    if (test_opus_codec_independent_formats() != 0) return 1;
     if (test_error_handling() != 0) return 1;
     
     printf("All tests passed successfully!\n");
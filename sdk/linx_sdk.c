@@ -16,6 +16,14 @@
 #include <pthread.h>
 #include <unistd.h>
 
+/**
+ * @brief 事件循环单次最长阻塞时间（毫秒）
+ *
+ * 事件线程阻塞在 mg_mgr_poll 中，套接字事件、上行帧入队和停止请求都会
+ * 立即唤醒它；该值只决定空闲时的兜底唤醒频率。
+ */
+#define LINX_SDK_EVENT_LOOP_MAX_WAIT_MS 1000
+
 // ============================================================================
 // 内部函数声明
 // ============================================================================
@@ -29,10 +37,24 @@ static void _linx_sdk_on_websocket_connected(void* user_data);
 static void _linx_sdk_on_websocket_disconnected(void* user_data);
 static void _linx_sdk_on_websocket_error(const char* error_msg, void* user_data);
 static void _linx_sdk_on_websocket_message(const cJSON* root, void* user_data);
-static void _linx_sdk_on_websocket_audio_data(linx_audio_stream_packet_t* packet, void* user_data);
+static void _linx_sdk_on_websocket_backpressure(bool congested, size_t buffered_bytes, void* user_data);
+
+// 消息路由
+static void _linx_sdk_register_builtin_handlers(LinxSdk* sdk);
+static void _linx_sdk_on_websocket_audio_data(const linx_audio_stream_packet_t* packet, void* user_data);
 
 // 事件处理线程
 static void* _linx_sdk_event_thread(void* arg);
+static void _linx_sdk_stop_event_thread(LinxSdk* sdk);
+
+// 上行PCM编码
+static void _linx_sdk_stop_uplink(LinxSdk* sdk);
+static void _linx_sdk_destroy_protocol(LinxSdk* sdk);
+static int _linx_sdk_uplink_frame_duration(const LinxSdk* sdk);
+
+// 下行解码播放
+static bool _linx_sdk_create_playback(LinxSdk* sdk);
+static void _linx_sdk_configure_playback(LinxSdk* sdk);
 
 // 状态管理函数
 static void _linx_sdk_set_session_id(LinxSdk* sdk, const char* session_id);
@@ -42,7 +64,7 @@ static void _linx_sdk_set_tts_state(LinxSdk* sdk, const char* state);
 // 内部监听控制函数 (预留接口)
 
 // MCP回调函数
-static void _linx_sdk_mcp_send_callback(const char* message);
+static void _linx_sdk_mcp_send_callback(const char* message, void* user_data);
 
 // ============================================================================
 // 核心API函数实现
@@ -102,6 +124,57 @@ LinxSdk* linx_sdk_create(const LinxSdkConfig* config) {
     sdk->tts_state = NULL;
     pthread_mutex_init(&sdk->state_mutex, NULL);
     
+    // 采集时钟从SDK创建时刻开始计时
+    sdk->clock_origin_us = linx_send_queue_now_us();
+    sdk->playback_reported = false;
+    
+    // 初始化消息路由表并注册内置处理函数
+    pthread_mutex_init(&sdk->router_mutex, NULL);
+    pthread_mutex_init(&sdk->uplink_mutex, NULL);
+    linx_message_router_init(&sdk->message_router);
+    _linx_sdk_register_builtin_handlers(sdk);
+    
+    // 创建下行抖动缓冲（如果启用，SDK解码播放时必须启用）
+    sdk->jitter_buffer = NULL;
+    if (sdk->config.playback_device) {
+        sdk->config.playback_enabled = true;
+    }
+    if (sdk->config.jitter_buffer_max_ms > 0 || sdk->config.playback_enabled) {
+        jitter_buffer_config_t jb_config;
+        jitter_buffer_config_default(&jb_config);
+        jb_config.min_delay_ms = sdk->config.jitter_buffer_min_ms;
+        if (sdk->config.jitter_buffer_max_ms > 0) {
+            jb_config.max_delay_ms = sdk->config.jitter_buffer_max_ms;
+        }
+        // 服务器常以快于实时的速度下发TTS，槽位按最大深度的数倍预留
+        size_t capacity = jb_config.max_delay_ms * 4 / jb_config.frame_duration_ms + 8;
+        if (capacity > jb_config.capacity) {
+            jb_config.capacity = capacity;
+        }
+        // 只有协议v2的下行帧携带时间戳，其余版本按到达顺序编号
+        jb_config.timestamped = sdk->config.protocol_version == 2;
+        sdk->jitter_buffer = jitter_buffer_create(&jb_config);
+        if (!sdk->jitter_buffer) {
+            LOG_ERROR("抖动缓冲创建失败");
+            pthread_mutex_destroy(&sdk->state_mutex);
+            pthread_mutex_destroy(&sdk->router_mutex);
+            pthread_mutex_destroy(&sdk->uplink_mutex);
+            free(sdk);
+            return NULL;
+        }
+    }
+    
+    // 创建下行解码器与播放器（如果启用）
+    if (sdk->config.playback_enabled && !_linx_sdk_create_playback(sdk)) {
+        LOG_ERROR("下行播放器创建失败");
+        jitter_buffer_destroy(sdk->jitter_buffer);
+        pthread_mutex_destroy(&sdk->state_mutex);
+        pthread_mutex_destroy(&sdk->router_mutex);
+        pthread_mutex_destroy(&sdk->uplink_mutex);
+        free(sdk);
+        return NULL;
+    }
+    
     // 初始化MCP相关字段
     sdk->mcp_server = NULL;
 
@@ -113,7 +186,8 @@ LinxSdk* linx_sdk_create(const LinxSdkConfig* config) {
         LOG_WARN("MCP服务器创建失败");
     } else {
         // 设置MCP消息发送回调
-        mcp_server_set_send_callback(_linx_sdk_mcp_send_callback);
+        mcp_server_set_reply_callback(sdk->mcp_server, _linx_sdk_mcp_send_callback, sdk);
+        sdk->mcp_enabled = true;
         LOG_INFO("MCP服务器创建成功");
     }
     
@@ -130,17 +204,23 @@ void linx_sdk_destroy(LinxSdk* sdk) {
         linx_sdk_disconnect(sdk);
     }
     
-    // 停止事件处理线程
-    if (sdk->event_thread_running) {
-        sdk->event_thread_running = false;
-        pthread_join(sdk->event_thread, NULL);
+    // 停止事件处理线程与上行编码线程
+    _linx_sdk_stop_event_thread(sdk);
+    _linx_sdk_stop_uplink(sdk);
+    
+    // 清理下行播放器：播放线程会通过linx_sdk_mark_playback()使用WebSocket协议，
+    // 必须先于协议销毁停止，也要先于其读取的抖动缓冲释放
+    if (sdk->downlink_player) {
+        downlink_player_destroy(sdk->downlink_player);
+        sdk->downlink_player = NULL;
+    }
+    if (sdk->downlink_codec) {
+        codec_factory_destroy(sdk->downlink_codec);
+        sdk->downlink_codec = NULL;
     }
     
     // 清理WebSocket协议
-    if (sdk->ws_protocol) {
-        linx_websocket_destroy((linx_protocol_t*)sdk->ws_protocol);
-        sdk->ws_protocol = NULL;
-    }
+    _linx_sdk_destroy_protocol(sdk);
     
     // 清理MCP服务器
     if (sdk->mcp_server) {
@@ -148,6 +228,22 @@ void linx_sdk_destroy(LinxSdk* sdk) {
         sdk->mcp_server = NULL;
     }
     
+    // 清理抖动缓冲
+    if (sdk->jitter_buffer) {
+        jitter_buffer_destroy(sdk->jitter_buffer);
+        sdk->jitter_buffer = NULL;
+    }
+    
+    // 清理上行编码器
+    if (sdk->uplink_codec) {
+        codec_factory_destroy(sdk->uplink_codec);
+        sdk->uplink_codec = NULL;
+    }
+    if (sdk->bitrate_controller) {
+        bitrate_controller_destroy(sdk->bitrate_controller);
+        sdk->bitrate_controller = NULL;
+    }
+    
     // 清理字符串资源
     if (sdk->session_id) {
         free(sdk->session_id);
@@ -161,6 +257,8 @@ void linx_sdk_destroy(LinxSdk* sdk) {
     
     // 销毁互斥锁
     pthread_mutex_destroy(&sdk->state_mutex);
+    pthread_mutex_destroy(&sdk->router_mutex);
+    pthread_mutex_destroy(&sdk->uplink_mutex);
     
     LOG_INFO("LinxSDK实例已销毁");
     
@@ -194,8 +292,18 @@ LinxSdkError linx_sdk_connect(LinxSdk* sdk) {
         return LINX_SDK_ERROR_NOT_INITIALIZED;
     }
     
-    if (sdk->connected) {
-        return LINX_SDK_SUCCESS;
+    if (sdk->ws_protocol) {
+        // 已连接、握手进行中或正在自动重连时无需重复连接，也不能拆掉进行中的连接
+        if (sdk->connected || linx_websocket_has_connection(sdk->ws_protocol) ||
+            linx_websocket_is_reconnecting(sdk->ws_protocol)) {
+            LOG_DEBUG("连接已建立或正在进行，忽略重复连接请求");
+            return LINX_SDK_SUCCESS;
+        }
+        // 上一次连接已断开且不会重连，先回收旧的事件线程与连接实例；
+        // 播放线程仍在运行，协议实例经_linx_sdk_destroy_protocol()摘下后再销毁
+        _linx_sdk_stop_event_thread(sdk);
+        _linx_sdk_stop_uplink(sdk);
+        _linx_sdk_destroy_protocol(sdk);
     }
     
     _linx_sdk_set_state(sdk, LINX_DEVICE_STATE_CONNECTING);
@@ -209,16 +317,38 @@ LinxSdkError linx_sdk_connect(LinxSdk* sdk) {
         return LINX_SDK_ERROR_INVALID_PARAM;
     }
     
+    // 只有v2的二进制头携带时间戳，其他版本服务器无法对齐回声参考
+    if (sdk->config.listening_mode == LINX_LISTENING_MODE_REALTIME && sdk->config.protocol_version != 2) {
+        LOG_WARN("实时监听模式需要协议v2传递采集时间戳，当前为v%u", sdk->config.protocol_version);
+    }
+    
     // 创建WebSocket协议实例
     linx_websocket_config_t ws_config = {
         .url = sdk->config.server_url,
         .auth_token = strlen(sdk->config.auth_token) > 0 ? sdk->config.auth_token : NULL,
         .device_id = strlen(sdk->config.device_id) > 0 ? sdk->config.device_id : NULL,
         .client_id = strlen(sdk->config.client_id) > 0 ? sdk->config.client_id : NULL,
-        .protocol_version = sdk->config.protocol_version > 0 ? sdk->config.protocol_version : 1
+        .protocol_version = sdk->config.protocol_version > 0 ? sdk->config.protocol_version : 1,
+        .auto_reconnect = sdk->config.auto_reconnect,
+        .reconnect_base_ms = sdk->config.reconnect_base_ms,
+        .reconnect_max_ms = sdk->config.reconnect_max_ms,
+        .reconnect_max_attempts = (int)sdk->config.reconnect_max_attempts,
+        .ping_interval_ms = sdk->config.ping_interval_ms,
+        .idle_timeout_ms = sdk->config.idle_timeout_ms,
+        .send_buffer_limit = sdk->config.send_buffer_limit,
+        .backpressure_policy = sdk->config.backpressure_policy,
+        .server_aec = sdk->config.listening_mode == LINX_LISTENING_MODE_REALTIME,
+        .audio_batch_frames = (int)sdk->config.audio_batch_frames,
+        .audio_batch_delay_ms = sdk->config.audio_batch_delay_ms,
+        .audio_frame_duration = (uint32_t)_linx_sdk_uplink_frame_duration(sdk),
+        .runtime = sdk->config.runtime,
+        .shard = LINX_RUNTIME_AUTO_SHARD
     };
     
-    sdk->ws_protocol = linx_websocket_protocol_create(&ws_config);
+    linx_websocket_protocol_t* protocol = linx_websocket_protocol_create(&ws_config);
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    sdk->ws_protocol = protocol;
+    pthread_mutex_unlock(&sdk->uplink_mutex);
     if (!sdk->ws_protocol) {
         _linx_sdk_set_error(sdk, "WebSocket协议创建失败", LINX_SDK_ERROR_NETWORK);
         _linx_sdk_set_state(sdk, LINX_DEVICE_STATE_ERROR);
@@ -232,6 +362,7 @@ LinxSdkError linx_sdk_connect(LinxSdk* sdk) {
         .on_network_error = _linx_sdk_on_websocket_error,
         .on_incoming_json = _linx_sdk_on_websocket_message,
         .on_incoming_audio = _linx_sdk_on_websocket_audio_data,
+        .on_backpressure = _linx_sdk_on_websocket_backpressure,
         .user_data = sdk
     };
     linx_protocol_set_callbacks((linx_protocol_t*)sdk->ws_protocol, &callbacks);
@@ -240,19 +371,23 @@ LinxSdkError linx_sdk_connect(LinxSdk* sdk) {
     if (!linx_websocket_start((linx_protocol_t*)sdk->ws_protocol)) {
         _linx_sdk_set_error(sdk, "WebSocket连接启动失败", LINX_SDK_ERROR_NETWORK);
         _linx_sdk_set_state(sdk, LINX_DEVICE_STATE_ERROR);
-        linx_websocket_destroy((linx_protocol_t*)sdk->ws_protocol);
-        sdk->ws_protocol = NULL;
+        _linx_sdk_destroy_protocol(sdk);
         return LINX_SDK_ERROR_NETWORK;
     }
     
+    // 挂载到运行时的连接由分片线程驱动，无需独立的事件线程
+    if (sdk->config.runtime) {
+        LOG_INFO("WebSocket连接启动成功(运行时分片 %d)，等待连接建立...", sdk->ws_protocol->shard);
+        return LINX_SDK_SUCCESS;
+    }
+    
     // 启动事件处理线程
     sdk->event_thread_running = true;
     if (pthread_create(&sdk->event_thread, NULL, _linx_sdk_event_thread, sdk) != 0) {
         _linx_sdk_set_error(sdk, "事件处理线程创建失败", LINX_SDK_ERROR_UNKNOWN);
         _linx_sdk_set_state(sdk, LINX_DEVICE_STATE_ERROR);
         sdk->event_thread_running = false;
-        linx_websocket_destroy((linx_protocol_t*)sdk->ws_protocol);
-        sdk->ws_protocol = NULL;
+        _linx_sdk_destroy_protocol(sdk);
         return LINX_SDK_ERROR_UNKNOWN;
     }
     
@@ -269,17 +404,16 @@ LinxSdkError linx_sdk_disconnect(LinxSdk* sdk) {
         return LINX_SDK_ERROR_NOT_INITIALIZED;
     }
     
-    if (!sdk->connected) {
+    // 连接断开但仍在自动重连时，事件线程与连接实例同样需要回收
+    if (!sdk->ws_protocol) {
         return LINX_SDK_SUCCESS;
     }
     
     LOG_INFO("正在断开连接...");
     
-    // 停止事件处理线程
-    if (sdk->event_thread_running) {
-        sdk->event_thread_running = false;
-        pthread_join(sdk->event_thread, NULL);
-    }
+    // 停止事件处理线程与上行编码线程
+    _linx_sdk_stop_event_thread(sdk);
+    _linx_sdk_stop_uplink(sdk);
     
     // 停止WebSocket连接
     if (sdk->ws_protocol) {
@@ -288,6 +422,8 @@ LinxSdkError linx_sdk_disconnect(LinxSdk* sdk) {
     
     sdk->connected = false;
     sdk->connect_time = 0;
+    jitter_buffer_reset(sdk->jitter_buffer);
+    downlink_player_reset(sdk->downlink_player);
     _linx_sdk_set_state(sdk, LINX_DEVICE_STATE_IDLE);
     
     LOG_INFO("连接已断开");
@@ -320,6 +456,18 @@ LinxSdkError linx_sdk_send_text(LinxSdk* sdk, const char* text) {
 }
 
 LinxSdkError linx_sdk_send_audio(LinxSdk* sdk, const uint8_t* data, size_t size) {
+    return linx_sdk_send_audio_with_timestamp(sdk, data, size, linx_sdk_get_clock_ms(sdk));
+}
+
+uint32_t linx_sdk_get_clock_ms(LinxSdk* sdk) {
+    if (!sdk) {
+        return 0;
+    }
+    
+    return (uint32_t)((linx_send_queue_now_us() - sdk->clock_origin_us) / 1000);
+}
+
+LinxSdkError linx_sdk_send_audio_with_timestamp(LinxSdk* sdk, const uint8_t* data, size_t size, uint32_t capture_ms) {
     if (!sdk || !data || size == 0) {
         return LINX_SDK_ERROR_INVALID_PARAM;
     }
@@ -334,8 +482,9 @@ LinxSdkError linx_sdk_send_audio(LinxSdk* sdk, const uint8_t* data, size_t size)
     
     LOG_DEBUG("发送音频数据: %zu 字节", size);
     
-    // 创建音频数据包并发送
+    // 创建音频数据包并发送，时间戳为采集时钟，供服务器对齐回声参考
     linx_audio_stream_packet_t packet = {
+        .timestamp = capture_ms,
         .payload = (uint8_t*)data,
         .payload_size = size
     };
@@ -347,6 +496,253 @@ LinxSdkError linx_sdk_send_audio(LinxSdk* sdk, const uint8_t* data, size_t size)
     return LINX_SDK_SUCCESS;
 }
 
+// 码率表的复杂度与带宽不超过编码档位的设置
+static void _linx_sdk_apply_bitrate_level(LinxSdk* sdk, const bitrate_level_t* level) {
+    codec_profile_params_t profile;
+    codec_profile_get_params(sdk->config.encoder_profile, &profile);
+    int bandwidth_hz = level->bandwidth_hz < profile.max_bandwidth_hz ? level->bandwidth_hz
+                                                                      : profile.max_bandwidth_hz;
+    codec_set_bitrate(sdk->uplink_codec, level->bitrate);
+    codec_set_complexity(sdk->uplink_codec, level->complexity < profile.complexity ? level->complexity
+                                                                                 : profile.complexity);
+    codec_set_max_bandwidth(sdk->uplink_codec, bandwidth_hz);
+}
+
+// 每个评估周期汇总发送队列、丢帧与RTT反馈；在编码线程上调用，与编码互不冲突
+static void _linx_sdk_adapt_bitrate(LinxSdk* sdk) {
+    uint64_t now_ms = linx_send_queue_now_us() / 1000;
+    if (!bitrate_controller_is_due(sdk->bitrate_controller, now_ms)) {
+        return;
+    }
+    
+    LinxSdkSendStats send;
+    LinxSdkRttStats rtt;
+    linx_websocket_get_send_stats(sdk->ws_protocol, &send);
+    linx_websocket_get_rtt_stats(sdk->ws_protocol, &rtt);
+    bitrate_controller_input_t input = {
+        .queue_depth = send.queue_depth,
+        .congested = send.congested,
+        .dropped_frames = send.dropped_oldest + send.dropped_newest + sdk->uplink_sink_drops,
+        .rtt_samples = rtt.pongs_received,
+        .rtt_us = rtt.last_us,
+        .rtt_min_us = rtt.min_us
+    };
+    
+    bitrate_level_t level;
+    if (bitrate_controller_update(sdk->bitrate_controller, now_ms, &input, &level)) {
+        _linx_sdk_apply_bitrate_level(sdk, &level);
+    }
+}
+
+static void* _linx_sdk_uplink_reserve(void* user_data, size_t size, uint8_t** buffer) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    if (sdk->bitrate_controller) {
+        _linx_sdk_adapt_bitrate(sdk);
+    }
+    linx_send_frame_t* frame = linx_websocket_reserve_audio(sdk->ws_protocol, size);
+    if (frame) {
+        *buffer = frame->data;
+    } else {
+        sdk->uplink_sink_drops++;
+    }
+    return frame;
+}
+
+static bool _linx_sdk_uplink_commit(void* user_data, void* handle, size_t size, uint32_t timestamp) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    return linx_websocket_commit_audio(sdk->ws_protocol, (linx_send_frame_t*)handle, size, timestamp);
+}
+
+// Opus可直接编解码的采样率，其余采样率需经重采样
+static bool _linx_sdk_is_codec_rate(int sample_rate) {
+    return sample_rate == 8000 || sample_rate == 12000 || sample_rate == 16000 ||
+           sample_rate == 24000 || sample_rate == 48000;
+}
+
+// 上行帧时长由编码档位决定，同时写入hello的audio_params
+static int _linx_sdk_uplink_frame_duration(const LinxSdk* sdk) {
+    codec_profile_params_t profile;
+    if (!codec_profile_get_params(sdk->config.encoder_profile, &profile)) {
+        return LINX_WEBSOCKET_AUDIO_FRAME_DURATION;
+    }
+    return profile.frame_duration_ms;
+}
+
+// 首次发送PCM时创建编码器并启动编码线程，调用方持有uplink_mutex
+static LinxSdkError _linx_sdk_start_uplink(LinxSdk* sdk) {
+    // 采集采样率Opus不支持时（如44.1kHz）按hello声明的采样率编码，SDK内部重采样
+    int input_rate = (int)sdk->config.sample_rate;
+    int codec_rate = _linx_sdk_is_codec_rate(input_rate) ? input_rate : LINX_WEBSOCKET_AUDIO_SAMPLE_RATE;
+    int frame_duration = _linx_sdk_uplink_frame_duration(sdk);
+    if (!sdk->uplink_codec) {
+        audio_codec_t* codec = codec_factory_create(CODEC_TYPE_OPUS);
+        if (!codec) {
+            LOG_ERROR("上行编码器创建失败");
+            return LINX_SDK_ERROR_MEMORY;
+        }
+        if (codec_set_profile(codec, sdk->config.encoder_profile) != CODEC_SUCCESS) {
+            LOG_ERROR("不支持的上行编码档位: %d", (int)sdk->config.encoder_profile);
+            codec_factory_destroy(codec);
+            return LINX_SDK_ERROR_INVALID_PARAM;
+        }
+        audio_format_t format;
+        audio_format_init(&format, codec_rate, sdk->config.channels, 16, frame_duration);
+        if (codec->vtable->init_encoder(codec, &format) != CODEC_SUCCESS) {
+            LOG_ERROR("上行编码器初始化失败: %u Hz, %u 声道", sdk->config.sample_rate, sdk->config.channels);
+            codec_factory_destroy(codec);
+            return LINX_SDK_ERROR_INVALID_PARAM;
+        }
+        sdk->uplink_codec = codec;
+    }
+    
+    if (sdk->config.adaptive_bitrate) {
+        if (!sdk->bitrate_controller) {
+            // 不超过编码档位的码率；积压阈值按帧时长换算，约240ms积压视为拥塞
+            bitrate_controller_config_t controller_config = {
+                .max_bitrate = codec_get_bitrate(sdk->uplink_codec),
+                .initial_level = SIZE_MAX,
+                .queue_high = (size_t)(frame_duration < 60 ? 240 / frame_duration : 4),
+                .queue_low = (size_t)(frame_duration < 60 ? 60 / frame_duration : 1)
+            };
+            sdk->bitrate_controller = bitrate_controller_create(&controller_config);
+            if (!sdk->bitrate_controller) {
+                LOG_ERROR("上行码率控制器创建失败");
+                return LINX_SDK_ERROR_MEMORY;
+            }
+            bitrate_level_t level = bitrate_controller_get_level(sdk->bitrate_controller);
+            _linx_sdk_apply_bitrate_level(sdk, &level);
+        }
+        // 新连接的发送统计从零开始，保留档位但重建基线
+        bitrate_controller_reset(sdk->bitrate_controller);
+    }
+    
+    uplink_encoder_sink_t sink = {
+        .reserve = _linx_sdk_uplink_reserve,
+        .commit = _linx_sdk_uplink_commit,
+        .user_data = sdk
+    };
+    // 环形缓冲按时长而不是帧数保持默认容量，短帧时不因采集块较大而丢样本
+    size_t ring_frames = (size_t)(UPLINK_ENCODER_DEFAULT_RING_FRAMES * LINX_WEBSOCKET_AUDIO_FRAME_DURATION / frame_duration);
+    sdk->uplink_encoder = uplink_encoder_create(sdk->uplink_codec, ring_frames, LINX_SDK_PCM_MAX_PACKET_SIZE, &sink);
+    if (!sdk->uplink_encoder) {
+        LOG_ERROR("上行编码线程启动失败");
+        return LINX_SDK_ERROR_MEMORY;
+    }
+    if (!uplink_encoder_set_input_rate(sdk->uplink_encoder, input_rate)) {
+        LOG_ERROR("上行重采样创建失败: %d -> %d Hz", input_rate, codec_rate);
+        uplink_encoder_destroy(sdk->uplink_encoder);
+        sdk->uplink_encoder = NULL;
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    return LINX_SDK_SUCCESS;
+}
+
+// 连接实例被停止或销毁前调用，未编码的样本随编码线程一起丢弃
+static void _linx_sdk_stop_uplink(LinxSdk* sdk) {
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    if (sdk->uplink_encoder) {
+        uplink_encoder_destroy(sdk->uplink_encoder);
+        sdk->uplink_encoder = NULL;
+    }
+    pthread_mutex_unlock(&sdk->uplink_mutex);
+}
+
+// 销毁连接实例：先在uplink_mutex下摘下指针，播放线程上报播放对齐时同样持有该锁，
+// 解锁后不会再有线程使用旧实例
+static void _linx_sdk_destroy_protocol(LinxSdk* sdk) {
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    linx_websocket_protocol_t* protocol = sdk->ws_protocol;
+    sdk->ws_protocol = NULL;
+    pthread_mutex_unlock(&sdk->uplink_mutex);
+    
+    if (protocol) {
+        linx_websocket_destroy((linx_protocol_t*)protocol);
+    }
+}
+
+LinxSdkError linx_sdk_send_pcm(LinxSdk* sdk, const int16_t* pcm, size_t samples) {
+    if (!sdk || !pcm || samples == 0) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->initialized) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    if (!sdk->connected) {
+        return LINX_SDK_ERROR_NETWORK;
+    }
+    
+    // 块首采样的采集时刻：函数在采集回调之后调用，当前时刻对应块尾
+    uint32_t rate = sdk->config.sample_rate * sdk->config.channels;
+    uint32_t capture_ms = linx_sdk_get_clock_ms(sdk) - (uint32_t)((uint64_t)samples * 1000 / rate);
+    
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    LinxSdkError result = LINX_SDK_SUCCESS;
+    if (!sdk->uplink_encoder && sdk->ws_protocol) {
+        result = _linx_sdk_start_uplink(sdk);
+    }
+    if (result == LINX_SDK_SUCCESS) {
+        if (!sdk->uplink_encoder) {
+            result = LINX_SDK_ERROR_NETWORK;
+        } else if (uplink_encoder_write(sdk->uplink_encoder, pcm, samples, capture_ms) < samples) {
+            result = LINX_SDK_ERROR_NETWORK;
+        }
+    }
+    pthread_mutex_unlock(&sdk->uplink_mutex);
+    
+    return result;
+}
+
+LinxSdkError linx_sdk_mark_playback(LinxSdk* sdk, uint32_t timestamp) {
+    if (!sdk) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->connected) {
+        return LINX_SDK_ERROR_NETWORK;
+    }
+    
+    // 播放对齐只服务于服务器端回声消除，hello中未声明features.aec时服务器不认识该消息
+    if (sdk->config.listening_mode != LINX_LISTENING_MODE_REALTIME) {
+        return LINX_SDK_SUCCESS;
+    }
+    
+    uint32_t played_at = linx_sdk_get_clock_ms(sdk);
+    int64_t offset = (int64_t)played_at - (int64_t)timestamp;
+    
+    // 播放延迟稳定时不重复上报，只在每轮首帧和漂移超过阈值时发送
+    pthread_mutex_lock(&sdk->state_mutex);
+    int64_t drift = offset - sdk->playback_offset_ms;
+    bool report = !sdk->playback_reported || drift > LINX_SDK_PLAYBACK_SYNC_MS || drift < -LINX_SDK_PLAYBACK_SYNC_MS;
+    if (report) {
+        sdk->playback_reported = true;
+        sdk->playback_offset_ms = offset;
+    }
+    pthread_mutex_unlock(&sdk->state_mutex);
+    
+    if (!report) {
+        return LINX_SDK_SUCCESS;
+    }
+    
+    // 播放线程与重新连接并发，持有uplink_mutex期间连接实例不会被销毁
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    bool sent = false;
+    if (sdk->ws_protocol) {
+        const char* session_id = linx_protocol_get_session_id((linx_protocol_t*)sdk->ws_protocol);
+        char message[192];
+        snprintf(message, sizeof(message),
+                 "{\"session_id\":\"%s\",\"type\":\"playback\",\"timestamp\":%u,\"played_at\":%u}",
+                 session_id ? session_id : "", timestamp, played_at);
+        LOG_DEBUG("上报播放对齐: 下行时间戳 %u, 播放时刻 %u", timestamp, played_at);
+        // 不是控制指令，走MCP/文本通道，不插到abort、listen之前
+        sent = linx_protocol_send_text((linx_protocol_t*)sdk->ws_protocol, message, LINX_SEND_PRIORITY_MCP);
+    }
+    pthread_mutex_unlock(&sdk->uplink_mutex);
+    
+    return sent ? LINX_SDK_SUCCESS : LINX_SDK_ERROR_NETWORK;
+}
+
 LinxDeviceState linx_sdk_get_state(LinxSdk* sdk) {
     if (!sdk) {
         return LINX_DEVICE_STATE_ERROR;
@@ -539,8 +935,9 @@ static void _linx_sdk_on_websocket_connected(void* user_data) {
  * 
  * @note 该函数在WebSocket线程上下文中被调用
  * @note 如果user_data为NULL，函数会安全返回
- * @note 断开连接后设备状态会自动切换到LINX_DEVICE_STATE_DISCONNECTED
- * @note 应用程序应该监听此事件以处理重连逻辑
+ * @note 启用auto_reconnect且已安排重连时，设备状态切换到LINX_DEVICE_STATE_CONNECTING，
+ *       否则切换到LINX_DEVICE_STATE_DISCONNECTED
+ * @note 未启用auto_reconnect时，应用程序应该监听此事件以处理重连逻辑
  * 
  * @see LINX_EVENT_WEBSOCKET_DISCONNECTED
  * @see LINX_DEVICE_STATE_DISCONNECTED
@@ -551,7 +948,10 @@ static void _linx_sdk_on_websocket_disconnected(void* user_data) {
     if (!sdk) return;
     
     sdk->connected = false;
-    _linx_sdk_set_state(sdk, LINX_DEVICE_STATE_DISCONNECTED);
+    
+    // 已安排自动重连时保持连接中状态，否则视为最终断开
+    bool reconnecting = linx_websocket_is_reconnecting(sdk->ws_protocol);
+    _linx_sdk_set_state(sdk, reconnecting ? LINX_DEVICE_STATE_CONNECTING : LINX_DEVICE_STATE_DISCONNECTED);
     
     // 触发断开连接事件
     LinxEvent event = {
@@ -566,6 +966,41 @@ static void _linx_sdk_on_websocket_disconnected(void* user_data) {
     LOG_INFO("WebSocket连接已断开");
 }
 
+/**
+ * @brief WebSocket上行拥塞回调函数
+ * 
+ * 发送缓冲区积压超过send_buffer_limit时以congested=true调用，
+ * 回落到上限一半以下时以congested=false调用，转发为LINX_EVENT_BACKPRESSURE事件。
+ * 
+ * @param congested 是否进入拥塞
+ * @param buffered_bytes 当前积压字节数
+ * @param user_data 用户数据指针，应该指向LinxSdk实例
+ * 
+ * @note 该函数在WebSocket线程上下文中被调用
+ * @note LINX_BACKPRESSURE_LOWER_BITRATE策略下应用应在收到拥塞事件后降低编码码率；
+ *       启用adaptive_bitrate时linx_sdk_send_pcm的编码器由SDK自动降档
+ * 
+ * @see LINX_EVENT_BACKPRESSURE
+ * @see linx_sdk_get_send_stats
+ */
+static void _linx_sdk_on_websocket_backpressure(bool congested, size_t buffered_bytes, void* user_data) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    if (!sdk) return;
+    
+    LinxEvent event = {
+        .type = LINX_EVENT_BACKPRESSURE,
+        .timestamp = time(NULL),
+        .data.backpressure = {
+            .congested = congested,
+            .buffered_bytes = buffered_bytes
+        }
+    };
+    
+    if (sdk->event_callback) {
+        sdk->event_callback(&event, sdk->user_data);
+    }
+}
+
 /**
  * @brief WebSocket错误回调函数
  * 
@@ -591,129 +1026,272 @@ static void _linx_sdk_on_websocket_error(const char* error_msg, void* user_data)
     _linx_sdk_set_error(sdk, error_msg, LINX_SDK_ERROR_WEBSOCKET);
 }
 
+/**
+ * @brief WebSocket消息回调函数
+ * 
+ * 接收协议层已解析的JSON消息，按 type/state 通过消息路由表分发给
+ * 已注册的处理函数。没有处理函数的消息被直接丢弃，不产生日志。
+ * 
+ * @param root 已解析的消息，仅在回调期间有效
+ * @param user_data 用户数据指针，应该指向LinxSdk实例
+ * 
+ * @note 该函数在WebSocket线程上下文中被调用
+ * @note 只在查找处理函数时持有 router_mutex，调用前释放，处理函数（及其触发的
+ *       事件回调）中可以注册或注销处理函数；因此注销返回后已取出的处理函数
+ *       仍可能执行，user_data须存活到SDK销毁
+ * 
+ * @see linx_message_router_lookup
+ * @see linx_sdk_register_message_handler
+ */
 static void _linx_sdk_on_websocket_message(const cJSON* root, void* user_data) {
     LinxSdk* sdk = (LinxSdk*)user_data;
     if (!sdk || !root) return;
     
-    char* json_string = cJSON_Print(root);
-    if (!json_string) return;
+    // 只记录消息类型：SDK默认以调试级别运行，每条消息序列化整棵树会拖慢接收路径
+    const cJSON* type = cJSON_GetObjectItem(root, "type");
+    LOG_DEBUG("收到WebSocket消息: %s", cJSON_IsString(type) ? type->valuestring : "(无type)");
     
-    LOG_DEBUG("收到WebSocket消息: %s", json_string);
+    linx_message_handler_t handler = NULL;
+    void* handler_data = NULL;
+    pthread_mutex_lock(&sdk->router_mutex);
+    bool found = linx_message_router_lookup(&sdk->message_router, root, &handler, &handler_data);
+    pthread_mutex_unlock(&sdk->router_mutex);
     
-    // 获取消息类型
-    const cJSON* type = cJSON_GetObjectItem(root, "type");
-    if (!type || !cJSON_IsString(type)) {
-        LOG_ERROR("消息类型缺失或无效");
-        free(json_string);
+    if (found) {
+        handler(root, handler_data);
+    }
+}
+
+// ============================================================================
+// 内置消息处理函数
+// ============================================================================
+
+/**
+ * @brief 处理服务器hello消息：记录会话ID并自动开始监听
+ */
+static void _linx_sdk_handle_hello(const cJSON* root, void* user_data) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    
+    const cJSON* session_id = cJSON_GetObjectItem(root, "session_id");
+    if (!session_id || !cJSON_IsString(session_id)) {
         return;
     }
     
-    // 处理hello响应
-    if (strcmp(type->valuestring, "hello") == 0) {
-        const cJSON* session_id = cJSON_GetObjectItem(root, "session_id");
-        if (session_id && cJSON_IsString(session_id)) {
-            _linx_sdk_set_session_id(sdk, session_id->valuestring);
-            LOG_INFO("会话建立，ID: %s", session_id->valuestring);
-            
-            // 触发会话建立事件
-            LinxEvent event = {
-                .type = LINX_EVENT_SESSION_ESTABLISHED,
-                .timestamp = time(NULL),
-                .data.session_established = {
-                    .session_id = session_id->valuestring
-                }
-            };
-            
-            if (sdk->event_callback) {
-                sdk->event_callback(&event, sdk->user_data);
-            }
-            
-            // 自动开始监听（如果配置了音频通道）
-            _linx_sdk_set_listen_state(sdk, "start");
-            linx_protocol_send_start_listening((linx_protocol_t*)sdk->ws_protocol, sdk->config.listening_mode);
-            LOG_INFO("开始语音监听");
-            
-            // 触发监听开始事件
-            LinxEvent listen_event = {
-                .type = LINX_EVENT_LISTENING_STARTED,
-                .timestamp = time(NULL)
-            };
-            
-            if (sdk->event_callback) {
-                sdk->event_callback(&listen_event, sdk->user_data);
-            }
+    _linx_sdk_set_session_id(sdk, session_id->valuestring);
+    LOG_INFO("会话建立，ID: %s", session_id->valuestring);
+    
+    // 按服务器audio_params重新配置下行解码器
+    _linx_sdk_configure_playback(sdk);
+    
+    // 触发会话建立事件
+    LinxEvent event = {
+        .type = LINX_EVENT_SESSION_ESTABLISHED,
+        .timestamp = time(NULL),
+        .data.session_established = {
+            .session_id = session_id->valuestring
         }
+    };
+    
+    if (sdk->event_callback) {
+        sdk->event_callback(&event, sdk->user_data);
     }
-    // 处理TTS状态
-    else if (strcmp(type->valuestring, "tts") == 0) {
-        const cJSON* state = cJSON_GetObjectItem(root, "state");
-        if (state && cJSON_IsString(state)) {
-            _linx_sdk_set_tts_state(sdk, state->valuestring);
-            LOG_INFO("TTS状态: %s", state->valuestring);
-            
-            if (strcmp(state->valuestring, "start") == 0) {
-                // TTS开始播放，停止监听避免回音
-                _linx_sdk_set_listen_state(sdk, "stop");
-                if (sdk->ws_protocol) {
-                    linx_protocol_send_stop_listening((linx_protocol_t*)sdk->ws_protocol);
-                }
-                LOG_INFO("停止监听（TTS播放中）");
-                
-                // 触发TTS开始事件
-                LinxEvent event = {
-                    .type = LINX_EVENT_TTS_STARTED,
-                    .timestamp = time(NULL)
-                };
-                
-                if (sdk->event_callback) {
-                    sdk->event_callback(&event, sdk->user_data);
-                }
-            } else if (strcmp(state->valuestring, "stop") == 0) {
-                // TTS播放结束，重新开始监听
-                _linx_sdk_set_listen_state(sdk, "start");
-                if (sdk->ws_protocol) {
-                    linx_protocol_send_start_listening((linx_protocol_t*)sdk->ws_protocol, sdk->config.listening_mode);
-                }
-                LOG_INFO("恢复语音监听");
-                
-                // 触发TTS停止事件
-                LinxEvent event = {
-                    .type = LINX_EVENT_TTS_STOPPED,
-                    .timestamp = time(NULL)
-                };
-                
-                if (sdk->event_callback) {
-                    sdk->event_callback(&event, sdk->user_data);
-                }
-            }
+    
+    // 自动开始监听（如果配置了音频通道）
+    _linx_sdk_set_listen_state(sdk, "start");
+    linx_protocol_send_start_listening((linx_protocol_t*)sdk->ws_protocol, sdk->config.listening_mode);
+    LOG_INFO("开始语音监听");
+    
+    // 触发监听开始事件
+    LinxEvent listen_event = {
+        .type = LINX_EVENT_LISTENING_STARTED,
+        .timestamp = time(NULL)
+    };
+    
+    if (sdk->event_callback) {
+        sdk->event_callback(&listen_event, sdk->user_data);
+    }
+}
+
+/**
+ * @brief 处理tts消息中未单独注册的状态（如 sentence_end），仅记录状态
+ */
+static void _linx_sdk_handle_tts(const cJSON* root, void* user_data) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    
+    const cJSON* state = cJSON_GetObjectItem(root, "state");
+    if (state && cJSON_IsString(state)) {
+        _linx_sdk_set_tts_state(sdk, state->valuestring);
+    }
+}
+
+/**
+ * @brief 处理 tts/start：TTS开始播放，停止监听避免回音
+ * 
+ * 实时监听模式下由服务器根据播放对齐消息做回声消除，播放期间继续监听。
+ */
+static void _linx_sdk_handle_tts_start(const cJSON* root, void* user_data) {
+    (void)root;
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    
+    _linx_sdk_set_tts_state(sdk, "start");
+    
+    // 新一轮播放重新上报播放对齐，并丢弃上一轮残留的下行帧
+    pthread_mutex_lock(&sdk->state_mutex);
+    sdk->playback_reported = false;
+    pthread_mutex_unlock(&sdk->state_mutex);
+    jitter_buffer_reset(sdk->jitter_buffer);
+    downlink_player_reset(sdk->downlink_player);
+    
+    if (sdk->config.listening_mode != LINX_LISTENING_MODE_REALTIME) {
+        _linx_sdk_set_listen_state(sdk, "stop");
+        if (sdk->ws_protocol) {
+            linx_protocol_send_stop_listening((linx_protocol_t*)sdk->ws_protocol);
         }
+        LOG_INFO("停止监听（TTS播放中）");
     }
-    // 处理goodbye消息
-    else if (strcmp(type->valuestring, "goodbye") == 0) {
-        LOG_INFO("会话结束");
-        _linx_sdk_set_session_id(sdk, NULL);
-        
-        // 触发会话结束事件
-        LinxEvent event = {
-            .type = LINX_EVENT_SESSION_ENDED,
-            .timestamp = time(NULL)
-        };
-        
-        if (sdk->event_callback) {
-            sdk->event_callback(&event, sdk->user_data);
+    
+    // 触发TTS开始事件
+    LinxEvent event = {
+        .type = LINX_EVENT_TTS_STARTED,
+        .timestamp = time(NULL)
+    };
+    
+    if (sdk->event_callback) {
+        sdk->event_callback(&event, sdk->user_data);
+    }
+}
+
+/**
+ * @brief 处理 tts/stop：TTS播放结束，重新开始监听
+ */
+static void _linx_sdk_handle_tts_stop(const cJSON* root, void* user_data) {
+    (void)root;
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    
+    _linx_sdk_set_tts_state(sdk, "stop");
+    // 本轮不会再有新帧，剩余缓冲直接播完
+    jitter_buffer_drain(sdk->jitter_buffer);
+    if (sdk->config.listening_mode != LINX_LISTENING_MODE_REALTIME) {
+        _linx_sdk_set_listen_state(sdk, "start");
+        if (sdk->ws_protocol) {
+            linx_protocol_send_start_listening((linx_protocol_t*)sdk->ws_protocol, sdk->config.listening_mode);
         }
+        LOG_INFO("恢复语音监听");
+    }
+    
+    // 触发TTS停止事件
+    LinxEvent event = {
+        .type = LINX_EVENT_TTS_STOPPED,
+        .timestamp = time(NULL)
+    };
+    
+    if (sdk->event_callback) {
+        sdk->event_callback(&event, sdk->user_data);
     }
-    // 处理其他消息类型
-    else {
-        LOG_WARN("未知消息类型: %s", type->valuestring);
+}
+
+/**
+ * @brief 发出文本消息事件
+ */
+static void _linx_sdk_emit_text(LinxSdk* sdk, const cJSON* root, const char* role) {
+    const cJSON* text = cJSON_GetObjectItem(root, "text");
+    if (!text || !cJSON_IsString(text) || !sdk->event_callback) {
+        return;
     }
     
-    // 如果启用了MCP，将消息传递给MCP服务器处理
-    if (sdk->mcp_enabled && sdk->mcp_server) {
-        mcp_server_parse_message(sdk->mcp_server, json_string);
+    LinxEvent event = {
+        .type = LINX_EVENT_TEXT_MESSAGE,
+        .timestamp = time(NULL),
+        .data.text_message = {
+            .text = text->valuestring,
+            .role = (char*)role
+        }
+    };
+    sdk->event_callback(&event, sdk->user_data);
+}
+
+/**
+ * @brief 处理 tts/sentence_start：把即将播报的句子作为助手文本发出
+ */
+static void _linx_sdk_handle_tts_sentence_start(const cJSON* root, void* user_data) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    
+    _linx_sdk_set_tts_state(sdk, "sentence_start");
+    _linx_sdk_emit_text(sdk, root, "assistant");
+}
+
+/**
+ * @brief 处理stt消息：把语音识别结果作为用户文本发出
+ */
+static void _linx_sdk_handle_stt(const cJSON* root, void* user_data) {
+    _linx_sdk_emit_text((LinxSdk*)user_data, root, "user");
+}
+
+/**
+ * @brief 处理goodbye消息：结束会话
+ */
+static void _linx_sdk_handle_goodbye(const cJSON* root, void* user_data) {
+    (void)root;
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    
+    LOG_INFO("会话结束");
+    _linx_sdk_set_session_id(sdk, NULL);
+    
+    // 触发会话结束事件
+    LinxEvent event = {
+        .type = LINX_EVENT_SESSION_ENDED,
+        .timestamp = time(NULL)
+    };
+    
+    if (sdk->event_callback) {
+        sdk->event_callback(&event, sdk->user_data);
     }
+}
+
+/**
+ * @brief 处理mcp消息：直接把已解析的payload子树交给MCP服务器
+ */
+static void _linx_sdk_handle_mcp(const cJSON* root, void* user_data) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
     
-    free(json_string);
+    const cJSON* payload = cJSON_GetObjectItem(root, "payload");
+    if (sdk->mcp_enabled && sdk->mcp_server && cJSON_IsObject(payload)) {
+        mcp_server_parse_json_message(sdk->mcp_server, payload);
+    }
+}
+
+/**
+ * @brief 注册SDK内置的消息处理函数
+ * 
+ * 应用可以通过 linx_sdk_register_message_handler() 以相同的 type/state
+ * 覆盖这些处理函数，或为 llm、iot 等类型添加处理函数。
+ * 
+ * @param sdk 指向LinxSdk实例的指针
+ */
+static void _linx_sdk_register_builtin_handlers(LinxSdk* sdk) {
+    linx_message_router_t* router = &sdk->message_router;
+    
+    linx_message_router_register(router, "hello", NULL, _linx_sdk_handle_hello, sdk);
+    linx_message_router_register(router, "tts", NULL, _linx_sdk_handle_tts, sdk);
+    linx_message_router_register(router, "tts", "start", _linx_sdk_handle_tts_start, sdk);
+    linx_message_router_register(router, "tts", "stop", _linx_sdk_handle_tts_stop, sdk);
+    linx_message_router_register(router, "tts", "sentence_start", _linx_sdk_handle_tts_sentence_start, sdk);
+    linx_message_router_register(router, "stt", NULL, _linx_sdk_handle_stt, sdk);
+    linx_message_router_register(router, "goodbye", NULL, _linx_sdk_handle_goodbye, sdk);
+    linx_message_router_register(router, "mcp", NULL, _linx_sdk_handle_mcp, sdk);
+}
+
+// 下行数据包的实际时长：服务器可能下发多帧或与hello声明时长不同的数据包，
+// 解码器能从包头得知时长时以包头为准，否则使用hello中的frame_duration
+static uint32_t _linx_sdk_packet_duration(LinxSdk* sdk, const linx_audio_stream_packet_t* packet) {
+    audio_codec_t* codec = sdk->downlink_codec;
+    if (codec && codec->decoder_initialized && codec->decoder_format.sample_rate > 0) {
+        int samples = codec_get_packet_samples(codec, packet->payload, packet->payload_size);
+        if (samples > 0) {
+            return (uint32_t)((int64_t)samples * 1000 / codec->decoder_format.sample_rate);
+        }
+    }
+    return (uint32_t)packet->frame_duration;
 }
 
 /**
@@ -727,24 +1305,43 @@ static void _linx_sdk_on_websocket_message(const cJSON* root, void* user_data) {
  * 
  * @note 该函数在WebSocket线程上下文中被调用
  * @note 如果packet或user_data为NULL，函数会安全返回
- * @note 音频数据的处理可以扩展为实际的音频播放功能
- * @note 接收到音频数据会触发LINX_EVENT_AUDIO_DATA事件
+ * @note 启用抖动缓冲时帧被复制进缓冲，否则触发LINX_EVENT_AUDIO_DATA事件
+ * @note packet 是借用视图，payload 指向接收缓冲区，仅在本回调内有效；
+ *       事件原样转交该视图不做复制，应用需要保留时调用 linx_sdk_retain_audio()
  * 
  * @see linx_audio_stream_packet_t
  * @see LINX_EVENT_AUDIO_DATA
  * @see LinxEvent
  */
-static void _linx_sdk_on_websocket_audio_data(linx_audio_stream_packet_t* packet, void* user_data) {
+static void _linx_sdk_on_websocket_audio_data(const linx_audio_stream_packet_t* packet, void* user_data) {
     LinxSdk* sdk = (LinxSdk*)user_data;
     if (!sdk || !packet) return;
     
     LOG_DEBUG("收到音频数据: %zu 字节", packet->payload_size);
     
-    // 这里可以处理音频数据，例如播放TTS音频
-    // 触发TTS相关事件
+    // 启用抖动缓冲时由播放线程通过linx_sdk_read_audio按节奏取帧
+    if (sdk->jitter_buffer) {
+        uint32_t arrival_ms = (uint32_t)(linx_send_queue_now_us() / 1000);
+        jitter_buffer_result_t result = jitter_buffer_put(sdk->jitter_buffer, packet->timestamp,
+                                                          _linx_sdk_packet_duration(sdk, packet),
+                                                          packet->payload, packet->payload_size, arrival_ms);
+        if (result != JITTER_BUFFER_OK) {
+            LOG_DEBUG("抖动缓冲丢弃下行帧 %u: %d", packet->timestamp, result);
+        }
+        return;
+    }
+    
+    // 事件直接借用接收缓冲区，需要跨回调保留的应用调用linx_sdk_retain_audio
     LinxEvent event = {
         .type = LINX_EVENT_AUDIO_DATA,
-        .timestamp = time(NULL)
+        .timestamp = time(NULL),
+        .data.audio_data = {
+            .data = packet->payload,
+            .size = packet->payload_size,
+            .timestamp = packet->timestamp,
+            .sample_rate = packet->sample_rate,
+            .frame_duration = packet->frame_duration
+        }
     };
     
     if (sdk->event_callback) {
@@ -762,31 +1359,52 @@ static void _linx_sdk_on_websocket_audio_data(linx_audio_stream_packet_t* packet
  * @return void* 线程返回值，总是返回NULL
  * 
  * @note 该函数在独立的线程中运行
- * @note 线程会以10ms的间隔轮询WebSocket事件
+ * @note 线程阻塞在 mg_mgr_poll 中，直到有网络事件、上行帧入队或停止请求唤醒，
+ *       空闲时最多每 LINX_SDK_EVENT_LOOP_MAX_WAIT_MS 毫秒醒来一次
  * @note 如果arg为NULL，线程会立即退出
  * @note 线程的运行状态由sdk->event_thread_running控制
- * @note 使用usleep避免过高的CPU占用
  * 
  * @see linx_websocket_poll
+ * @see _linx_sdk_stop_event_thread
  * @see LinxSdk::event_thread_running
  */
 static void* _linx_sdk_event_thread(void* arg) {
     LinxSdk* sdk = (LinxSdk*)arg;
     if (!sdk) return NULL;
     
-    while (sdk->event_thread_running) {
-        // 轮询WebSocket协议
+    while (__atomic_load_n(&sdk->event_thread_running, __ATOMIC_ACQUIRE)) {
+        // 阻塞等待网络事件或显式唤醒
         if (sdk->ws_protocol) {
-            linx_websocket_poll(sdk->ws_protocol, 10);
+            linx_websocket_poll(sdk->ws_protocol, LINX_SDK_EVENT_LOOP_MAX_WAIT_MS);
         }
-        
-        // 短暂休眠避免CPU占用过高
-        usleep(10000); // 10ms
     }
     
     return NULL;
 }
 
+/**
+ * @brief 停止SDK事件处理线程
+ * 
+ * 清除运行标志后唤醒阻塞在 mg_mgr_poll 中的事件线程，再等待其退出，
+ * 因此停止操作不需要等待轮询超时。
+ * 
+ * @param sdk 指向LinxSdk实例的指针，不能为NULL
+ * 
+ * @note 线程未运行时直接返回
+ * @note 不能在事件线程内部（例如事件回调中）调用
+ */
+static void _linx_sdk_stop_event_thread(LinxSdk* sdk) {
+    if (!sdk->event_thread_running) {
+        return;
+    }
+    
+    __atomic_store_n(&sdk->event_thread_running, false, __ATOMIC_RELEASE);
+    if (sdk->ws_protocol) {
+        linx_websocket_wakeup(sdk->ws_protocol);
+    }
+    pthread_join(sdk->event_thread, NULL);
+}
+
 // 状态管理函数
 /**
  * @brief 设置SDK会话ID
@@ -895,28 +1513,32 @@ static void _linx_sdk_set_tts_state(LinxSdk* sdk, const char* state) {
 /**
  * @brief MCP消息发送回调函数
  * 
- * 这是一个内部回调函数，用于处理从MCP（Model Context Protocol）
- * 服务器需要发送的消息。由于回调函数签名的限制，无法直接获取SDK实例，
- * 实际实现中可能需要使用全局变量或其他方式来访问SDK上下文。
+ * MCP服务器处理完请求后通过此回调发出JSON-RPC回复。回调按SDK实例注册，
+ * 回复被包装成 {"type":"mcp"} 消息，经由MCP优先级通道发送，
+ * 不会排在已积压的上行音频之后。
  * 
- * @param message MCP消息字符串，可能为NULL
+ * @param message 完整的JSON-RPC消息，可能为NULL
+ * @param user_data 注册时传入的SDK实例
  * 
- * @note 该函数在MCP服务器的上下文中被调用
- * @note 如果message为NULL，函数会安全返回
- * @note 接收到的MCP消息会被记录到调试日志中
- * @note 由于回调函数签名限制，暂时无法获取SDK实例进行实际发送
- * @note 实际实现中可能需要重新设计回调机制以支持SDK上下文传递
+ * @note 该函数在MCP服务器的上下文中被调用（通常是事件循环线程）
+ * @note 连接未建立时回复被丢弃并记录警告
  * 
- * @see mcp_server_set_send_callback
- * @see LOG_DEBUG
+ * @see mcp_server_set_reply_callback
+ * @see linx_protocol_send_mcp_message
  */
-static void _linx_sdk_mcp_send_callback(const char* message) {
-    // 这里需要获取sdk实例，但由于回调函数签名限制，暂时留空
-    // 实际实现中可能需要使用全局变量或其他方式
-    if (message) {
-        // 发送MCP消息的逻辑
-        LOG_DEBUG("收到MCP消息: %s", message);
+static void _linx_sdk_mcp_send_callback(const char* message, void* user_data) {
+    LinxSdk* sdk = (LinxSdk*)user_data;
+    if (!sdk || !message) {
+        return;
     }
+    
+    if (!sdk->ws_protocol || !sdk->ws_protocol->connected) {
+        LOG_WARN("连接未建立，丢弃MCP回复");
+        return;
+    }
+    
+    LOG_DEBUG("发送MCP回复: %s", message);
+    linx_protocol_send_mcp_message((linx_protocol_t*)sdk->ws_protocol, message);
 }
 
 // ============================================================================
@@ -933,6 +1555,9 @@ LinxSdkError linx_sdk_abort_speaking(LinxSdk* sdk, linx_abort_reason_t reason) {
     }
     
     linx_protocol_send_abort_speaking((linx_protocol_t*)sdk->ws_protocol, reason);
+    // 打断后不再播放已缓冲的TTS
+    jitter_buffer_reset(sdk->jitter_buffer);
+    downlink_player_reset(sdk->downlink_player);
     
     return LINX_SDK_SUCCESS;
 }
@@ -959,6 +1584,245 @@ const char* linx_sdk_get_session_id(LinxSdk* sdk) {
     return sdk->session_id;
 }
 
+// ============================================================================
+// 消息路由函数实现
+// ============================================================================
+
+LinxSdkError linx_sdk_register_message_handler(LinxSdk* sdk, const char* type, const char* state,
+                                               LinxMessageHandler handler, void* user_data) {
+    if (!sdk || !type || !handler) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->initialized) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    pthread_mutex_lock(&sdk->router_mutex);
+    bool ok = linx_message_router_register(&sdk->message_router, type, state, handler, user_data);
+    pthread_mutex_unlock(&sdk->router_mutex);
+    
+    return ok ? LINX_SDK_SUCCESS : LINX_SDK_ERROR_INVALID_PARAM;
+}
+
+LinxSdkError linx_sdk_unregister_message_handler(LinxSdk* sdk, const char* type, const char* state) {
+    if (!sdk || !type) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->initialized) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    pthread_mutex_lock(&sdk->router_mutex);
+    bool ok = linx_message_router_unregister(&sdk->message_router, type, state);
+    pthread_mutex_unlock(&sdk->router_mutex);
+    
+    return ok ? LINX_SDK_SUCCESS : LINX_SDK_ERROR_INVALID_PARAM;
+}
+
+// ============================================================================
+// 运行统计函数实现
+// ============================================================================
+
+LinxSdkError linx_sdk_get_loop_stats(LinxSdk* sdk, LinxSdkLoopStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->ws_protocol) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    linx_websocket_get_loop_stats(sdk->ws_protocol, stats);
+    return LINX_SDK_SUCCESS;
+}
+
+LinxSdkError linx_sdk_get_rtt_stats(LinxSdk* sdk, LinxSdkRttStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->ws_protocol) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    linx_websocket_get_rtt_stats(sdk->ws_protocol, stats);
+    return LINX_SDK_SUCCESS;
+}
+
+LinxSdkError linx_sdk_get_send_stats(LinxSdk* sdk, LinxSdkSendStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->ws_protocol) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    linx_websocket_get_send_stats(sdk->ws_protocol, stats);
+    return LINX_SDK_SUCCESS;
+}
+
+linx_audio_stream_packet_t* linx_sdk_retain_audio(const LinxEvent* event) {
+    if (!event || event->type != LINX_EVENT_AUDIO_DATA) {
+        return NULL;
+    }
+    
+    const linx_audio_stream_packet_t packet = {
+        .sample_rate = event->data.audio_data.sample_rate,
+        .frame_duration = event->data.audio_data.frame_duration,
+        .timestamp = event->data.audio_data.timestamp,
+        .payload = (uint8_t*)event->data.audio_data.data,
+        .payload_size = event->data.audio_data.size
+    };
+    return linx_audio_stream_packet_retain(&packet);
+}
+
+jitter_buffer_result_t linx_sdk_read_audio(LinxSdk* sdk, audio_codec_t* decoder, int16_t* pcm, size_t pcm_size,
+                                           size_t* decoded_size, uint32_t* timestamp) {
+    if (!sdk || !sdk->jitter_buffer) {
+        return JITTER_BUFFER_INVALID_PARAMETER;
+    }
+    
+    return jitter_buffer_decode(sdk->jitter_buffer, decoder, pcm, pcm_size, decoded_size, timestamp);
+}
+
+LinxSdkError linx_sdk_get_jitter_stats(LinxSdk* sdk, LinxSdkJitterStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->jitter_buffer) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    jitter_buffer_get_stats(sdk->jitter_buffer, stats);
+    return LINX_SDK_SUCCESS;
+}
+
+static void _linx_sdk_on_playback(uint32_t timestamp, void* user_data) {
+    linx_sdk_mark_playback((LinxSdk*)user_data, timestamp);
+}
+
+// 解码输出采样率：显式配置 > 播放设备 > 服务器hello
+static int _linx_sdk_playback_sample_rate(LinxSdk* sdk, int server_sample_rate) {
+    if (sdk->config.playback_sample_rate > 0) {
+        return (int)sdk->config.playback_sample_rate;
+    }
+    if (sdk->config.playback_device && sdk->config.playback_device->sample_rate > 0) {
+        return (int)sdk->config.playback_device->sample_rate;
+    }
+    return server_sample_rate;
+}
+
+// Opus直接解码到输出采样率；Opus不支持的输出采样率（如44.1kHz）按服务器采样率解码后重采样
+static bool _linx_sdk_set_playback_format(LinxSdk* sdk, int server_rate, int frame_duration) {
+    int output_rate = _linx_sdk_playback_sample_rate(sdk, server_rate);
+    int decode_rate = _linx_sdk_is_codec_rate(output_rate) ? output_rate : server_rate;
+    return downlink_player_set_output_rate(sdk->downlink_player, output_rate) &&
+           downlink_player_set_format(sdk->downlink_player, decode_rate, 1, frame_duration);
+}
+
+static void _linx_sdk_configure_playback(LinxSdk* sdk) {
+    if (!sdk->downlink_player || !sdk->ws_protocol) {
+        return;
+    }
+    
+    const linx_protocol_t* protocol = (const linx_protocol_t*)sdk->ws_protocol;
+    int server_rate = linx_protocol_get_server_sample_rate(protocol);
+    int frame_duration = linx_protocol_get_server_frame_duration(protocol);
+    if (!_linx_sdk_set_playback_format(sdk, server_rate, frame_duration)) {
+        _linx_sdk_set_error(sdk, "下行解码器配置失败", -1);
+    }
+}
+
+// 创建时按服务器默认参数（24kHz、60ms）配置，收到hello后再按实际参数调整
+static bool _linx_sdk_create_playback(LinxSdk* sdk) {
+    sdk->downlink_codec = codec_factory_create(CODEC_TYPE_OPUS);
+    if (!sdk->downlink_codec) {
+        return false;
+    }
+    
+    sdk->downlink_player = downlink_player_create(sdk->jitter_buffer, sdk->downlink_codec);
+    if (!sdk->downlink_player || !_linx_sdk_set_playback_format(sdk, 24000, 60)) {
+        downlink_player_destroy(sdk->downlink_player);
+        sdk->downlink_player = NULL;
+        codec_factory_destroy(sdk->downlink_codec);
+        sdk->downlink_codec = NULL;
+        return false;
+    }
+    
+    if (sdk->config.playback_device &&
+        !downlink_player_start(sdk->downlink_player, sdk->config.playback_device, sdk->config.playback_period_ms,
+                               _linx_sdk_on_playback, sdk)) {
+        downlink_player_destroy(sdk->downlink_player);
+        sdk->downlink_player = NULL;
+        codec_factory_destroy(sdk->downlink_codec);
+        sdk->downlink_codec = NULL;
+        return false;
+    }
+    return true;
+}
+
+size_t linx_sdk_read_pcm(LinxSdk* sdk, int16_t* pcm, size_t samples) {
+    if (!sdk || !sdk->downlink_player) {
+        return 0;
+    }
+    
+    uint32_t timestamp = 0;
+    size_t decoded = downlink_player_read(sdk->downlink_player, pcm, samples, &timestamp);
+    if (decoded > 0) {
+        linx_sdk_mark_playback(sdk, timestamp);
+    }
+    return decoded;
+}
+
+LinxSdkError linx_sdk_get_playback_stats(LinxSdk* sdk, LinxSdkPlaybackStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    if (!sdk->downlink_player) {
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    
+    downlink_player_get_stats(sdk->downlink_player, stats);
+    return LINX_SDK_SUCCESS;
+}
+
+LinxSdkError linx_sdk_get_pcm_stats(LinxSdk* sdk, LinxSdkPcmStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    if (!sdk->uplink_encoder) {
+        pthread_mutex_unlock(&sdk->uplink_mutex);
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    uplink_encoder_get_stats(sdk->uplink_encoder, stats);
+    pthread_mutex_unlock(&sdk->uplink_mutex);
+    
+    return LINX_SDK_SUCCESS;
+}
+
+LinxSdkError linx_sdk_get_bitrate_stats(LinxSdk* sdk, LinxSdkBitrateStats* stats) {
+    if (!sdk || !stats) {
+        return LINX_SDK_ERROR_INVALID_PARAM;
+    }
+    
+    pthread_mutex_lock(&sdk->uplink_mutex);
+    if (!sdk->bitrate_controller) {
+        pthread_mutex_unlock(&sdk->uplink_mutex);
+        return LINX_SDK_ERROR_NOT_INITIALIZED;
+    }
+    bitrate_controller_get_stats(sdk->bitrate_controller, stats);
+    pthread_mutex_unlock(&sdk->uplink_mutex);
+    
+    return LINX_SDK_SUCCESS;
+}
+
 // ============================================================================
 // MCP相关函数实现
 // ============================================================================
@@ -19,7 +19,12 @@
 // 引入相关模块
 
 #include "protocols/linx_websocket.h"
+#include "protocols/linx_message_router.h"
 #include "mcp/mcp_server.h"
+#include "audio/jitter_buffer.h"
+#include "audio/uplink_encoder.h"
+#include "audio/downlink_player.h"
+#include "audio/bitrate_controller.h"
 #include "cjson/cJSON.h"
 
 #ifdef __cplusplus
@@ -31,6 +36,16 @@ extern "C" {
  */
 #define LINX_SDK_VERSION "1.0.0"
 
+/**
+ * @brief 播放延迟变化超过该值（毫秒）时重新向服务器上报播放对齐
+ */
+#define LINX_SDK_PLAYBACK_SYNC_MS 10
+
+/**
+ * @brief linx_sdk_send_pcm()为每个编码帧预留的最大字节数
+ */
+#define LINX_SDK_PCM_MAX_PACKET_SIZE 1500
+
 /**
  * @brief SDK错误码
  */
@@ -62,7 +77,7 @@ typedef enum {
 typedef struct {
     // 基础配置
     char server_url[256];           ///< 服务器URL
-    uint32_t sample_rate;           ///< 采样率 (默认16000)
+    uint32_t sample_rate;           ///< 采集采样率 (默认16000；Opus不支持的采样率如44100由SDK重采样到16000后编码)
     uint16_t channels;              ///< 声道数 (默认1)
     uint32_t timeout_ms;            ///< 超时时间(毫秒)
     
@@ -72,7 +87,42 @@ typedef struct {
     char client_id[64];             ///< 客户端ID
     uint32_t protocol_version;      ///< 协议版本
     
-    linx_listening_mode_t listening_mode; ///< 监听模式
+    linx_listening_mode_t listening_mode; ///< 监听模式 (REALTIME会在hello中声明features.aec，由服务器做回声消除)
+    
+    // 自动重连配置
+    bool auto_reconnect;            ///< 连接意外断开后自动重连 (默认关闭)
+    uint32_t reconnect_base_ms;     ///< 首次重连延迟上限(毫秒，0使用默认1000)
+    uint32_t reconnect_max_ms;      ///< 重连延迟上限(毫秒，0使用默认30000)
+    uint32_t reconnect_max_attempts; ///< 最大连续重连次数 (0表示不限)
+    
+    // 心跳配置
+    uint32_t ping_interval_ms;      ///< 心跳间隔(毫秒，0使用默认15000)
+    uint32_t idle_timeout_ms;       ///< 空闲超时(毫秒，0使用默认45000)，超时后关闭连接
+    
+    // 上行背压配置
+    uint32_t send_buffer_limit;     ///< 发送缓冲区积压上限(字节，0使用默认4096)
+    linx_websocket_backpressure_policy_t backpressure_policy; ///< 积压超限时的音频处理策略 (默认丢弃最早的音频)
+    bool adaptive_bitrate;          ///< 根据发送队列积压、RTT和丢帧自动调整linx_sdk_send_pcm的Opus码率、复杂度与带宽 (默认关闭，固定为编码档位的码率)
+    
+    // 上行编码配置（linx_sdk_send_pcm）
+    codec_profile_t encoder_profile; ///< Opus编码档位 (默认CODEC_PROFILE_DEFAULT音质优先；LOW_LATENCY为10ms帧并写入hello，LOW_CPU适合低端ARM板，BANDWIDTH_SAVER为12kbps+DTX)；启用adaptive_bitrate时档位的码率、复杂度与带宽为上限
+    
+    // 上行多帧打包配置（仅协议v2/v3，需服务器在hello中确认）
+    uint32_t audio_batch_frames;    ///< 每条WebSocket消息最多打包的音频帧数 (0或1表示逐帧发送，最大16)
+    uint32_t audio_batch_delay_ms;  ///< 打包引入的最大额外延迟(毫秒，0使用默认60)
+    
+    // 下行抖动缓冲配置
+    uint32_t jitter_buffer_max_ms;  ///< 抖动缓冲最大目标深度(毫秒，0表示不启用，下行音频直接通过LINX_EVENT_AUDIO_DATA事件下发)
+    uint32_t jitter_buffer_min_ms;  ///< 抖动缓冲最小目标深度(毫秒，0使用一帧时长)
+    
+    // 下行播放配置（SDK解码下行音频并按固定周期输出PCM，未设置jitter_buffer_max_ms时抖动缓冲使用默认深度）
+    bool playback_enabled;          ///< 由SDK解码下行音频，应用调用linx_sdk_read_pcm拉取 (设置playback_device时自动启用)
+    AudioInterface* playback_device; ///< 播放设备(非NULL时SDK启动播放线程按周期写入，设备由应用初始化并启动播放)
+    uint32_t playback_sample_rate;  ///< 解码输出采样率(0使用播放设备采样率，无设备时使用服务器hello中的采样率；Opus不支持的采样率由SDK重采样)
+    uint32_t playback_period_ms;    ///< 播放线程每次写入的周期(毫秒，0使用服务器帧时长)
+    
+    // 运行时配置
+    linx_runtime_t* runtime;        ///< 共享的分片运行时(NULL表示每个SDK实例自建事件线程)
 } LinxSdkConfig;
 
 /**
@@ -81,7 +131,7 @@ typedef struct {
 typedef enum {
     LINX_EVENT_STATE_CHANGED,       ///< 状态改变
     LINX_EVENT_TEXT_MESSAGE,        ///< 文本消息
-    LINX_EVENT_AUDIO_DATA,          ///< 音频数据
+    LINX_EVENT_AUDIO_DATA,          ///< 音频数据（启用抖动缓冲时不触发，改用linx_sdk_read_audio拉取）
     LINX_EVENT_ERROR,               ///< 错误事件
     
     // WebSocket相关事件
@@ -96,6 +146,9 @@ typedef enum {
     
     // MCP相关事件
     LINX_EVENT_MCP_MESSAGE,         ///< MCP消息
+    
+    // 网络质量事件
+    LINX_EVENT_BACKPRESSURE,        ///< 上行拥塞状态变化
 
 } LinxEventType;
 
@@ -117,8 +170,11 @@ typedef struct {
         } text_message;
         
         struct {
-            uint8_t* data;
-            size_t size;
+            const uint8_t* data;    // 编码音频载荷（借用视图，直接指向接收缓冲区，仅在回调内有效）
+            size_t size;            // 载荷字节数
+            uint32_t timestamp;     // 服务器下发的帧时间戳（仅v2携带），播放时传给linx_sdk_mark_playback
+            int sample_rate;        // 服务器采样率（hello中的audio_params）
+            int frame_duration;     // 帧时长(毫秒)
         } audio_data;
         
         struct {
@@ -164,6 +220,11 @@ typedef struct {
         struct {
             char* message;
         } mcp_message_sent;
+        
+        struct {
+            bool congested;         // true: 进入拥塞; false: 积压已回落到上限一半以下
+            size_t buffered_bytes;  // 当前发送缓冲区积压字节数
+        } backpressure;
     } data;
 } LinxEvent;
 
@@ -202,6 +263,29 @@ struct LinxSdk {
     // MCP相关
     bool mcp_enabled;                       ///< MCP是否启用
     mcp_server_t* mcp_server;               ///< MCP服务器实例
+    
+    // 消息路由
+    linx_message_router_t message_router;   ///< 按type/state分发的消息路由表
+    pthread_mutex_t router_mutex;           ///< 路由表互斥锁
+    
+    // 采集时钟与播放对齐（服务器回声消除）
+    uint64_t clock_origin_us;               ///< 采集时钟零点（单调时钟微秒）
+    int64_t playback_offset_ms;             ///< 最近上报的 播放时刻-下行时间戳 差值
+    bool playback_reported;                 ///< 本轮TTS是否已上报过播放对齐
+    
+    // 下行抖动缓冲
+    jitter_buffer_t* jitter_buffer;         ///< 抖动缓冲实例（未启用时为NULL）
+    
+    // 上行PCM编码
+    audio_codec_t* uplink_codec;            ///< linx_sdk_send_pcm()使用的Opus编码器（首次调用时创建）
+    uplink_encoder_t* uplink_encoder;       ///< 上行编码线程（连接断开时停止）
+    pthread_mutex_t uplink_mutex;           ///< 上行编码器互斥锁，同时保护播放线程对ws_protocol的使用
+    bitrate_controller_t* bitrate_controller; ///< 上行码率自适应（未启用时为NULL，随编码器创建）
+    uint64_t uplink_sink_drops;             ///< 发送队列无空位跳过的帧数（仅编码线程访问）
+    
+    // 下行解码播放
+    audio_codec_t* downlink_codec;          ///< 下行Opus解码器（未启用时为NULL）
+    downlink_player_t* downlink_player;     ///< 下行播放器（未启用时为NULL）
 
 };
 
@@ -352,7 +436,11 @@ LinxSdkError linx_sdk_set_event_callback(LinxSdk* sdk, LinxEventCallback callbac
  * @note 
  * - 连接成功后会触发LINX_EVENT_WEBSOCKET_CONNECTED事件
  * - 连接过程是异步的，函数返回成功不代表连接已完全建立
- * - 如果已经连接，重复调用会返回成功
+ * - 如果已经连接、上一次调用的握手仍在进行或正在自动重连，重复调用直接返回成功，不会中断进行中的连接
+ * - 启用auto_reconnect后，意外断开会按带抖动的指数退避自动重连，
+ *   服务器hello声明features.session_resume时重连会携带原session_id请求恢复会话
+ * - 配置了runtime时不创建事件线程，连接挂载到会话数最少的分片，
+ *   事件回调在该分片线程上执行；同一进程内的大量设备应共享一个运行时
  * 
  * @warning 
  * - 确保在调用前已设置事件回调函数
@@ -479,6 +567,126 @@ LinxSdkError linx_sdk_send_text(LinxSdk* sdk, const char* text);
  */
 LinxSdkError linx_sdk_send_audio(LinxSdk* sdk, const uint8_t* data, size_t size);
 
+/**
+ * @brief 获取SDK采集时钟
+ * 
+ * 单调递增的毫秒时钟，零点为SDK创建时刻。上行音频帧的时间戳（协议v2头部的
+ * timestamp字段）和播放对齐消息都基于该时钟，服务器据此把回声参考信号与
+ * 采集到的麦克风信号对齐。
+ * 
+ * @param sdk SDK实例指针
+ * @return 当前时钟值（毫秒，约49天回绕一次），sdk为NULL时返回0
+ * 
+ * @note 此函数是线程安全的
+ */
+uint32_t linx_sdk_get_clock_ms(LinxSdk* sdk);
+
+/**
+ * @brief 发送带采集时间戳的音频数据
+ * 
+ * 与linx_sdk_send_audio()相同，但使用调用者提供的采集时刻作为帧时间戳。
+ * 采集回调与发送不在同一时刻时（例如先缓存再批量编码），应在采集时调用
+ * linx_sdk_get_clock_ms()记录时刻，再通过本函数发送，避免把排队时间算进回声路径延迟。
+ * 
+ * @param sdk SDK实例指针
+ * @param data 音频数据缓冲区指针
+ * @param size 音频数据大小（字节数）
+ * @param capture_ms 该帧首个采样的采集时刻（linx_sdk_get_clock_ms()的返回值）
+ * 
+ * @return 同linx_sdk_send_audio()
+ * 
+ * @see linx_sdk_get_clock_ms(), linx_sdk_send_audio()
+ */
+LinxSdkError linx_sdk_send_audio_with_timestamp(LinxSdk* sdk, const uint8_t* data, size_t size, uint32_t capture_ms);
+
+/**
+ * @brief 发送原始PCM音频，由SDK负责编码
+ * 
+ * 应用只需把采集回调得到的PCM原样交给SDK，块大小任意。SDK把样本复制进预分配的
+ * 环形缓冲后立即返回，由内部编码线程按encoder_profile的帧时长拼成
+ * 完整帧，用Opus（config中的sample_rate和channels）直接编码进发送队列的槽位，
+ * 不再经过额外的复制。每帧的时间戳为其首个采样的采集时刻。sample_rate不是Opus
+ * 支持的采样率（8/12/16/24/48kHz）时，样本先在写入环形缓冲前重采样到16kHz。
+ * 
+ * @param sdk SDK实例指针
+ * @param pcm 交错排列的16位PCM样本
+ * @param samples 样本数（所有声道合计）
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 样本已全部进入环形缓冲
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或pcm为NULL，或samples为0
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: SDK未初始化
+ * - LINX_SDK_ERROR_NETWORK: 未连接，或环形缓冲已满有样本被丢弃
+ * - LINX_SDK_ERROR_MEMORY: 编码器创建失败
+ * 
+ * @note 
+ * - 应在采集回调返回后立即调用，函数本身不做编码，不会阻塞采集线程
+ * - 编码线程在首次调用时启动，连接断开时停止并丢弃未编码的样本
+ * - 不要与linx_sdk_send_audio()混用在同一路音频上
+ * 
+ * @see linx_sdk_get_pcm_stats()
+ * 
+ * @example
+ * ```c
+ * static void on_capture(const int16_t* pcm, size_t samples, void* user_data) {
+ *     linx_sdk_send_pcm((LinxSdk*)user_data, pcm, samples);
+ * }
+ * ```
+ */
+LinxSdkError linx_sdk_send_pcm(LinxSdk* sdk, const int16_t* pcm, size_t samples);
+
+/**
+ * @brief 记录下行音频帧的实际播放时刻
+ * 
+ * 应用在一帧TTS音频真正送到扬声器时调用，传入该帧LINX_EVENT_AUDIO_DATA事件中的
+ * timestamp。SDK以采集时钟记录播放时刻，每轮TTS首帧以及播放延迟变化超过
+ * LINX_SDK_PLAYBACK_SYNC_MS时向服务器发送一条播放对齐消息：
+ * {"type":"playback","timestamp":下行时间戳,"played_at":采集时钟}。
+ * 服务器据此确定回声参考信号在上行音频中的位置，从而支持实时监听模式。
+ * 只有listening_mode为LINX_LISTENING_MODE_REALTIME（hello中声明了features.aec）时
+ * 才发送，其余模式只返回成功；消息走MCP/文本发送通道，不占用控制通道。
+ * 
+ * @param sdk SDK实例指针
+ * @param timestamp 已播放帧的下行时间戳
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 记录成功（不一定发送消息）
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk为NULL
+ * - LINX_SDK_ERROR_NETWORK: 未连接或发送失败
+ * 
+ * @note 此函数是线程安全的，可在音频播放线程中调用
+ * 
+ * @see LINX_EVENT_AUDIO_DATA, LINX_LISTENING_MODE_REALTIME
+ */
+LinxSdkError linx_sdk_mark_playback(LinxSdk* sdk, uint32_t timestamp);
+
+/**
+ * @brief 保留LINX_EVENT_AUDIO_DATA事件中的音频帧
+ * 
+ * 音频事件中的data不经复制直接指向WebSocket接收缓冲区，回调返回后即失效。
+ * 需要把帧放入队列、交给其他线程解码播放的应用，在回调内调用本函数复制一份；
+ * 只在回调内同步处理的应用无需调用，也就没有任何复制开销。
+ * 
+ * @param event LINX_EVENT_AUDIO_DATA事件
+ * 
+ * @return 新分配的数据包（结构体与载荷一次分配），包含载荷、采样率、帧时长和时间戳；
+ *         event为NULL、类型不符或内存不足时返回NULL
+ * 
+ * @note 返回值用linx_audio_stream_packet_destroy()释放
+ * 
+ * @example
+ * ```c
+ * case LINX_EVENT_AUDIO_DATA: {
+ *     linx_audio_stream_packet_t* frame = linx_sdk_retain_audio(event);
+ *     if (frame && !playback_queue_push(frame)) {
+ *         linx_audio_stream_packet_destroy(frame);
+ *     }
+ *     break;
+ * }
+ * ```
+ */
+linx_audio_stream_packet_t* linx_sdk_retain_audio(const LinxEvent* event);
+
 /**
  * @brief 获取当前状态
  * 
@@ -707,6 +915,352 @@ LinxSdkError linx_sdk_send_wake_word(LinxSdk* sdk, const char* wake_word);
  */
 const char* linx_sdk_get_session_id(LinxSdk* sdk);
 
+// ============================================================================
+// 消息路由函数
+// ============================================================================
+
+/**
+ * @brief 消息处理函数类型
+ * 
+ * @param root 已解析的服务器消息，仅在回调期间有效
+ * @param user_data 注册时传入的用户数据
+ */
+typedef linx_message_handler_t LinxMessageHandler;
+
+/**
+ * @brief 注册服务器消息处理函数
+ * 
+ * 按消息的 type（以及可选的 state）字段注册处理函数。分发通过预先计算的
+ * 哈希查表完成，先匹配 (type, state)，再回退到只匹配 type 的处理函数。
+ * SDK内置了 hello、tts、stt、goodbye、mcp 的处理函数，以相同键注册会覆盖它们；
+ * llm、iot 等类型默认无人处理，会被静默丢弃。
+ * 
+ * @param sdk SDK实例指针
+ * @param type 消息类型，如 "llm"、"iot"，长度小于 LINX_MESSAGE_ROUTER_NAME_MAX
+ * @param state 消息状态，如 "sentence_start"；NULL表示匹配该类型的任意状态
+ * @param handler 处理函数
+ * @param user_data 传给处理函数的用户数据
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 注册成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: 参数无效、名称过长或路由表已满
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: SDK未正确初始化
+ * 
+ * @note 
+ * - 处理函数在事件线程中被调用，应避免长时间阻塞
+ * - 可以在任意线程注册或注销，包括在处理函数和事件回调内部
+ * - 处理函数在查表之后、不持锁的情况下调用：在其他线程注销返回时，已取出的
+ *   处理函数仍可能正在或即将以原user_data执行，user_data应保持有效直到
+ *   linx_sdk_destroy()返回
+ * 
+ * @example
+ * ```c
+ * static void on_llm(const cJSON* root, void* user_data) {
+ *     const cJSON* emotion = cJSON_GetObjectItem(root, "emotion");
+ *     if (cJSON_IsString(emotion)) {
+ *         printf("表情: %s\n", emotion->valuestring);
+ *     }
+ * }
+ * 
+ * linx_sdk_register_message_handler(sdk, "llm", NULL, on_llm, NULL);
+ * ```
+ */
+LinxSdkError linx_sdk_register_message_handler(LinxSdk* sdk, const char* type, const char* state,
+                                               LinxMessageHandler handler, void* user_data);
+
+/**
+ * @brief 注销服务器消息处理函数
+ * 
+ * @param sdk SDK实例指针
+ * @param type 消息类型
+ * @param state 消息状态，NULL表示类型级处理函数
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 注销成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: 参数无效或未找到对应处理函数
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: SDK未正确初始化
+ * 
+ * @note 注销之后不会再有新消息分发给该处理函数，但不等待正在执行的调用结束；
+ *       注册时传入的user_data不能在此时释放，见linx_sdk_register_message_handler()
+ */
+LinxSdkError linx_sdk_unregister_message_handler(LinxSdk* sdk, const char* type, const char* state);
+
+// ============================================================================
+// 运行统计函数
+// ============================================================================
+
+/**
+ * @brief 事件循环统计
+ * 
+ * 每次事件循环迭代分为两段：阻塞在 mg_mgr_poll 中等待（wait）和处理事件（busy）。
+ * 队列延迟为上行帧从入队到写入连接的耗时。
+ */
+typedef linx_websocket_loop_stats_t LinxSdkLoopStats;
+
+/**
+ * @brief 获取事件循环统计
+ * 
+ * 返回SDK事件线程的迭代次数、唤醒次数、等待/处理耗时以及上行队列延迟，
+ * 用于评估事件驱动循环的响应延迟和空闲功耗。
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 尚未建立连接，无统计数据
+ * 
+ * @note 
+ * - 此函数是线程安全的
+ * - 统计值在每次 linx_sdk_connect() 创建新连接时清零
+ * - 挂载到运行时的连接由分片线程驱动，不统计等待/处理耗时，只统计队列延迟
+ * 
+ * @example
+ * ```c
+ * LinxSdkLoopStats stats;
+ * if (linx_sdk_get_loop_stats(sdk, &stats) == LINX_SDK_SUCCESS && stats.iterations > 0) {
+ *     printf("平均处理耗时: %llu us, 最大队列延迟: %llu us\n",
+ *            (unsigned long long)(stats.total_busy_us / stats.iterations),
+ *            (unsigned long long)stats.max_queue_delay_us);
+ * }
+ * ```
+ */
+LinxSdkError linx_sdk_get_loop_stats(LinxSdk* sdk, LinxSdkLoopStats* stats);
+
+/**
+ * @brief 心跳往返时延统计
+ * 
+ * min/avg/p99 基于最近的心跳样本窗口，单位为微秒。
+ */
+typedef linx_websocket_rtt_stats_t LinxSdkRttStats;
+
+/**
+ * @brief 获取心跳RTT统计
+ * 
+ * SDK按ping_interval_ms定期发送带时间戳的WebSocket ping，根据服务器回显的pong
+ * 计算往返时延；连接超过idle_timeout_ms未收到任何数据会被主动关闭，
+ * 启用auto_reconnect时随后自动重连。
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 尚未建立连接，无统计数据
+ * 
+ * @note 此函数是线程安全的
+ * 
+ * @example
+ * ```c
+ * LinxSdkRttStats rtt;
+ * if (linx_sdk_get_rtt_stats(sdk, &rtt) == LINX_SDK_SUCCESS && rtt.samples > 0) {
+ *     printf("RTT min/avg/p99: %u/%u/%u us\n", rtt.min_us, rtt.avg_us, rtt.p99_us);
+ * }
+ * ```
+ */
+LinxSdkError linx_sdk_get_rtt_stats(LinxSdk* sdk, LinxSdkRttStats* stats);
+
+/**
+ * @brief 上行发送统计
+ * 
+ * 包含发送缓冲区积压字节数、发送队列深度以及按背压策略丢弃的音频帧数。
+ */
+typedef linx_websocket_send_stats_t LinxSdkSendStats;
+
+/**
+ * @brief 获取上行发送统计
+ * 
+ * 网络拥塞时发送缓冲区中积压的字节数不再无限增长：超过send_buffer_limit后
+ * 按backpressure_policy丢弃最早或最新的音频帧，或在LINX_BACKPRESSURE_LOWER_BITRATE
+ * 策略下通过LINX_EVENT_BACKPRESSURE事件通知应用降低编码码率。文本与控制消息从不丢弃。
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 尚未建立连接，无统计数据
+ * 
+ * @note 此函数是线程安全的
+ * 
+ * @example
+ * ```c
+ * LinxSdkSendStats send;
+ * if (linx_sdk_get_send_stats(sdk, &send) == LINX_SDK_SUCCESS) {
+ *     printf("积压 %zu 字节, 丢弃 %llu/%llu 帧\n", send.buffered_bytes,
+ *            (unsigned long long)send.dropped_oldest, (unsigned long long)send.dropped_newest);
+ * }
+ * ```
+ */
+LinxSdkError linx_sdk_get_send_stats(LinxSdk* sdk, LinxSdkSendStats* stats);
+
+/**
+ * @brief 下行抖动缓冲统计
+ * 
+ * 包含当前缓冲深度、自适应目标深度、平滑到达抖动，以及补偿、迟到、重复、
+ * 溢出的帧数和欠载次数。
+ */
+typedef jitter_buffer_stats_t LinxSdkJitterStats;
+
+/**
+ * @brief 从抖动缓冲读取并解码下一帧下行音频
+ * 
+ * 配置jitter_buffer_max_ms后，网络线程收到的下行帧按时间戳（协议v2）或到达顺序
+ * （v1/v3）放入抖动缓冲，不再触发LINX_EVENT_AUDIO_DATA事件。播放线程按设备节奏
+ * （每帧时长）调用本函数取帧：缓冲深度按实测到达抖动自适应，乱序帧被重排，
+ * 错过播放时刻的帧被丢弃，缺失的帧由解码器做丢包补偿（Opus PLC）。
+ * 
+ * @param sdk SDK实例指针
+ * @param decoder 已初始化的解码器，只在调用线程中使用
+ * @param pcm 输出PCM缓冲区
+ * @param pcm_size 输出缓冲区大小（样本数）
+ * @param decoded_size 输出实际样本数，缓冲为空时为0
+ * @param timestamp 输出该帧的下行时间戳，可为NULL；播放后传给linx_sdk_mark_playback
+ * 
+ * @return 
+ * - JITTER_BUFFER_OK: 输出一帧解码音频
+ * - JITTER_BUFFER_LOST: 帧缺失或无法解码，输出补偿音频
+ * - JITTER_BUFFER_EMPTY: 正在预缓冲或欠载，调用方播放静音
+ * - JITTER_BUFFER_INVALID_PARAMETER: 参数无效或未启用抖动缓冲
+ * 
+ * @note 
+ * - TTS开始和中断播放时缓冲被清空，TTS结束时剩余帧不再等待目标深度直接播完
+ * - 启用playback_enabled时由SDK解码，应改用linx_sdk_read_pcm()
+ * 
+ * @example
+ * ```c
+ * int16_t pcm[2880];
+ * size_t samples = 0;
+ * uint32_t timestamp = 0;
+ * if (linx_sdk_read_audio(sdk, decoder, pcm, 2880, &samples, &timestamp) == JITTER_BUFFER_EMPTY) {
+ *     samples = silence(pcm, frame_samples);
+ * }
+ * audio_interface_write(audio, pcm, samples);
+ * linx_sdk_mark_playback(sdk, timestamp);
+ * ```
+ */
+jitter_buffer_result_t linx_sdk_read_audio(LinxSdk* sdk, audio_codec_t* decoder, int16_t* pcm, size_t pcm_size,
+                                           size_t* decoded_size, uint32_t* timestamp);
+
+/**
+ * @brief 获取下行抖动缓冲统计
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 未启用抖动缓冲
+ * 
+ * @note 此函数是线程安全的
+ */
+LinxSdkError linx_sdk_get_jitter_stats(LinxSdk* sdk, LinxSdkJitterStats* stats);
+
+/**
+ * @brief 拉取一个周期的下行PCM
+ * 
+ * 配置playback_enabled后，SDK用按服务器hello中audio_params配置的Opus解码器
+ * 解码抖动缓冲中的下行帧，并切分成应用要求的固定长度。应在音频设备的回调或
+ * 播放线程中按设备节奏调用，网络线程不再做任何解码。
+ * 
+ * @param sdk SDK实例指针
+ * @param pcm 输出缓冲区，至少samples个样本
+ * @param samples 周期长度（交错样本数）
+ * 
+ * @return 解码出的样本数；不足samples的部分已补静音，返回0表示整个周期都是静音
+ * 
+ * @note 
+ * - 输出采样率为playback_sample_rate（未设置时为播放设备或服务器采样率），应用应按此配置设备
+ * - 拉取模式输出单声道样本；设置playback_device时按设备声道数交错输出
+ * - 含有音频的周期会自动调用linx_sdk_mark_playback()上报播放时刻
+ * - 设置playback_device时由SDK播放线程调用，应用不应再调用本函数
+ * 
+ * @example
+ * ```c
+ * static void on_device_needs_data(int16_t* out, size_t samples, void* user_data) {
+ *     linx_sdk_read_pcm((LinxSdk*)user_data, out, samples);
+ * }
+ * ```
+ */
+size_t linx_sdk_read_pcm(LinxSdk* sdk, int16_t* pcm, size_t samples);
+
+/**
+ * @brief 下行播放统计
+ * 
+ * 包含输出的有声/静音周期数、解码与补偿的帧数、设备缓冲写满被丢弃的周期数，
+ * 以及播放线程的最大唤醒延迟。
+ */
+typedef downlink_player_stats_t LinxSdkPlaybackStats;
+
+/**
+ * @brief 获取下行播放统计
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 未启用下行播放
+ * 
+ * @note 此函数是线程安全的
+ */
+LinxSdkError linx_sdk_get_playback_stats(LinxSdk* sdk, LinxSdkPlaybackStats* stats);
+
+/**
+ * @brief 上行PCM编码统计
+ * 
+ * 包含已编码和已发送的帧数、因环形缓冲写满丢弃的样本数、因发送队列已满跳过的
+ * 帧数、编码失败次数以及编码耗时。
+ */
+typedef uplink_encoder_stats_t LinxSdkPcmStats;
+
+/**
+ * @brief 获取上行PCM编码统计
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 编码线程未运行
+ * 
+ * @note 此函数是线程安全的；统计随编码线程重建而清零
+ */
+LinxSdkError linx_sdk_get_pcm_stats(LinxSdk* sdk, LinxSdkPcmStats* stats);
+
+/**
+ * @brief 上行码率自适应统计
+ * 
+ * 包含评估周期数、升降档次数、按发送队列/丢帧/RTT分类的拥塞周期数、
+ * 升档后很快回落的试探失败次数，以及当前档位与码率。
+ */
+typedef bitrate_controller_stats_t LinxSdkBitrateStats;
+
+/**
+ * @brief 获取上行码率自适应统计
+ * 
+ * 启用adaptive_bitrate后，编码线程每秒汇总发送队列深度、发送缓冲区拥塞状态、
+ * 丢弃的音频帧数和心跳RTT：出现拥塞立即降一档，连续多个周期空闲才升一档，
+ * 升档后很快又拥塞时升档前的等待时间加倍。
+ * 
+ * @param sdk SDK实例指针
+ * @param stats 输出统计数据，不能为NULL
+ * 
+ * @return 
+ * - LINX_SDK_SUCCESS: 获取成功
+ * - LINX_SDK_ERROR_INVALID_PARAM: sdk或stats为NULL
+ * - LINX_SDK_ERROR_NOT_INITIALIZED: 未启用adaptive_bitrate或尚未调用linx_sdk_send_pcm
+ * 
+ * @note 此函数是线程安全的；档位在重连后保留
+ */
+LinxSdkError linx_sdk_get_bitrate_stats(LinxSdk* sdk, LinxSdkBitrateStats* stats);
+
 
 
 // ============================================================================
@@ -13,6 +13,9 @@
 /* 全局消息发送回调函数 */
 static mcp_send_message_callback_t g_send_callback = NULL;
 
+static void mcp_server_send_result(const mcp_server_t* server, int id, const char* result);
+static void mcp_server_send_error(const mcp_server_t* server, int id, const char* message);
+
 /**
  * 创建MCP服务器实例
  */
@@ -45,6 +48,10 @@ mcp_server_t* mcp_server_create(const char* server_name, const char* server_vers
     /* 初始化能力回调结构体 */
     memset(&server->capability_callbacks, 0, sizeof(server->capability_callbacks));
     
+    /* 未设置实例回调时回退到全局回调 */
+    server->reply_callback = NULL;
+    server->reply_user_data = NULL;
+    
     LOG_DEBUG("MCP server created successfully: %p", server);
     return server;
 }
@@ -167,6 +174,16 @@ void mcp_server_set_send_callback(mcp_send_message_callback_t callback) {
     g_send_callback = callback;
 }
 
+/**
+ * 设置实例级回复回调函数
+ */
+void mcp_server_set_reply_callback(mcp_server_t* server, mcp_server_reply_callback_t callback, void* user_data) {
+    if (server) {
+        server->reply_callback = callback;
+        server->reply_user_data = user_data;
+    }
+}
+
 /**
  * 解析字符串消息
  */
@@ -245,15 +262,27 @@ void mcp_server_parse_json_message(mcp_server_t* server, const cJSON* json) {
         LOG_WARN("Method not implemented: %s", method_str);
         char error_msg[256];
         snprintf(error_msg, sizeof(error_msg), "Method not implemented: %s", method_str);
-        mcp_server_reply_error(id_int, error_msg);
+        mcp_server_send_error(server, id_int, error_msg);
     }
 }
 
-/**
- * 回复成功结果
+/*
+ * 发送一条完整的 JSON-RPC 消息：优先使用实例回调，否则使用全局回调
  */
-void mcp_server_reply_result(int id, const char* result) {
-    if (!g_send_callback || !result) {
+static void mcp_server_deliver(const mcp_server_t* server, const char* payload) {
+    if (server && server->reply_callback) {
+        server->reply_callback(payload, server->reply_user_data);
+    } else if (g_send_callback) {
+        g_send_callback(payload);
+    }
+}
+
+static bool mcp_server_has_sink(const mcp_server_t* server) {
+    return (server && server->reply_callback) || g_send_callback;
+}
+
+static void mcp_server_send_result(const mcp_server_t* server, int id, const char* result) {
+    if (!mcp_server_has_sink(server) || !result) {
         return;
     }
     
@@ -263,26 +292,48 @@ void mcp_server_reply_result(int id, const char* result) {
     }
     
     sprintf(payload, "{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":%s}", id, result);
-    g_send_callback(payload);
+    mcp_server_deliver(server, payload);
     free(payload);
 }
 
-/**
- * 回复错误信息
- */
-void mcp_server_reply_error(int id, const char* message) {
-    if (!g_send_callback || !message) {
+static void mcp_server_send_error(const mcp_server_t* server, int id, const char* message) {
+    if (!mcp_server_has_sink(server) || !message) {
         return;
     }
     
-    char* payload = malloc(strlen(message) + 128);
-    if (!payload) {
+    /* 用cJSON构建，错误消息中的引号和控制字符会被正确转义 */
+    cJSON* root = cJSON_CreateObject();
+    cJSON* error = cJSON_CreateObject();
+    if (!root || !error) {
+        cJSON_Delete(root);
+        cJSON_Delete(error);
         return;
     }
+    cJSON_AddStringToObject(root, "jsonrpc", "2.0");
+    cJSON_AddNumberToObject(root, "id", id);
+    cJSON_AddStringToObject(error, "message", message);
+    cJSON_AddItemToObject(root, "error", error);
     
-    sprintf(payload, "{\"jsonrpc\":\"2.0\",\"id\":%d,\"error\":{\"message\":\"%s\"}}", id, message);
-    g_send_callback(payload);
-    free(payload);
+    char* payload = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (payload) {
+        mcp_server_deliver(server, payload);
+        free(payload);
+    }
+}
+
+/**
+ * 回复成功结果
+ */
+void mcp_server_reply_result(int id, const char* result) {
+    mcp_server_send_result(NULL, id, result);
+}
+
+/**
+ * 回复错误信息
+ */
+void mcp_server_reply_error(int id, const char* message) {
+    mcp_server_send_error(NULL, id, message);
 }
 
 /**
@@ -327,7 +378,7 @@ void mcp_server_parse_capabilities(mcp_server_t* server, const cJSON* capabiliti
  */
 void mcp_server_handle_initialize(mcp_server_t* server, int id, const cJSON* params) {
     if (!server) {
-        mcp_server_reply_error(id, "Server not initialized");
+        mcp_server_send_error(server, id, "Server not initialized");
         return;
     }
     
@@ -345,7 +396,7 @@ void mcp_server_handle_initialize(mcp_server_t* server, int id, const cJSON* par
         "{\"protocolVersion\":\"%s\",\"capabilities\":{\"tools\":{\"listChanged\":false}},\"serverInfo\":{\"name\":\"%s\",\"version\":\"%s\"}}",
         MCP_PROTOCOL_VERSION, server->server_name, server->server_version);
     
-    mcp_server_reply_result(id, result);
+    mcp_server_send_result(server, id, result);
 }
 
 /**
@@ -353,7 +404,7 @@ void mcp_server_handle_initialize(mcp_server_t* server, int id, const cJSON* par
  */
 void mcp_server_handle_tools_list(mcp_server_t* server, int id, const cJSON* params) {
     if (!server) {
-        mcp_server_reply_error(id, "Server not initialized");
+        mcp_server_send_error(server, id, "Server not initialized");
         return;
     }
     
@@ -376,10 +427,10 @@ void mcp_server_handle_tools_list(mcp_server_t* server, int id, const cJSON* par
     // 获取工具列表JSON
     char* tools_json = mcp_server_get_tools_list_json(server, cursor, list_user_only_tools);
     if (tools_json) {
-        mcp_server_reply_result(id, tools_json);
+        mcp_server_send_result(server, id, tools_json);
         free(tools_json);
     } else {
-        mcp_server_reply_error(id, "Failed to generate tools list");
+        mcp_server_send_error(server, id, "Failed to generate tools list");
     }
 }
 
@@ -388,14 +439,14 @@ void mcp_server_handle_tools_list(mcp_server_t* server, int id, const cJSON* par
  */
 void mcp_server_handle_tools_call(mcp_server_t* server, int id, const cJSON* params) {
     if (!server || !params) {
-        mcp_server_reply_error(id, "Invalid parameters");
+        mcp_server_send_error(server, id, "Invalid parameters");
         return;
     }
     
     // 获取工具名称
     const cJSON* name_json = cJSON_GetObjectItem(params, "name");
     if (!name_json || !cJSON_IsString(name_json)) {
-        mcp_server_reply_error(id, "Tool name is required");
+        mcp_server_send_error(server, id, "Tool name is required");
         return;
     }
     
@@ -406,7 +457,7 @@ void mcp_server_handle_tools_call(mcp_server_t* server, int id, const cJSON* par
     if (!tool) {
         char error_msg[256];
         snprintf(error_msg, sizeof(error_msg), "Tool not found: %s", tool_name);
-        mcp_server_reply_error(id, error_msg);
+        mcp_server_send_error(server, id, error_msg);
         return;
     }
     
@@ -524,13 +575,13 @@ void mcp_server_handle_tools_call(mcp_server_t* server, int id, const cJSON* par
     
     if (response) {
         if (is_error) {
-            mcp_server_reply_error(id, "Tool execution failed");
+            mcp_server_send_error(server, id, "Tool execution failed");
         } else {
-            mcp_server_reply_result(id, response);
+            mcp_server_send_result(server, id, response);
         }
         free(response);
     } else {
-        mcp_server_reply_error(id, "Failed to process tool result - memory allocation error");
+        mcp_server_send_error(server, id, "Failed to process tool result - memory allocation error");
     }
 }
 
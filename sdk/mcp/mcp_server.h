@@ -20,11 +20,16 @@ typedef struct mcp_server {
     char server_name[MCP_MAX_NAME_LENGTH];      // 服务器名称
     char server_version[64];                    // 服务器版本
     mcp_capability_callbacks_t capability_callbacks; // 能力回调函数集合
+    void (*reply_callback)(const char* message, void* user_data); // 实例级回复回调，NULL 时使用全局回调
+    void* reply_user_data;                      // 传给 reply_callback 的用户数据
 } mcp_server_t;
 
 /* 消息发送回调函数类型 */
 typedef void (*mcp_send_message_callback_t)(const char* message);
 
+/* 实例级回复回调函数类型，user_data 为注册时传入的指针 */
+typedef void (*mcp_server_reply_callback_t)(const char* message, void* user_data);
+
 /* 服务器基础函数 */
 /**
  * 创建MCP服务器实例
@@ -88,6 +93,16 @@ const mcp_tool_t* mcp_server_find_tool(const mcp_server_t* server, const char* n
  */
 void mcp_server_set_send_callback(mcp_send_message_callback_t callback);
 
+/**
+ * 设置实例级回复回调函数
+ * 设置后该服务器处理请求产生的回复都经由此回调发出，多个服务器实例可互不干扰；
+ * 未设置时回退到 mcp_server_set_send_callback 注册的全局回调
+ * @param server 服务器实例
+ * @param callback 回调函数指针，NULL 表示取消
+ * @param user_data 透传给回调的用户数据
+ */
+void mcp_server_set_reply_callback(mcp_server_t* server, mcp_server_reply_callback_t callback, void* user_data);
+
 /**
  * 解析字符串消息
  * @param server 服务器实例
@@ -0,0 +1,160 @@
+#include "linx_message_router.h"
+#include <string.h>
+#include "../log/linx_log.h"
+
+#define FNV_OFFSET_BASIS    2166136261u
+#define FNV_PRIME           16777619u
+#define STATE_SEPARATOR     0x1f        /* 区分 ("ab","c") 与 ("a","bc") */
+
+static uint32_t fnv1a_append(uint32_t hash, const char* str) {
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+        hash ^= *p;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t hash_with_state(uint32_t type_hash, const char* state) {
+    uint32_t hash = (type_hash ^ STATE_SEPARATOR) * FNV_PRIME;
+    return fnv1a_append(hash, state);
+}
+
+uint32_t linx_message_router_hash(const char* type, const char* state) {
+    uint32_t hash = fnv1a_append(FNV_OFFSET_BASIS, type ? type : "");
+    return state ? hash_with_state(hash, state) : hash;
+}
+
+/* 在表中查找路由，未找到返回 NULL */
+static linx_message_route_t* find_route(linx_message_router_t* router, uint32_t hash,
+                                        const char* type, const char* state) {
+    const size_t mask = LINX_MESSAGE_ROUTER_CAPACITY - 1;
+    for (size_t i = 0; i < LINX_MESSAGE_ROUTER_CAPACITY; i++) {
+        linx_message_route_t* route = &router->routes[(hash + i) & mask];
+        if (!route->used) {
+            if (!route->handler) {
+                return NULL;    /* 从未使用过的槽位终止探测 */
+            }
+            continue;           /* 已删除的槽位（墓碑），继续探测 */
+        }
+        if (route->hash == hash && route->has_state == (state != NULL) &&
+            strcmp(route->type, type) == 0 && (!state || strcmp(route->state, state) == 0)) {
+            return route;
+        }
+    }
+    return NULL;
+}
+
+void linx_message_router_init(linx_message_router_t* router) {
+    if (router) {
+        memset(router, 0, sizeof(linx_message_router_t));
+    }
+}
+
+bool linx_message_router_register(linx_message_router_t* router, const char* type, const char* state,
+                                  linx_message_handler_t handler, void* user_data) {
+    if (!router || !type || !handler) {
+        return false;
+    }
+    if (strlen(type) >= LINX_MESSAGE_ROUTER_NAME_MAX ||
+        (state && strlen(state) >= LINX_MESSAGE_ROUTER_NAME_MAX)) {
+        LOG_ERROR("Message route name too long: type=%s state=%s", type, state ? state : "*");
+        return false;
+    }
+
+    uint32_t hash = linx_message_router_hash(type, state);
+    linx_message_route_t* route = find_route(router, hash, type, state);
+    if (route) {
+        route->handler = handler;
+        route->user_data = user_data;
+        return true;
+    }
+
+    if (router->count >= LINX_MESSAGE_ROUTER_CAPACITY / 2) {
+        /* 保持低装载率，探测长度接近常数 */
+        LOG_ERROR("Message router full, cannot register type=%s state=%s", type, state ? state : "*");
+        return false;
+    }
+
+    const size_t mask = LINX_MESSAGE_ROUTER_CAPACITY - 1;
+    for (size_t i = 0; i < LINX_MESSAGE_ROUTER_CAPACITY; i++) {
+        route = &router->routes[(hash + i) & mask];
+        if (!route->used) {
+            memset(route, 0, sizeof(*route));
+            route->used = true;
+            route->hash = hash;
+            route->has_state = state != NULL;
+            strcpy(route->type, type);
+            if (state) {
+                strcpy(route->state, state);
+            }
+            route->handler = handler;
+            route->user_data = user_data;
+            router->count++;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool linx_message_router_unregister(linx_message_router_t* router, const char* type, const char* state) {
+    if (!router || !type) {
+        return false;
+    }
+
+    linx_message_route_t* route = find_route(router, linx_message_router_hash(type, state), type, state);
+    if (!route) {
+        return false;
+    }
+
+    /* 保留 handler 非空作为墓碑，保证后续探测链不断 */
+    route->used = false;
+    route->user_data = NULL;
+    router->count--;
+    return true;
+}
+
+bool linx_message_router_lookup(linx_message_router_t* router, const cJSON* root,
+                                linx_message_handler_t* handler, void** user_data) {
+    if (!router || !root || !handler || !user_data) {
+        return false;
+    }
+
+    const cJSON* type = cJSON_GetObjectItemCaseSensitive(root, "type");
+    if (!cJSON_IsString(type) || !type->valuestring) {
+        router->unhandled++;
+        return false;
+    }
+
+    uint32_t type_hash = linx_message_router_hash(type->valuestring, NULL);
+    linx_message_route_t* route = NULL;
+
+    /* 先匹配 (type, state)，再回退到类型级路由 */
+    const cJSON* state = cJSON_GetObjectItemCaseSensitive(root, "state");
+    if (cJSON_IsString(state) && state->valuestring) {
+        route = find_route(router, hash_with_state(type_hash, state->valuestring),
+                           type->valuestring, state->valuestring);
+    }
+    if (!route) {
+        route = find_route(router, type_hash, type->valuestring, NULL);
+    }
+
+    if (!route) {
+        router->unhandled++;
+        return false;
+    }
+
+    router->dispatched++;
+    *handler = route->handler;
+    *user_data = route->user_data;
+    return true;
+}
+
+bool linx_message_router_dispatch(linx_message_router_t* router, const cJSON* root) {
+    linx_message_handler_t handler = NULL;
+    void* user_data = NULL;
+    if (!linx_message_router_lookup(router, root, &handler, &user_data)) {
+        return false;
+    }
+    handler(root, user_data);
+    return true;
+}
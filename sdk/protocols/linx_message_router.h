@@ -0,0 +1,112 @@
+#ifndef LINX_MESSAGE_ROUTER_H
+#define LINX_MESSAGE_ROUTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../cjson/cJSON.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 路由表参数 */
+#define LINX_MESSAGE_ROUTER_CAPACITY    64      // 路由槽位数（2的幂）
+#define LINX_MESSAGE_ROUTER_NAME_MAX    32      // type/state 最大长度（含结尾0）
+
+/**
+ * 消息处理函数
+ * @param root 已解析的消息，仅在回调期间有效
+ * @param user_data 注册时传入的用户数据
+ */
+typedef void (*linx_message_handler_t)(const cJSON* root, void* user_data);
+
+/* 路由表项 */
+typedef struct {
+    uint32_t hash;                              // type（及 state）的哈希
+    bool used;                                  // 槽位是否被占用
+    bool has_state;                             // 是否限定 state
+    char type[LINX_MESSAGE_ROUTER_NAME_MAX];    // 消息类型
+    char state[LINX_MESSAGE_ROUTER_NAME_MAX];   // 消息状态（has_state 时有效）
+    linx_message_handler_t handler;             // 处理函数
+    void* user_data;                            // 用户数据
+} linx_message_route_t;
+
+/*
+ * 消息路由器
+ *
+ * 以 "type" 字段（可选再加 "state" 字段）的哈希为键的开放寻址表，
+ * 分发时先查 (type, state)，再查 (type, 任意state)，均为 O(1)。
+ * 没有处理函数的消息只计数，不打印日志。
+ * 路由器本身不加锁，由使用者保证注册与分发不并发。
+ */
+typedef struct {
+    linx_message_route_t routes[LINX_MESSAGE_ROUTER_CAPACITY];
+    size_t count;                               // 已注册的路由数
+    uint64_t dispatched;                        // 已分发的消息数
+    uint64_t unhandled;                         // 无处理函数而丢弃的消息数
+} linx_message_router_t;
+
+/**
+ * 初始化路由器
+ * @param router 路由器
+ */
+void linx_message_router_init(linx_message_router_t* router);
+
+/**
+ * 注册消息处理函数，同一 (type, state) 重复注册时替换原处理函数
+ * @param router 路由器
+ * @param type 消息类型，如 "tts"
+ * @param state 消息状态，如 "start"；NULL 表示匹配该类型的任意状态
+ * @param handler 处理函数
+ * @param user_data 传给处理函数的用户数据
+ * @return 成功返回 true；参数无效、名称过长或路由表已满返回 false
+ */
+bool linx_message_router_register(linx_message_router_t* router, const char* type, const char* state,
+                                  linx_message_handler_t handler, void* user_data);
+
+/**
+ * 注销消息处理函数
+ * @param router 路由器
+ * @param type 消息类型
+ * @param state 消息状态，NULL 表示类型级路由
+ * @return 找到并删除返回 true
+ */
+bool linx_message_router_unregister(linx_message_router_t* router, const char* type, const char* state);
+
+/**
+ * 按 type/state 查找消息的处理函数并计入分发统计，不调用处理函数
+ *
+ * 使用者可在锁内查找、释放锁后再调用处理函数，使处理函数中可以注册或注销路由。
+ * 此时注销并不等待已取出的处理函数执行完毕，user_data 须在路由器的整个
+ * 使用期内保持有效（例如直到协议实例销毁）。
+ * @param router 路由器
+ * @param root 已解析的消息
+ * @param handler 输出处理函数
+ * @param user_data 输出注册时传入的用户数据
+ * @return 找到处理函数返回 true，否则返回 false（消息被丢弃）
+ */
+bool linx_message_router_lookup(linx_message_router_t* router, const cJSON* root,
+                                linx_message_handler_t* handler, void** user_data);
+
+/**
+ * 按 type/state 分发消息
+ * @param router 路由器
+ * @param root 已解析的消息
+ * @return 找到处理函数返回 true，否则返回 false（消息被丢弃）
+ */
+bool linx_message_router_dispatch(linx_message_router_t* router, const cJSON* root);
+
+/**
+ * 计算路由键哈希（FNV-1a）
+ * @param type 消息类型
+ * @param state 消息状态，可为 NULL
+ * @return 哈希值
+ */
+uint32_t linx_message_router_hash(const char* type, const char* state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINX_MESSAGE_ROUTER_H */
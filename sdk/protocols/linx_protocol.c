@@ -11,7 +11,7 @@
 static uint64_t get_current_time_ms(void) {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
 }
 
 /* 协议管理函数 */
@@ -118,9 +118,23 @@ bool linx_protocol_send_audio(linx_protocol_t* protocol, linx_audio_stream_packe
     return result;
 }
 
-/* 高级消息发送函数 */
+bool linx_protocol_send_text(linx_protocol_t* protocol, const char* text, linx_send_priority_t priority) {
+    if (!protocol || !protocol->vtable || !text) {
+        return false;
+    }
+    
+    if (protocol->vtable->send_text_priority) {
+        return protocol->vtable->send_text_priority(protocol, text, priority);
+    }
+    if (protocol->vtable->send_text) {
+        return protocol->vtable->send_text(protocol, text);
+    }
+    return false;
+}
+
+/* 高级消息发送函数：控制消息走最高优先级，不会排在已入队的音频之后 */
 void linx_protocol_send_wake_word_detected(linx_protocol_t* protocol, const char* wake_word) {
-    if (!protocol || !protocol->vtable || !protocol->vtable->send_text || !wake_word) {
+    if (!protocol || !wake_word) {
         return;
     }
     
@@ -129,11 +143,11 @@ void linx_protocol_send_wake_word_detected(linx_protocol_t* protocol, const char
              "{\"session_id\":\"%s\",\"type\":\"listen\",\"state\":\"detect\",\"text\":\"%s\"}", 
              protocol->session_id ? protocol->session_id : "", wake_word);
     
-    protocol->vtable->send_text(protocol, message);
+    linx_protocol_send_text(protocol, message, LINX_SEND_PRIORITY_CONTROL);
 }
 
 void linx_protocol_send_start_listening(linx_protocol_t* protocol, linx_listening_mode_t mode) {
-    if (!protocol || !protocol->vtable || !protocol->vtable->send_text) {
+    if (!protocol) {
         return;
     }
     
@@ -158,11 +172,11 @@ void linx_protocol_send_start_listening(linx_protocol_t* protocol, linx_listenin
              "{\"session_id\":\"%s\",\"type\":\"listen\",\"state\":\"start\",\"mode\":\"%s\"}", 
              protocol->session_id ? protocol->session_id : "", mode_str);
     
-    protocol->vtable->send_text(protocol, message);
+    linx_protocol_send_text(protocol, message, LINX_SEND_PRIORITY_CONTROL);
 }
 
 void linx_protocol_send_stop_listening(linx_protocol_t* protocol) {
-    if (!protocol || !protocol->vtable || !protocol->vtable->send_text) {
+    if (!protocol) {
         return;
     }
     
@@ -171,11 +185,11 @@ void linx_protocol_send_stop_listening(linx_protocol_t* protocol) {
              "{\"session_id\":\"%s\",\"type\":\"listen\",\"state\":\"stop\"}", 
              protocol->session_id ? protocol->session_id : "");
     
-    protocol->vtable->send_text(protocol, message);
+    linx_protocol_send_text(protocol, message, LINX_SEND_PRIORITY_CONTROL);
 }
 
 void linx_protocol_send_abort_speaking(linx_protocol_t* protocol, linx_abort_reason_t reason) {
-    if (!protocol || !protocol->vtable || !protocol->vtable->send_text) {
+    if (!protocol) {
         return;
     }
     
@@ -190,20 +204,36 @@ void linx_protocol_send_abort_speaking(linx_protocol_t* protocol, linx_abort_rea
                  protocol->session_id ? protocol->session_id : "");
     }
     
-    protocol->vtable->send_text(protocol, message);
+    linx_protocol_send_text(protocol, message, LINX_SEND_PRIORITY_CONTROL);
 }
 
 void linx_protocol_send_mcp_message(linx_protocol_t* protocol, const char* message) {
-    if (!protocol || !protocol->vtable || !protocol->vtable->send_text || !message) {
+    if (!protocol || !message) {
         return;
     }
     
-    char mcp_message[1024];
-    snprintf(mcp_message, sizeof(mcp_message), 
-             "{\"session_id\":\"%s\",\"type\":\"mcp\",\"payload\":\"%s\"}", 
-             protocol->session_id ? protocol->session_id : "", message);
+    /* payload 是 JSON-RPC 对象：按对象嵌入，解析失败时才作为转义后的字符串发送 */
+    cJSON* root = cJSON_CreateObject();
+    if (!root) {
+        return;
+    }
+    cJSON_AddStringToObject(root, "session_id", protocol->session_id ? protocol->session_id : "");
+    cJSON_AddStringToObject(root, "type", "mcp");
+    cJSON* payload = cJSON_Parse(message);
+    if (payload) {
+        cJSON_AddItemToObject(root, "payload", payload);
+    } else {
+        LOG_WARN("MCP message is not valid JSON, sending it as a string");
+        cJSON_AddStringToObject(root, "payload", message);
+    }
     
-    protocol->vtable->send_text(protocol, mcp_message);
+    char* text = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!text) {
+        return;
+    }
+    linx_protocol_send_text(protocol, text, LINX_SEND_PRIORITY_MCP);
+    free(text);
 }
 
 /* 工具函数 */
@@ -228,17 +258,63 @@ bool linx_protocol_is_timeout(const linx_protocol_t* protocol) {
     }
     
     uint64_t current_time = get_current_time_ms();
-    bool is_timeout = (current_time - protocol->last_incoming_time) > LINX_TIMEOUT_MS;
+    uint64_t last_incoming = __atomic_load_n(&protocol->last_incoming_time, __ATOMIC_RELAXED);
+    bool is_timeout = (current_time - last_incoming) > LINX_TIMEOUT_MS;
     
     if (is_timeout) {
         LOG_WARN("Protocol timeout detected - last_incoming: %llu, current: %llu, diff: %llu ms", 
-                 protocol->last_incoming_time, current_time, 
-                 current_time - protocol->last_incoming_time);
+                 (unsigned long long)last_incoming, (unsigned long long)current_time, 
+                 (unsigned long long)(current_time - last_incoming));
     }
     
     return is_timeout;
 }
 
+void linx_protocol_update_incoming_time(linx_protocol_t* protocol) {
+    if (protocol) {
+        __atomic_store_n(&protocol->last_incoming_time, get_current_time_ms(), __ATOMIC_RELAXED);
+    }
+}
+
+uint64_t linx_protocol_get_idle_ms(const linx_protocol_t* protocol) {
+    if (!protocol) {
+        return 0;
+    }
+    
+    uint64_t current_time = get_current_time_ms();
+    uint64_t last_incoming = __atomic_load_n(&protocol->last_incoming_time, __ATOMIC_RELAXED);
+    return current_time > last_incoming ? current_time - last_incoming : 0;
+}
+
+/* 多帧打包解析：条目头为大端 {uint32 timestamp, uint16 payload_size} */
+bool linx_protocol_next_batch_frame(const uint8_t** cursor, size_t* remaining, uint32_t* timestamp,
+                                    const uint8_t** payload, size_t* payload_size) {
+    if (!cursor || !*cursor || !remaining || *remaining < sizeof(linx_audio_batch_entry_t)) {
+        return false;
+    }
+    
+    const uint8_t* p = *cursor;
+    size_t size = ((size_t)p[4] << 8) | p[5];
+    if (size > *remaining - sizeof(linx_audio_batch_entry_t)) {
+        LOG_WARN("Audio batch entry of %zu bytes exceeds remaining %zu bytes", size, *remaining);
+        return false;
+    }
+    
+    if (timestamp) {
+        *timestamp = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+    if (payload) {
+        *payload = p + sizeof(linx_audio_batch_entry_t);
+    }
+    if (payload_size) {
+        *payload_size = size;
+    }
+    
+    *cursor = p + sizeof(linx_audio_batch_entry_t) + size;
+    *remaining -= sizeof(linx_audio_batch_entry_t) + size;
+    return true;
+}
+
 /* 音频数据包管理 */
 linx_audio_stream_packet_t* linx_audio_stream_packet_create(size_t payload_size) {
     linx_audio_stream_packet_t* packet = malloc(sizeof(linx_audio_stream_packet_t));
@@ -266,9 +342,32 @@ void linx_audio_stream_packet_destroy(linx_audio_stream_packet_t* packet) {
         return;
     }
     
-    // 释放载荷内存
-    if (packet->payload) {
+    // 释放载荷内存（retain 创建的数据包载荷与结构体在同一块内存中）
+    if (packet->payload && packet->payload != (uint8_t*)(packet + 1)) {
         free(packet->payload);
     }
     free(packet);
+}
+
+linx_audio_stream_packet_t* linx_audio_stream_packet_retain(const linx_audio_stream_packet_t* packet) {
+    if (!packet) {
+        return NULL;
+    }
+    
+    linx_audio_stream_packet_t* copy = malloc(sizeof(linx_audio_stream_packet_t) + packet->payload_size);
+    if (!copy) {
+        LOG_ERROR("Failed to retain audio packet: memory allocation failed (%zu bytes)", packet->payload_size);
+        return NULL;
+    }
+    
+    *copy = *packet;
+    copy->payload = NULL;
+    if (packet->payload_size > 0 && packet->payload) {
+        copy->payload = (uint8_t*)(copy + 1);
+        memcpy(copy->payload, packet->payload, packet->payload_size);
+    } else {
+        copy->payload_size = 0;
+    }
+    
+    return copy;
 }
\ No newline at end of file
@@ -11,7 +11,14 @@
 extern "C" {
 #endif
 
-/* 音频流数据包结构 */
+/*
+ * 音频流数据包结构
+ *
+ * 接收路径上传给 on_incoming_audio 的数据包是“借用视图”：结构体位于栈上，
+ * payload 直接指向 mongoose 接收缓冲区，只在回调执行期间有效。
+ * 需要在回调返回后继续使用时，调用 linx_audio_stream_packet_retain()
+ * 复制一份，并在使用完后调用 linx_audio_stream_packet_destroy() 释放。
+ */
 typedef struct {
     int sample_rate;        // 采样率
     int frame_duration;     // 帧持续时间
@@ -23,7 +30,7 @@ typedef struct {
 /* 二进制协议 v2 结构 */
 typedef struct __attribute__((packed)) {
     uint16_t version;       // 协议版本
-    uint16_t type;          // 消息类型 (0: OPUS, 1: JSON)
+    uint16_t type;          // 消息类型 (0: OPUS, 1: JSON, 2: OPUS 多帧打包)
     uint32_t reserved;      // 保留字段，供将来使用
     uint32_t timestamp;     // 时间戳（毫秒），用于服务端回声消除
     uint32_t payload_size;  // 载荷大小（字节）
@@ -38,6 +45,22 @@ typedef struct __attribute__((packed)) {
     uint8_t payload[];      // 载荷数据
 } linx_binary_protocol3_t;
 
+/* 二进制消息类型（v2 的 type 字段为 uint16，v3 为 uint8） */
+#define LINX_BINARY_TYPE_OPUS           0   // 单帧 Opus
+#define LINX_BINARY_TYPE_JSON           1   // JSON
+#define LINX_BINARY_TYPE_OPUS_BATCH     2   // 多帧 Opus 打包，需在 hello 中协商 features.audio_batch
+
+/*
+ * 多帧打包条目头
+ *
+ * LINX_BINARY_TYPE_OPUS_BATCH 消息的载荷由若干 {条目头, Opus 数据} 依次排列组成，
+ * 帧数由载荷长度隐含。v2 外层头中的 timestamp 等于第一帧的时间戳。
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t timestamp;     // 该帧时间戳（毫秒，网络字节序）
+    uint16_t payload_size;  // 该帧 Opus 数据长度（网络字节序）
+} linx_audio_batch_entry_t;
+
 /* 中止原因枚举 */
 typedef enum {
     LINX_ABORT_REASON_NONE,                 // 无特定原因
@@ -51,15 +74,24 @@ typedef enum {
     LINX_LISTENING_MODE_REALTIME        // 实时模式（需要回声消除支持）
 } linx_listening_mode_t;
 
+/* 上行优先级：发送调度总是先写出高优先级的消息，音频最后 */
+typedef enum {
+    LINX_SEND_PRIORITY_CONTROL = 0,     // 控制消息（abort、listen、唤醒词）
+    LINX_SEND_PRIORITY_MCP,             // MCP 响应及其他文本消息
+    LINX_SEND_PRIORITY_AUDIO,           // 音频帧
+    LINX_SEND_PRIORITY_COUNT
+} linx_send_priority_t;
+
 /* 前向声明 */
 typedef struct linx_protocol linx_protocol_t;
 
 /* 回调函数类型定义 */
-typedef void (*linx_on_incoming_audio_cb_t)(linx_audio_stream_packet_t* packet, void* user_data);
+typedef void (*linx_on_incoming_audio_cb_t)(const linx_audio_stream_packet_t* packet, void* user_data);
 typedef void (*linx_on_incoming_json_cb_t)(const cJSON* root, void* user_data);
 typedef void (*linx_on_network_error_cb_t)(const char* message, void* user_data);
 typedef void (*linx_on_connected_cb_t)(void* user_data);
 typedef void (*linx_on_disconnected_cb_t)(void* user_data);
+typedef void (*linx_on_backpressure_cb_t)(bool congested, size_t buffered_bytes, void* user_data);
 
 /* 回调函数配置结构体 */
 typedef struct {
@@ -68,6 +100,7 @@ typedef struct {
     linx_on_network_error_cb_t on_network_error;        // 网络错误回调
     linx_on_connected_cb_t on_connected;                // 连接成功回调
     linx_on_disconnected_cb_t on_disconnected;          // 连接断开回调
+    linx_on_backpressure_cb_t on_backpressure;          // 上行拥塞状态变化回调（事件循环线程）
     void* user_data;                                    // 用户数据
 } linx_protocol_callbacks_t;
 
@@ -77,6 +110,7 @@ typedef struct {
     bool (*send_audio)(linx_protocol_t* protocol, linx_audio_stream_packet_t* packet);
     bool (*send_text)(linx_protocol_t* protocol, const char* text);
     void (*destroy)(linx_protocol_t* protocol);
+    bool (*send_text_priority)(linx_protocol_t* protocol, const char* text, linx_send_priority_t priority); // 可选，缺省时退化为 send_text
 } linx_protocol_vtable_t;
 
 /* 协议基础结构 */
@@ -89,7 +123,7 @@ struct linx_protocol {
     int server_frame_duration;      // 服务器帧持续时间
     bool error_occurred;            // 是否发生错误
     char* session_id;               // 会话ID
-    uint64_t last_incoming_time;    // 最后接收数据的时间戳（毫秒）
+    uint64_t last_incoming_time;    // 最后接收数据的时间戳（单调时钟毫秒，原子访问）
 };
 
 /* 协议管理函数 */
@@ -108,6 +142,15 @@ const char* linx_protocol_get_session_id(const linx_protocol_t* protocol);
 bool linx_protocol_start(linx_protocol_t* protocol);
 bool linx_protocol_send_audio(linx_protocol_t* protocol, linx_audio_stream_packet_t* packet);
 
+/**
+ * 按优先级发送文本消息
+ * @param protocol 协议实例
+ * @param text 消息文本
+ * @param priority 优先级，实现不支持优先级时按普通文本发送
+ * @return 成功入队或写出返回 true
+ */
+bool linx_protocol_send_text(linx_protocol_t* protocol, const char* text, linx_send_priority_t priority);
+
 /* 高级消息发送函数 */
 void linx_protocol_send_wake_word_detected(linx_protocol_t* protocol, const char* wake_word);
 void linx_protocol_send_start_listening(linx_protocol_t* protocol, linx_listening_mode_t mode);
@@ -119,10 +162,44 @@ void linx_protocol_send_mcp_message(linx_protocol_t* protocol, const char* messa
 void linx_protocol_set_error(linx_protocol_t* protocol, const char* message);
 bool linx_protocol_is_timeout(const linx_protocol_t* protocol);
 
+/**
+ * 记录收到数据的时刻，传输层每收到一帧调用一次
+ * @param protocol 协议实例
+ */
+void linx_protocol_update_incoming_time(linx_protocol_t* protocol);
+
+/**
+ * 获取距最后一次收到数据的时长
+ * @param protocol 协议实例
+ * @return 空闲时长（毫秒），protocol 为 NULL 时返回 0
+ */
+uint64_t linx_protocol_get_idle_ms(const linx_protocol_t* protocol);
+
+/**
+ * 从多帧打包载荷中取出下一帧
+ * @param cursor 读取位置，成功后移到下一条目
+ * @param remaining 剩余字节数，成功后相应减少
+ * @param timestamp 输出该帧时间戳（主机字节序）
+ * @param payload 输出该帧数据起始位置（指向原载荷，不复制）
+ * @param payload_size 输出该帧数据长度
+ * @return 取出一帧返回 true；载荷已读完或条目被截断返回 false
+ */
+bool linx_protocol_next_batch_frame(const uint8_t** cursor, size_t* remaining, uint32_t* timestamp,
+                                    const uint8_t** payload, size_t* payload_size);
+
 /* 音频数据包管理 */
 linx_audio_stream_packet_t* linx_audio_stream_packet_create(size_t payload_size);
 void linx_audio_stream_packet_destroy(linx_audio_stream_packet_t* packet);
 
+/**
+ * 复制一个（借用的）音频数据包，使其脱离回调生命周期
+ *
+ * 结构体与载荷在一次分配中完成，返回值用 linx_audio_stream_packet_destroy() 释放。
+ * @param packet 源数据包（通常为 on_incoming_audio 收到的借用视图）
+ * @return 新分配的数据包，失败返回 NULL
+ */
+linx_audio_stream_packet_t* linx_audio_stream_packet_retain(const linx_audio_stream_packet_t* packet);
+
 #ifdef __cplusplus
 }
 #endif
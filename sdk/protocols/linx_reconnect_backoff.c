@@ -0,0 +1,52 @@
+#include "linx_reconnect_backoff.h"
+#include <stddef.h>
+
+/* xorshift32：开销小，只需让不同设备的抖动互不相关 */
+static uint32_t linx_reconnect_backoff_xorshift(void* user_data) {
+    linx_reconnect_backoff_t* backoff = (linx_reconnect_backoff_t*)user_data;
+    uint32_t x = backoff->jitter_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    backoff->jitter_state = x;
+    return x;
+}
+
+void linx_reconnect_backoff_init(linx_reconnect_backoff_t* backoff, uint32_t base_ms, uint32_t max_ms, uint32_t seed) {
+    backoff->base_ms = base_ms > 0 ? base_ms : 1;
+    backoff->max_ms = max_ms > backoff->base_ms ? max_ms : backoff->base_ms;
+    backoff->attempts = 0;
+    backoff->jitter_state = seed != 0 ? seed : 0x9e3779b9u;
+    backoff->rand = NULL;
+    backoff->rand_data = NULL;
+}
+
+void linx_reconnect_backoff_set_rand(linx_reconnect_backoff_t* backoff, linx_reconnect_backoff_rand_t rand,
+                                     void* user_data) {
+    backoff->rand = rand;
+    backoff->rand_data = user_data;
+}
+
+int linx_reconnect_backoff_next(linx_reconnect_backoff_t* backoff, uint64_t* delay_ms) {
+    int attempt = __atomic_add_fetch(&backoff->attempts, 1, __ATOMIC_ACQ_REL);
+
+    uint64_t cap_ms = backoff->base_ms;
+    for (int i = 1; i < attempt && cap_ms < backoff->max_ms; i++) {
+        cap_ms <<= 1;
+    }
+    if (cap_ms > backoff->max_ms) {
+        cap_ms = backoff->max_ms;
+    }
+
+    uint32_t r = backoff->rand ? backoff->rand(backoff->rand_data) : linx_reconnect_backoff_xorshift(backoff);
+    *delay_ms = cap_ms / 2 + r % (cap_ms - cap_ms / 2 + 1);
+    return attempt;
+}
+
+int linx_reconnect_backoff_attempts(const linx_reconnect_backoff_t* backoff) {
+    return __atomic_load_n(&backoff->attempts, __ATOMIC_ACQUIRE);
+}
+
+void linx_reconnect_backoff_reset(linx_reconnect_backoff_t* backoff) {
+    __atomic_store_n(&backoff->attempts, 0, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,79 @@
+#ifndef LINX_RECONNECT_BACKOFF_H
+#define LINX_RECONNECT_BACKOFF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 随机数来源
+ *
+ * @param user_data 用户数据
+ * @return 32 位随机数
+ */
+typedef uint32_t (*linx_reconnect_backoff_rand_t)(void* user_data);
+
+/**
+ * 重连退避
+ *
+ * 第 n 次重连的延迟上限为 min(max_ms, base_ms * 2^(n-1))，实际延迟在
+ * [上限/2, 上限] 内随机取值（equal jitter）：同一次服务器重启断开的设备
+ * 不会同步重连，而每台设备仍至少等待一半的标称退避。
+ *
+ * 连续重连次数可在任意线程读取和清零；抽取下一次延迟只由事件循环线程调用。
+ */
+typedef struct {
+    uint32_t base_ms;               // 首次重连延迟上限（毫秒）
+    uint32_t max_ms;                // 重连延迟上限（毫秒）
+    int attempts;                   // 当前连续重连次数（原子访问）
+    uint32_t jitter_state;          // 内置 xorshift32 的状态
+    linx_reconnect_backoff_rand_t rand; // 随机数来源，NULL 使用内置 xorshift32
+    void* rand_data;                // 传给 rand 的用户数据
+} linx_reconnect_backoff_t;
+
+/**
+ * 初始化退避状态
+ *
+ * @param backoff 退避状态
+ * @param base_ms 首次重连延迟上限（毫秒），至少为 1
+ * @param max_ms 重连延迟上限（毫秒），小于 base_ms 时取 base_ms
+ * @param seed 内置随机数种子，0 时使用固定的非零种子
+ */
+void linx_reconnect_backoff_init(linx_reconnect_backoff_t* backoff, uint32_t base_ms, uint32_t max_ms, uint32_t seed);
+
+/**
+ * 替换随机数来源（测试中注入确定的序列）
+ *
+ * @param backoff 退避状态
+ * @param rand 随机数来源，NULL 恢复内置 xorshift32
+ * @param user_data 传给 rand 的用户数据
+ */
+void linx_reconnect_backoff_set_rand(linx_reconnect_backoff_t* backoff, linx_reconnect_backoff_rand_t rand,
+                                     void* user_data);
+
+/**
+ * 连续重连次数加一并抽取本次重连的延迟
+ *
+ * @param backoff 退避状态
+ * @param delay_ms 输出本次延迟（毫秒），不能为 NULL
+ * @return 加一后的连续重连次数
+ */
+int linx_reconnect_backoff_next(linx_reconnect_backoff_t* backoff, uint64_t* delay_ms);
+
+/**
+ * 获取当前连续重连次数，线程安全
+ */
+int linx_reconnect_backoff_attempts(const linx_reconnect_backoff_t* backoff);
+
+/**
+ * 清零连续重连次数，下一次重连重新从最短退避开始，线程安全
+ */
+void linx_reconnect_backoff_reset(linx_reconnect_backoff_t* backoff);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINX_RECONNECT_BACKOFF_H */
@@ -0,0 +1,49 @@
+#include "linx_rtt_window.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int linx_rtt_window_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void linx_rtt_window_reset(linx_rtt_window_t* window) {
+    memset(window, 0, sizeof(*window));
+}
+
+bool linx_rtt_window_add_pong(linx_rtt_window_t* window, uint64_t sent_us, uint64_t now_us, uint64_t max_age_us,
+                              uint32_t* rtt_us) {
+    if (sent_us == 0 || sent_us > now_us || now_us - sent_us > max_age_us) {
+        return false;
+    }
+
+    uint32_t rtt = (uint32_t)(now_us - sent_us);
+    window->samples[window->next % LINX_RTT_WINDOW_SIZE] = rtt;
+    window->next++;
+    if (rtt_us) {
+        *rtt_us = rtt;
+    }
+    return true;
+}
+
+void linx_rtt_window_summarize(const linx_rtt_window_t* window, linx_rtt_summary_t* summary) {
+    memset(summary, 0, sizeof(*summary));
+    uint32_t count = window->next < LINX_RTT_WINDOW_SIZE ? window->next : LINX_RTT_WINDOW_SIZE;
+    if (count == 0) {
+        return;
+    }
+
+    /* 窗口很小，按需排序副本，记录样本保持 O(1) */
+    uint32_t sorted[LINX_RTT_WINDOW_SIZE];
+    memcpy(sorted, window->samples, count * sizeof(uint32_t));
+    qsort(sorted, count, sizeof(uint32_t), linx_rtt_window_compare);
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        sum += sorted[i];
+    }
+    summary->samples = count;
+    summary->min_us = sorted[0];
+    summary->avg_us = (uint32_t)(sum / count);
+    summary->p99_us = sorted[(count * 99 + 99) / 100 - 1];
+}
@@ -0,0 +1,64 @@
+#ifndef LINX_RTT_WINDOW_H
+#define LINX_RTT_WINDOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LINX_RTT_WINDOW_SIZE    64      // 窗口样本数
+
+/* 窗口内样本的汇总 */
+typedef struct {
+    uint32_t samples;               // 窗口内样本数
+    uint32_t min_us;                // 最小 RTT（微秒）
+    uint32_t avg_us;                // 平均 RTT（微秒）
+    uint32_t p99_us;                // 99 分位 RTT（微秒）
+} linx_rtt_summary_t;
+
+/**
+ * 心跳 RTT 样本窗口
+ *
+ * 保存最近 LINX_RTT_WINDOW_SIZE 个样本，写满后覆盖最早的样本。
+ * 时间由调用方传入，不读取时钟；不加锁，由调用方同步。
+ */
+typedef struct {
+    uint32_t samples[LINX_RTT_WINDOW_SIZE]; // 样本环形数组（微秒）
+    uint32_t next;                  // 累计写入的样本数，取模即下一个写入位置
+} linx_rtt_window_t;
+
+/**
+ * 清空窗口
+ */
+void linx_rtt_window_reset(linx_rtt_window_t* window);
+
+/**
+ * 根据 pong 携带的 ping 发送时刻记录一个样本
+ *
+ * 发送时刻为 0、晚于 now_us，或早于 now_us 超过 max_age_us 的 pong
+ * 不是本端发出的或已过期，不记录。
+ *
+ * @param window 样本窗口
+ * @param sent_us ping 发送时刻（单调时钟微秒）
+ * @param now_us 收到 pong 的时刻（单调时钟微秒）
+ * @param max_age_us 样本的最大有效时长（微秒）
+ * @param rtt_us 输出记录的 RTT（微秒），可为 NULL
+ * @return 记录了样本返回 true
+ */
+bool linx_rtt_window_add_pong(linx_rtt_window_t* window, uint64_t sent_us, uint64_t now_us, uint64_t max_age_us,
+                              uint32_t* rtt_us);
+
+/**
+ * 汇总窗口内的样本；窗口为空时各项为 0
+ *
+ * 对样本副本排序，调用方可先在锁内复制窗口，再在锁外汇总。
+ */
+void linx_rtt_window_summarize(const linx_rtt_window_t* window, linx_rtt_summary_t* summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINX_RTT_WINDOW_H */
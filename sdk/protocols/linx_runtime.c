@@ -0,0 +1,407 @@
+#include "linx_runtime.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <mongoose.h>
+#include "linx_websocket.h"
+#include "../log/linx_log.h"
+
+/*
+ * 分片运行时：每个分片一个线程、一个 mg_mgr。
+ * 会话列表只由分片线程访问；其他线程通过任务队列 + mg_wakeup
+ * 把操作（挂载、启动、停止、卸载）投递到分片线程执行，
+ * 因此 mongoose 连接始终只被一个线程触碰。
+ * 分片线程同步调用其他分片时，等待期间继续执行投递给自己的任务，
+ * 因此分片之间相互回调不会死锁。
+ */
+
+struct linx_runtime_shard;
+
+/* 跨线程任务，生命周期属于调用方栈帧 */
+typedef struct linx_runtime_task {
+    linx_runtime_task_fn fn;
+    void* arg;
+    bool done;                              // 受 notify->lock 保护
+    struct linx_runtime_shard* notify;      // 完成时通知的分片（调用方所在分片或目标分片）
+    struct linx_runtime_task* next;
+} linx_runtime_task_t;
+
+typedef struct linx_runtime_shard {
+    linx_runtime_t* runtime;
+    int index;
+    struct mg_mgr mgr;                      // 分片的 mongoose 管理器
+    pthread_t thread;                       // 分片线程
+    bool thread_started;                    // 线程是否已创建
+
+    pthread_mutex_t lock;                   // 保护任务队列与统计
+    pthread_cond_t done_cond;               // 任务完成或（分片线程等待时）新任务入队通知
+    linx_runtime_task_t* task_head;         // 待执行任务
+    linx_runtime_task_t* task_tail;
+    bool closed;                            // 分片线程已退出循环，不再接受任务（受 lock 保护）
+
+    linx_websocket_protocol_t** sessions;   // 挂载的会话（仅分片线程访问）
+    size_t session_capacity;
+    size_t session_count;                   // 会话数（原子访问）
+    size_t reserved;                        // 含挂载中会话的计数，用于负载均衡（原子访问）
+    uint64_t next_deadline_ms;              // 最早的会话定时器截止时刻，0 表示无
+
+    linx_runtime_shard_stats_t stats;       // 受 lock 保护
+} linx_runtime_shard_t;
+
+struct linx_runtime {
+    linx_runtime_shard_t* shards;
+    size_t shard_count;
+    int max_wait_ms;
+    int running;                            // 原子访问
+};
+
+typedef struct {
+    linx_runtime_shard_t* shard;
+    linx_websocket_protocol_t* ws;
+    bool result;
+} linx_runtime_attach_ctx_t;
+
+static uint64_t linx_runtime_now_ms(void) {
+    return linx_send_queue_now_us() / 1000;
+}
+
+static linx_runtime_shard_t* linx_runtime_get_shard(const linx_runtime_t* runtime, int shard) {
+    if (!runtime || shard < 0 || (size_t)shard >= runtime->shard_count) {
+        return NULL;
+    }
+    return &runtime->shards[shard];
+}
+
+/* 执行已投递的任务并唤醒等待者（分片线程） */
+static void linx_runtime_run_tasks(linx_runtime_shard_t* shard) {
+    pthread_mutex_lock(&shard->lock);
+    linx_runtime_task_t* task = shard->task_head;
+    shard->task_head = shard->task_tail = NULL;
+    shard->stats.iterations++;
+    pthread_mutex_unlock(&shard->lock);
+
+    if (!task) {
+        return;
+    }
+
+    uint64_t executed = 0;
+    while (task) {
+        /* 任务完成后调用方可能立即返回并释放 task，先取出 next 与 notify */
+        linx_runtime_task_t* next = task->next;
+        linx_runtime_shard_t* notify = task->notify;
+        task->fn(task->arg);
+        pthread_mutex_lock(&notify->lock);
+        task->done = true;
+        pthread_cond_broadcast(&notify->done_cond);
+        pthread_mutex_unlock(&notify->lock);
+        executed++;
+        task = next;
+    }
+
+    pthread_mutex_lock(&shard->lock);
+    shard->stats.tasks += executed;
+    pthread_mutex_unlock(&shard->lock);
+
+    /* 任务可能改变了会话集合或其定时器，下一轮重新扫描 */
+    shard->next_deadline_ms = 1;
+}
+
+/* 驱动到期的会话定时器并计算下一个截止时刻（分片线程） */
+static void linx_runtime_scan_timers(linx_runtime_shard_t* shard) {
+    uint64_t next_deadline = 0;
+
+    /* 定时器处理可能触发回调并卸载会话，按下标遍历并每次重新检查边界 */
+    for (size_t i = 0; i < shard->session_count;) {
+        size_t count = shard->session_count;
+        uint64_t deadline = linx_websocket_service_timers(shard->sessions[i]);
+        if (deadline != 0 && (next_deadline == 0 || deadline < next_deadline)) {
+            next_deadline = deadline;
+        }
+        /* 卸载会把末尾会话换到空出的槽位，此时不前进，避免跳过换来的会话 */
+        if (shard->session_count >= count) {
+            i++;
+        }
+    }
+    shard->next_deadline_ms = next_deadline;
+
+    pthread_mutex_lock(&shard->lock);
+    shard->stats.timer_scans++;
+    pthread_mutex_unlock(&shard->lock);
+}
+
+static void* linx_runtime_shard_thread(void* arg) {
+    linx_runtime_shard_t* shard = (linx_runtime_shard_t*)arg;
+    linx_runtime_t* runtime = shard->runtime;
+
+    LOG_DEBUG("Runtime shard %d started", shard->index);
+    while (__atomic_load_n(&runtime->running, __ATOMIC_ACQUIRE)) {
+        int timeout_ms = runtime->max_wait_ms;
+        if (shard->next_deadline_ms != 0) {
+            uint64_t now_ms = linx_runtime_now_ms();
+            uint64_t remaining_ms = shard->next_deadline_ms > now_ms ? shard->next_deadline_ms - now_ms : 0;
+            if (remaining_ms < (uint64_t)timeout_ms) {
+                timeout_ms = (int)remaining_ms;
+            }
+        }
+
+        mg_mgr_poll(&shard->mgr, timeout_ms);
+        linx_runtime_run_tasks(shard);
+
+        if (shard->next_deadline_ms != 0 && linx_runtime_now_ms() >= shard->next_deadline_ms) {
+            linx_runtime_scan_timers(shard);
+        }
+    }
+
+    /* 先拒绝新任务再处理最后一批，已入队的任务都会执行，调用方不会永久等待 */
+    pthread_mutex_lock(&shard->lock);
+    shard->closed = true;
+    pthread_mutex_unlock(&shard->lock);
+    linx_runtime_run_tasks(shard);
+    LOG_DEBUG("Runtime shard %d stopped", shard->index);
+    return NULL;
+}
+
+linx_runtime_t* linx_runtime_create(const linx_runtime_config_t* config) {
+    size_t shard_count = config ? config->shard_count : 0;
+    if (shard_count == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        shard_count = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    linx_runtime_t* runtime = calloc(1, sizeof(linx_runtime_t));
+    if (!runtime) {
+        LOG_ERROR("Runtime creation failed: memory allocation failed");
+        return NULL;
+    }
+
+    runtime->shards = calloc(shard_count, sizeof(linx_runtime_shard_t));
+    if (!runtime->shards) {
+        LOG_ERROR("Runtime creation failed: cannot allocate %zu shards", shard_count);
+        free(runtime);
+        return NULL;
+    }
+
+    runtime->shard_count = shard_count;
+    runtime->max_wait_ms = config && config->max_wait_ms > 0 ? config->max_wait_ms : LINX_RUNTIME_MAX_WAIT_MS;
+    runtime->running = 1;
+
+    for (size_t i = 0; i < shard_count; i++) {
+        linx_runtime_shard_t* shard = &runtime->shards[i];
+        shard->runtime = runtime;
+        shard->index = (int)i;
+        pthread_mutex_init(&shard->lock, NULL);
+        pthread_cond_init(&shard->done_cond, NULL);
+        mg_mgr_init(&shard->mgr);
+        if (!mg_wakeup_init(&shard->mgr)) {
+            LOG_ERROR("Runtime creation failed: shard %zu wakeup pipe unavailable", i);
+            linx_runtime_destroy(runtime);
+            return NULL;
+        }
+        if (pthread_create(&shard->thread, NULL, linx_runtime_shard_thread, shard) != 0) {
+            LOG_ERROR("Runtime creation failed: cannot start shard %zu thread", i);
+            linx_runtime_destroy(runtime);
+            return NULL;
+        }
+        shard->thread_started = true;
+    }
+
+    LOG_INFO("Runtime created - shards: %zu", shard_count);
+    return runtime;
+}
+
+void linx_runtime_destroy(linx_runtime_t* runtime) {
+    if (!runtime) {
+        return;
+    }
+
+    __atomic_store_n(&runtime->running, 0, __ATOMIC_RELEASE);
+    for (size_t i = 0; i < runtime->shard_count; i++) {
+        linx_runtime_shard_t* shard = &runtime->shards[i];
+        if (shard->thread_started) {
+            mg_wakeup(&shard->mgr, LINX_WEBSOCKET_WAKEUP_ANY_ID, "", 0);
+            pthread_join(shard->thread, NULL);
+        }
+    }
+
+    for (size_t i = 0; i < runtime->shard_count; i++) {
+        linx_runtime_shard_t* shard = &runtime->shards[i];
+        if (shard->session_count > 0) {
+            LOG_WARN("Runtime shard %zu destroyed with %zu sessions attached", i, shard->session_count);
+        }
+        if (shard->runtime) {
+            mg_mgr_free(&shard->mgr);
+            pthread_mutex_destroy(&shard->lock);
+            pthread_cond_destroy(&shard->done_cond);
+        }
+        free(shard->sessions);
+    }
+
+    free(runtime->shards);
+    free(runtime);
+    LOG_INFO("Runtime destroyed");
+}
+
+size_t linx_runtime_get_shard_count(const linx_runtime_t* runtime) {
+    return runtime ? runtime->shard_count : 0;
+}
+
+bool linx_runtime_on_shard(const linx_runtime_t* runtime, int shard) {
+    const linx_runtime_shard_t* s = linx_runtime_get_shard(runtime, shard);
+    return s && s->thread_started && pthread_equal(s->thread, pthread_self());
+}
+
+/* 当前线程所在的分片，非分片线程返回 NULL */
+static linx_runtime_shard_t* linx_runtime_current_shard(linx_runtime_t* runtime) {
+    for (size_t i = 0; i < runtime->shard_count; i++) {
+        if (linx_runtime_on_shard(runtime, (int)i)) {
+            return &runtime->shards[i];
+        }
+    }
+    return NULL;
+}
+
+bool linx_runtime_call(linx_runtime_t* runtime, int shard, linx_runtime_task_fn fn, void* arg) {
+    linx_runtime_shard_t* s = linx_runtime_get_shard(runtime, shard);
+    if (!s || !fn) {
+        return false;
+    }
+
+    if (linx_runtime_on_shard(runtime, shard)) {
+        fn(arg);
+        return true;
+    }
+
+    /* 分片线程调用其他分片时由自己的分片接收完成通知，等待期间执行投递给自己的任务 */
+    linx_runtime_shard_t* self = linx_runtime_current_shard(runtime);
+    linx_runtime_task_t task = { .fn = fn, .arg = arg, .done = false, .notify = self ? self : s, .next = NULL };
+
+    pthread_mutex_lock(&s->lock);
+    if (s->closed || !__atomic_load_n(&runtime->running, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_unlock(&s->lock);
+        return false;
+    }
+    if (s->task_tail) {
+        s->task_tail->next = &task;
+    } else {
+        s->task_head = &task;
+    }
+    s->task_tail = &task;
+    /* 目标分片线程可能正阻塞在对其他分片的调用中 */
+    pthread_cond_broadcast(&s->done_cond);
+    pthread_mutex_unlock(&s->lock);
+
+    mg_wakeup(&s->mgr, LINX_WEBSOCKET_WAKEUP_ANY_ID, "", 0);
+
+    linx_runtime_shard_t* notify = task.notify;
+    pthread_mutex_lock(&notify->lock);
+    while (!task.done) {
+        if (self && self->task_head) {
+            pthread_mutex_unlock(&notify->lock);
+            linx_runtime_run_tasks(self);
+            pthread_mutex_lock(&notify->lock);
+            continue;
+        }
+        pthread_cond_wait(&notify->done_cond, &notify->lock);
+    }
+    pthread_mutex_unlock(&notify->lock);
+    return true;
+}
+
+static void linx_runtime_attach_task(void* arg) {
+    linx_runtime_attach_ctx_t* ctx = (linx_runtime_attach_ctx_t*)arg;
+    linx_runtime_shard_t* shard = ctx->shard;
+
+    if (shard->session_count == shard->session_capacity) {
+        size_t capacity = shard->session_capacity ? shard->session_capacity * 2 : 16;
+        linx_websocket_protocol_t** sessions = realloc(shard->sessions, capacity * sizeof(*sessions));
+        if (!sessions) {
+            LOG_ERROR("Runtime shard %d cannot grow session table", shard->index);
+            ctx->result = false;
+            return;
+        }
+        shard->sessions = sessions;
+        shard->session_capacity = capacity;
+    }
+
+    shard->sessions[shard->session_count] = ctx->ws;
+    __atomic_store_n(&shard->session_count, shard->session_count + 1, __ATOMIC_RELEASE);
+    ctx->result = true;
+}
+
+int linx_runtime_attach(linx_runtime_t* runtime, struct linx_websocket_protocol* ws, int shard,
+                        struct mg_mgr** mgr) {
+    if (!runtime || !ws || !mgr) {
+        return -1;
+    }
+
+    if (shard == LINX_RUNTIME_AUTO_SHARD) {
+        /* 选择会话最少的分片；并发挂载时的计数竞争只影响均衡程度 */
+        size_t best_load = (size_t)-1;
+        for (size_t i = 0; i < runtime->shard_count; i++) {
+            size_t load = __atomic_load_n(&runtime->shards[i].reserved, __ATOMIC_RELAXED);
+            if (load < best_load) {
+                best_load = load;
+                shard = (int)i;
+            }
+        }
+    }
+
+    linx_runtime_shard_t* s = linx_runtime_get_shard(runtime, shard);
+    if (!s) {
+        LOG_ERROR("Runtime attach failed: invalid shard %d", shard);
+        return -1;
+    }
+
+    __atomic_add_fetch(&s->reserved, 1, __ATOMIC_RELAXED);
+    linx_runtime_attach_ctx_t ctx = { .shard = s, .ws = ws, .result = false };
+    if (!linx_runtime_call(runtime, shard, linx_runtime_attach_task, &ctx) || !ctx.result) {
+        __atomic_sub_fetch(&s->reserved, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    *mgr = &s->mgr;
+    LOG_DEBUG("Runtime attached session %p to shard %d", (void*)ws, shard);
+    return shard;
+}
+
+void linx_runtime_detach(linx_runtime_t* runtime, struct linx_websocket_protocol* ws, int shard) {
+    linx_runtime_shard_t* s = linx_runtime_get_shard(runtime, shard);
+    if (!s || !ws) {
+        return;
+    }
+
+    for (size_t i = 0; i < s->session_count; i++) {
+        if (s->sessions[i] == ws) {
+            s->sessions[i] = s->sessions[s->session_count - 1];
+            __atomic_store_n(&s->session_count, s->session_count - 1, __ATOMIC_RELEASE);
+            __atomic_sub_fetch(&s->reserved, 1, __ATOMIC_RELAXED);
+            LOG_DEBUG("Runtime detached session %p from shard %d", (void*)ws, shard);
+            return;
+        }
+    }
+}
+
+void linx_runtime_schedule(linx_runtime_t* runtime, int shard, uint64_t deadline_ms) {
+    linx_runtime_shard_t* s = linx_runtime_get_shard(runtime, shard);
+    if (!s || deadline_ms == 0) {
+        return;
+    }
+
+    if (s->next_deadline_ms == 0 || deadline_ms < s->next_deadline_ms) {
+        s->next_deadline_ms = deadline_ms;
+    }
+}
+
+bool linx_runtime_get_shard_stats(linx_runtime_t* runtime, int shard, linx_runtime_shard_stats_t* stats) {
+    linx_runtime_shard_t* s = linx_runtime_get_shard(runtime, shard);
+    if (!s || !stats) {
+        return false;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    *stats = s->stats;
+    pthread_mutex_unlock(&s->lock);
+    stats->sessions = __atomic_load_n(&s->session_count, __ATOMIC_ACQUIRE);
+    return true;
+}
@@ -0,0 +1,129 @@
+#ifndef LINX_RUNTIME_H
+#define LINX_RUNTIME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 默认运行时参数 */
+#define LINX_RUNTIME_MAX_WAIT_MS    1000    // 分片事件循环最长阻塞时间（毫秒）
+#define LINX_RUNTIME_AUTO_SHARD     (-1)    // 自动选择会话数最少的分片
+
+/* 运行时配置 */
+typedef struct {
+    size_t shard_count;             // 事件循环线程数，0 表示每个在线 CPU 一个
+    int max_wait_ms;                // 单次 mg_mgr_poll 最长阻塞（毫秒），0 使用默认值
+} linx_runtime_config_t;
+
+/* 分片统计 */
+typedef struct {
+    size_t sessions;                // 当前挂载的会话数
+    uint64_t iterations;            // 事件循环迭代次数
+    uint64_t tasks;                 // 执行的跨线程任务数
+    uint64_t timer_scans;           // 会话定时器扫描次数
+} linx_runtime_shard_stats_t;
+
+/* 在分片线程上执行的任务 */
+typedef void (*linx_runtime_task_fn)(void* arg);
+
+/* 前向声明 */
+typedef struct linx_runtime linx_runtime_t;
+struct mg_mgr;
+struct linx_websocket_protocol;
+
+/**
+ * 创建分片运行时
+ *
+ * 运行时拥有 shard_count 个事件循环线程，每个线程持有一个 mg_mgr，
+ * 承载多个 WebSocket 会话。会话在创建时固定到某个分片，其连接、
+ * 定时器（心跳、重连）和全部回调都在该分片线程上执行。
+ *
+ * @param config 运行时配置，NULL 使用默认值
+ * @return 运行时实例，失败返回 NULL
+ */
+linx_runtime_t* linx_runtime_create(const linx_runtime_config_t* config);
+
+/**
+ * 停止所有分片线程并销毁运行时
+ *
+ * 调用前应先销毁挂载在运行时上的全部会话。
+ * @param runtime 运行时实例
+ */
+void linx_runtime_destroy(linx_runtime_t* runtime);
+
+/**
+ * 获取分片数
+ * @param runtime 运行时实例
+ * @return 分片数
+ */
+size_t linx_runtime_get_shard_count(const linx_runtime_t* runtime);
+
+/**
+ * 在指定分片线程上同步执行任务
+ *
+ * 当前线程就是该分片线程时直接调用，否则入队、唤醒分片并等待任务完成。
+ * 从另一个分片线程调用时，等待期间继续执行投递给调用方分片的任务，
+ * 因此目标任务可以同步回调调用方分片。
+ * @param runtime 运行时实例
+ * @param shard 分片序号
+ * @param fn 任务函数
+ * @param arg 任务参数
+ * @return 任务已执行返回 true；参数无效或运行时正在停止返回 false
+ */
+bool linx_runtime_call(linx_runtime_t* runtime, int shard, linx_runtime_task_fn fn, void* arg);
+
+/**
+ * 当前线程是否为指定分片的事件循环线程
+ * @param runtime 运行时实例
+ * @param shard 分片序号
+ * @return 是返回 true
+ */
+bool linx_runtime_on_shard(const linx_runtime_t* runtime, int shard);
+
+/**
+ * 将会话挂载到分片（由 WebSocket 协议层在创建时调用）
+ *
+ * 成功后 ws 使用分片的 mg_mgr 与线程，由分片负责驱动其定时器。
+ * @param runtime 运行时实例
+ * @param ws WebSocket 会话
+ * @param shard 分片序号，LINX_RUNTIME_AUTO_SHARD 选择会话数最少的分片
+ * @param mgr 输出分片的 mg_mgr
+ * @return 实际挂载的分片序号，失败返回 -1
+ */
+int linx_runtime_attach(linx_runtime_t* runtime, struct linx_websocket_protocol* ws, int shard,
+                        struct mg_mgr** mgr);
+
+/**
+ * 将会话从分片卸载（仅分片线程调用，通常经 linx_runtime_call 进入）
+ * @param runtime 运行时实例
+ * @param ws WebSocket 会话
+ * @param shard 会话所在分片
+ */
+void linx_runtime_detach(linx_runtime_t* runtime, struct linx_websocket_protocol* ws, int shard);
+
+/**
+ * 通知分片某会话的下一个定时器截止时刻提前（仅分片线程调用）
+ * @param runtime 运行时实例
+ * @param shard 会话所在分片
+ * @param deadline_ms 截止时刻（单调时钟毫秒）
+ */
+void linx_runtime_schedule(linx_runtime_t* runtime, int shard, uint64_t deadline_ms);
+
+/**
+ * 获取分片统计
+ * @param runtime 运行时实例
+ * @param shard 分片序号
+ * @param stats 输出统计数据
+ * @return 成功返回 true
+ */
+bool linx_runtime_get_shard_stats(linx_runtime_t* runtime, int shard, linx_runtime_shard_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINX_RUNTIME_H */
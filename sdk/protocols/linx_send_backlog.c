@@ -0,0 +1,134 @@
+#include "linx_send_backlog.h"
+#include <string.h>
+
+/*
+ * 音频与控制记录都是按偏移递增的环形数组。缓冲区头部写出、剪除一条音频
+ * 或把文本前移时，记录中的偏移随字节的移动整体修正。
+ */
+
+static void linx_send_backlog_pop_audio(linx_send_backlog_t* backlog) {
+    backlog->audio_head = (backlog->audio_head + 1) % LINX_SEND_BACKLOG_AUDIO_MAX;
+    backlog->audio_count--;
+}
+
+/* 所有音频记录的偏移加上 delta */
+static void linx_send_backlog_shift_audio(linx_send_backlog_t* backlog, ptrdiff_t delta) {
+    for (size_t i = 0; i < backlog->audio_count; i++) {
+        size_t index = (backlog->audio_head + i) % LINX_SEND_BACKLOG_AUDIO_MAX;
+        backlog->audio[index].offset += delta;
+    }
+}
+
+/* 末尾位于 from 之后的控制消息移动 delta 字节 */
+static void linx_send_backlog_shift_control(linx_send_backlog_t* backlog, size_t from, ptrdiff_t delta) {
+    for (size_t i = 0; i < backlog->control_count; i++) {
+        size_t index = (backlog->control_head + i) % LINX_SEND_BACKLOG_CONTROL_MAX;
+        if (backlog->control[index].end > from) {
+            backlog->control[index].end += delta;
+        }
+    }
+}
+
+static void linx_send_backlog_reverse(uint8_t* buf, size_t len) {
+    for (size_t i = 0, j = len; i + 1 < j; i++, j--) {
+        uint8_t tmp = buf[i];
+        buf[i] = buf[j - 1];
+        buf[j - 1] = tmp;
+    }
+}
+
+void linx_send_backlog_reset(linx_send_backlog_t* backlog, bool editable) {
+    backlog->audio_head = 0;
+    backlog->audio_count = 0;
+    backlog->control_head = 0;
+    backlog->control_count = 0;
+    backlog->editable = editable;
+}
+
+void linx_send_backlog_track_audio(linx_send_backlog_t* backlog, size_t offset, size_t length, uint32_t frames) {
+    if (backlog->audio_count == LINX_SEND_BACKLOG_AUDIO_MAX) {
+        return;
+    }
+
+    size_t tail = (backlog->audio_head + backlog->audio_count) % LINX_SEND_BACKLOG_AUDIO_MAX;
+    backlog->audio[tail].offset = offset;
+    backlog->audio[tail].length = length;
+    backlog->audio[tail].frames = frames;
+    backlog->audio_count++;
+}
+
+void linx_send_backlog_track_control(linx_send_backlog_t* backlog, size_t end, uint64_t submit_us) {
+    if (backlog->control_count == LINX_SEND_BACKLOG_CONTROL_MAX) {
+        return;
+    }
+
+    size_t tail = (backlog->control_head + backlog->control_count) % LINX_SEND_BACKLOG_CONTROL_MAX;
+    backlog->control[tail].end = end;
+    backlog->control[tail].submit_us = submit_us;
+    backlog->control_count++;
+}
+
+uint32_t linx_send_backlog_evict_oldest(linx_send_backlog_t* backlog, uint8_t* buf, size_t* len) {
+    if (!backlog->editable || backlog->audio_count == 0) {
+        return 0;
+    }
+
+    const linx_send_backlog_audio_t* oldest = &backlog->audio[backlog->audio_head];
+    size_t offset = oldest->offset;
+    size_t length = oldest->length;
+    uint32_t frames = oldest->frames;
+    memmove(buf + offset, buf + offset + length, *len - offset - length);
+    *len -= length;
+
+    linx_send_backlog_pop_audio(backlog);
+    linx_send_backlog_shift_audio(backlog, -(ptrdiff_t)length);
+    linx_send_backlog_shift_control(backlog, offset, -(ptrdiff_t)length);
+    return frames;
+}
+
+size_t linx_send_backlog_promote(linx_send_backlog_t* backlog, uint8_t* buf, size_t offset, size_t length) {
+    if (!backlog->editable || backlog->audio_count == 0) {
+        return offset + length;
+    }
+
+    size_t target = backlog->audio[backlog->audio_head].offset;
+    if (target >= offset) {
+        return offset + length;
+    }
+
+    /* 三次翻转把 [target, offset) 与 [offset, offset + length) 原地交换 */
+    uint8_t* region = buf + target;
+    size_t audio_len = offset - target;
+    linx_send_backlog_reverse(region, audio_len);
+    linx_send_backlog_reverse(region + audio_len, length);
+    linx_send_backlog_reverse(region, audio_len + length);
+
+    linx_send_backlog_shift_control(backlog, target, (ptrdiff_t)length);
+    linx_send_backlog_shift_audio(backlog, (ptrdiff_t)length);
+    return target + length;
+}
+
+void linx_send_backlog_on_written(linx_send_backlog_t* backlog, size_t written, uint64_t now_us,
+                                  linx_send_backlog_written_t* done) {
+    memset(done, 0, sizeof(*done));
+
+    /* 套接字已开始写出的音频不能再剪除 */
+    while (backlog->audio_count > 0 && backlog->audio[backlog->audio_head].offset < written) {
+        linx_send_backlog_pop_audio(backlog);
+    }
+    linx_send_backlog_shift_audio(backlog, -(ptrdiff_t)written);
+
+    /* 整条交给套接字的控制消息：记录其时延 */
+    while (backlog->control_count > 0 && backlog->control[backlog->control_head].end <= written) {
+        uint64_t submit_us = backlog->control[backlog->control_head].submit_us;
+        uint64_t latency_us = now_us > submit_us ? now_us - submit_us : 0;
+        done->control_frames++;
+        done->total_latency_us += latency_us;
+        if (latency_us > done->max_latency_us) {
+            done->max_latency_us = latency_us;
+        }
+        backlog->control_head = (backlog->control_head + 1) % LINX_SEND_BACKLOG_CONTROL_MAX;
+        backlog->control_count--;
+    }
+    linx_send_backlog_shift_control(backlog, 0, -(ptrdiff_t)written);
+}
@@ -0,0 +1,109 @@
+#ifndef LINX_SEND_BACKLOG_H
+#define LINX_SEND_BACKLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 记录容量 */
+#define LINX_SEND_BACKLOG_AUDIO_MAX     128     // 可回收的未发送音频消息记录数
+#define LINX_SEND_BACKLOG_CONTROL_MAX   16      // 等待写出的控制消息记录数（用于时延统计）
+
+/* 发送缓冲区中尚未开始写出的一条音频消息（偏移相对于缓冲区起始） */
+typedef struct {
+    size_t offset;
+    size_t length;
+    uint32_t frames;                // 消息承载的音频帧数（多帧打包时大于 1）
+} linx_send_backlog_audio_t;
+
+/* 发送缓冲区中等待写出的一条控制消息 */
+typedef struct {
+    size_t end;                     // 消息末尾在缓冲区中的偏移
+    uint64_t submit_us;             // 调用发送接口的时刻（单调时钟微秒）
+} linx_send_backlog_control_t;
+
+/* 一次写出中完整交给套接字的控制消息 */
+typedef struct {
+    uint64_t control_frames;        // 控制消息数
+    uint64_t total_latency_us;      // 从发送调用到写出的总时延（微秒）
+    uint64_t max_latency_us;        // 最大时延（微秒）
+} linx_send_backlog_written_t;
+
+/**
+ * 发送缓冲区簿记
+ *
+ * 记录音频消息与控制消息在发送缓冲区（mongoose 的 conn->send）中的位置，
+ * 以便把套接字尚未开始写出的音频整条剪掉（DROP_OLDEST），或让文本消息
+ * 越过它们，并在缓冲区头部被写出时同步修正所有偏移。缓冲区中每条消息都是
+ * 完整且独立掩码的 WebSocket 帧，整帧移动或删除不会破坏字节流；不经本模块
+ * 写入的字节（pong、close 帧）不被记录，也就不会被移动。
+ *
+ * 只由事件循环线程访问，不加锁。
+ */
+typedef struct {
+    linx_send_backlog_audio_t audio[LINX_SEND_BACKLOG_AUDIO_MAX]; // 可回收的音频消息，按偏移递增
+    size_t audio_head;              // 最早一条音频记录的位置
+    size_t audio_count;             // 音频记录条数
+    linx_send_backlog_control_t control[LINX_SEND_BACKLOG_CONTROL_MAX]; // 尚未写出的控制消息
+    size_t control_head;            // 最早一条控制消息记录的位置
+    size_t control_count;           // 控制消息记录条数
+    bool editable;                  // 是否允许改写缓冲区；TLS 可能从缓冲区头部重试半条记录，此时为 false
+} linx_send_backlog_t;
+
+/**
+ * 清空所有记录
+ *
+ * @param backlog 簿记
+ * @param editable 是否允许剪除或重排缓冲区中的消息（TLS 连接传 false）
+ */
+void linx_send_backlog_reset(linx_send_backlog_t* backlog, bool editable);
+
+/**
+ * 记录刚追加到缓冲区末尾的一条音频消息；记录已满时不记录，该消息不会被剪除或越过
+ */
+void linx_send_backlog_track_audio(linx_send_backlog_t* backlog, size_t offset, size_t length, uint32_t frames);
+
+/**
+ * 记录一条控制消息的末尾位置，写出后据此统计时延；记录已满时不记录
+ */
+void linx_send_backlog_track_control(linx_send_backlog_t* backlog, size_t end, uint64_t submit_us);
+
+/**
+ * 从缓冲区剪掉最早一条尚未开始写出的音频消息
+ *
+ * @param backlog 簿记
+ * @param buf 发送缓冲区
+ * @param len 缓冲区数据长度，剪除后减去消息长度
+ * @return 被剪掉的音频帧数；没有可剪除的消息或不允许改写缓冲区时返回 0
+ */
+uint32_t linx_send_backlog_evict_oldest(linx_send_backlog_t* backlog, uint8_t* buf, size_t* len);
+
+/**
+ * 把刚追加在 [offset, offset + length) 的文本消息原地移到最早一条未写出的音频消息之前
+ *
+ * @return 文本消息移动后的末尾偏移；无需或不允许移动时为 offset + length
+ */
+size_t linx_send_backlog_promote(linx_send_backlog_t* backlog, uint8_t* buf, size_t offset, size_t length);
+
+/**
+ * 套接字从缓冲区头部写出了 written 字节
+ *
+ * 已开始写出的音频消息不再可剪除；末尾已写出的控制消息按 now_us 计算时延并汇总到 done。
+ *
+ * @param backlog 簿记
+ * @param written 写出的字节数
+ * @param now_us 当前时刻（单调时钟微秒）
+ * @param done 输出本次完成的控制消息统计，不能为 NULL
+ */
+void linx_send_backlog_on_written(linx_send_backlog_t* backlog, size_t written, uint64_t now_us,
+                                  linx_send_backlog_written_t* done);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINX_SEND_BACKLOG_H */
@@ -0,0 +1,216 @@
+#include "linx_send_queue.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "../log/linx_log.h"
+
+/*
+ * 基于序列号的有界 MPSC 环形队列（Vyukov 算法）。
+ * 每个槽位携带一个序列号：
+ *   sequence == pos       槽位空闲，可被位置 pos 的生产者占用
+ *   sequence == pos + 1   槽位已发布，可被消费者读取
+ * 生产者通过 CAS 推进 enqueue_pos 抢占槽位，写完数据后以 release 语义发布；
+ * 消费者独占 dequeue_pos，读完后把序列号推进一整圈以归还槽位。
+ */
+
+#define LINX_CACHE_LINE_SIZE 64
+
+typedef struct {
+    size_t sequence;                // 槽位序列号（原子访问）
+    linx_send_frame_t frame;        // 帧数据
+} linx_send_slot_t;
+
+struct linx_send_queue {
+    linx_send_slot_t* slots;        // 槽位数组
+    size_t capacity;                // 槽位数（2的幂）
+    size_t mask;                    // capacity - 1
+    char pad0[LINX_CACHE_LINE_SIZE];
+    size_t enqueue_pos;             // 生产者位置（原子访问）
+    char pad1[LINX_CACHE_LINE_SIZE];
+    size_t dequeue_pos;             // 消费者位置（仅消费者写入）
+    char pad2[LINX_CACHE_LINE_SIZE];
+};
+
+uint64_t linx_send_queue_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+linx_send_queue_t* linx_send_queue_create(size_t capacity) {
+    if (capacity == 0) {
+        capacity = LINX_SEND_QUEUE_DEFAULT_CAPACITY;
+    }
+    capacity = round_up_pow2(capacity < 2 ? 2 : capacity);
+
+    linx_send_queue_t* queue = calloc(1, sizeof(linx_send_queue_t));
+    if (!queue) {
+        LOG_ERROR("Send queue creation failed: memory allocation failed");
+        return NULL;
+    }
+
+    queue->slots = calloc(capacity, sizeof(linx_send_slot_t));
+    if (!queue->slots) {
+        LOG_ERROR("Send queue creation failed: cannot allocate %zu slots", capacity);
+        free(queue);
+        return NULL;
+    }
+
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    for (size_t i = 0; i < capacity; i++) {
+        queue->slots[i].sequence = i;
+    }
+    queue->enqueue_pos = 0;
+    queue->dequeue_pos = 0;
+
+    LOG_DEBUG("Send queue created - capacity: %zu", capacity);
+    return queue;
+}
+
+void linx_send_queue_destroy(linx_send_queue_t* queue) {
+    if (!queue) {
+        return;
+    }
+
+    for (size_t i = 0; i < queue->capacity; i++) {
+        free(queue->slots[i].frame.data);
+    }
+    free(queue->slots);
+    free(queue);
+}
+
+linx_send_frame_t* linx_send_queue_reserve(linx_send_queue_t* queue, linx_send_frame_type_t type, size_t size) {
+    if (!queue) {
+        return NULL;
+    }
+
+    linx_send_slot_t* slot;
+    size_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        slot = &queue->slots[pos & queue->mask];
+        size_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return NULL;    /* 队列已满 */
+        } else {
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    /* 槽位已被当前生产者独占，按需扩容缓冲区 */
+    linx_send_frame_t* frame = &slot->frame;
+    frame->type = type;
+    frame->size = 0;
+    if (frame->capacity < size) {
+        size_t new_capacity = size > LINX_SEND_QUEUE_DEFAULT_SLOT_SIZE ? size : LINX_SEND_QUEUE_DEFAULT_SLOT_SIZE;
+        uint8_t* buffer = realloc(frame->data, new_capacity);
+        if (!buffer) {
+            /* 槽位已占用，只能以空帧发布，消费者会跳过 */
+            LOG_ERROR("Send queue reserve failed: cannot grow slot to %zu bytes", new_capacity);
+            __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+            return NULL;
+        }
+        frame->data = buffer;
+        frame->capacity = new_capacity;
+    }
+    return frame;
+}
+
+void linx_send_queue_commit(linx_send_queue_t* queue, linx_send_frame_t* frame, size_t size, uint32_t timestamp) {
+    if (!queue || !frame) {
+        return;
+    }
+
+    /* frame 是槽位的成员，未发布前序列号仍等于占用时的位置 */
+    linx_send_slot_t* slot = (linx_send_slot_t*)((char*)frame - offsetof(linx_send_slot_t, frame));
+    size_t pos = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+
+    frame->timestamp = timestamp;
+    frame->enqueue_time_us = linx_send_queue_now_us();
+    frame->size = size <= frame->capacity ? size : 0;
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+}
+
+bool linx_send_queue_push(linx_send_queue_t* queue, linx_send_frame_type_t type,
+                          const void* data, size_t size, uint32_t timestamp) {
+    if (!queue || (!data && size > 0)) {
+        return false;
+    }
+
+    linx_send_frame_t* frame = linx_send_queue_reserve(queue, type, size);
+    if (!frame) {
+        return false;
+    }
+    if (size > 0) {
+        memcpy(frame->data, data, size);
+    }
+    linx_send_queue_commit(queue, frame, size, timestamp);
+    return true;
+}
+
+linx_send_frame_t* linx_send_queue_peek(linx_send_queue_t* queue) {
+    if (!queue) {
+        return NULL;
+    }
+
+    size_t pos = queue->dequeue_pos;
+    linx_send_slot_t* slot = &queue->slots[pos & queue->mask];
+    size_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    if (seq != pos + 1) {
+        return NULL;
+    }
+    return &slot->frame;
+}
+
+void linx_send_queue_pop(linx_send_queue_t* queue) {
+    if (!queue) {
+        return;
+    }
+
+    size_t pos = queue->dequeue_pos;
+    linx_send_slot_t* slot = &queue->slots[pos & queue->mask];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+        return;
+    }
+
+    __atomic_store_n(&slot->sequence, pos + queue->capacity, __ATOMIC_RELEASE);
+    __atomic_store_n(&queue->dequeue_pos, pos + 1, __ATOMIC_RELEASE);
+}
+
+size_t linx_send_queue_clear(linx_send_queue_t* queue) {
+    size_t dropped = 0;
+    while (linx_send_queue_peek(queue)) {
+        linx_send_queue_pop(queue);
+        dropped++;
+    }
+    return dropped;
+}
+
+size_t linx_send_queue_depth(const linx_send_queue_t* queue) {
+    if (!queue) {
+        return 0;
+    }
+
+    size_t tail = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_ACQUIRE);
+    size_t head = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_ACQUIRE);
+    return head > tail ? head - tail : 0;
+}
+
+size_t linx_send_queue_capacity(const linx_send_queue_t* queue) {
+    return queue ? queue->capacity : 0;
+}
@@ -0,0 +1,131 @@
+#ifndef LINX_SEND_QUEUE_H
+#define LINX_SEND_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 默认队列参数 */
+#define LINX_SEND_QUEUE_DEFAULT_CAPACITY    64      // 默认槽位数（必须为2的幂）
+#define LINX_SEND_QUEUE_DEFAULT_SLOT_SIZE   512     // 槽位缓冲区初始大小（字节）
+
+/* 上行帧类型 */
+typedef enum {
+    LINX_SEND_FRAME_AUDIO,          // 音频帧（按协议版本封装为二进制帧）
+    LINX_SEND_FRAME_TEXT            // 文本帧（JSON 消息）
+} linx_send_frame_type_t;
+
+/* 队列中的一帧数据 */
+typedef struct {
+    linx_send_frame_type_t type;    // 帧类型
+    uint32_t timestamp;             // 音频时间戳（毫秒，仅音频帧有效）
+    uint64_t enqueue_time_us;       // 入队时刻（单调时钟，微秒）
+    uint8_t* data;                  // 帧数据（槽位自有缓冲区）
+    size_t size;                    // 数据长度
+    size_t capacity;                // 缓冲区容量
+} linx_send_frame_t;
+
+/* 前向声明 */
+typedef struct linx_send_queue linx_send_queue_t;
+
+/**
+ * 创建上行发送队列
+ *
+ * 有界无锁多生产者/单消费者（MPSC）环形队列：任意线程都可以调用
+ * linx_send_queue_push() 入队，只有事件循环线程出队并写入连接。
+ * 槽位缓冲区在首次使用时分配并在后续复用，稳态下入队不再分配内存。
+ *
+ * @param capacity 槽位数，0 使用默认值，非2的幂时向上取整
+ * @return 队列实例，失败返回 NULL
+ */
+linx_send_queue_t* linx_send_queue_create(size_t capacity);
+
+/**
+ * 销毁发送队列并释放所有槽位缓冲区
+ * @param queue 队列实例
+ */
+void linx_send_queue_destroy(linx_send_queue_t* queue);
+
+/**
+ * 入队一帧数据（生产者侧，线程安全，无锁）
+ * @param queue 队列实例
+ * @param type 帧类型
+ * @param data 帧数据，入队时复制
+ * @param size 数据长度
+ * @param timestamp 音频时间戳
+ * @return 成功返回 true，队列已满或内存不足返回 false
+ */
+bool linx_send_queue_push(linx_send_queue_t* queue, linx_send_frame_type_t type,
+                          const void* data, size_t size, uint32_t timestamp);
+
+/**
+ * 预留一个槽位，由生产者直接在槽位缓冲区中写入帧数据（生产者侧，线程安全，无锁）
+ *
+ * 适用于编码器等可以把输出直接写进目标缓冲区的生产者，省去一次复制。
+ * 预留后必须尽快调用 linx_send_queue_commit() 发布：在此之前消费者会停在该槽位。
+ *
+ * @param queue 队列实例
+ * @param type 帧类型
+ * @param size 需要的最大字节数，返回帧的 capacity 不小于该值
+ * @return 预留的帧，队列已满或内存不足返回 NULL
+ */
+linx_send_frame_t* linx_send_queue_reserve(linx_send_queue_t* queue, linx_send_frame_type_t type, size_t size);
+
+/**
+ * 发布预留的帧（生产者侧）
+ * @param queue 队列实例
+ * @param frame linx_send_queue_reserve() 返回的帧
+ * @param size 实际写入的字节数，0 表示放弃该帧（消费者跳过空帧）
+ * @param timestamp 音频时间戳
+ */
+void linx_send_queue_commit(linx_send_queue_t* queue, linx_send_frame_t* frame, size_t size, uint32_t timestamp);
+
+/**
+ * 查看队首帧（仅消费者线程调用）
+ * @param queue 队列实例
+ * @return 队首帧，队列为空返回 NULL；在 linx_send_queue_pop() 前保持有效
+ */
+linx_send_frame_t* linx_send_queue_peek(linx_send_queue_t* queue);
+
+/**
+ * 释放队首帧的槽位（仅消费者线程调用）
+ * @param queue 队列实例
+ */
+void linx_send_queue_pop(linx_send_queue_t* queue);
+
+/**
+ * 丢弃队列中所有帧（仅消费者线程调用）
+ * @param queue 队列实例
+ * @return 丢弃的帧数
+ */
+size_t linx_send_queue_clear(linx_send_queue_t* queue);
+
+/**
+ * 获取当前队列深度（近似值，任意线程可调用）
+ * @param queue 队列实例
+ * @return 队列中的帧数
+ */
+size_t linx_send_queue_depth(const linx_send_queue_t* queue);
+
+/**
+ * 获取单调时钟当前时间，与 enqueue_time_us 使用同一时基
+ * @return 当前时间（微秒）
+ */
+uint64_t linx_send_queue_now_us(void);
+
+/**
+ * 获取队列容量
+ * @param queue 队列实例
+ * @return 槽位数
+ */
+size_t linx_send_queue_capacity(const linx_send_queue_t* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINX_SEND_QUEUE_H */
@@ -9,7 +9,7 @@
 
 /* Internal helper function declarations */
 static void linx_websocket_protocol_destroy(linx_websocket_protocol_t* ws_protocol);
-static bool linx_websocket_parse_server_hello(linx_websocket_protocol_t* ws_protocol, const char* json_str);
+static bool linx_websocket_parse_server_hello(linx_websocket_protocol_t* ws_protocol, const cJSON* root);
 static char* linx_websocket_get_hello_message(linx_websocket_protocol_t* ws_protocol);
 static void linx_websocket_event_handler(struct mg_connection* conn, int ev, void* ev_data);
 static char* extract_json_string_value(const cJSON* json, const char* key);
@@ -19,13 +19,47 @@ static bool linx_websocket_protocol_set_server(linx_websocket_protocol_t* ws_pro
 static bool linx_websocket_protocol_set_auth_token(linx_websocket_protocol_t* ws_protocol, const char* token);
 static bool linx_websocket_protocol_set_device_id(linx_websocket_protocol_t* ws_protocol, const char* device_id);
 static bool linx_websocket_protocol_set_client_id(linx_websocket_protocol_t* ws_protocol, const char* client_id);
+static bool linx_websocket_transmit_audio(linx_websocket_protocol_t* ws_protocol, const uint8_t* payload, size_t payload_size, uint32_t timestamp);
+static bool linx_websocket_write_audio(linx_websocket_protocol_t* ws_protocol, int type, const uint8_t* payload, size_t payload_size,
+                                       uint32_t timestamp, int frames);
+static void linx_websocket_flush_batch(linx_websocket_protocol_t* ws_protocol);
+static bool linx_websocket_transmit_text(linx_websocket_protocol_t* ws_protocol, const char* text, size_t length,
+                                         linx_send_priority_t priority, uint64_t submit_us);
+static void linx_websocket_drain_send_queue(linx_websocket_protocol_t* ws_protocol);
+static bool linx_websocket_on_loop_thread(const linx_websocket_protocol_t* ws_protocol);
+static uint64_t linx_websocket_now_us(void);
+static void linx_websocket_handle_binary(linx_websocket_protocol_t* ws_protocol, const struct mg_ws_message* wm);
+static bool linx_websocket_open_connection(linx_websocket_protocol_t* ws_protocol);
+static void linx_websocket_schedule_reconnect(linx_websocket_protocol_t* ws_protocol);
+static void linx_websocket_service_reconnect(linx_websocket_protocol_t* ws_protocol);
+static uint64_t linx_websocket_now_ms(void);
+static int linx_websocket_clamp_timeout(int timeout_ms, uint64_t deadline_ms, uint64_t now_ms);
+static void linx_websocket_service_keepalive(linx_websocket_protocol_t* ws_protocol);
+static void linx_websocket_handle_control(linx_websocket_protocol_t* ws_protocol, const struct mg_ws_message* wm);
+static uint64_t linx_websocket_next_deadline(const linx_websocket_protocol_t* ws_protocol);
+static void linx_websocket_start_task(void* arg);
+static void linx_websocket_stop_task(void* arg);
+static void linx_websocket_detach_task(void* arg);
+static bool linx_websocket_admit_audio(linx_websocket_protocol_t* ws_protocol, size_t incoming, int frames);
+static void linx_websocket_track_audio(linx_websocket_protocol_t* ws_protocol, size_t offset, size_t length, int frames);
+static void linx_websocket_on_written(linx_websocket_protocol_t* ws_protocol, size_t written);
+static void linx_websocket_update_congestion(linx_websocket_protocol_t* ws_protocol);
+static void linx_websocket_reset_backpressure(linx_websocket_protocol_t* ws_protocol);
+static size_t linx_websocket_queue_depth(const linx_websocket_protocol_t* ws_protocol);
+
+/* Arguments for running linx_websocket_start() on the owning shard */
+typedef struct {
+    linx_websocket_protocol_t* ws_protocol;
+    bool result;
+} linx_websocket_start_ctx_t;
 
 /* Protocol vtable for WebSocket implementation */
 static const linx_protocol_vtable_t linx_websocket_vtable = {
     .start = linx_websocket_start,
     .send_audio = linx_websocket_send_audio,
     .send_text = linx_websocket_send_text,
-    .destroy = linx_websocket_destroy
+    .destroy = linx_websocket_destroy,
+    .send_text_priority = linx_websocket_send_text_priority
 };
 
 /* WebSocket protocol creation and destruction */
@@ -44,12 +78,19 @@ linx_websocket_protocol_t* linx_websocket_protocol_create(const linx_websocket_c
     }
     
     memset(ws_protocol, 0, sizeof(linx_websocket_protocol_t));
+    pthread_mutex_init(&ws_protocol->stats_mutex, NULL);
     
     /* Initialize base protocol */
     linx_protocol_init(&ws_protocol->base, &linx_websocket_vtable);
     
-    /* Initialize mongoose manager */
-    mg_mgr_init(&ws_protocol->mgr);
+    /* Initialize mongoose manager; runtime sessions share their shard's manager instead */
+    if (!config->runtime) {
+        mg_mgr_init(&ws_protocol->own_mgr);
+        ws_protocol->mgr = &ws_protocol->own_mgr;
+        if (!mg_wakeup_init(ws_protocol->mgr)) {
+            LOG_WARN("WebSocket wakeup pipe unavailable, queued sends wait for the next poll");
+        }
+    }
     
     /* Set default values */
     ws_protocol->connected = false;
@@ -63,6 +104,45 @@ linx_websocket_protocol_t* linx_websocket_protocol_create(const linx_websocket_c
     ws_protocol->device_id = NULL;
     ws_protocol->client_id = NULL;
     
+    /* Reconnect policy; the jitter seed differs per device so a fleet spreads out */
+    ws_protocol->auto_reconnect = config->auto_reconnect;
+    ws_protocol->reconnect_max_attempts = config->reconnect_max_attempts > 0 ? config->reconnect_max_attempts : 0;
+    uint32_t jitter_seed = 0;
+    mg_random(&jitter_seed, sizeof(jitter_seed));
+    jitter_seed ^= (uint32_t)mg_millis() ^ (uint32_t)(uintptr_t)ws_protocol;
+    linx_reconnect_backoff_init(&ws_protocol->backoff,
+                                config->reconnect_base_ms > 0 ? config->reconnect_base_ms : LINX_WEBSOCKET_RECONNECT_BASE_MS,
+                                config->reconnect_max_ms > 0 ? config->reconnect_max_ms : LINX_WEBSOCKET_RECONNECT_MAX_MS,
+                                jitter_seed);
+    
+    /* Keepalive policy */
+    ws_protocol->ping_interval_ms = config->ping_interval_ms > 0 ? config->ping_interval_ms : LINX_WEBSOCKET_PING_INTERVAL_MS;
+    ws_protocol->idle_timeout_ms = config->idle_timeout_ms > 0 ? config->idle_timeout_ms : LINX_WEBSOCKET_IDLE_TIMEOUT_MS;
+    
+    /* Backpressure policy */
+    ws_protocol->send_buffer_limit = config->send_buffer_limit > 0 ? config->send_buffer_limit : LINX_WEBSOCKET_SEND_BUFFER_LIMIT;
+    ws_protocol->backpressure_policy = config->backpressure_policy;
+    ws_protocol->server_aec = config->server_aec;
+    ws_protocol->audio_frame_duration = config->audio_frame_duration > 0 ? config->audio_frame_duration
+                                                                         : LINX_WEBSOCKET_AUDIO_FRAME_DURATION;
+    
+    /* Multi-frame packing needs a typed binary header, so v1 always sends frame by frame */
+    ws_protocol->batch_max_frames = config->audio_batch_frames > LINX_WEBSOCKET_AUDIO_BATCH_MAX ?
+                                    LINX_WEBSOCKET_AUDIO_BATCH_MAX : config->audio_batch_frames;
+    ws_protocol->batch_max_delay_ms = config->audio_batch_delay_ms > 0 ? config->audio_batch_delay_ms
+                                                                       : LINX_WEBSOCKET_AUDIO_BATCH_DELAY_MS;
+    /* Create uplink send queues, one per priority lane; only audio can back up deeply */
+    for (int lane = 0; lane < LINX_SEND_PRIORITY_COUNT; lane++) {
+        size_t capacity = lane == LINX_SEND_PRIORITY_AUDIO ? config->send_queue_capacity
+                                                           : LINX_WEBSOCKET_CONTROL_QUEUE_CAPACITY;
+        ws_protocol->send_queues[lane] = linx_send_queue_create(capacity);
+        if (!ws_protocol->send_queues[lane]) {
+            LOG_ERROR("WebSocket protocol creation failed: cannot create send queue");
+            linx_websocket_protocol_destroy(ws_protocol);
+            return NULL;
+        }
+    }
+    
     LOG_DEBUG("WebSocket protocol basic initialization completed");
     
     /* Configure server connection */
@@ -126,6 +206,22 @@ linx_websocket_protocol_t* linx_websocket_protocol_create(const linx_websocket_c
         LOG_DEBUG("Setting WebSocket protocol version: %d", config->protocol_version);
         ws_protocol->version = config->protocol_version;
     }
+    if (ws_protocol->batch_max_frames > 1 && ws_protocol->version != 2 && ws_protocol->version != 3) {
+        LOG_WARN("WebSocket audio batching requires protocol v2 or v3, disabled for v%d", ws_protocol->version);
+        ws_protocol->batch_max_frames = 0;
+    }
+    
+    /* Pin to a runtime shard last, once the session is fully initialized */
+    if (config->runtime) {
+        int shard = linx_runtime_attach(config->runtime, ws_protocol, config->shard, &ws_protocol->mgr);
+        if (shard < 0) {
+            LOG_ERROR("WebSocket protocol creation failed: cannot attach to runtime");
+            linx_websocket_protocol_destroy(ws_protocol);
+            return NULL;
+        }
+        ws_protocol->runtime = config->runtime;
+        ws_protocol->shard = shard;
+    }
     
     LOG_INFO("WebSocket protocol created successfully - version: %d, URL: %s", 
              ws_protocol->version, ws_protocol->server_url ? ws_protocol->server_url : "N/A");
@@ -141,18 +237,37 @@ static void linx_websocket_protocol_destroy(linx_websocket_protocol_t* ws_protoc
     
     LOG_DEBUG("Destroying WebSocket protocol");
     
-    /* Stop the protocol if running */
-    linx_websocket_stop(ws_protocol);
-    
-    /* Clean up connection */
-    if (ws_protocol->conn) {
-        LOG_DEBUG("Closing WebSocket connection");
-        ws_protocol->conn->is_closing = 1;
-        ws_protocol->conn = NULL;
+    if (ws_protocol->runtime) {
+        /* The shard owns the manager; leave it on the shard thread */
+        if (!linx_runtime_call(ws_protocol->runtime, ws_protocol->shard, linx_websocket_detach_task, ws_protocol)) {
+            LOG_WARN("WebSocket runtime already stopped, cannot detach cleanly");
+        }
+    } else {
+        /* Stop the protocol if running */
+        linx_websocket_stop(ws_protocol);
+        
+        /* Clean up connection */
+        if (ws_protocol->conn) {
+            LOG_DEBUG("Closing WebSocket connection");
+            ws_protocol->conn->is_closing = 1;
+            ws_protocol->conn = NULL;
+        }
+        
+        /* Clean up mongoose manager */
+        if (ws_protocol->mgr) {
+            mg_mgr_free(ws_protocol->mgr);
+        }
     }
     
-    /* Clean up mongoose manager */
-    mg_mgr_free(&ws_protocol->mgr);
+    free(ws_protocol->batch_buf);
+    ws_protocol->batch_buf = NULL;
+    
+    /* Release queued frames */
+    for (int lane = 0; lane < LINX_SEND_PRIORITY_COUNT; lane++) {
+        linx_send_queue_destroy(ws_protocol->send_queues[lane]);
+        ws_protocol->send_queues[lane] = NULL;
+    }
+    pthread_mutex_destroy(&ws_protocol->stats_mutex);
     
     /* Free allocated strings */
     if (ws_protocol->server_url) {
@@ -278,7 +393,7 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
     linx_websocket_protocol_t* ws_protocol = (linx_websocket_protocol_t*)conn->fn_data;
     
     if (!ws_protocol) {
-        LOG_ERROR("WebSocket event handler called with NULL protocol");
+        /* Session was destroyed while this connection was closing on a shared manager */
         return;
     }
     
@@ -293,6 +408,8 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
             /* WebSocket connection opened */
             LOG_INFO("WebSocket connection opened successfully");
             ws_protocol->connected = true;
+            /* TLS may retry a partial record from the buffer head; only plain sockets are edited */
+            linx_send_backlog_reset(&ws_protocol->backlog, !conn->is_tls);
             if (ws_protocol->base.callbacks.on_connected) {
                 ws_protocol->base.callbacks.on_connected(ws_protocol->base.callbacks.user_data);
             }
@@ -309,6 +426,25 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
             break;
         }
         
+        case MG_EV_READ: {
+            /* Any inbound byte proves the peer is alive, even mid-frame */
+            linx_protocol_update_incoming_time(&ws_protocol->base);
+            break;
+        }
+        
+        case MG_EV_WRITE: {
+            /* Socket accepted some bytes: retire written audio and re-check congestion */
+            linx_websocket_on_written(ws_protocol, (size_t)*(long*)ev_data);
+            linx_websocket_update_congestion(ws_protocol);
+            break;
+        }
+        
+        case MG_EV_WS_CTL: {
+            /* Ping/pong/close control frame; mongoose answers pings itself */
+            linx_websocket_handle_control(ws_protocol, (const struct mg_ws_message*)ev_data);
+            break;
+        }
+        
         case MG_EV_WS_MSG: {
             /* WebSocket message received */
             struct mg_ws_message* wm = (struct mg_ws_message*)ev_data;
@@ -339,17 +475,14 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
                 if (strcmp(type->valuestring, "hello") == 0) {
                     /* Server hello message - handle internally */
                     LOG_INFO("WebSocket processing server hello message");
-                    char* json_string = cJSON_Print(json);
-                    if (json_string) {
-                        linx_websocket_parse_server_hello(ws_protocol, json_string);
+                    if (linx_websocket_parse_server_hello(ws_protocol, json)) {
                         LOG_INFO("WebSocket server hello processed successfully");
-                        free(json_string);
                     } else {
-                        LOG_ERROR("WebSocket failed to serialize hello message");
+                        LOG_ERROR("WebSocket server hello rejected");
                     }
-                } 
+                }
 
-                /* Other message types - call user callback */
+                /* Hand the parsed tree to the user callback; it must not outlive this call */
                 if (ws_protocol->base.callbacks.on_incoming_json) {
                     ws_protocol->base.callbacks.on_incoming_json(json, ws_protocol->base.callbacks.user_data);
                     LOG_DEBUG("WebSocket user callback executed for type: %s", type->valuestring);
@@ -360,65 +493,28 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
 
                 cJSON_Delete(json);
             } else if (wm->flags & WEBSOCKET_OP_BINARY) {
-               
-                /* Binary message - parse as audio data based on protocol version */
-                if (ws_protocol->base.callbacks.on_incoming_audio) {
-                    if (ws_protocol->version == 2) {
-                        /* Use binary protocol v2 */
-                        if (wm->data.len >= sizeof(linx_binary_protocol2_t)) {
-                            linx_binary_protocol2_t* bp2 = (linx_binary_protocol2_t*)wm->data.buf;
-                            uint16_t version = ntohs(bp2->version);
-                            uint16_t type = ntohs(bp2->type);
-                            uint32_t timestamp = ntohl(bp2->timestamp);
-                            uint32_t payload_size = ntohl(bp2->payload_size);
-                            
-                            if (type == 0 && payload_size > 0) { /* Audio data */
-                                linx_audio_stream_packet_t* packet = linx_audio_stream_packet_create(payload_size);
-                                if (packet) {
-                                    packet->sample_rate = ws_protocol->base.server_sample_rate;
-                                    packet->frame_duration = ws_protocol->base.server_frame_duration;
-                                    packet->timestamp = timestamp;
-                                    memcpy(packet->payload, bp2->payload, payload_size);
-                                    
-                                    ws_protocol->base.callbacks.on_incoming_audio(packet, ws_protocol->base.callbacks.user_data);
-                                    linx_audio_stream_packet_destroy(packet);
-                                }
-                            }
-                        }
-                    } else if (ws_protocol->version == 3) {
-                        /* Use binary protocol v3 */
-                        if (wm->data.len >= sizeof(linx_binary_protocol3_t)) {
-                            linx_binary_protocol3_t* bp3 = (linx_binary_protocol3_t*)wm->data.buf;
-                            uint8_t type = bp3->type;
-                            uint16_t payload_size = ntohs(bp3->payload_size);
-                            
-                            if (type == 0 && payload_size > 0) { /* Audio data */
-                                linx_audio_stream_packet_t* packet = linx_audio_stream_packet_create(payload_size);
-                                if (packet) {
-                                    packet->sample_rate = ws_protocol->base.server_sample_rate;
-                                    packet->frame_duration = ws_protocol->base.server_frame_duration;
-                                    packet->timestamp = 0; /* v3 protocol doesn't include timestamp */
-                                    memcpy(packet->payload, bp3->payload, payload_size);
-                                    
-                                    ws_protocol->base.callbacks.on_incoming_audio(packet, ws_protocol->base.callbacks.user_data);
-                                    linx_audio_stream_packet_destroy(packet);
-                                }
-                            }
-                        }
-                    } else {
-                        /* Fallback for unsupported protocol versions - treat as raw audio data */
-                        linx_audio_stream_packet_t* packet = linx_audio_stream_packet_create(wm->data.len);
-                        if (packet) {
-                            packet->sample_rate = ws_protocol->base.server_sample_rate;
-                            packet->frame_duration = ws_protocol->base.server_frame_duration;
-                            packet->timestamp = 0;
-                            memcpy(packet->payload, wm->data.buf, wm->data.len);
-                            
-                            ws_protocol->base.callbacks.on_incoming_audio(packet, ws_protocol->base.callbacks.user_data);
-                            linx_audio_stream_packet_destroy(packet);
-                        }
-                    }
-                }
+                linx_websocket_handle_binary(ws_protocol, wm);
+            }
+            break;
+        }
+        
+        case MG_EV_POLL: {
+            /* First MG_EV_POLL of an iteration marks the end of the blocking wait */
+            if (ws_protocol->poll_woke_us == 0) {
+                ws_protocol->poll_woke_us = linx_websocket_now_us();
+            }
+            linx_websocket_drain_send_queue(ws_protocol);
+            break;
+        }
+        
+        case MG_EV_WAKEUP: {
+            /* Flush frames queued by other threads */
+            pthread_mutex_lock(&ws_protocol->stats_mutex);
+            ws_protocol->loop_stats.wakeups++;
+            pthread_mutex_unlock(&ws_protocol->stats_mutex);
+            linx_websocket_drain_send_queue(ws_protocol);
+            if (__atomic_load_n(&ws_protocol->ping_requested, __ATOMIC_ACQUIRE)) {
+                linx_websocket_service_keepalive(ws_protocol);
             }
             break;
         }
@@ -429,6 +525,28 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
             ws_protocol->connected = false;
             ws_protocol->audio_channel_opened = false;
             ws_protocol->conn = NULL;
+            __atomic_store_n(&ws_protocol->conn_id, 0UL, __ATOMIC_RELEASE);
+            
+            size_t dropped = 0;
+            for (int lane = 0; lane < LINX_SEND_PRIORITY_COUNT; lane++) {
+                dropped += linx_send_queue_clear(ws_protocol->send_queues[lane]);
+            }
+            if (dropped > 0) {
+                LOG_WARN("WebSocket dropped %zu queued frames on close", dropped);
+            }
+            linx_websocket_reset_backpressure(ws_protocol);
+            if (ws_protocol->batch_count > 0) {
+                LOG_WARN("WebSocket dropped %d packed audio frames on close", ws_protocol->batch_count);
+            }
+            ws_protocol->batch_len = 0;
+            ws_protocol->batch_count = 0;
+            ws_protocol->batch_due_ms = 0;
+            ws_protocol->batch_frames = 0;
+            
+            /* Schedule before notifying so the callback can ask linx_websocket_is_reconnecting() */
+            if (ws_protocol->running && !ws_protocol->should_stop && ws_protocol->auto_reconnect) {
+                linx_websocket_schedule_reconnect(ws_protocol);
+            }
             
             if (ws_protocol->base.callbacks.on_disconnected) {
                 ws_protocol->base.callbacks.on_disconnected(ws_protocol->base.callbacks.user_data);
@@ -450,6 +568,94 @@ static void linx_websocket_event_handler(struct mg_connection* conn, int ev, voi
     }
 }
 
+/* Hand each packet of a downlink batch to on_incoming_audio in order */
+static void linx_websocket_deliver_batch(linx_websocket_protocol_t* ws_protocol, linx_audio_stream_packet_t* packet,
+                                         const uint8_t* data, size_t length) {
+    const uint8_t* payload;
+    while (linx_protocol_next_batch_frame(&data, &length, &packet->timestamp, &payload, &packet->payload_size)) {
+        if (packet->payload_size == 0) {
+            continue;
+        }
+        packet->payload = (uint8_t*)payload;
+        ws_protocol->base.callbacks.on_incoming_audio(packet, ws_protocol->base.callbacks.user_data);
+    }
+}
+
+/*
+ * Deliver a binary frame as a borrowed packet: the packet lives on the stack
+ * and its payload points into mongoose's receive buffer, so nothing is
+ * allocated or copied. Consumers that need the data after the callback
+ * returns must call linx_audio_stream_packet_retain().
+ */
+static void linx_websocket_handle_binary(linx_websocket_protocol_t* ws_protocol, const struct mg_ws_message* wm) {
+    if (!ws_protocol->base.callbacks.on_incoming_audio) {
+        return;
+    }
+    
+    const uint8_t* data = (const uint8_t*)wm->data.buf;
+    size_t length = wm->data.len;
+    linx_audio_stream_packet_t packet = {
+        .sample_rate = ws_protocol->base.server_sample_rate,
+        .frame_duration = ws_protocol->base.server_frame_duration,
+        .timestamp = 0
+    };
+    
+    if (ws_protocol->version == 2) {
+        /* Use binary protocol v2 */
+        if (length < sizeof(linx_binary_protocol2_t)) {
+            LOG_WARN("WebSocket binary frame too short for protocol v2: %zu bytes", length);
+            return;
+        }
+        const linx_binary_protocol2_t* bp2 = (const linx_binary_protocol2_t*)data;
+        uint16_t type = ntohs(bp2->type);
+        uint32_t payload_size = ntohl(bp2->payload_size);
+        if ((type != LINX_BINARY_TYPE_OPUS && type != LINX_BINARY_TYPE_OPUS_BATCH) || payload_size == 0) { /* Audio data only */
+            return;
+        }
+        if (payload_size > length - sizeof(linx_binary_protocol2_t)) {
+            LOG_WARN("WebSocket v2 payload size %u exceeds frame length %zu", payload_size, length);
+            return;
+        }
+        if (type == LINX_BINARY_TYPE_OPUS_BATCH) {
+            linx_websocket_deliver_batch(ws_protocol, &packet, data + sizeof(linx_binary_protocol2_t), payload_size);
+            return;
+        }
+        packet.timestamp = ntohl(bp2->timestamp);
+        packet.payload = (uint8_t*)data + sizeof(linx_binary_protocol2_t);
+        packet.payload_size = payload_size;
+    } else if (ws_protocol->version == 3) {
+        /* Use binary protocol v3 (no timestamp) */
+        if (length < sizeof(linx_binary_protocol3_t)) {
+            LOG_WARN("WebSocket binary frame too short for protocol v3: %zu bytes", length);
+            return;
+        }
+        const linx_binary_protocol3_t* bp3 = (const linx_binary_protocol3_t*)data;
+        uint16_t payload_size = ntohs(bp3->payload_size);
+        if ((bp3->type != LINX_BINARY_TYPE_OPUS && bp3->type != LINX_BINARY_TYPE_OPUS_BATCH) || payload_size == 0) { /* Audio data only */
+            return;
+        }
+        if (payload_size > length - sizeof(linx_binary_protocol3_t)) {
+            LOG_WARN("WebSocket v3 payload size %u exceeds frame length %zu", payload_size, length);
+            return;
+        }
+        if (bp3->type == LINX_BINARY_TYPE_OPUS_BATCH) {
+            linx_websocket_deliver_batch(ws_protocol, &packet, data + sizeof(linx_binary_protocol3_t), payload_size);
+            return;
+        }
+        packet.payload = (uint8_t*)data + sizeof(linx_binary_protocol3_t);
+        packet.payload_size = payload_size;
+    } else {
+        /* Fallback for unsupported protocol versions - treat as raw audio data */
+        if (length == 0) {
+            return;
+        }
+        packet.payload = (uint8_t*)data;
+        packet.payload_size = length;
+    }
+    
+    ws_protocol->base.callbacks.on_incoming_audio(&packet, ws_protocol->base.callbacks.user_data);
+}
+
 /* Protocol implementation functions */
 bool linx_websocket_start(linx_protocol_t* protocol) {
     linx_websocket_protocol_t* ws_protocol = (linx_websocket_protocol_t*)protocol;
@@ -461,8 +667,34 @@ bool linx_websocket_start(linx_protocol_t* protocol) {
         return false;
     }
     
+    /* Connections on a shared manager may only be created by the owning shard */
+    if (ws_protocol->runtime && !linx_websocket_on_loop_thread(ws_protocol)) {
+        linx_websocket_start_ctx_t ctx = { .ws_protocol = ws_protocol, .result = false };
+        if (!linx_runtime_call(ws_protocol->runtime, ws_protocol->shard, linx_websocket_start_task, &ctx)) {
+            return false;
+        }
+        return ctx.result;
+    }
+    
     LOG_INFO("Starting WebSocket connection to: %s", ws_protocol->server_url);
+    
+    /* An explicit start is a fresh session: forget any reconnect state */
+    linx_reconnect_backoff_reset(&ws_protocol->backoff);
+    __atomic_store_n(&ws_protocol->reconnect_due_ms, 0, __ATOMIC_RELEASE);
+    ws_protocol->resume_session = false;
+    
+    if (!linx_websocket_open_connection(ws_protocol)) {
+        return false;
+    }
+    
+    ws_protocol->running = true;
+    ws_protocol->should_stop = false;
+    
+    return true;
+}
 
+/* Issue the WebSocket connect request; the handshake completes in later polls */
+static bool linx_websocket_open_connection(linx_websocket_protocol_t* ws_protocol) {
     /* Create WebSocket connection with headers */
     char headers[1024] = "";
     
@@ -496,7 +728,7 @@ bool linx_websocket_start(linx_protocol_t* protocol) {
         strncat(headers, client_header, sizeof(headers) - strlen(headers) - 1);
     }
     
-    ws_protocol->conn = mg_ws_connect(&ws_protocol->mgr, ws_protocol->server_url, 
+    ws_protocol->conn = mg_ws_connect(ws_protocol->mgr, ws_protocol->server_url, 
                                      linx_websocket_event_handler, ws_protocol, 
                                      strlen(headers) > 0 ? "%s" : NULL, headers);
     
@@ -504,102 +736,405 @@ bool linx_websocket_start(linx_protocol_t* protocol) {
         return false;
     }
     
-    ws_protocol->running = true;
-    ws_protocol->should_stop = false;
+    __atomic_store_n(&ws_protocol->conn_id, ws_protocol->conn->id, __ATOMIC_RELEASE);
     
+    /* The idle clock also bounds the TCP + WebSocket handshake */
+    linx_protocol_update_incoming_time(&ws_protocol->base);
+    ws_protocol->next_ping_ms = linx_websocket_now_ms() + ws_protocol->ping_interval_ms;
+    if (ws_protocol->runtime) {
+        linx_runtime_schedule(ws_protocol->runtime, ws_protocol->shard, linx_websocket_next_deadline(ws_protocol));
+    }
     return true;
 }
 
+static void linx_websocket_start_task(void* arg) {
+    linx_websocket_start_ctx_t* ctx = (linx_websocket_start_ctx_t*)arg;
+    ctx->result = linx_websocket_start(&ctx->ws_protocol->base);
+}
+
+static void linx_websocket_stop_task(void* arg) {
+    linx_websocket_stop((linx_websocket_protocol_t*)arg);
+}
+
+/* Runs on the owning shard: stop, orphan every connection still bound to us, leave the shard */
+static void linx_websocket_detach_task(void* arg) {
+    linx_websocket_protocol_t* ws_protocol = (linx_websocket_protocol_t*)arg;
+    
+    linx_websocket_stop(ws_protocol);
+    for (struct mg_connection* c = ws_protocol->mgr->conns; c != NULL; c = c->next) {
+        if (c->fn_data == ws_protocol) {
+            c->fn_data = NULL;
+            c->is_closing = 1;
+        }
+    }
+    linx_runtime_detach(ws_protocol->runtime, ws_protocol, ws_protocol->shard);
+}
+
 
 
 
 
-bool linx_websocket_send_audio(linx_protocol_t* protocol, linx_audio_stream_packet_t* packet) {
-    linx_websocket_protocol_t* ws_protocol = (linx_websocket_protocol_t*)protocol;
+/*
+ * Append a binary protocol header and its payload to the connection's send
+ * buffer and wrap both into one WebSocket binary frame in place.
+ * mg_ws_wrap() prepends the WebSocket header and masks the data inside
+ * c->send, so no temporary frame buffer is allocated; the send buffer keeps
+ * its capacity between frames.
+ */
+static bool linx_websocket_send_framed(struct mg_connection* conn, const void* header, size_t header_size,
+                                       const uint8_t* payload, size_t payload_size) {
+    size_t original_len = conn->send.len;
+    
+    if (!mg_send(conn, header, header_size) ||
+        (payload_size > 0 && !mg_send(conn, payload, payload_size))) {
+        conn->send.len = original_len;
+        return false;
+    }
     
-    if (!ws_protocol || !ws_protocol->conn || !ws_protocol->connected || !packet) {
-        LOG_ERROR("Invalid websocket protocol or connection state");
+    size_t wrapped_len = mg_ws_wrap(conn, header_size + payload_size, WEBSOCKET_OP_BINARY);
+    if (wrapped_len <= original_len + header_size + payload_size) {
+        /* The WebSocket header could not be inserted; drop the partial frame */
+        conn->send.len = original_len;
         return false;
     }
-    LOG_DEBUG("Sending audio packet - Sample Rate: %d, Frame Duration: %d, Timestamp: %u, Payload Size: %zu, Version: %d", 
-              packet->sample_rate, packet->frame_duration, packet->timestamp, packet->payload_size, ws_protocol->version);
     
-    if (ws_protocol->version == 2) {
+    return true;
+}
 
+/*
+ * Frame and write one audio message: a single packet, or a packed batch of
+ * `frames` packets when type is LINX_BINARY_TYPE_OPUS_BATCH. Must run on the
+ * event loop thread.
+ */
+static bool linx_websocket_write_audio(linx_websocket_protocol_t* ws_protocol, int type, const uint8_t* payload, size_t payload_size,
+                                       uint32_t timestamp, int frames) {
+    if (!ws_protocol->conn || !ws_protocol->connected) {
+        return false;
+    }
+    
+    /* Worst-case frame size: binary protocol header plus a masked WebSocket header */
+    size_t header_size = ws_protocol->version == 2 ? sizeof(linx_binary_protocol2_t)
+                       : ws_protocol->version == 3 ? sizeof(linx_binary_protocol3_t) : 0;
+    if (!linx_websocket_admit_audio(ws_protocol, payload_size + header_size + 14, frames)) {
+        linx_websocket_update_congestion(ws_protocol);
+        return false;
+    }
+    
+    size_t offset = ws_protocol->conn->send.len;
+    bool sent;
+    if (ws_protocol->version == 2) {
         /* Use binary protocol v2 */
-        size_t total_size = sizeof(linx_binary_protocol2_t) + packet->payload_size;
-        uint8_t* buffer = malloc(total_size);
-        if (!buffer) {
-            LOG_ERROR("WebSocket send failed: memory allocation failed (protocol v2)");
-            return false;
-        }
-        
-        linx_binary_protocol2_t* bp2 = (linx_binary_protocol2_t*)buffer;
-        bp2->version = htons(ws_protocol->version);
-        bp2->type = htons(0); /* Audio type */
-        bp2->reserved = 0;
-        bp2->timestamp = htonl(packet->timestamp);
-        bp2->payload_size = htonl(packet->payload_size);
-        memcpy(bp2->payload, packet->payload, packet->payload_size);
-        
-        int send_result = mg_ws_send(ws_protocol->conn, buffer, total_size, WEBSOCKET_OP_BINARY);
-        free(buffer);
-        
-        if (send_result > 0) {
-            LOG_DEBUG("WebSocket send successful: %zu bytes (protocol v2, total size: %zu)", packet->payload_size, total_size);
-        } else {
-            LOG_ERROR("WebSocket send failed: mg_ws_send returned %d (protocol v2)", send_result);
-        }
-        
-        return send_result > 0;
+        linx_binary_protocol2_t bp2;
+        bp2.version = htons(ws_protocol->version);
+        bp2.type = htons((uint16_t)type);
+        bp2.reserved = 0;
+        bp2.timestamp = htonl(timestamp);
+        bp2.payload_size = htonl(payload_size);
+        sent = linx_websocket_send_framed(ws_protocol->conn, &bp2, sizeof(bp2), payload, payload_size);
     } else if (ws_protocol->version == 3) {
         /* Use binary protocol v3 */
-        size_t total_size = sizeof(linx_binary_protocol3_t) + packet->payload_size;
-        uint8_t* buffer = malloc(total_size);
-        if (!buffer) {
-            LOG_ERROR("WebSocket send failed: memory allocation failed (protocol v3)");
+        if (payload_size > UINT16_MAX) {
+            LOG_ERROR("WebSocket send failed: payload %zu bytes exceeds protocol v3 limit", payload_size);
             return false;
         }
-        
-        linx_binary_protocol3_t* bp3 = (linx_binary_protocol3_t*)buffer;
-        bp3->type = 0; /* Audio type */
-        bp3->reserved = 0;
-        bp3->payload_size = htons(packet->payload_size);
-        memcpy(bp3->payload, packet->payload, packet->payload_size);
-        
-        int send_result = mg_ws_send(ws_protocol->conn, buffer, total_size, WEBSOCKET_OP_BINARY);
-        free(buffer);
-        
-        if (send_result > 0) {
-            LOG_DEBUG("WebSocket send successful: %zu bytes (protocol v3, total size: %zu)", packet->payload_size, total_size);
-        } else {
-            LOG_ERROR("WebSocket send failed: mg_ws_send returned %d (protocol v3)", send_result);
-        }
-        
-        return send_result > 0;
+        linx_binary_protocol3_t bp3;
+        bp3.type = (uint8_t)type;
+        bp3.reserved = 0;
+        bp3.payload_size = htons((uint16_t)payload_size);
+        sent = linx_websocket_send_framed(ws_protocol->conn, &bp3, sizeof(bp3), payload, payload_size);
     } else {
         /* Fallback for unsupported protocol versions - send raw payload */
-        int send_result = mg_ws_send(ws_protocol->conn, packet->payload, packet->payload_size, WEBSOCKET_OP_BINARY);
-        
-        if (send_result > 0) {
-            LOG_DEBUG("WebSocket send successful: %zu bytes (raw data, protocol v%d)", packet->payload_size, ws_protocol->version);
-        } else {
-            LOG_ERROR("WebSocket send failed: mg_ws_send returned %d (raw data, protocol v%d)", send_result, ws_protocol->version);
+        sent = mg_ws_send(ws_protocol->conn, payload, payload_size, WEBSOCKET_OP_BINARY) > 0;
+    }
+    
+    if (sent) {
+        LOG_DEBUG("WebSocket send successful: %zu bytes, %d frame(s) (protocol v%d)", payload_size, frames, ws_protocol->version);
+        linx_websocket_track_audio(ws_protocol, offset, ws_protocol->conn->send.len - offset, frames);
+    } else {
+        LOG_ERROR("WebSocket send failed: %zu bytes (protocol v%d)", payload_size, ws_protocol->version);
+    }
+    linx_websocket_update_congestion(ws_protocol);
+    
+    return sent;
+}
+
+/* Send whatever is packed so far as one LINX_BINARY_TYPE_OPUS_BATCH message */
+static void linx_websocket_flush_batch(linx_websocket_protocol_t* ws_protocol) {
+    if (ws_protocol->batch_count == 0) {
+        return;
+    }
+    
+    linx_websocket_write_audio(ws_protocol, LINX_BINARY_TYPE_OPUS_BATCH, ws_protocol->batch_buf, ws_protocol->batch_len,
+                               ws_protocol->batch_timestamp, ws_protocol->batch_count);
+    ws_protocol->batch_len = 0;
+    ws_protocol->batch_count = 0;
+    ws_protocol->batch_due_ms = 0;
+}
+
+/*
+ * Write one audio packet; must run on the event loop thread. With batching
+ * negotiated the packet is appended to the pending batch, which goes out
+ * once it holds batch_frames packets or its first packet has waited
+ * batch_max_delay_ms, whichever comes first.
+ */
+static bool linx_websocket_transmit_audio(linx_websocket_protocol_t* ws_protocol, const uint8_t* payload, size_t payload_size, uint32_t timestamp) {
+    if (!ws_protocol->conn || !ws_protocol->connected) {
+        return false;
+    }
+    if (ws_protocol->batch_frames < 2 || payload_size > UINT16_MAX) {
+        linx_websocket_flush_batch(ws_protocol);
+        return linx_websocket_write_audio(ws_protocol, LINX_BINARY_TYPE_OPUS, payload, payload_size, timestamp, 1);
+    }
+    
+    size_t entry_size = sizeof(linx_audio_batch_entry_t) + payload_size;
+    if (ws_protocol->version == 3 && ws_protocol->batch_len + entry_size > UINT16_MAX) {
+        /* The v3 header cannot describe a larger batch */
+        linx_websocket_flush_batch(ws_protocol);
+    }
+    if (ws_protocol->batch_len + entry_size > ws_protocol->batch_cap) {
+        size_t cap = ws_protocol->batch_cap ? ws_protocol->batch_cap : 1024;
+        while (cap < ws_protocol->batch_len + entry_size) {
+            cap *= 2;
+        }
+        uint8_t* buf = realloc(ws_protocol->batch_buf, cap);
+        if (!buf) {
+            LOG_ERROR("WebSocket audio batch allocation failed (%zu bytes)", cap);
+            linx_websocket_flush_batch(ws_protocol);
+            return linx_websocket_write_audio(ws_protocol, LINX_BINARY_TYPE_OPUS, payload, payload_size, timestamp, 1);
+        }
+        ws_protocol->batch_buf = buf;
+        ws_protocol->batch_cap = cap;
+    }
+    
+    linx_audio_batch_entry_t entry;
+    entry.timestamp = htonl(timestamp);
+    entry.payload_size = htons((uint16_t)payload_size);
+    memcpy(ws_protocol->batch_buf + ws_protocol->batch_len, &entry, sizeof(entry));
+    memcpy(ws_protocol->batch_buf + ws_protocol->batch_len + sizeof(entry), payload, payload_size);
+    ws_protocol->batch_len += entry_size;
+    
+    if (ws_protocol->batch_count++ == 0) {
+        ws_protocol->batch_timestamp = timestamp;
+        ws_protocol->batch_due_ms = linx_websocket_now_ms() + ws_protocol->batch_max_delay_ms;
+        if (ws_protocol->runtime) {
+            linx_runtime_schedule(ws_protocol->runtime, ws_protocol->shard, ws_protocol->batch_due_ms);
+        }
+    }
+    if (ws_protocol->batch_count >= ws_protocol->batch_frames) {
+        linx_websocket_flush_batch(ws_protocol);
+    }
+    return true;
+}
+
+/*
+ * Write one text frame; must run on the event loop thread. Control and MCP
+ * frames are moved in front of audio the socket has not started on, so a
+ * barge-in never waits behind a buffer full of speech.
+ */
+static bool linx_websocket_transmit_text(linx_websocket_protocol_t* ws_protocol, const char* text, size_t length,
+                                         linx_send_priority_t priority, uint64_t submit_us) {
+    if (!ws_protocol->conn || !ws_protocol->connected) {
+        return false;
+    }
+    
+    /* Speech held for packing must not wait out the delay budget behind e.g. listen stop */
+    linx_websocket_flush_batch(ws_protocol);
+    
+    struct mg_connection* conn = ws_protocol->conn;
+    size_t offset = conn->send.len;
+    if (mg_ws_send(conn, text, length, WEBSOCKET_OP_TEXT) == 0 || conn->send.len <= offset) {
+        return false;
+    }
+    
+    size_t end = conn->send.len;
+    if (priority < LINX_SEND_PRIORITY_AUDIO) {
+        end = linx_send_backlog_promote(&ws_protocol->backlog, conn->send.buf, offset, conn->send.len - offset);
+    }
+    if (priority == LINX_SEND_PRIORITY_CONTROL) {
+        linx_send_backlog_track_control(&ws_protocol->backlog, end, submit_us);
+    }
+    linx_websocket_update_congestion(ws_protocol);
+    return true;
+}
+
+static bool linx_websocket_on_loop_thread(const linx_websocket_protocol_t* ws_protocol) {
+    if (ws_protocol->runtime) {
+        return linx_runtime_on_shard(ws_protocol->runtime, ws_protocol->shard);
+    }
+    return ws_protocol->loop_thread_valid && pthread_equal(ws_protocol->loop_thread, pthread_self());
+}
+
+/* Head of the highest-priority non-empty lane, or NULL when every lane is empty */
+static linx_send_frame_t* linx_websocket_next_frame(linx_websocket_protocol_t* ws_protocol, int* lane) {
+    for (int i = 0; i < LINX_SEND_PRIORITY_COUNT; i++) {
+        linx_send_frame_t* frame = linx_send_queue_peek(ws_protocol->send_queues[i]);
+        if (frame) {
+            *lane = i;
+            return frame;
+        }
+    }
+    return NULL;
+}
+
+/* True when no lane at or above `priority` holds a frame */
+static bool linx_websocket_lanes_empty(linx_websocket_protocol_t* ws_protocol, linx_send_priority_t priority) {
+    for (int i = 0; i <= (int)priority && i < LINX_SEND_PRIORITY_COUNT; i++) {
+        if (linx_send_queue_peek(ws_protocol->send_queues[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Write every queued frame to the connection (event loop thread only).
+ * Lanes are re-examined after each frame, so a control message queued while
+ * a long audio backlog is draining goes out next rather than last.
+ */
+static void linx_websocket_drain_send_queue(linx_websocket_protocol_t* ws_protocol) {
+    /* Clear the flag first so a producer racing with this drain re-arms the wakeup */
+    __atomic_store_n(&ws_protocol->wakeup_pending, 0, __ATOMIC_RELEASE);
+    
+    int lane = LINX_SEND_PRIORITY_AUDIO;
+    linx_send_frame_t* frame = linx_websocket_next_frame(ws_protocol, &lane);
+    if (!frame) {
+        return;
+    }
+    
+    uint64_t now_us = linx_websocket_now_us();
+    uint64_t frames = 0, total_delay_us = 0, max_delay_us = 0;
+    for (; frame != NULL; frame = linx_websocket_next_frame(ws_protocol, &lane)) {
+        uint64_t delay_us = now_us > frame->enqueue_time_us ? now_us - frame->enqueue_time_us : 0;
+        frames++;
+        total_delay_us += delay_us;
+        if (delay_us > max_delay_us) {
+            max_delay_us = delay_us;
         }
         
-        return send_result > 0;
+        if (frame->size > 0) {
+            if (frame->type == LINX_SEND_FRAME_AUDIO) {
+                linx_websocket_transmit_audio(ws_protocol, frame->data, frame->size, frame->timestamp);
+            } else {
+                linx_websocket_transmit_text(ws_protocol, (const char*)frame->data, frame->size,
+                                             (linx_send_priority_t)lane, frame->enqueue_time_us);
+            }
+        }
+        linx_send_queue_pop(ws_protocol->send_queues[lane]);
+    }
+    
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    ws_protocol->loop_stats.queued_frames += frames;
+    ws_protocol->loop_stats.total_queue_delay_us += total_delay_us;
+    if (max_delay_us > ws_protocol->loop_stats.max_queue_delay_us) {
+        ws_protocol->loop_stats.max_queue_delay_us = max_delay_us;
+    }
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+}
+
+void linx_websocket_wakeup(linx_websocket_protocol_t* ws_protocol) {
+    if (!ws_protocol) {
+        return;
+    }
+    
+    unsigned long conn_id = __atomic_load_n(&ws_protocol->conn_id, __ATOMIC_ACQUIRE);
+    if (conn_id == 0) {
+        /* No connection to deliver MG_EV_WAKEUP to; just interrupt the poll */
+        if (ws_protocol->mgr) {
+            mg_wakeup(ws_protocol->mgr, LINX_WEBSOCKET_WAKEUP_ANY_ID, "", 0);
+        }
+        return;
+    }
+    
+    /* Only the first producer after a drain pays for the wakeup syscall */
+    if (__atomic_exchange_n(&ws_protocol->wakeup_pending, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+    
+    if (!mg_wakeup(ws_protocol->mgr, conn_id, "", 0)) {
+        /* Nothing to wake; let the next producer retry */
+        __atomic_store_n(&ws_protocol->wakeup_pending, 0, __ATOMIC_RELEASE);
+    }
+}
+
+bool linx_websocket_send_audio(linx_protocol_t* protocol, linx_audio_stream_packet_t* packet) {
+    linx_websocket_protocol_t* ws_protocol = (linx_websocket_protocol_t*)protocol;
+    
+    if (!ws_protocol || !ws_protocol->connected || !packet) {
+        LOG_ERROR("Invalid websocket protocol or connection state");
+        return false;
+    }
+    LOG_DEBUG("Sending audio packet - Sample Rate: %d, Frame Duration: %d, Timestamp: %u, Payload Size: %zu, Version: %d", 
+              packet->sample_rate, packet->frame_duration, packet->timestamp, packet->payload_size, ws_protocol->version);
+    
+    /* On the loop thread with nothing queued ahead: write straight through */
+    if (linx_websocket_on_loop_thread(ws_protocol) && linx_websocket_lanes_empty(ws_protocol, LINX_SEND_PRIORITY_AUDIO)) {
+        return linx_websocket_transmit_audio(ws_protocol, packet->payload, packet->payload_size, packet->timestamp);
+    }
+    
+    if (!linx_send_queue_push(ws_protocol->send_queues[LINX_SEND_PRIORITY_AUDIO], LINX_SEND_FRAME_AUDIO,
+                              packet->payload, packet->payload_size, packet->timestamp)) {
+        LOG_WARN("WebSocket send queue full, audio frame dropped");
+        return false;
+    }
+    linx_websocket_wakeup(ws_protocol);
+    return true;
+}
+
+linx_send_frame_t* linx_websocket_reserve_audio(linx_websocket_protocol_t* ws_protocol, size_t size) {
+    if (!ws_protocol || !ws_protocol->connected || size == 0) {
+        return NULL;
+    }
+    
+    linx_send_frame_t* frame = linx_send_queue_reserve(ws_protocol->send_queues[LINX_SEND_PRIORITY_AUDIO],
+                                                       LINX_SEND_FRAME_AUDIO, size);
+    if (!frame) {
+        LOG_WARN("WebSocket send queue full, audio frame dropped");
     }
+    return frame;
+}
+
+bool linx_websocket_commit_audio(linx_websocket_protocol_t* ws_protocol, linx_send_frame_t* frame,
+                                 size_t size, uint32_t timestamp) {
+    if (!ws_protocol || !frame) {
+        return false;
+    }
+    
+    /* Publish even when abandoning: the slot is claimed and the loop would stall on it */
+    linx_send_queue_commit(ws_protocol->send_queues[LINX_SEND_PRIORITY_AUDIO], frame, size, timestamp);
+    if (size == 0) {
+        return false;
+    }
+    linx_websocket_wakeup(ws_protocol);
+    return true;
 }
 
 bool linx_websocket_send_text(linx_protocol_t* protocol, const char* text) {
+    /* Untagged text (application JSON, MCP replies) rides the MCP lane */
+    return linx_websocket_send_text_priority(protocol, text, LINX_SEND_PRIORITY_MCP);
+}
+
+bool linx_websocket_send_text_priority(linx_protocol_t* protocol, const char* text, linx_send_priority_t priority) {
     linx_websocket_protocol_t* ws_protocol = (linx_websocket_protocol_t*)protocol;
     
-    if (!ws_protocol || !ws_protocol->conn || !ws_protocol->connected || !text) {
+    if (!ws_protocol || !ws_protocol->connected || !text) {
         LOG_ERROR("WebSocket send text failed: invalid protocol or connection or not connected or text is empty");
         return false;
     }
-    LOG_DEBUG("WebSocket sending text: %s", text);
-    mg_ws_send(ws_protocol->conn, text, strlen(text), WEBSOCKET_OP_TEXT);
+    if ((int)priority < 0 || priority >= LINX_SEND_PRIORITY_COUNT) {
+        priority = LINX_SEND_PRIORITY_MCP;
+    }
+    LOG_DEBUG("WebSocket sending text (lane %d): %s", (int)priority, text);
+    
+    size_t length = strlen(text);
+    if (linx_websocket_on_loop_thread(ws_protocol) && linx_websocket_lanes_empty(ws_protocol, priority)) {
+        return linx_websocket_transmit_text(ws_protocol, text, length, priority, linx_websocket_now_us());
+    }
+    
+    if (!linx_send_queue_push(ws_protocol->send_queues[priority], LINX_SEND_FRAME_TEXT, text, length, 0)) {
+        LOG_WARN("WebSocket send queue full, text message dropped (lane %d)", (int)priority);
+        return false;
+    }
+    linx_websocket_wakeup(ws_protocol);
     return true;
 }
 
@@ -610,11 +1145,209 @@ void linx_websocket_destroy(linx_protocol_t* protocol) {
 
 /* Event loop functions */
 void linx_websocket_poll(linx_websocket_protocol_t* ws_protocol, int timeout_ms) {
-    if (!ws_protocol) {
+    if (!ws_protocol || ws_protocol->runtime) {
+        return;
+    }
+    
+    /* The polling thread owns the connection; remember it so sends made
+     * from inside callbacks bypass the queue */
+    if (!ws_protocol->loop_thread_valid) {
+        ws_protocol->loop_thread = pthread_self();
+        ws_protocol->loop_thread_valid = true;
+    }
+    
+    /* Never sleep past a pending reconnect, heartbeat or idle deadline */
+    timeout_ms = linx_websocket_clamp_timeout(timeout_ms, linx_websocket_next_deadline(ws_protocol),
+                                              linx_websocket_now_ms());
+    
+    ws_protocol->poll_started_us = linx_websocket_now_us();
+    ws_protocol->poll_woke_us = 0;
+    
+    mg_mgr_poll(ws_protocol->mgr, timeout_ms);
+    
+    linx_websocket_service_timers(ws_protocol);
+    
+    /* Without a connection there is no MG_EV_POLL; count the whole call as waiting */
+    uint64_t finished_us = linx_websocket_now_us();
+    uint64_t woke_us = ws_protocol->poll_woke_us ? ws_protocol->poll_woke_us : finished_us;
+    uint64_t wait_us = woke_us - ws_protocol->poll_started_us;
+    uint64_t busy_us = finished_us - woke_us;
+    
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    linx_websocket_loop_stats_t* stats = &ws_protocol->loop_stats;
+    stats->iterations++;
+    stats->total_wait_us += wait_us;
+    stats->total_busy_us += busy_us;
+    if (wait_us > stats->max_wait_us) {
+        stats->max_wait_us = wait_us;
+    }
+    if (busy_us > stats->max_busy_us) {
+        stats->max_busy_us = busy_us;
+    }
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+}
+
+void linx_websocket_get_loop_stats(linx_websocket_protocol_t* ws_protocol, linx_websocket_loop_stats_t* stats) {
+    if (!ws_protocol || !stats) {
+        return;
+    }
+    
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    *stats = ws_protocol->loop_stats;
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+}
+
+/*
+ * Backpressure.
+ *
+ * mongoose keeps every unsent byte in conn->send, so on a congested uplink
+ * the buffer (and with it the audio latency) grows without bound. Audio
+ * frames are admitted against send_buffer_limit; text and control frames
+ * are always written. The loop thread records in a linx_send_backlog_t where
+ * each audio frame sits in conn->send so that frames the socket has not
+ * started writing can be cut out again (DROP_OLDEST) or overtaken by
+ * control and MCP frames. Every frame in the buffer is a complete,
+ * independently masked WebSocket frame, so removing one whole frame keeps
+ * the stream valid. Bytes mongoose appends on its own (pong replies, close
+ * frames) are never tracked and therefore never removed.
+ */
+static bool linx_websocket_admit_audio(linx_websocket_protocol_t* ws_protocol, size_t incoming, int frames) {
+    struct mg_connection* conn = ws_protocol->conn;
+    size_t limit = ws_protocol->send_buffer_limit;
+    
+    if (conn->send.len + incoming <= limit) {
+        return true;
+    }
+    
+    bool admitted = false;
+    uint64_t evicted = 0;
+    switch (ws_protocol->backpressure_policy) {
+        case LINX_BACKPRESSURE_DROP_OLDEST:
+            while (conn->send.len + incoming > limit) {
+                uint32_t frames_evicted = linx_send_backlog_evict_oldest(&ws_protocol->backlog, conn->send.buf,
+                                                                         &conn->send.len);
+                if (frames_evicted == 0) {
+                    break;
+                }
+                evicted += frames_evicted;
+            }
+            admitted = conn->send.len + incoming <= limit;
+            break;
+        case LINX_BACKPRESSURE_LOWER_BITRATE:
+            /* The encoder gets a chance to adapt; past twice the limit fall back to dropping */
+            admitted = conn->send.len + incoming <= 2 * limit;
+            break;
+        case LINX_BACKPRESSURE_DROP_NEWEST:
+        default:
+            break;
+    }
+    
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    ws_protocol->send_stats.dropped_oldest += evicted;
+    if (!admitted) {
+        ws_protocol->send_stats.dropped_newest += (uint64_t)frames;
+    }
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+    
+    if (!admitted) {
+        LOG_DEBUG("WebSocket uplink congested (%zu bytes buffered), audio frame dropped", conn->send.len);
+    }
+    return admitted;
+}
+
+static void linx_websocket_track_audio(linx_websocket_protocol_t* ws_protocol, size_t offset, size_t length, int frames) {
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    ws_protocol->send_stats.audio_frames_sent += (uint64_t)frames;
+    ws_protocol->send_stats.audio_messages_sent++;
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+    
+    /* Untracked frames are simply never evicted or overtaken */
+    linx_send_backlog_track_audio(&ws_protocol->backlog, offset, length, (uint32_t)frames);
+}
+
+/* mongoose removed `written` bytes from the front of conn->send */
+static void linx_websocket_on_written(linx_websocket_protocol_t* ws_protocol, size_t written) {
+    linx_send_backlog_written_t done;
+    linx_send_backlog_on_written(&ws_protocol->backlog, written, linx_websocket_now_us(), &done);
+    if (done.control_frames == 0) {
+        return;
+    }
+    
+    /* Control frames fully handed to the socket: record their latency */
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    ws_protocol->send_stats.control_frames += done.control_frames;
+    ws_protocol->send_stats.total_control_latency_us += done.total_latency_us;
+    if (done.max_latency_us > ws_protocol->send_stats.max_control_latency_us) {
+        ws_protocol->send_stats.max_control_latency_us = done.max_latency_us;
+    }
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+}
+
+/* Publish the buffered byte count and report congestion transitions (with hysteresis) */
+static void linx_websocket_update_congestion(linx_websocket_protocol_t* ws_protocol) {
+    size_t buffered = ws_protocol->conn ? ws_protocol->conn->send.len : 0;
+    size_t limit = ws_protocol->send_buffer_limit;
+    bool congested = ws_protocol->congested;
+    
+    __atomic_store_n(&ws_protocol->send_buffered, buffered, __ATOMIC_RELAXED);
+    
+    if (!congested && buffered > limit) {
+        congested = true;
+    } else if (congested && buffered <= limit / 2) {
+        congested = false;
+    }
+    
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    if (buffered > ws_protocol->send_stats.max_buffered_bytes) {
+        ws_protocol->send_stats.max_buffered_bytes = buffered;
+    }
+    if (congested != ws_protocol->congested) {
+        ws_protocol->send_stats.congested = congested;
+        if (congested) {
+            ws_protocol->send_stats.congestion_events++;
+        }
+    }
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+    
+    if (congested == ws_protocol->congested) {
+        return;
+    }
+    ws_protocol->congested = congested;
+    
+    if (congested) {
+        LOG_WARN("WebSocket uplink congested: %zu bytes buffered (limit %zu)", buffered, limit);
+    } else {
+        LOG_INFO("WebSocket uplink recovered: %zu bytes buffered", buffered);
+    }
+    if (ws_protocol->base.callbacks.on_backpressure) {
+        ws_protocol->base.callbacks.on_backpressure(congested, buffered, ws_protocol->base.callbacks.user_data);
+    }
+}
+
+/* The send buffer died with the connection */
+static void linx_websocket_reset_backpressure(linx_websocket_protocol_t* ws_protocol) {
+    linx_send_backlog_reset(&ws_protocol->backlog, false);
+    linx_websocket_update_congestion(ws_protocol);
+}
+
+void linx_websocket_get_send_stats(linx_websocket_protocol_t* ws_protocol, linx_websocket_send_stats_t* stats) {
+    if (!ws_protocol || !stats) {
         return;
     }
     
-    mg_mgr_poll(&ws_protocol->mgr, timeout_ms);
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    *stats = ws_protocol->send_stats;
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+    stats->buffered_bytes = __atomic_load_n(&ws_protocol->send_buffered, __ATOMIC_RELAXED);
+    stats->queue_depth = linx_websocket_queue_depth(ws_protocol);
+}
+
+static size_t linx_websocket_queue_depth(const linx_websocket_protocol_t* ws_protocol) {
+    size_t depth = 0;
+    for (int lane = 0; lane < LINX_SEND_PRIORITY_COUNT; lane++) {
+        depth += linx_send_queue_depth(ws_protocol->send_queues[lane]);
+    }
+    return depth;
 }
 
 void linx_websocket_stop(linx_websocket_protocol_t* ws_protocol) {
@@ -622,8 +1355,14 @@ void linx_websocket_stop(linx_websocket_protocol_t* ws_protocol) {
         return;
     }
     
+    if (ws_protocol->runtime && !linx_websocket_on_loop_thread(ws_protocol)) {
+        linx_runtime_call(ws_protocol->runtime, ws_protocol->shard, linx_websocket_stop_task, ws_protocol);
+        return;
+    }
+    
     ws_protocol->should_stop = true;
     ws_protocol->running = false;
+    __atomic_store_n(&ws_protocol->reconnect_due_ms, 0, __ATOMIC_RELEASE);
     
     if (ws_protocol->conn) {
         ws_protocol->conn->is_closing = 1;
@@ -631,6 +1370,200 @@ void linx_websocket_stop(linx_websocket_protocol_t* ws_protocol) {
     }
 }
 
+static uint64_t linx_websocket_now_us(void) {
+    return linx_send_queue_now_us();
+}
+
+static uint64_t linx_websocket_now_ms(void) {
+    return linx_send_queue_now_us() / 1000;
+}
+
+/* Shorten a poll timeout so it ends no later than deadline_ms (0 = no deadline) */
+static int linx_websocket_clamp_timeout(int timeout_ms, uint64_t deadline_ms, uint64_t now_ms) {
+    if (deadline_ms == 0) {
+        return timeout_ms;
+    }
+    
+    uint64_t remaining_ms = deadline_ms > now_ms ? deadline_ms - now_ms : 0;
+    if (timeout_ms < 0 || remaining_ms < (uint64_t)timeout_ms) {
+        return (int)remaining_ms;
+    }
+    return timeout_ms;
+}
+
+/*
+ * Heartbeat and dead-peer detection (event loop thread only). Any received
+ * byte refreshes base.last_incoming_time; a connection that stays silent for
+ * idle_timeout_ms - i.e. it missed several pongs - is closed so MG_EV_CLOSE
+ * can hand it to the reconnect logic. This also bounds a stalled handshake,
+ * because opening a connection resets the idle clock.
+ */
+static void linx_websocket_service_keepalive(linx_websocket_protocol_t* ws_protocol) {
+    if (!ws_protocol->conn || ws_protocol->conn->is_closing) {
+        return;
+    }
+    
+    uint64_t idle_ms = linx_protocol_get_idle_ms(&ws_protocol->base);
+    if (idle_ms > ws_protocol->idle_timeout_ms) {
+        LOG_WARN("WebSocket idle for %llu ms, closing connection", (unsigned long long)idle_ms);
+        pthread_mutex_lock(&ws_protocol->stats_mutex);
+        ws_protocol->rtt_stats.idle_timeouts++;
+        pthread_mutex_unlock(&ws_protocol->stats_mutex);
+        ws_protocol->conn->is_closing = 1;
+        return;
+    }
+    
+    if (!ws_protocol->connected) {
+        return;
+    }
+    
+    uint64_t now_us = linx_websocket_now_us();
+    bool requested = __atomic_exchange_n(&ws_protocol->ping_requested, 0, __ATOMIC_ACQ_REL) != 0;
+    if (!requested && now_us / 1000 < ws_protocol->next_ping_ms) {
+        return;
+    }
+    
+    /* The payload is the send time; the peer echoes it back in the pong */
+    uint8_t payload[8];
+    for (int i = 0; i < 8; i++) {
+        payload[i] = (uint8_t)(now_us >> (56 - 8 * i));
+    }
+    mg_ws_send(ws_protocol->conn, payload, sizeof(payload), WEBSOCKET_OP_PING);
+    ws_protocol->next_ping_ms = now_us / 1000 + ws_protocol->ping_interval_ms;
+    
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    ws_protocol->rtt_stats.pings_sent++;
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+}
+
+static uint64_t linx_websocket_min_deadline(uint64_t a, uint64_t b) {
+    if (a == 0) {
+        return b;
+    }
+    return (b != 0 && b < a) ? b : a;
+}
+
+/* Earliest pending timer (reconnect, idle timeout, next ping, batch flush); 0 when none */
+static uint64_t linx_websocket_next_deadline(const linx_websocket_protocol_t* ws_protocol) {
+    uint64_t deadline = ws_protocol->reconnect_due_ms;
+    if (ws_protocol->conn && !ws_protocol->conn->is_closing) {
+        uint64_t last_incoming = __atomic_load_n(&ws_protocol->base.last_incoming_time, __ATOMIC_RELAXED);
+        deadline = linx_websocket_min_deadline(deadline, last_incoming + ws_protocol->idle_timeout_ms + 1);
+        if (ws_protocol->connected) {
+            deadline = linx_websocket_min_deadline(deadline, ws_protocol->next_ping_ms);
+            deadline = linx_websocket_min_deadline(deadline, ws_protocol->batch_due_ms);
+        }
+    }
+    return deadline;
+}
+
+uint64_t linx_websocket_service_timers(linx_websocket_protocol_t* ws_protocol) {
+    if (!ws_protocol) {
+        return 0;
+    }
+    
+    linx_websocket_service_reconnect(ws_protocol);
+    linx_websocket_service_keepalive(ws_protocol);
+    if (ws_protocol->batch_due_ms != 0 && linx_websocket_now_ms() >= ws_protocol->batch_due_ms) {
+        linx_websocket_flush_batch(ws_protocol);
+    }
+    return linx_websocket_next_deadline(ws_protocol);
+}
+
+/* Turn a pong carrying one of our ping timestamps into an RTT sample */
+static void linx_websocket_handle_control(linx_websocket_protocol_t* ws_protocol, const struct mg_ws_message* wm) {
+    if ((wm->flags & 0x0F) != WEBSOCKET_OP_PONG || wm->data.len != 8) {
+        return;
+    }
+    
+    const uint8_t* data = (const uint8_t*)wm->data.buf;
+    uint64_t sent_us = 0;
+    for (int i = 0; i < 8; i++) {
+        sent_us = (sent_us << 8) | data[i];
+    }
+    
+    uint32_t rtt_us = 0;
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    bool recorded = linx_rtt_window_add_pong(&ws_protocol->rtt_window, sent_us, linx_websocket_now_us(),
+                                             (uint64_t)ws_protocol->idle_timeout_ms * 1000, &rtt_us);
+    if (recorded) {
+        ws_protocol->rtt_stats.last_us = rtt_us;
+        ws_protocol->rtt_stats.pongs_received++;
+    }
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+    
+    /* A pong that is not one of ours, or stale, is ignored */
+    if (recorded) {
+        LOG_DEBUG("WebSocket pong RTT: %u us", rtt_us);
+    }
+}
+
+void linx_websocket_get_rtt_stats(linx_websocket_protocol_t* ws_protocol, linx_websocket_rtt_stats_t* stats) {
+    if (!ws_protocol || !stats) {
+        return;
+    }
+    
+    /* Summarizing sorts the samples, so do it on a copy outside the lock */
+    linx_rtt_window_t window;
+    pthread_mutex_lock(&ws_protocol->stats_mutex);
+    *stats = ws_protocol->rtt_stats;
+    window = ws_protocol->rtt_window;
+    pthread_mutex_unlock(&ws_protocol->stats_mutex);
+    
+    linx_rtt_summary_t summary;
+    linx_rtt_window_summarize(&window, &summary);
+    stats->samples = summary.samples;
+    stats->min_us = summary.min_us;
+    stats->avg_us = summary.avg_us;
+    stats->p99_us = summary.p99_us;
+}
+
+/*
+ * Arm the next reconnect after a connection loss (event loop thread only).
+ * The delay is capped exponential backoff with "equal jitter", see
+ * linx_reconnect_backoff.h.
+ */
+static void linx_websocket_schedule_reconnect(linx_websocket_protocol_t* ws_protocol) {
+    uint64_t delay_ms = 0;
+    int attempt = linx_reconnect_backoff_next(&ws_protocol->backoff, &delay_ms);
+    if (ws_protocol->reconnect_max_attempts > 0 && attempt > ws_protocol->reconnect_max_attempts) {
+        LOG_ERROR("WebSocket giving up after %d reconnect attempts", attempt - 1);
+        __atomic_store_n(&ws_protocol->reconnect_due_ms, 0, __ATOMIC_RELEASE);
+        ws_protocol->running = false;
+        linx_protocol_set_error(&ws_protocol->base, "WebSocket reconnect attempts exhausted");
+        return;
+    }
+    
+    /* Offer the old session back only if the server said it can resume one */
+    ws_protocol->resume_session = ws_protocol->session_resume_allowed && ws_protocol->base.session_id != NULL;
+    
+    uint64_t due_ms = linx_websocket_now_ms() + delay_ms;
+    __atomic_store_n(&ws_protocol->reconnect_due_ms, due_ms, __ATOMIC_RELEASE);
+    if (ws_protocol->runtime) {
+        linx_runtime_schedule(ws_protocol->runtime, ws_protocol->shard, due_ms);
+    }
+    LOG_INFO("WebSocket reconnect attempt %d in %llu ms%s", attempt, (unsigned long long)delay_ms,
+             ws_protocol->resume_session ? " (resuming session)" : "");
+}
+
+/* Fire a due reconnect; a failed connect request is rescheduled with a longer backoff */
+static void linx_websocket_service_reconnect(linx_websocket_protocol_t* ws_protocol) {
+    uint64_t due_ms = ws_protocol->reconnect_due_ms;
+    if (due_ms == 0 || linx_websocket_now_ms() < due_ms || ws_protocol->should_stop) {
+        return;
+    }
+    
+    __atomic_store_n(&ws_protocol->reconnect_due_ms, 0, __ATOMIC_RELEASE);
+    ws_protocol->server_hello_received = false;
+    
+    LOG_INFO("WebSocket reconnecting to: %s (attempt %d)", ws_protocol->server_url,
+             linx_websocket_get_reconnect_attempts(ws_protocol));
+    if (!linx_websocket_open_connection(ws_protocol)) {
+        LOG_WARN("WebSocket reconnect request failed");
+        linx_websocket_schedule_reconnect(ws_protocol);
+    }
+}
+
 /* cJSON-based JSON value extraction helpers */
 static char* extract_json_string_value(const cJSON* json, const char* key) {
     const cJSON* item = cJSON_GetObjectItemCaseSensitive(json, key);
@@ -656,34 +1589,28 @@ static int extract_json_int_value(const cJSON* json, const char* key) {
 }
 
 /* Helper functions */
-static bool linx_websocket_parse_server_hello(linx_websocket_protocol_t* ws_protocol, const char* json_str) {
-    if (!ws_protocol || !json_str) {
-        return false;
-    }
-    
-    cJSON* root = cJSON_Parse(json_str);
-    if (!root) {
+/* Apply the server hello from the already-parsed message tree */
+static bool linx_websocket_parse_server_hello(linx_websocket_protocol_t* ws_protocol, const cJSON* root) {
+    if (!ws_protocol || !root) {
         return false;
     }
     
     /* Check transport type */
-    char* transport = extract_json_string_value(root, "transport");
-    if (transport) {
-        if (strcmp(transport, "websocket") != 0) {
-            free(transport);
-            cJSON_Delete(root);
-            return false;
-        }
-        free(transport);
+    const cJSON* transport = cJSON_GetObjectItemCaseSensitive(root, "transport");
+    if (cJSON_IsString(transport) && transport->valuestring &&
+        strcmp(transport->valuestring, "websocket") != 0) {
+        return false;
     }
     
-    /* Parse session ID */
+    /* Parse session ID into the base protocol, where outgoing messages read it */
     char* session_id = extract_json_string_value(root, "session_id");
+    bool session_resumed = session_id && ws_protocol->base.session_id &&
+                           strcmp(session_id, ws_protocol->base.session_id) == 0;
     if (session_id) {
-        if (ws_protocol->session_id) {
-            free(ws_protocol->session_id);
+        if (ws_protocol->base.session_id) {
+            free(ws_protocol->base.session_id);
         }
-        ws_protocol->session_id = session_id;
+        ws_protocol->base.session_id = session_id;
     }
     
     /* Parse audio_params section */
@@ -691,17 +1618,43 @@ static bool linx_websocket_parse_server_hello(linx_websocket_protocol_t* ws_prot
     if (cJSON_IsObject(audio_params)) {
         int sample_rate = extract_json_int_value(audio_params, "sample_rate");
         if (sample_rate > 0) {
-            ws_protocol->server_sample_rate = sample_rate;
+            ws_protocol->base.server_sample_rate = sample_rate;
         }
         
         int frame_duration = extract_json_int_value(audio_params, "frame_duration");
         if (frame_duration > 0) {
-            ws_protocol->server_frame_duration = frame_duration;
+            ws_protocol->base.server_frame_duration = frame_duration;
         }
     }
     
+    /* Whether a later reconnect may ask for this session back */
+    const cJSON* features = cJSON_GetObjectItemCaseSensitive(root, "features");
+    const cJSON* session_resume = cJSON_IsObject(features) ?
+        cJSON_GetObjectItemCaseSensitive(features, "session_resume") : NULL;
+    ws_protocol->session_resume_allowed = cJSON_IsTrue(session_resume);
+    
+    /* Pack uplink audio only if the server echoes audio_batch; never exceed either side's limit */
+    const cJSON* audio_batch = cJSON_IsObject(features) ?
+        cJSON_GetObjectItemCaseSensitive(features, "audio_batch") : NULL;
+    int server_batch = cJSON_IsObject(audio_batch) ? extract_json_int_value(audio_batch, "max_frames") : 0;
+    ws_protocol->batch_frames = 0;
+    if (ws_protocol->batch_max_frames > 1 && server_batch > 1) {
+        ws_protocol->batch_frames = server_batch < ws_protocol->batch_max_frames ? server_batch : ws_protocol->batch_max_frames;
+        LOG_INFO("WebSocket audio batching enabled: up to %d frames / %u ms per message",
+                 ws_protocol->batch_frames, ws_protocol->batch_max_delay_ms);
+    }
+    
+    if (ws_protocol->resume_session) {
+        LOG_INFO("WebSocket session %s after reconnect: %s",
+                 session_resumed ? "resumed" : "replaced",
+                 ws_protocol->base.session_id ? ws_protocol->base.session_id : "N/A");
+        ws_protocol->resume_session = false;
+    }
+    
+    /* A completed handshake ends the reconnect streak */
+    linx_websocket_reset_reconnect_attempts(ws_protocol);
+    
     ws_protocol->server_hello_received = true;
-    cJSON_Delete(root);
     return true;
 }
 
@@ -718,17 +1671,31 @@ static char* linx_websocket_get_hello_message(linx_websocket_protocol_t* ws_prot
     /* Add features object */
     cJSON* features = cJSON_CreateObject();
     cJSON_AddBoolToObject(features, "mcp", true);
-    /* Note: AEC feature would be added here if supported */
+    /* Uplink frames carry capture-clock timestamps (v2), so the server can cancel echo */
+    if (ws_protocol->server_aec) {
+        cJSON_AddBoolToObject(features, "aec", true);
+    }
+    if (ws_protocol->batch_max_frames > 1) {
+        cJSON* audio_batch = cJSON_CreateObject();
+        cJSON_AddNumberToObject(audio_batch, "max_frames", ws_protocol->batch_max_frames);
+        cJSON_AddNumberToObject(audio_batch, "max_delay_ms", ws_protocol->batch_max_delay_ms);
+        cJSON_AddItemToObject(features, "audio_batch", audio_batch);
+    }
     cJSON_AddItemToObject(root, "features", features);
     
     cJSON_AddStringToObject(root, "transport", "websocket");
     
+    /* Ask the server to resume the session this device held before the drop */
+    if (ws_protocol->resume_session && ws_protocol->base.session_id) {
+        cJSON_AddStringToObject(root, "session_id", ws_protocol->base.session_id);
+    }
+    
     /* Add audio_params object */
     cJSON* audio_params = cJSON_CreateObject();
     cJSON_AddStringToObject(audio_params, "format", LINX_WEBSOCKET_AUDIO_FORMAT);
     cJSON_AddNumberToObject(audio_params, "sample_rate", LINX_WEBSOCKET_AUDIO_SAMPLE_RATE);
     cJSON_AddNumberToObject(audio_params, "channels", LINX_WEBSOCKET_AUDIO_CHANNELS);
-    cJSON_AddNumberToObject(audio_params, "frame_duration", LINX_WEBSOCKET_AUDIO_FRAME_DURATION);
+    cJSON_AddNumberToObject(audio_params, "frame_duration", ws_protocol->audio_frame_duration);
     cJSON_AddItemToObject(root, "audio_params", audio_params);
     
     char* json_string = cJSON_PrintUnformatted(root);
@@ -744,12 +1711,31 @@ bool linx_websocket_is_connected(const linx_websocket_protocol_t* ws_protocol) {
 
 /* Additional WebSocket functions */
 int linx_websocket_get_reconnect_attempts(const linx_websocket_protocol_t* protocol) {
-    /* TODO: Add reconnect attempts tracking */
-    return 0;
+    if (!protocol) {
+        return 0;
+    }
+    return linx_reconnect_backoff_attempts(&protocol->backoff);
 }
 
 void linx_websocket_reset_reconnect_attempts(linx_websocket_protocol_t* protocol) {
-    /* TODO: Reset reconnect attempts counter */
+    if (!protocol) {
+        return;
+    }
+    linx_reconnect_backoff_reset(&protocol->backoff);
+}
+
+bool linx_websocket_is_reconnecting(const linx_websocket_protocol_t* protocol) {
+    if (!protocol) {
+        return false;
+    }
+    return __atomic_load_n(&protocol->reconnect_due_ms, __ATOMIC_ACQUIRE) != 0;
+}
+
+bool linx_websocket_has_connection(const linx_websocket_protocol_t* protocol) {
+    if (!protocol) {
+        return false;
+    }
+    return __atomic_load_n(&protocol->conn_id, __ATOMIC_ACQUIRE) != 0;
 }
 
 void linx_websocket_process_events(linx_websocket_protocol_t* protocol) {
@@ -758,17 +1744,21 @@ void linx_websocket_process_events(linx_websocket_protocol_t* protocol) {
 }
 
 bool linx_websocket_send_ping(linx_websocket_protocol_t* protocol) {
-    if (!protocol || !protocol->conn) {
+    if (!protocol || __atomic_load_n(&protocol->conn_id, __ATOMIC_ACQUIRE) == 0) {
         return false;
     }
     
-    mg_ws_send(protocol->conn, "", 0, WEBSOCKET_OP_PING);
+    /* The loop thread owns the connection; it sends the ping after this wakeup */
+    __atomic_store_n(&protocol->ping_requested, 1, __ATOMIC_RELEASE);
+    linx_websocket_wakeup(protocol);
     return true;
 }
 
 bool linx_websocket_is_connection_timeout(const linx_websocket_protocol_t* protocol) {
-    /* TODO: Implement connection timeout check */
-    return false;
+    if (!protocol || __atomic_load_n(&protocol->conn_id, __ATOMIC_ACQUIRE) == 0) {
+        return false;
+    }
+    return linx_protocol_get_idle_ms(&protocol->base) > protocol->idle_timeout_ms;
 }
 
 /* WebSocket create function with config */
@@ -2,7 +2,13 @@
 #define LINX_WEBSOCKET_H
 
 #include "linx_protocol.h"
+#include "linx_send_queue.h"
+#include "linx_send_backlog.h"
+#include "linx_reconnect_backoff.h"
+#include "linx_rtt_window.h"
+#include "linx_runtime.h"
 #include <stdbool.h>
+#include <pthread.h>
 #include <mongoose.h>
 
 #ifdef __cplusplus
@@ -15,10 +21,81 @@ extern "C" {
 #define LINX_WEBSOCKET_AUDIO_CHANNELS       1
 #define LINX_WEBSOCKET_AUDIO_FRAME_DURATION 60
 
-/* WebSocket 协议实现结构体 */
+/* 事件循环唤醒目标：不对应任何连接，仅让阻塞中的 mg_mgr_poll 返回 */
+#define LINX_WEBSOCKET_WAKEUP_ANY_ID        (~0UL)
+
+/* 自动重连默认参数 */
+#define LINX_WEBSOCKET_RECONNECT_BASE_MS    1000    // 首次重连延迟上限（毫秒）
+#define LINX_WEBSOCKET_RECONNECT_MAX_MS     30000   // 重连延迟上限（毫秒）
+
+/* 心跳默认参数：连续约三个心跳周期收不到任何数据即判定连接失效 */
+#define LINX_WEBSOCKET_PING_INTERVAL_MS     15000   // 心跳间隔（毫秒）
+#define LINX_WEBSOCKET_IDLE_TIMEOUT_MS      45000   // 空闲超时（毫秒）
+#define LINX_WEBSOCKET_RTT_WINDOW           LINX_RTT_WINDOW_SIZE // RTT 统计窗口（样本数）
+
+/* 上行背压默认参数 */
+#define LINX_WEBSOCKET_SEND_BUFFER_LIMIT    4096    // 发送缓冲区积压上限（字节），约 1 秒 32kbps 音频
+#define LINX_WEBSOCKET_CONTROL_QUEUE_CAPACITY 32    // 控制与 MCP 队列槽位数
+
+/* 上行多帧打包默认参数 */
+#define LINX_WEBSOCKET_AUDIO_BATCH_DELAY_MS 60      // 首帧在打包缓冲中最多等待的时长（毫秒）
+#define LINX_WEBSOCKET_AUDIO_BATCH_MAX      16      // 单条消息可打包的最大帧数
+
+/* 发送缓冲区超过上限时的音频处理策略（文本/控制消息从不丢弃） */
+typedef enum {
+    LINX_BACKPRESSURE_DROP_OLDEST,      // 丢弃缓冲区中最早的、尚未开始发送的音频帧
+    LINX_BACKPRESSURE_DROP_NEWEST,      // 丢弃新到达的音频帧
+    LINX_BACKPRESSURE_LOWER_BITRATE     // 通知上层降低码率，积压达到两倍上限后丢弃新帧
+} linx_websocket_backpressure_policy_t;
+
+/* 上行发送统计 */
 typedef struct {
+    uint64_t audio_frames_sent;     // 写入发送缓冲区的音频帧数
+    uint64_t dropped_oldest;        // 按 DROP_OLDEST 从缓冲区回收的音频帧数（打包消息按其中的帧数计）
+    uint64_t dropped_newest;        // 因积压被丢弃的新音频帧数（打包消息按其中的帧数计）
+    uint64_t congestion_events;     // 进入拥塞状态的次数
+    size_t buffered_bytes;          // 当前发送缓冲区积压字节数
+    size_t max_buffered_bytes;      // 积压字节数峰值
+    size_t queue_depth;             // 各优先级队列中等待写入的帧数之和
+    bool congested;                 // 当前是否拥塞
+    uint64_t control_frames;        // 已写出到套接字的控制消息数
+    uint64_t total_control_latency_us; // 控制消息从发送调用到写入套接字的总时延（微秒）
+    uint64_t max_control_latency_us;   // 控制消息的最大时延（微秒）
+    uint64_t audio_messages_sent;   // 承载音频的 WebSocket 消息数（打包时小于 audio_frames_sent）
+} linx_websocket_send_stats_t;
+
+/* 事件循环统计（每次 linx_websocket_poll 为一次迭代） */
+typedef struct {
+    uint64_t iterations;            // 迭代次数
+    uint64_t wakeups;               // 由 mg_wakeup 触发的唤醒次数
+    uint64_t total_wait_us;         // 阻塞等待总时长（微秒）
+    uint64_t max_wait_us;           // 单次最长阻塞等待（微秒）
+    uint64_t total_busy_us;         // 事件处理总时长（微秒）
+    uint64_t max_busy_us;           // 单次最长事件处理（微秒）
+    uint64_t queued_frames;         // 经发送队列写出的帧数
+    uint64_t total_queue_delay_us;  // 入队到写入连接的总延迟（微秒）
+    uint64_t max_queue_delay_us;    // 入队到写入连接的最大延迟（微秒）
+} linx_websocket_loop_stats_t;
+
+/* 心跳往返时延统计，min/avg/p99 基于最近 LINX_WEBSOCKET_RTT_WINDOW 个样本 */
+typedef struct {
+    uint64_t pings_sent;            // 已发送的 ping 数
+    uint64_t pongs_received;        // 已收到的有效 pong 数
+    uint64_t idle_timeouts;         // 因空闲超时关闭的连接数
+    uint32_t samples;               // 窗口内样本数
+    uint32_t last_us;               // 最近一次 RTT（微秒）
+    uint32_t min_us;                // 窗口内最小 RTT（微秒）
+    uint32_t avg_us;                // 窗口内平均 RTT（微秒）
+    uint32_t p99_us;                // 窗口内 99 分位 RTT（微秒）
+} linx_websocket_rtt_stats_t;
+
+/* WebSocket 协议实现结构体 */
+typedef struct linx_websocket_protocol {
     linx_protocol_t base;           // 基础协议结构体
-    struct mg_mgr mgr;              // Mongoose 管理器
+    struct mg_mgr* mgr;             // 所用的 Mongoose 管理器（自有或分片共享）
+    struct mg_mgr own_mgr;          // 未使用运行时时自有的管理器
+    linx_runtime_t* runtime;        // 所属分片运行时，NULL 表示自行驱动事件循环
+    int shard;                      // 所在分片序号
     struct mg_connection* conn;     // WebSocket 连接句柄
     bool connected;                 // 连接状态标志
     bool audio_channel_opened;      // 音频通道开启状态
@@ -30,12 +107,61 @@ typedef struct {
     char* server_host;              // 服务器主机
     char* server_path;              // 服务器路径
     int server_port;                // 服务器端口
-    char* session_id;               // 会话ID
     char* auth_token;               // 认证令牌
     char* device_id;                // 设备ID
     char* client_id;                // 客户端ID
-    int server_sample_rate;         // 服务器采样率
-    int server_frame_duration;      // 服务器帧持续时间
+
+    /* 上行发送队列：任意线程入队，事件循环线程按优先级出队写入连接 */
+    linx_send_queue_t* send_queues[LINX_SEND_PRIORITY_COUNT]; // 按 linx_send_priority_t 分道的队列
+    unsigned long conn_id;          // 当前连接ID（供 mg_wakeup 使用）
+    pthread_t loop_thread;          // 事件循环线程
+    bool loop_thread_valid;         // loop_thread 是否已记录
+    int wakeup_pending;             // 是否已有未处理的唤醒（原子访问）
+
+    /* 事件循环统计 */
+    uint64_t poll_started_us;       // 本次迭代开始时刻
+    uint64_t poll_woke_us;          // 本次迭代结束等待的时刻（首个 MG_EV_POLL）
+    linx_websocket_loop_stats_t loop_stats; // 累计统计
+    pthread_mutex_t stats_mutex;    // 保护 loop_stats
+
+    /* 自动重连：断开后由事件循环线程按退避时间重新发起连接 */
+    bool auto_reconnect;            // 是否启用自动重连
+    int reconnect_max_attempts;     // 最大连续重连次数，0 表示不限
+    linx_reconnect_backoff_t backoff; // 退避参数、连续重连次数与抖动状态
+    uint64_t reconnect_due_ms;      // 下次重连时刻（单调时钟毫秒），0 表示无待定重连
+    bool session_resume_allowed;    // 服务器 hello 是否声明支持会话恢复
+    bool resume_session;            // 下一个 hello 是否携带上次的 session_id
+
+    /* 心跳：定期发送带时间戳的 ping，根据 pong 计算 RTT，空闲超时则关闭连接 */
+    uint32_t ping_interval_ms;      // 心跳间隔（毫秒）
+    uint32_t idle_timeout_ms;       // 空闲超时（毫秒）
+    uint64_t next_ping_ms;          // 下次发送 ping 的时刻（单调时钟毫秒）
+    int ping_requested;             // 其他线程请求立即发送 ping（原子访问）
+    linx_rtt_window_t rtt_window;   // 最近的 RTT 样本，受 stats_mutex 保护
+    linx_websocket_rtt_stats_t rtt_stats; // 计数与最近样本，受 stats_mutex 保护
+
+    /* 上行背压：限制 mongoose 发送缓冲区中积压的字节数 */
+    linx_websocket_backpressure_policy_t backpressure_policy; // 超限时的音频处理策略
+    size_t send_buffer_limit;       // 积压上限（字节），低于一半时解除拥塞
+    bool congested;                 // 是否处于拥塞状态（事件循环线程访问）
+    size_t send_buffered;           // 最近观测到的积压字节数（原子访问）
+    linx_send_backlog_t backlog;    // conn->send 中未写出的音频与控制消息（事件循环线程访问）
+    linx_websocket_send_stats_t send_stats; // 丢帧与拥塞计数，受 stats_mutex 保护
+
+    /* hello 声明：连接建立时告知服务器的客户端能力与上行音频参数 */
+    bool server_aec;                // 是否声明 features.aec
+    uint32_t audio_frame_duration;  // 上行帧时长（毫秒）
+
+    /* 上行多帧打包：服务器 hello 确认后，连续音频帧合并为一条消息（事件循环线程访问） */
+    int batch_max_frames;           // 本端愿意打包的最大帧数，小于 2 表示不请求
+    uint32_t batch_max_delay_ms;    // 首帧最多等待时长（毫秒）
+    int batch_frames;               // 本连接协商结果，0 表示逐帧发送
+    uint8_t* batch_buf;             // 待发送的打包载荷（条目头 + 数据）
+    size_t batch_len;               // 打包载荷长度
+    size_t batch_cap;               // batch_buf 容量
+    int batch_count;                // 已打包帧数
+    uint32_t batch_timestamp;       // 第一帧时间戳
+    uint64_t batch_due_ms;          // 最迟发送时刻（单调时钟毫秒），0 表示缓冲为空
 } linx_websocket_protocol_t;
 
 /* WebSocket 配置结构体 */
@@ -48,6 +174,21 @@ typedef struct {
     const char* device_id;          // 设备ID
     const char* client_id;          // 客户端ID
     int protocol_version;           // 协议版本
+    size_t send_queue_capacity;     // 音频队列槽位数，0 使用默认值（控制与 MCP 队列固定大小）
+    bool auto_reconnect;            // 连接断开后自动重连
+    uint32_t reconnect_base_ms;     // 首次重连延迟上限（毫秒），0 使用默认值
+    uint32_t reconnect_max_ms;      // 重连延迟上限（毫秒），0 使用默认值
+    int reconnect_max_attempts;     // 最大连续重连次数，0 表示不限
+    uint32_t ping_interval_ms;      // 心跳间隔（毫秒），0 使用默认值
+    uint32_t idle_timeout_ms;       // 空闲超时（毫秒），0 使用默认值
+    size_t send_buffer_limit;       // 发送缓冲区积压上限（字节），0 使用默认值
+    linx_websocket_backpressure_policy_t backpressure_policy; // 积压超限时的音频处理策略
+    int audio_batch_frames;         // 请求每条消息最多打包的音频帧数，0/1 表示逐帧发送（仅 v2/v3）
+    uint32_t audio_batch_delay_ms;  // 打包引入的最大额外延迟（毫秒），0 使用默认值
+    uint32_t audio_frame_duration;  // 上行音频帧时长（毫秒），写入 hello 的 audio_params，0 使用默认值
+    bool server_aec;                // 在 hello 中声明 features.aec，由服务器按上行时间戳做回声消除
+    linx_runtime_t* runtime;        // 挂载到的分片运行时，NULL 表示使用自有管理器
+    int shard;                      // 运行时分片序号，LINX_RUNTIME_AUTO_SHARD 自动均衡（仅 runtime 非 NULL 时有效）
 } linx_websocket_config_t;
 
 /* 核心接口函数 */
@@ -63,6 +204,29 @@ linx_websocket_protocol_t* linx_websocket_protocol_create(const linx_websocket_c
 bool linx_websocket_start(linx_protocol_t* protocol);
 bool linx_websocket_send_audio(linx_protocol_t* protocol, linx_audio_stream_packet_t* packet);
 bool linx_websocket_send_text(linx_protocol_t* protocol, const char* message);
+bool linx_websocket_send_text_priority(linx_protocol_t* protocol, const char* message, linx_send_priority_t priority);
+
+/**
+ * 在音频通道上预留一帧，调用方把编码结果直接写入 frame->data
+ *
+ * 供编码线程零复制上行：预留后必须调用 linx_websocket_commit_audio() 发布。
+ * 帧走与 linx_websocket_send_audio() 相同的队列，同样受背压策略与多帧打包约束。
+ * @param protocol WebSocket 协议实例
+ * @param size 需要的最大字节数
+ * @return 预留的帧，未连接或队列已满返回 NULL
+ */
+linx_send_frame_t* linx_websocket_reserve_audio(linx_websocket_protocol_t* protocol, size_t size);
+
+/**
+ * 发布预留的音频帧并唤醒事件循环
+ * @param protocol WebSocket 协议实例
+ * @param frame linx_websocket_reserve_audio() 返回的帧
+ * @param size 实际写入的字节数，0 表示放弃该帧
+ * @param timestamp 采集时间戳（毫秒）
+ * @return 帧已发布返回 true，放弃返回 false
+ */
+bool linx_websocket_commit_audio(linx_websocket_protocol_t* protocol, linx_send_frame_t* frame,
+                                 size_t size, uint32_t timestamp);
 
 /**
  * 销毁 WebSocket 协议实例
@@ -74,17 +238,118 @@ void linx_websocket_destroy(linx_protocol_t* protocol);
 
 /**
  * 轮询 WebSocket 事件
+ *
+ * 阻塞在 mg_mgr_poll 中直到有套接字事件、linx_websocket_wakeup() 唤醒或超时，
+ * 随后写出发送队列中的帧。每次调用计为一次事件循环迭代。
+ * 挂载到运行时的会话由分片线程驱动，调用此函数直接返回。
  * @param protocol WebSocket 协议实例
- * @param timeout_ms 超时时间（毫秒）
+ * @param timeout_ms 最长阻塞时间（毫秒）
  */
 void linx_websocket_poll(linx_websocket_protocol_t* protocol, int timeout_ms);
 
+/**
+ * 处理到期的重连与心跳定时器（仅事件循环线程调用）
+ *
+ * linx_websocket_poll() 与运行时分片在每次 mg_mgr_poll 之后调用。
+ * @param protocol WebSocket 协议实例
+ * @return 下一个定时器截止时刻（单调时钟毫秒），0 表示没有待处理定时器
+ */
+uint64_t linx_websocket_service_timers(linx_websocket_protocol_t* protocol);
+
+/**
+ * 唤醒阻塞在 linx_websocket_poll() 中的事件循环线程
+ *
+ * 线程安全，可在任意线程调用。用于通知事件循环处理新入队的上行帧，
+ * 或让事件循环及时响应停止请求。
+ * @param protocol WebSocket 协议实例
+ */
+void linx_websocket_wakeup(linx_websocket_protocol_t* protocol);
+
+/**
+ * 获取事件循环统计
+ * @param protocol WebSocket 协议实例
+ * @param stats 输出统计数据
+ */
+void linx_websocket_get_loop_stats(linx_websocket_protocol_t* protocol, linx_websocket_loop_stats_t* stats);
+
 /**
  * 停止 WebSocket 连接
  * @param protocol WebSocket 协议实例
  */
 void linx_websocket_stop(linx_websocket_protocol_t* protocol);
 
+/* 自动重连 */
+
+/**
+ * 获取当前连续重连次数
+ *
+ * 每次安排重连时加一，收到服务器 hello 后清零。线程安全。
+ * @param protocol WebSocket 协议实例
+ * @return 连续重连次数
+ */
+int linx_websocket_get_reconnect_attempts(const linx_websocket_protocol_t* protocol);
+
+/**
+ * 清零连续重连次数，下一次重连重新从最短退避开始
+ * @param protocol WebSocket 协议实例
+ */
+void linx_websocket_reset_reconnect_attempts(linx_websocket_protocol_t* protocol);
+
+/**
+ * 是否有待执行的自动重连
+ *
+ * 在 on_disconnected 回调中调用可区分临时断开与最终断开。
+ * @param protocol WebSocket 协议实例
+ * @return 已安排重连返回 true
+ */
+bool linx_websocket_is_reconnecting(const linx_websocket_protocol_t* protocol);
+
+/**
+ * 是否存在连接（握手进行中或已建立）
+ *
+ * 发起连接后即为 true，连接关闭后变为 false。线程安全。
+ * @param protocol WebSocket 协议实例
+ * @return 存在连接返回 true
+ */
+bool linx_websocket_has_connection(const linx_websocket_protocol_t* protocol);
+
+/* 心跳 */
+
+/**
+ * 请求立即发送一次心跳 ping
+ *
+ * 线程安全：ping 由事件循环线程发出，payload 为 8 字节发送时刻，
+ * 服务器回显的 pong 用于计算 RTT。
+ * @param protocol WebSocket 协议实例
+ * @return 当前有连接返回 true
+ */
+bool linx_websocket_send_ping(linx_websocket_protocol_t* protocol);
+
+/**
+ * 连接是否已空闲超时（超过 idle_timeout_ms 未收到任何数据）
+ * @param protocol WebSocket 协议实例
+ * @return 有连接且已超时返回 true
+ */
+bool linx_websocket_is_connection_timeout(const linx_websocket_protocol_t* protocol);
+
+/**
+ * 获取心跳 RTT 统计
+ * @param protocol WebSocket 协议实例
+ * @param stats 输出统计数据
+ */
+void linx_websocket_get_rtt_stats(linx_websocket_protocol_t* protocol, linx_websocket_rtt_stats_t* stats);
+
+/* 上行背压 */
+
+/**
+ * 获取上行发送统计：积压字节数、队列深度与丢帧计数
+ *
+ * 线程安全。拥塞状态变化时还会通过 on_backpressure 回调通知。
+ * @param protocol WebSocket 协议实例
+ * @param stats 输出统计数据
+ */
+void linx_websocket_get_send_stats(linx_websocket_protocol_t* protocol, linx_websocket_send_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -249,7 +249,7 @@ static void on_websocket_message(const cJSON* root, void* user_data) {
     }
 }
 
-static void on_websocket_audio_data(linx_audio_stream_packet_t* packet, void* user_data) {
+static void on_websocket_audio_data(const linx_audio_stream_packet_t* packet, void* user_data) {
     printf("🎵 收到音频数据: %zu 字节, 采样率: %d, 帧时长: %d\n", 
            packet->payload_size, packet->sample_rate, packet->frame_duration);
     
@@ -0,0 +1,714 @@
+/**
+ * @file linx_mock_server.c
+ * @brief 本地 Linx 模拟服务器
+ *
+ * 基于 mongoose 的最小服务端实现，用于离线测试和性能基准，不需要真实的云端服务：
+ * - hello 握手，按 Protocol-Version 请求头（或 hello 中的 version）选择 v1/v2/v3 二进制帧格式
+ * - 上行多帧打包：客户端在 hello 中请求 features.audio_batch 时确认并解包
+ * - listen start/stop/detect、abort、goodbye、playback（播放对齐，仅打印）
+ * - TTS：回放本轮上行音频（echo）或合成 Opus 静音帧（synth），首包延迟与发送节奏可配置
+ * - MCP：握手后按脚本下发 initialize、tools/list，并可选地调用一个工具
+ *
+ * 用法: linx_mock_server [选项]，运行 -h 查看全部选项
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <mongoose.h>
+#include "linx_protocol.h"
+
+// ==================== 配置与状态 ====================
+
+#define MOCK_TICK_MS            5       // TTS 发送节奏定时器周期
+#define MOCK_MAX_FRAME_SIZE     4000    // 单帧 Opus 数据上限
+#define MOCK_MAX_ECHO_FRAMES    3000    // 回放模式最多缓存的上行帧数
+
+/* mongoose 的 fn_data 同时可能指向服务器或会话，用首个字段区分 */
+enum { MOCK_KIND_SERVER = 0x5345, MOCK_KIND_SESSION = 0x5345 + 1 };
+
+/* MCP 脚本请求 ID */
+enum { MOCK_MCP_ID_INITIALIZE = 1, MOCK_MCP_ID_TOOLS_LIST = 2, MOCK_MCP_ID_TOOLS_CALL = 3 };
+
+/**
+ * @brief 命令行选项
+ */
+typedef struct {
+    const char* listen_url;     // 监听地址
+    bool echo;                  // true: 回放上行音频; false: 合成静音帧
+    int sample_rate;            // hello 中声明的下行采样率
+    int frame_duration;         // 合成帧时长（毫秒）
+    int synth_frames;           // 每轮合成的帧数
+    int first_delay_ms;         // listen stop 到 tts start 的延迟（模拟 ASR/LLM 耗时）
+    double pace;                // 发送节奏：1.0 实时，0.5 两倍速，0 尽快发送
+    int burst_frames;           // tts start 后立即发送的预缓冲帧数
+    bool session_resume;        // hello 中声明 features.session_resume
+    int max_batch_frames;       // 接受的单条上行消息最大帧数，小于 2 表示不支持打包
+    bool mcp_script;            // 握手后执行 MCP 脚本
+    const char* tool_name;      // tools/list 之后调用的工具名
+    const char* tool_args;      // 工具参数（JSON 对象）
+    bool verbose;               // 打印每条消息
+} mock_options_t;
+
+typedef enum {
+    MOCK_TTS_IDLE,
+    MOCK_TTS_PENDING,           // 等待首包延迟
+    MOCK_TTS_PLAYING            // 正在按节奏发送
+} mock_tts_state_t;
+
+struct mock_server;
+
+/**
+ * @brief 每个客户端连接的会话状态
+ */
+typedef struct mock_session {
+    int kind;                           // MOCK_KIND_SESSION
+    struct mock_server* server;
+    struct mg_connection* conn;
+    struct mock_session* next;
+    int version;                        // 二进制协议版本
+    bool hello_done;
+    bool listening;
+    char session_id[48];
+
+    /* 回放模式缓存的本轮上行帧 */
+    uint8_t* echo_data;
+    size_t echo_len, echo_cap;
+    uint32_t* echo_sizes;
+    size_t echo_count, echo_cap_frames;
+
+    /* 下行 TTS */
+    mock_tts_state_t tts_state;
+    uint64_t tts_due_ms;                // PENDING: 开始时刻; PLAYING: 第一帧发送时刻
+    size_t tts_sent, tts_total;
+    size_t echo_offset;                 // 回放读取位置
+
+    int batch_frames;                   // 协商的上行打包帧数，0 表示逐帧
+    uint64_t rx_frames, rx_messages, tx_frames;
+} mock_session_t;
+
+/**
+ * @brief 服务器全局状态
+ */
+typedef struct mock_server {
+    int kind;                           // MOCK_KIND_SERVER
+    mock_options_t opts;
+    mock_session_t* sessions;
+    uint64_t session_seq;
+    uint8_t silence[8];                 // 合成用 Opus 静音帧
+    size_t silence_size;
+
+    /* 累计统计 */
+    uint64_t total_sessions, active_sessions;
+    uint64_t total_rx_frames, total_tx_frames, total_turns;
+} mock_server_t;
+
+static volatile sig_atomic_t g_running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+// ==================== 发送辅助函数 ====================
+
+static void mock_send_json(mock_session_t* s, cJSON* root) {
+    char* text = cJSON_PrintUnformatted(root);
+    if (text) {
+        if (s->server->opts.verbose) {
+            printf("[%s] >> %s\n", s->session_id, text);
+        }
+        mg_ws_send(s->conn, text, strlen(text), WEBSOCKET_OP_TEXT);
+        free(text);
+    }
+    cJSON_Delete(root);
+}
+
+static cJSON* mock_new_message(mock_session_t* s, const char* type) {
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "session_id", s->session_id);
+    cJSON_AddStringToObject(root, "type", type);
+    return root;
+}
+
+static void mock_send_tts_state(mock_session_t* s, const char* state, const char* text) {
+    cJSON* root = mock_new_message(s, "tts");
+    cJSON_AddStringToObject(root, "state", state);
+    if (text) {
+        cJSON_AddStringToObject(root, "text", text);
+    }
+    mock_send_json(s, root);
+}
+
+/* 按会话协议版本封装一帧下行音频 */
+static void mock_send_audio(mock_session_t* s, const uint8_t* payload, size_t size, uint32_t timestamp) {
+    uint8_t frame[sizeof(linx_binary_protocol2_t) + MOCK_MAX_FRAME_SIZE];
+    size_t header_size = 0;
+
+    if (size > MOCK_MAX_FRAME_SIZE) {
+        return;
+    }
+
+    if (s->version == 2) {
+        linx_binary_protocol2_t bp2;
+        bp2.version = htons(2);
+        bp2.type = htons(0);
+        bp2.reserved = 0;
+        bp2.timestamp = htonl(timestamp);
+        bp2.payload_size = htonl((uint32_t)size);
+        memcpy(frame, &bp2, sizeof(bp2));
+        header_size = sizeof(bp2);
+    } else if (s->version == 3) {
+        linx_binary_protocol3_t bp3;
+        bp3.type = 0;
+        bp3.reserved = 0;
+        bp3.payload_size = htons((uint16_t)size);
+        memcpy(frame, &bp3, sizeof(bp3));
+        header_size = sizeof(bp3);
+    }
+
+    memcpy(frame + header_size, payload, size);
+    mg_ws_send(s->conn, frame, header_size + size, WEBSOCKET_OP_BINARY);
+    s->tx_frames++;
+    s->server->total_tx_frames++;
+}
+
+/*
+ * 构造 frame_ms 时长的 Opus 静音包：TOC 选择 CELT 全带配置，
+ * 帧数据长度为 0（解码器输出静音/PLC）。20ms 的整数倍使用 code 3 多帧包。
+ */
+static size_t mock_build_silence(int frame_ms, uint8_t* out) {
+    if (frame_ms == 10) {
+        out[0] = 0xF0;                          // config 30: CELT FB 10ms, code 0
+        return 1;
+    }
+    if (frame_ms % 20 != 0 || frame_ms / 20 < 1 || frame_ms / 20 > 6) {
+        return 0;
+    }
+    int count = frame_ms / 20;
+    if (count == 1) {
+        out[0] = 0xF8;                          // config 31: CELT FB 20ms, code 0
+        return 1;
+    }
+    out[0] = 0xFB;                              // config 31, code 3
+    out[1] = (uint8_t)count;                    // CBR，无填充
+    return 2;
+}
+
+// ==================== TTS 调度 ====================
+
+static void mock_start_tts(mock_session_t* s) {
+    const mock_options_t* opts = &s->server->opts;
+
+    cJSON* stt = mock_new_message(s, "stt");
+    cJSON_AddStringToObject(stt, "text", "这是模拟服务器识别的文本");
+    mock_send_json(s, stt);
+
+    s->tts_total = opts->echo ? s->echo_count : (size_t)opts->synth_frames;
+    s->tts_sent = 0;
+    s->echo_offset = 0;
+    s->tts_state = MOCK_TTS_PENDING;
+    s->tts_due_ms = mg_millis() + (uint64_t)opts->first_delay_ms;
+    s->server->total_turns++;
+}
+
+static void mock_stop_tts(mock_session_t* s) {
+    if (s->tts_state == MOCK_TTS_IDLE) {
+        return;
+    }
+    s->tts_state = MOCK_TTS_IDLE;
+    mock_send_tts_state(s, "stop", NULL);
+}
+
+/* 发送当前已到期的 TTS 帧 */
+static void mock_pump_tts(mock_session_t* s, uint64_t now_ms) {
+    const mock_options_t* opts = &s->server->opts;
+
+    if (s->tts_state == MOCK_TTS_PENDING) {
+        if (now_ms < s->tts_due_ms) {
+            return;
+        }
+        mock_send_tts_state(s, "start", NULL);
+        mock_send_tts_state(s, "sentence_start", "这是模拟服务器合成的语音");
+        s->tts_state = MOCK_TTS_PLAYING;
+        s->tts_due_ms = now_ms;
+    }
+    if (s->tts_state != MOCK_TTS_PLAYING) {
+        return;
+    }
+
+    size_t due = s->tts_total;
+    int frame_ms = opts->frame_duration;
+    if (opts->pace > 0) {
+        double interval_ms = frame_ms * opts->pace;
+        due = (size_t)opts->burst_frames + (size_t)((now_ms - s->tts_due_ms) / interval_ms) + 1;
+        if (due > s->tts_total) {
+            due = s->tts_total;
+        }
+    }
+
+    while (s->tts_sent < due) {
+        uint32_t timestamp = (uint32_t)(s->tts_sent * (size_t)frame_ms);
+        if (opts->echo) {
+            uint32_t size = s->echo_sizes[s->tts_sent];
+            mock_send_audio(s, s->echo_data + s->echo_offset, size, timestamp);
+            s->echo_offset += size;
+        } else {
+            mock_send_audio(s, s->server->silence, s->server->silence_size, timestamp);
+        }
+        s->tts_sent++;
+    }
+
+    if (s->tts_sent >= s->tts_total) {
+        mock_stop_tts(s);
+    }
+}
+
+static void mock_timer_fn(void* arg) {
+    mock_server_t* server = (mock_server_t*)arg;
+    uint64_t now_ms = mg_millis();
+    for (mock_session_t* s = server->sessions; s != NULL; s = s->next) {
+        if (s->tts_state != MOCK_TTS_IDLE) {
+            mock_pump_tts(s, now_ms);
+        }
+    }
+}
+
+// ==================== MCP 脚本 ====================
+
+static void mock_send_mcp_request(mock_session_t* s, const char* method, cJSON* params, int id) {
+    cJSON* payload = cJSON_CreateObject();
+    cJSON_AddStringToObject(payload, "jsonrpc", "2.0");
+    cJSON_AddStringToObject(payload, "method", method);
+    cJSON_AddItemToObject(payload, "params", params ? params : cJSON_CreateObject());
+    cJSON_AddNumberToObject(payload, "id", id);
+
+    cJSON* root = mock_new_message(s, "mcp");
+    cJSON_AddItemToObject(root, "payload", payload);
+    mock_send_json(s, root);
+}
+
+static void mock_handle_mcp(mock_session_t* s, const cJSON* root) {
+    const mock_options_t* opts = &s->server->opts;
+    const cJSON* payload = cJSON_GetObjectItemCaseSensitive(root, "payload");
+    cJSON* parsed = NULL;
+
+    /* 兼容把 JSON-RPC 消息编码为字符串的客户端 */
+    if (cJSON_IsString(payload) && payload->valuestring) {
+        parsed = cJSON_Parse(payload->valuestring);
+        payload = parsed;
+    }
+    if (!cJSON_IsObject(payload)) {
+        printf("[%s] ⚠️ 无法解析的 MCP 载荷\n", s->session_id);
+        cJSON_Delete(parsed);
+        return;
+    }
+
+    const cJSON* id = cJSON_GetObjectItemCaseSensitive(payload, "id");
+    const cJSON* error = cJSON_GetObjectItemCaseSensitive(payload, "error");
+    int request_id = cJSON_IsNumber(id) ? id->valueint : 0;
+    printf("[%s] MCP 响应 id=%d %s\n", s->session_id, request_id, error ? "error" : "ok");
+
+    if (!error && opts->mcp_script) {
+        if (request_id == MOCK_MCP_ID_INITIALIZE) {
+            cJSON* params = cJSON_CreateObject();
+            cJSON_AddStringToObject(params, "cursor", "");
+            mock_send_mcp_request(s, "tools/list", params, MOCK_MCP_ID_TOOLS_LIST);
+        } else if (request_id == MOCK_MCP_ID_TOOLS_LIST && opts->tool_name) {
+            cJSON* params = cJSON_CreateObject();
+            cJSON_AddStringToObject(params, "name", opts->tool_name);
+            cJSON* args = opts->tool_args ? cJSON_Parse(opts->tool_args) : NULL;
+            cJSON_AddItemToObject(params, "arguments", args ? args : cJSON_CreateObject());
+            mock_send_mcp_request(s, "tools/call", params, MOCK_MCP_ID_TOOLS_CALL);
+        }
+    }
+    cJSON_Delete(parsed);
+}
+
+// ==================== 消息处理 ====================
+
+static void mock_handle_hello(mock_session_t* s, const cJSON* root) {
+    mock_server_t* server = s->server;
+    const cJSON* version = cJSON_GetObjectItemCaseSensitive(root, "version");
+    if (cJSON_IsNumber(version) && version->valueint >= 1 && version->valueint <= 3) {
+        s->version = version->valueint;
+    }
+
+    /* 客户端重连时携带原 session_id，允许恢复时沿用 */
+    const cJSON* session_id = cJSON_GetObjectItemCaseSensitive(root, "session_id");
+    if (server->opts.session_resume && cJSON_IsString(session_id) && session_id->valuestring &&
+        strlen(session_id->valuestring) < sizeof(s->session_id)) {
+        snprintf(s->session_id, sizeof(s->session_id), "%s", session_id->valuestring);
+        printf("[%s] 🔁 会话已恢复\n", s->session_id);
+    }
+
+    cJSON* reply = mock_new_message(s, "hello");
+    cJSON_AddStringToObject(reply, "transport", "websocket");
+    cJSON* features = cJSON_CreateObject();
+    cJSON_AddBoolToObject(features, "session_resume", server->opts.session_resume);
+
+    /* 打包需要带类型字段的二进制头，v1 不支持 */
+    const cJSON* client_features = cJSON_GetObjectItemCaseSensitive(root, "features");
+    const cJSON* audio_batch = cJSON_IsObject(client_features) ?
+        cJSON_GetObjectItemCaseSensitive(client_features, "audio_batch") : NULL;
+    const cJSON* max_frames = cJSON_IsObject(audio_batch) ?
+        cJSON_GetObjectItemCaseSensitive(audio_batch, "max_frames") : NULL;
+    s->batch_frames = 0;
+    if (cJSON_IsNumber(max_frames) && max_frames->valueint > 1 && server->opts.max_batch_frames > 1 && s->version >= 2) {
+        s->batch_frames = max_frames->valueint < server->opts.max_batch_frames ? max_frames->valueint
+                                                                                : server->opts.max_batch_frames;
+        cJSON* batch_reply = cJSON_CreateObject();
+        cJSON_AddNumberToObject(batch_reply, "max_frames", s->batch_frames);
+        cJSON_AddItemToObject(features, "audio_batch", batch_reply);
+        printf("[%s] 📦 上行打包: 每条消息最多 %d 帧\n", s->session_id, s->batch_frames);
+    }
+    cJSON_AddItemToObject(reply, "features", features);
+    cJSON* audio_params = cJSON_CreateObject();
+    cJSON_AddStringToObject(audio_params, "format", "opus");
+    cJSON_AddNumberToObject(audio_params, "sample_rate", server->opts.sample_rate);
+    cJSON_AddNumberToObject(audio_params, "channels", 1);
+    cJSON_AddNumberToObject(audio_params, "frame_duration", server->opts.frame_duration);
+    cJSON_AddItemToObject(reply, "audio_params", audio_params);
+    mock_send_json(s, reply);
+
+    s->hello_done = true;
+    if (server->opts.mcp_script) {
+        cJSON* params = cJSON_CreateObject();
+        cJSON_AddItemToObject(params, "capabilities", cJSON_CreateObject());
+        mock_send_mcp_request(s, "initialize", params, MOCK_MCP_ID_INITIALIZE);
+    }
+}
+
+static void mock_handle_listen(mock_session_t* s, const cJSON* root) {
+    const cJSON* state = cJSON_GetObjectItemCaseSensitive(root, "state");
+    if (!cJSON_IsString(state) || !state->valuestring) {
+        return;
+    }
+
+    if (strcmp(state->valuestring, "start") == 0) {
+        s->listening = true;
+        s->echo_len = 0;
+        s->echo_count = 0;
+    } else if (strcmp(state->valuestring, "stop") == 0) {
+        s->listening = false;
+        mock_start_tts(s);
+    } else if (strcmp(state->valuestring, "detect") == 0) {
+        const cJSON* text = cJSON_GetObjectItemCaseSensitive(root, "text");
+        printf("[%s] 唤醒词: %s\n", s->session_id,
+               cJSON_IsString(text) && text->valuestring ? text->valuestring : "");
+    }
+}
+
+static void mock_handle_text(mock_session_t* s, const struct mg_ws_message* wm) {
+    if (s->server->opts.verbose) {
+        printf("[%s] << %.*s\n", s->session_id, (int)wm->data.len, wm->data.buf);
+    }
+
+    cJSON* root = cJSON_ParseWithLength(wm->data.buf, wm->data.len);
+    if (!root) {
+        printf("[%s] ⚠️ 无效的 JSON 消息\n", s->session_id);
+        return;
+    }
+
+    const cJSON* type = cJSON_GetObjectItemCaseSensitive(root, "type");
+    if (cJSON_IsString(type) && type->valuestring) {
+        if (strcmp(type->valuestring, "hello") == 0) {
+            mock_handle_hello(s, root);
+        } else if (strcmp(type->valuestring, "listen") == 0) {
+            mock_handle_listen(s, root);
+        } else if (strcmp(type->valuestring, "abort") == 0) {
+            mock_stop_tts(s);
+        } else if (strcmp(type->valuestring, "playback") == 0) {
+            const cJSON* timestamp = cJSON_GetObjectItemCaseSensitive(root, "timestamp");
+            const cJSON* played_at = cJSON_GetObjectItemCaseSensitive(root, "played_at");
+            if (cJSON_IsNumber(timestamp) && cJSON_IsNumber(played_at)) {
+                printf("[%s] 🔊 播放对齐: 下行 %.0f ms 于设备时钟 %.0f ms 播放\n", s->session_id,
+                       timestamp->valuedouble, played_at->valuedouble);
+            }
+        } else if (strcmp(type->valuestring, "mcp") == 0) {
+            mock_handle_mcp(s, root);
+        } else if (strcmp(type->valuestring, "goodbye") == 0) {
+            s->conn->is_draining = 1;
+        }
+    }
+    cJSON_Delete(root);
+}
+
+/* 记录一帧上行音频，回放模式下缓存到本轮 */
+static void mock_store_uplink_frame(mock_session_t* s, const uint8_t* payload, size_t size) {
+    s->rx_frames++;
+    s->server->total_rx_frames++;
+
+    if (!s->server->opts.echo || !s->listening || size == 0 || size > MOCK_MAX_FRAME_SIZE ||
+        s->echo_count >= MOCK_MAX_ECHO_FRAMES) {
+        return;
+    }
+
+    if (s->echo_len + size > s->echo_cap) {
+        size_t cap = s->echo_cap ? s->echo_cap * 2 : 64 * 1024;
+        while (cap < s->echo_len + size) {
+            cap *= 2;
+        }
+        uint8_t* buf = realloc(s->echo_data, cap);
+        if (!buf) {
+            return;
+        }
+        s->echo_data = buf;
+        s->echo_cap = cap;
+    }
+    if (s->echo_count == s->echo_cap_frames) {
+        size_t cap = s->echo_cap_frames ? s->echo_cap_frames * 2 : 256;
+        uint32_t* sizes = realloc(s->echo_sizes, cap * sizeof(uint32_t));
+        if (!sizes) {
+            return;
+        }
+        s->echo_sizes = sizes;
+        s->echo_cap_frames = cap;
+    }
+
+    memcpy(s->echo_data + s->echo_len, payload, size);
+    s->echo_len += size;
+    s->echo_sizes[s->echo_count++] = (uint32_t)size;
+}
+
+/* 按协议版本解出上行音频载荷，打包消息逐帧拆开 */
+static void mock_handle_binary(mock_session_t* s, const struct mg_ws_message* wm) {
+    const uint8_t* data = (const uint8_t*)wm->data.buf;
+    size_t length = wm->data.len;
+    const uint8_t* payload = data;
+    size_t size = length;
+    int type = LINX_BINARY_TYPE_OPUS;
+
+    if (s->version == 2) {
+        if (length < sizeof(linx_binary_protocol2_t)) {
+            return;
+        }
+        const linx_binary_protocol2_t* bp2 = (const linx_binary_protocol2_t*)data;
+        type = ntohs(bp2->type);
+        size = ntohl(bp2->payload_size);
+        payload = data + sizeof(linx_binary_protocol2_t);
+        if (size > length - sizeof(linx_binary_protocol2_t)) {
+            return;
+        }
+    } else if (s->version == 3) {
+        if (length < sizeof(linx_binary_protocol3_t)) {
+            return;
+        }
+        const linx_binary_protocol3_t* bp3 = (const linx_binary_protocol3_t*)data;
+        type = bp3->type;
+        size = ntohs(bp3->payload_size);
+        payload = data + sizeof(linx_binary_protocol3_t);
+        if (size > length - sizeof(linx_binary_protocol3_t)) {
+            return;
+        }
+    }
+
+    s->rx_messages++;
+    if (type != LINX_BINARY_TYPE_OPUS_BATCH) {
+        mock_store_uplink_frame(s, payload, size);
+        return;
+    }
+    if (s->batch_frames == 0) {
+        printf("[%s] ⚠️ 收到未协商的打包消息\n", s->session_id);
+    }
+
+    const uint8_t* frame;
+    size_t frame_size;
+    int frames = 0;
+    while (linx_protocol_next_batch_frame(&payload, &size, NULL, &frame, &frame_size)) {
+        mock_store_uplink_frame(s, frame, frame_size);
+        frames++;
+    }
+    if (size != 0) {
+        printf("[%s] ⚠️ 打包消息末尾有 %zu 字节无法解析\n", s->session_id, size);
+    }
+    if (s->server->opts.verbose) {
+        printf("[%s] << 打包消息 %d 帧\n", s->session_id, frames);
+    }
+}
+
+// ==================== 会话管理 ====================
+
+static mock_session_t* mock_session_create(mock_server_t* server, struct mg_connection* c) {
+    mock_session_t* s = calloc(1, sizeof(mock_session_t));
+    if (!s) {
+        return NULL;
+    }
+    s->kind = MOCK_KIND_SESSION;
+    s->server = server;
+    s->conn = c;
+    s->version = 1;
+    snprintf(s->session_id, sizeof(s->session_id), "mock-%llx-%llu",
+             (unsigned long long)mg_millis(), (unsigned long long)++server->session_seq);
+
+    s->next = server->sessions;
+    server->sessions = s;
+    server->total_sessions++;
+    server->active_sessions++;
+    return s;
+}
+
+static void mock_session_destroy(mock_session_t* s) {
+    mock_server_t* server = s->server;
+    for (mock_session_t** p = &server->sessions; *p != NULL; p = &(*p)->next) {
+        if (*p == s) {
+            *p = s->next;
+            break;
+        }
+    }
+    server->active_sessions--;
+    if (server->opts.verbose) {
+        printf("[%s] 连接关闭 (上行 %llu 帧/%llu 条消息, 下行 %llu 帧)\n", s->session_id,
+               (unsigned long long)s->rx_frames, (unsigned long long)s->rx_messages,
+               (unsigned long long)s->tx_frames);
+    }
+    free(s->echo_data);
+    free(s->echo_sizes);
+    free(s);
+}
+
+static void mock_event_handler(struct mg_connection* c, int ev, void* ev_data) {
+    if (ev == MG_EV_ACCEPT) {
+        /* 新连接继承监听连接的 fn_data（服务器），替换为自己的会话 */
+        mock_server_t* server = (mock_server_t*)c->fn_data;
+        mock_session_t* s = mock_session_create(server, c);
+        if (!s) {
+            c->is_closing = 1;
+            return;
+        }
+        c->fn_data = s;
+        return;
+    }
+
+    if (c->is_listening || !c->fn_data || *(int*)c->fn_data != MOCK_KIND_SESSION) {
+        return;
+    }
+    mock_session_t* s = (mock_session_t*)c->fn_data;
+
+    switch (ev) {
+        case MG_EV_HTTP_MSG: {
+            struct mg_http_message* hm = (struct mg_http_message*)ev_data;
+            struct mg_str* version = mg_http_get_header(hm, "Protocol-Version");
+            if (version && version->len == 1 && version->buf[0] >= '1' && version->buf[0] <= '3') {
+                s->version = version->buf[0] - '0';
+            }
+            mg_ws_upgrade(c, hm, NULL);
+            break;
+        }
+        case MG_EV_WS_MSG: {
+            struct mg_ws_message* wm = (struct mg_ws_message*)ev_data;
+            if ((wm->flags & 0x0F) == WEBSOCKET_OP_TEXT) {
+                mock_handle_text(s, wm);
+            } else if ((wm->flags & 0x0F) == WEBSOCKET_OP_BINARY) {
+                mock_handle_binary(s, wm);
+            }
+            break;
+        }
+        case MG_EV_CLOSE:
+            c->fn_data = NULL;
+            mock_session_destroy(s);
+            break;
+        default:
+            break;
+    }
+}
+
+// ==================== 主函数 ====================
+
+static void print_usage(const char* prog) {
+    printf("用法: %s [选项]\n", prog);
+    printf("  -l URL     监听地址 (默认 ws://0.0.0.0:8765)\n");
+    printf("  -e         回放模式：把本轮上行音频作为 TTS 下发 (默认合成静音帧)\n");
+    printf("  -s RATE    hello 中声明的下行采样率 (默认 16000)\n");
+    printf("  -f MS      合成帧时长，10 或 20 的整数倍且不超过 120 (默认 60)\n");
+    printf("  -n N       每轮合成的帧数 (默认 50)\n");
+    printf("  -d MS      listen stop 到 tts start 的延迟 (默认 200)\n");
+    printf("  -p FACTOR  发送节奏，1.0 实时，0 尽快发送 (默认 1.0)\n");
+    printf("  -b N       tts start 后立即发送的预缓冲帧数 (默认 3)\n");
+    printf("  -r         允许会话恢复 (hello 声明 features.session_resume)\n");
+    printf("  -k N       接受的上行打包帧数上限，0 不支持打包 (默认 8)\n");
+    printf("  -m         握手后执行 MCP 脚本 (initialize, tools/list)\n");
+    printf("  -t NAME    MCP 脚本在 tools/list 后调用的工具\n");
+    printf("  -a JSON    工具调用参数 (默认 {})\n");
+    printf("  -v         打印每条消息\n");
+    printf("  -h         显示帮助\n");
+}
+
+int main(int argc, char* argv[]) {
+    mock_server_t server;
+    memset(&server, 0, sizeof(server));
+    server.kind = MOCK_KIND_SERVER;
+    server.opts.listen_url = "ws://0.0.0.0:8765";
+    server.opts.sample_rate = 16000;
+    server.opts.frame_duration = 60;
+    server.opts.synth_frames = 50;
+    server.opts.first_delay_ms = 200;
+    server.opts.pace = 1.0;
+    server.opts.burst_frames = 3;
+    server.opts.max_batch_frames = 8;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "l:es:f:n:d:p:b:rk:mt:a:vh")) != -1) {
+        switch (opt) {
+            case 'l': server.opts.listen_url = optarg; break;
+            case 'e': server.opts.echo = true; break;
+            case 's': server.opts.sample_rate = atoi(optarg); break;
+            case 'f': server.opts.frame_duration = atoi(optarg); break;
+            case 'n': server.opts.synth_frames = atoi(optarg); break;
+            case 'd': server.opts.first_delay_ms = atoi(optarg); break;
+            case 'p': server.opts.pace = atof(optarg); break;
+            case 'b': server.opts.burst_frames = atoi(optarg); break;
+            case 'r': server.opts.session_resume = true; break;
+            case 'k': server.opts.max_batch_frames = atoi(optarg); break;
+            case 'm': server.opts.mcp_script = true; break;
+            case 't': server.opts.tool_name = optarg; server.opts.mcp_script = true; break;
+            case 'a': server.opts.tool_args = optarg; break;
+            case 'v': server.opts.verbose = true; break;
+            case 'h': print_usage(argv[0]); return 0;
+            default: print_usage(argv[0]); return 1;
+        }
+    }
+
+    server.silence_size = mock_build_silence(server.opts.frame_duration, server.silence);
+    if (server.silence_size == 0) {
+        fprintf(stderr, "❌ 不支持的帧时长: %d ms\n", server.opts.frame_duration);
+        return 1;
+    }
+    if (server.opts.synth_frames < 0 || server.opts.first_delay_ms < 0 ||
+        server.opts.burst_frames < 0 || server.opts.pace < 0) {
+        fprintf(stderr, "❌ 参数不能为负数\n");
+        return 1;
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    struct mg_mgr mgr;
+    mg_log_set(MG_LL_ERROR);
+    mg_mgr_init(&mgr);
+    if (!mg_http_listen(&mgr, server.opts.listen_url, mock_event_handler, &server)) {
+        fprintf(stderr, "❌ 无法监听 %s\n", server.opts.listen_url);
+        mg_mgr_free(&mgr);
+        return 1;
+    }
+    mg_timer_add(&mgr, MOCK_TICK_MS, MG_TIMER_REPEAT, mock_timer_fn, &server);
+
+    printf("🚀 Linx 模拟服务器已启动: %s\n", server.opts.listen_url);
+    printf("   TTS: %s, 帧时长 %d ms, 首包延迟 %d ms, 节奏 %.2f\n",
+           server.opts.echo ? "回放上行音频" : "合成静音帧", server.opts.frame_duration,
+           server.opts.first_delay_ms, server.opts.pace);
+
+    while (g_running) {
+        mg_mgr_poll(&mgr, 50);
+    }
+
+    mg_mgr_free(&mgr);
+    printf("\n📊 会话 %llu, 对话轮次 %llu, 上行帧 %llu, 下行帧 %llu\n",
+           (unsigned long long)server.total_sessions, (unsigned long long)server.total_turns,
+           (unsigned long long)server.total_rx_frames, (unsigned long long)server.total_tx_frames);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * 多帧打包解析单元测试
+ *
+ * 覆盖按条目头逐帧取出、空帧、截断的条目头与截断的数据，
+ * 确保解析不会越过载荷末尾。
+ */
+
+#include "linx_protocol.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <arpa/inet.h>
+
+// 追加一个条目，返回新的载荷长度
+static size_t append_entry(uint8_t* buf, size_t len, uint32_t timestamp, const uint8_t* data, uint16_t size) {
+    linx_audio_batch_entry_t entry;
+    entry.timestamp = htonl(timestamp);
+    entry.payload_size = htons(size);
+    memcpy(buf + len, &entry, sizeof(entry));
+    memcpy(buf + len + sizeof(entry), data, size);
+    return len + sizeof(entry) + size;
+}
+
+// 测试顺序取出每一帧及其时间戳
+static void test_iterate(void) {
+    printf("Testing batch iteration...\n");
+
+    uint8_t buf[256];
+    const uint8_t a[] = {0xF8, 0xFF, 0xFE};
+    const uint8_t b[] = {0xF8};
+    size_t len = 0;
+    len = append_entry(buf, len, 1000, a, sizeof(a));
+    len = append_entry(buf, len, 1060, NULL, 0);
+    len = append_entry(buf, len, 0xA0B0C0D0u, b, sizeof(b));
+    assert(sizeof(linx_audio_batch_entry_t) == 6);
+
+    const uint8_t* cursor = buf;
+    size_t remaining = len;
+    uint32_t timestamp = 0;
+    const uint8_t* payload = NULL;
+    size_t size = 0;
+
+    assert(linx_protocol_next_batch_frame(&cursor, &remaining, &timestamp, &payload, &size));
+    assert(timestamp == 1000 && size == sizeof(a) && memcmp(payload, a, sizeof(a)) == 0);
+
+    // 空帧也是合法条目
+    assert(linx_protocol_next_batch_frame(&cursor, &remaining, &timestamp, &payload, &size));
+    assert(timestamp == 1060 && size == 0);
+
+    assert(linx_protocol_next_batch_frame(&cursor, &remaining, &timestamp, &payload, &size));
+    assert(timestamp == 0xA0B0C0D0u && size == 1 && payload[0] == 0xF8);
+
+    assert(remaining == 0 && cursor == buf + len);
+    assert(!linx_protocol_next_batch_frame(&cursor, &remaining, &timestamp, &payload, &size));
+
+    // 输出参数可以为 NULL
+    cursor = buf;
+    remaining = len;
+    int frames = 0;
+    while (linx_protocol_next_batch_frame(&cursor, &remaining, NULL, NULL, NULL)) {
+        frames++;
+    }
+    assert(frames == 3 && remaining == 0);
+
+    printf("Batch iteration test passed!\n");
+}
+
+// 测试截断的载荷被拒绝且游标不前移
+static void test_truncated(void) {
+    printf("Testing truncated batches...\n");
+
+    uint8_t buf[64];
+    const uint8_t data[] = {1, 2, 3, 4};
+    size_t len = append_entry(buf, 0, 7, data, sizeof(data));
+
+    // 条目头不完整
+    const uint8_t* cursor = buf;
+    size_t remaining = sizeof(linx_audio_batch_entry_t) - 1;
+    assert(!linx_protocol_next_batch_frame(&cursor, &remaining, NULL, NULL, NULL));
+    assert(cursor == buf && remaining == sizeof(linx_audio_batch_entry_t) - 1);
+
+    // 声明的长度超过剩余数据
+    cursor = buf;
+    remaining = len - 1;
+    assert(!linx_protocol_next_batch_frame(&cursor, &remaining, NULL, NULL, NULL));
+    assert(cursor == buf && remaining == len - 1);
+
+    // 第一帧完整、第二帧截断：只取出第一帧
+    len = append_entry(buf, len, 8, data, sizeof(data));
+    cursor = buf;
+    remaining = len - 2;
+    int frames = 0;
+    while (linx_protocol_next_batch_frame(&cursor, &remaining, NULL, NULL, NULL)) {
+        frames++;
+    }
+    assert(frames == 1 && remaining == sizeof(linx_audio_batch_entry_t) + sizeof(data) - 2);
+
+    // 非法参数
+    remaining = len;
+    assert(!linx_protocol_next_batch_frame(NULL, &remaining, NULL, NULL, NULL));
+    cursor = NULL;
+    assert(!linx_protocol_next_batch_frame(&cursor, &remaining, NULL, NULL, NULL));
+
+    printf("Truncated batch test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx audio batch tests ===\n");
+
+    test_iterate();
+    test_truncated();
+
+    printf("All audio batch tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * linx_message_router 单元测试
+ *
+ * 覆盖 (type, state) 优先匹配、类型级回退、覆盖注册、注销后的探测链，
+ * 未注册类型的静默丢弃计数，以及查找后在处理函数中修改路由表。
+ */
+
+#include "linx_message_router.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+typedef struct {
+    int calls;
+    const char* last_tag;
+} handler_probe_t;
+
+static void tag_handler_a(const cJSON* root, void* user_data) {
+    (void)root;
+    handler_probe_t* probe = (handler_probe_t*)user_data;
+    probe->calls++;
+    probe->last_tag = "a";
+}
+
+static void tag_handler_b(const cJSON* root, void* user_data) {
+    (void)root;
+    handler_probe_t* probe = (handler_probe_t*)user_data;
+    probe->calls++;
+    probe->last_tag = "b";
+}
+
+static bool dispatch_json(linx_message_router_t* router, const char* text) {
+    cJSON* root = cJSON_Parse(text);
+    assert(root != NULL);
+    bool handled = linx_message_router_dispatch(router, root);
+    cJSON_Delete(root);
+    return handled;
+}
+
+// 测试 state 精确匹配与类型级回退
+static void test_state_routing(void) {
+    printf("Testing type/state routing...\n");
+
+    linx_message_router_t router;
+    linx_message_router_init(&router);
+    handler_probe_t probe = {0};
+
+    assert(linx_message_router_register(&router, "tts", NULL, tag_handler_a, &probe));
+    assert(linx_message_router_register(&router, "tts", "start", tag_handler_b, &probe));
+
+    assert(dispatch_json(&router, "{\"type\":\"tts\",\"state\":\"start\"}"));
+    assert(probe.calls == 1 && strcmp(probe.last_tag, "b") == 0);
+
+    assert(dispatch_json(&router, "{\"type\":\"tts\",\"state\":\"sentence_end\"}"));
+    assert(probe.calls == 2 && strcmp(probe.last_tag, "a") == 0);
+
+    assert(dispatch_json(&router, "{\"type\":\"tts\"}"));
+    assert(probe.calls == 3 && strcmp(probe.last_tag, "a") == 0);
+
+    // "tt"+"sstart" 与 "tts"+"start" 不能相互命中
+    assert(!dispatch_json(&router, "{\"type\":\"tt\",\"state\":\"sstart\"}"));
+
+    printf("Type/state routing test passed!\n");
+}
+
+// 测试覆盖、注销与未处理计数
+static void test_register_unregister(void) {
+    printf("Testing register/unregister...\n");
+
+    linx_message_router_t router;
+    linx_message_router_init(&router);
+    handler_probe_t probe = {0};
+
+    assert(!dispatch_json(&router, "{\"type\":\"llm\",\"emotion\":\"happy\"}"));
+    assert(!dispatch_json(&router, "{\"no_type\":1}"));
+    assert(router.unhandled == 2);
+
+    assert(linx_message_router_register(&router, "llm", NULL, tag_handler_a, &probe));
+    assert(linx_message_router_register(&router, "llm", NULL, tag_handler_b, &probe));
+    assert(router.count == 1);
+    assert(dispatch_json(&router, "{\"type\":\"llm\"}"));
+    assert(strcmp(probe.last_tag, "b") == 0);
+
+    // 填充大量路由后注销其中一部分，剩余路由必须仍可命中
+    char name[LINX_MESSAGE_ROUTER_NAME_MAX];
+    for (int i = 0; i < 20; i++) {
+        snprintf(name, sizeof(name), "type_%d", i);
+        assert(linx_message_router_register(&router, name, NULL, tag_handler_a, &probe));
+    }
+    for (int i = 0; i < 20; i += 2) {
+        snprintf(name, sizeof(name), "type_%d", i);
+        assert(linx_message_router_unregister(&router, name, NULL));
+    }
+    for (int i = 0; i < 20; i++) {
+        char json[64];
+        snprintf(json, sizeof(json), "{\"type\":\"type_%d\"}", i);
+        assert(dispatch_json(&router, json) == (i % 2 == 1));
+    }
+    assert(!linx_message_router_unregister(&router, "type_0", NULL));
+
+    // 名称过长被拒绝
+    char long_name[LINX_MESSAGE_ROUTER_NAME_MAX + 8];
+    memset(long_name, 'x', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    assert(!linx_message_router_register(&router, long_name, NULL, tag_handler_a, &probe));
+
+    printf("Register/unregister test passed!\n");
+}
+
+static linx_message_router_t* g_reentrant_router;
+
+// 处理函数中注销自身并注册新路由
+static void reentrant_handler(const cJSON* root, void* user_data) {
+    (void)root;
+    handler_probe_t* probe = (handler_probe_t*)user_data;
+    probe->calls++;
+    assert(linx_message_router_unregister(g_reentrant_router, "goodbye", NULL));
+    assert(linx_message_router_register(g_reentrant_router, "hello", NULL, tag_handler_a, probe));
+}
+
+// 测试查找只返回处理函数，调用时路由表可被修改
+static void test_lookup(void) {
+    printf("Testing lookup...\n");
+
+    linx_message_router_t router;
+    linx_message_router_init(&router);
+    handler_probe_t probe = {0};
+    g_reentrant_router = &router;
+    assert(linx_message_router_register(&router, "goodbye", NULL, reentrant_handler, &probe));
+
+    cJSON* root = cJSON_Parse("{\"type\":\"goodbye\"}");
+    assert(root != NULL);
+    linx_message_handler_t handler = NULL;
+    void* user_data = NULL;
+    assert(linx_message_router_lookup(&router, root, &handler, &user_data));
+    assert(handler == reentrant_handler && user_data == &probe);
+    assert(probe.calls == 0 && router.dispatched == 1);
+
+    handler(root, user_data);
+    assert(probe.calls == 1);
+    assert(!linx_message_router_lookup(&router, root, &handler, &user_data));
+    assert(router.unhandled == 1);
+    cJSON_Delete(root);
+
+    assert(dispatch_json(&router, "{\"type\":\"hello\"}"));
+    assert(probe.calls == 2 && strcmp(probe.last_tag, "a") == 0);
+
+    printf("Lookup test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx_message_router tests ===\n");
+
+    test_state_routing();
+    test_register_unregister();
+    test_lookup();
+
+    printf("All message router tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * 重连退避单元测试
+ *
+ * 注入确定的随机数序列检查每次重连的延迟区间端点，用内置 xorshift32
+ * 检查大量种子下延迟不越界，并覆盖上限封顶、成功后清零与参数修正。
+ */
+
+#include "linx_reconnect_backoff.h"
+#include <stdio.h>
+#include <assert.h>
+
+#define BASE_MS     1000
+#define MAX_MS      30000
+
+// 按顺序返回预设的随机数
+typedef struct {
+    const uint32_t* values;
+    int count;
+    int next;
+} fixed_rand_t;
+
+static uint32_t fixed_rand(void* user_data) {
+    fixed_rand_t* rand = (fixed_rand_t*)user_data;
+    assert(rand->next < rand->count);
+    return rand->values[rand->next++];
+}
+
+// 第 attempt 次重连的延迟上限
+static uint64_t expected_cap(int attempt) {
+    uint64_t cap = BASE_MS;
+    for (int i = 1; i < attempt && cap < MAX_MS; i++) {
+        cap <<= 1;
+    }
+    return cap < MAX_MS ? cap : MAX_MS;
+}
+
+// 测试注入随机数时延迟落在 [上限/2, 上限] 的两端
+static void test_jitter_bounds(void) {
+    printf("Testing jitter bounds with injected randomness...\n");
+
+    linx_reconnect_backoff_t backoff;
+    linx_reconnect_backoff_init(&backoff, BASE_MS, MAX_MS, 1);
+
+    // 每次重连先取最小值再取最大值：随机数 0 与区间宽度
+    uint32_t values[16];
+    for (int i = 0; i < 16; i++) {
+        uint64_t cap = expected_cap(i + 1);
+        values[i] = i % 2 == 0 ? 0 : (uint32_t)(cap - cap / 2);
+    }
+    fixed_rand_t rand = { .values = values, .count = 16, .next = 0 };
+    linx_reconnect_backoff_set_rand(&backoff, fixed_rand, &rand);
+
+    for (int attempt = 1; attempt <= 16; attempt++) {
+        uint64_t delay_ms = 0;
+        assert(linx_reconnect_backoff_next(&backoff, &delay_ms) == attempt);
+        uint64_t cap = expected_cap(attempt);
+        assert(delay_ms == (attempt % 2 == 1 ? cap / 2 : cap));
+    }
+    assert(linx_reconnect_backoff_attempts(&backoff) == 16);
+
+    // 随机数超出区间宽度时取模回绕，仍不越界
+    uint32_t wrap[] = { (uint32_t)(BASE_MS - BASE_MS / 2 + 1) };
+    fixed_rand_t wrap_rand = { .values = wrap, .count = 1, .next = 0 };
+    linx_reconnect_backoff_reset(&backoff);
+    linx_reconnect_backoff_set_rand(&backoff, fixed_rand, &wrap_rand);
+    uint64_t delay_ms = 0;
+    linx_reconnect_backoff_next(&backoff, &delay_ms);
+    assert(delay_ms == BASE_MS / 2);
+
+    printf("Jitter bounds test passed!\n");
+}
+
+// 测试内置 xorshift32 在大量种子与重连次数下都不越界，且同一种子序列可复现
+static void test_xorshift_range(void) {
+    printf("Testing built-in jitter range...\n");
+
+    for (uint32_t seed = 1; seed <= 200; seed++) {
+        linx_reconnect_backoff_t a;
+        linx_reconnect_backoff_t b;
+        linx_reconnect_backoff_init(&a, BASE_MS, MAX_MS, seed * 2654435761u);
+        linx_reconnect_backoff_init(&b, BASE_MS, MAX_MS, seed * 2654435761u);
+        for (int attempt = 1; attempt <= 40; attempt++) {
+            uint64_t delay_a = 0;
+            uint64_t delay_b = 0;
+            linx_reconnect_backoff_next(&a, &delay_a);
+            linx_reconnect_backoff_next(&b, &delay_b);
+            uint64_t cap = expected_cap(attempt);
+            assert(delay_a >= cap / 2 && delay_a <= cap);
+            assert(delay_a == delay_b);
+        }
+    }
+
+    // 种子为 0 时使用固定的非零种子，xorshift32 不会卡在 0
+    linx_reconnect_backoff_t zero;
+    linx_reconnect_backoff_init(&zero, BASE_MS, MAX_MS, 0);
+    assert(zero.jitter_state != 0);
+
+    printf("Built-in jitter range test passed!\n");
+}
+
+// 测试退避封顶：次数很大时不溢出，延迟不超过 max_ms
+static void test_cap(void) {
+    printf("Testing backoff cap...\n");
+
+    uint32_t values[] = { 0xFFFFFFFFu };
+    fixed_rand_t rand = { .values = values, .count = 1, .next = 0 };
+    linx_reconnect_backoff_t backoff;
+    linx_reconnect_backoff_init(&backoff, BASE_MS, MAX_MS, 1);
+    backoff.attempts = 1000;
+    linx_reconnect_backoff_set_rand(&backoff, fixed_rand, &rand);
+
+    uint64_t delay_ms = 0;
+    assert(linx_reconnect_backoff_next(&backoff, &delay_ms) == 1001);
+    assert(delay_ms >= MAX_MS / 2 && delay_ms <= MAX_MS);
+
+    // max_ms 小于 base_ms 时按 base_ms 封顶，base_ms 为 0 时取 1
+    linx_reconnect_backoff_init(&backoff, 5000, 2000, 1);
+    assert(backoff.base_ms == 5000 && backoff.max_ms == 5000);
+    for (int i = 0; i < 5; i++) {
+        linx_reconnect_backoff_next(&backoff, &delay_ms);
+        assert(delay_ms >= 2500 && delay_ms <= 5000);
+    }
+    linx_reconnect_backoff_init(&backoff, 0, 0, 1);
+    assert(backoff.base_ms == 1 && backoff.max_ms == 1);
+    linx_reconnect_backoff_next(&backoff, &delay_ms);
+    assert(delay_ms <= 1);
+
+    printf("Backoff cap test passed!\n");
+}
+
+// 测试连接成功后清零，下一次重连回到最短退避
+static void test_reset_on_success(void) {
+    printf("Testing reset on success...\n");
+
+    uint32_t values[] = { 0, 0, 0, 0, 0, 0 };
+    fixed_rand_t rand = { .values = values, .count = 6, .next = 0 };
+    linx_reconnect_backoff_t backoff;
+    linx_reconnect_backoff_init(&backoff, BASE_MS, MAX_MS, 1);
+    linx_reconnect_backoff_set_rand(&backoff, fixed_rand, &rand);
+
+    uint64_t delay_ms = 0;
+    for (int attempt = 1; attempt <= 5; attempt++) {
+        linx_reconnect_backoff_next(&backoff, &delay_ms);
+    }
+    assert(delay_ms == expected_cap(5) / 2);
+    assert(linx_reconnect_backoff_attempts(&backoff) == 5);
+
+    // 收到服务器 hello 后清零
+    linx_reconnect_backoff_reset(&backoff);
+    assert(linx_reconnect_backoff_attempts(&backoff) == 0);
+    assert(linx_reconnect_backoff_next(&backoff, &delay_ms) == 1);
+    assert(delay_ms == BASE_MS / 2);
+
+    printf("Reset on success test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx_reconnect_backoff tests ===\n");
+
+    test_jitter_bounds();
+    test_xorshift_range();
+    test_cap();
+    test_reset_on_success();
+
+    printf("All reconnect backoff tests passed!\n");
+    return 0;
+}
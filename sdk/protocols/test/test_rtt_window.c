@@ -0,0 +1,116 @@
+/**
+ * 心跳 RTT 窗口单元测试
+ *
+ * 用手动推进的时钟模拟 ping 发出与 pong 到达，覆盖非本端与过期 pong
+ * 的过滤、窗口未满与写满回绕后的 min/avg/p99，以及空窗口。
+ */
+
+#include "linx_rtt_window.h"
+#include <stdio.h>
+#include <assert.h>
+
+#define MAX_AGE_US  45000000ULL
+
+// 手动推进的单调时钟（微秒）
+typedef struct {
+    uint64_t now_us;
+} fake_clock_t;
+
+// 在当前时刻发出 ping，经过 rtt_us 后收到 pong
+static bool ping_pong(linx_rtt_window_t* window, fake_clock_t* clock, uint32_t rtt_us) {
+    uint64_t sent_us = clock->now_us;
+    clock->now_us += rtt_us;
+    bool recorded = linx_rtt_window_add_pong(window, sent_us, clock->now_us, MAX_AGE_US, NULL);
+    clock->now_us += 1000000;
+    return recorded;
+}
+
+// 测试只记录本端发出且未过期的 pong
+static void test_filter(void) {
+    printf("Testing pong filtering...\n");
+
+    linx_rtt_window_t window;
+    linx_rtt_window_reset(&window);
+    uint64_t now_us = 100000000;
+    uint32_t rtt_us = 0;
+
+    // 时间戳为 0 或来自未来：不是本端的 ping
+    assert(!linx_rtt_window_add_pong(&window, 0, now_us, MAX_AGE_US, &rtt_us));
+    assert(!linx_rtt_window_add_pong(&window, now_us + 1, now_us, MAX_AGE_US, &rtt_us));
+
+    // 超过最大有效时长：过期
+    assert(!linx_rtt_window_add_pong(&window, now_us - MAX_AGE_US - 1, now_us, MAX_AGE_US, &rtt_us));
+    assert(window.next == 0 && rtt_us == 0);
+
+    // 边界值仍然有效，同一时刻收到记为 0
+    assert(linx_rtt_window_add_pong(&window, now_us - MAX_AGE_US, now_us, MAX_AGE_US, &rtt_us));
+    assert(rtt_us == MAX_AGE_US);
+    assert(linx_rtt_window_add_pong(&window, now_us, now_us, MAX_AGE_US, &rtt_us));
+    assert(rtt_us == 0 && window.next == 2);
+
+    printf("Pong filtering test passed!\n");
+}
+
+// 测试窗口未满时的汇总
+static void test_partial_window(void) {
+    printf("Testing partial window...\n");
+
+    linx_rtt_window_t window;
+    linx_rtt_window_reset(&window);
+    fake_clock_t clock = { .now_us = 1 };
+    linx_rtt_summary_t summary;
+
+    linx_rtt_window_summarize(&window, &summary);
+    assert(summary.samples == 0 && summary.min_us == 0 && summary.avg_us == 0 && summary.p99_us == 0);
+
+    // 乱序写入 10 个样本：1000..10000
+    const uint32_t rtts[] = { 5000, 2000, 9000, 1000, 7000, 3000, 10000, 4000, 8000, 6000 };
+    for (int i = 0; i < 10; i++) {
+        assert(ping_pong(&window, &clock, rtts[i]));
+    }
+    linx_rtt_window_summarize(&window, &summary);
+    assert(summary.samples == 10);
+    assert(summary.min_us == 1000 && summary.avg_us == 5500 && summary.p99_us == 10000);
+
+    printf("Partial window test passed!\n");
+}
+
+// 测试写满后覆盖最早的样本，汇总只基于最近 LINX_RTT_WINDOW_SIZE 个
+static void test_wrap(void) {
+    printf("Testing window wrap-around...\n");
+
+    linx_rtt_window_t window;
+    linx_rtt_window_reset(&window);
+    fake_clock_t clock = { .now_us = 1 };
+    linx_rtt_summary_t summary;
+
+    // 先写入一个很大和一个很小的样本，再写满窗口把它们挤出去
+    assert(ping_pong(&window, &clock, 900000));
+    assert(ping_pong(&window, &clock, 10));
+    for (uint32_t i = 1; i <= LINX_RTT_WINDOW_SIZE - 2; i++) {
+        assert(ping_pong(&window, &clock, 1000 * i));
+    }
+    linx_rtt_window_summarize(&window, &summary);
+    assert(summary.samples == LINX_RTT_WINDOW_SIZE);
+    assert(summary.min_us == 10 && summary.p99_us == 900000);
+
+    assert(ping_pong(&window, &clock, 63000));
+    assert(ping_pong(&window, &clock, 64000));
+    linx_rtt_window_summarize(&window, &summary);
+    assert(summary.samples == LINX_RTT_WINDOW_SIZE);
+    assert(summary.min_us == 1000 && summary.p99_us == 64000);
+    assert(summary.avg_us == 32500);
+
+    printf("Window wrap-around test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx_rtt_window tests ===\n");
+
+    test_filter();
+    test_partial_window();
+    test_wrap();
+
+    printf("All RTT window tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * linx_runtime 单元测试
+ *
+ * 覆盖跨线程同步调用、分片线程内直接调用、分片之间相互回调、
+ * 任务后的定时器重扫与有界等待，以及并发调用后的停止与统计。
+ */
+
+#include "linx_runtime.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define CALLER_COUNT        4
+#define CALLS_PER_CALLER    500
+
+typedef struct {
+    linx_runtime_t* runtime;
+    int shard;
+    bool on_shard;
+    int calls;
+} probe_t;
+
+static void probe_task(void* arg) {
+    probe_t* probe = (probe_t*)arg;
+    probe->on_shard = linx_runtime_on_shard(probe->runtime, probe->shard);
+    probe->calls++;
+}
+
+// 测试调用在目标分片线程上同步执行
+static void test_call(void) {
+    printf("Testing call...\n");
+
+    linx_runtime_config_t config = { .shard_count = 2, .max_wait_ms = 1000 };
+    linx_runtime_t* runtime = linx_runtime_create(&config);
+    assert(runtime != NULL);
+    assert(linx_runtime_get_shard_count(runtime) == 2);
+    assert(!linx_runtime_on_shard(runtime, 0));
+
+    probe_t probe = { .runtime = runtime, .shard = 1 };
+    assert(linx_runtime_call(runtime, 1, probe_task, &probe));
+    assert(probe.calls == 1 && probe.on_shard);
+
+    // 参数无效
+    assert(!linx_runtime_call(runtime, 2, probe_task, &probe));
+    assert(!linx_runtime_call(runtime, -1, probe_task, &probe));
+    assert(!linx_runtime_call(runtime, 0, NULL, NULL));
+    assert(probe.calls == 1);
+
+    linx_runtime_shard_stats_t stats;
+    assert(linx_runtime_get_shard_stats(runtime, 1, &stats));
+    assert(stats.tasks == 1 && stats.sessions == 0);
+    assert(!linx_runtime_get_shard_stats(runtime, 2, &stats));
+
+    linx_runtime_destroy(runtime);
+    printf("Call test passed!\n");
+}
+
+typedef struct {
+    linx_runtime_t* runtime;
+    probe_t inner;
+    bool inner_result;
+    bool nested_result;
+} bounce_t;
+
+// 在分片 1 上执行：同步回调分片 0（调用方分片正等待本任务）
+static void bounce_back_task(void* arg) {
+    bounce_t* bounce = (bounce_t*)arg;
+    bounce->inner_result = linx_runtime_call(bounce->runtime, 0, probe_task, &bounce->inner);
+}
+
+// 在分片 0 上执行：本分片直接调用，再同步调用分片 1
+static void bounce_task(void* arg) {
+    bounce_t* bounce = (bounce_t*)arg;
+    probe_t self = { .runtime = bounce->runtime, .shard = 0 };
+    bounce->nested_result = linx_runtime_call(bounce->runtime, 0, probe_task, &self) && self.on_shard;
+    assert(linx_runtime_call(bounce->runtime, 1, bounce_back_task, bounce));
+}
+
+// 测试分片之间相互同步调用不会死锁
+static void test_cross_shard(void) {
+    printf("Testing cross-shard calls...\n");
+
+    linx_runtime_config_t config = { .shard_count = 2, .max_wait_ms = 1000 };
+    linx_runtime_t* runtime = linx_runtime_create(&config);
+    assert(runtime != NULL);
+
+    for (int i = 0; i < 100; i++) {
+        bounce_t bounce;
+        memset(&bounce, 0, sizeof(bounce));
+        bounce.runtime = runtime;
+        bounce.inner.runtime = runtime;
+        bounce.inner.shard = 0;
+        assert(linx_runtime_call(runtime, 0, bounce_task, &bounce));
+        assert(bounce.nested_result && bounce.inner_result);
+        assert(bounce.inner.calls == 1 && bounce.inner.on_shard);
+    }
+
+    linx_runtime_destroy(runtime);
+    printf("Cross-shard test passed!\n");
+}
+
+// 测试任务执行后重扫定时器，空闲时按 max_wait_ms 醒来
+static void test_timers(void) {
+    printf("Testing timer scans...\n");
+
+    linx_runtime_config_t config = { .shard_count = 1, .max_wait_ms = 10 };
+    linx_runtime_t* runtime = linx_runtime_create(&config);
+    assert(runtime != NULL);
+
+    linx_runtime_shard_stats_t before;
+    assert(linx_runtime_get_shard_stats(runtime, 0, &before));
+
+    probe_t probe = { .runtime = runtime, .shard = 0 };
+    assert(linx_runtime_call(runtime, 0, probe_task, &probe));
+    usleep(200000);
+
+    linx_runtime_shard_stats_t after;
+    assert(linx_runtime_get_shard_stats(runtime, 0, &after));
+    assert(after.timer_scans > before.timer_scans);
+    assert(after.iterations >= before.iterations + 5);
+
+    linx_runtime_destroy(runtime);
+    printf("Timer scan test passed!\n");
+}
+
+typedef struct {
+    linx_runtime_t* runtime;
+    int id;
+    int counter;
+} caller_args_t;
+
+static void count_task(void* arg) {
+    __atomic_add_fetch((int*)arg, 1, __ATOMIC_RELAXED);
+}
+
+static void* caller_thread(void* arg) {
+    caller_args_t* args = (caller_args_t*)arg;
+    int shards = (int)linx_runtime_get_shard_count(args->runtime);
+    for (int i = 0; i < CALLS_PER_CALLER; i++) {
+        assert(linx_runtime_call(args->runtime, (args->id + i) % shards, count_task, &args->counter));
+    }
+    return NULL;
+}
+
+// 测试并发调用全部执行，停止时不遗留等待者
+static void test_shutdown(void) {
+    printf("Testing concurrent calls and shutdown...\n");
+
+    linx_runtime_config_t config = { .shard_count = 3, .max_wait_ms = 1000 };
+    linx_runtime_t* runtime = linx_runtime_create(&config);
+    assert(runtime != NULL);
+
+    pthread_t threads[CALLER_COUNT];
+    caller_args_t args[CALLER_COUNT];
+    for (int i = 0; i < CALLER_COUNT; i++) {
+        args[i].runtime = runtime;
+        args[i].id = i;
+        args[i].counter = 0;
+        assert(pthread_create(&threads[i], NULL, caller_thread, &args[i]) == 0);
+    }
+    for (int i = 0; i < CALLER_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        assert(args[i].counter == CALLS_PER_CALLER);
+    }
+
+    uint64_t tasks = 0;
+    for (int shard = 0; shard < 3; shard++) {
+        linx_runtime_shard_stats_t stats;
+        assert(linx_runtime_get_shard_stats(runtime, shard, &stats));
+        tasks += stats.tasks;
+    }
+    assert(tasks == CALLER_COUNT * CALLS_PER_CALLER);
+
+    linx_runtime_destroy(runtime);
+    printf("Shutdown test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx_runtime tests ===\n");
+
+    test_call();
+    test_cross_shard();
+    test_timers();
+    test_shutdown();
+
+    printf("All runtime tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,222 @@
+/**
+ * 发送缓冲区簿记单元测试
+ *
+ * 用普通字节数组模拟 conn->send：每条消息填充一个字母，按字符串检查
+ * 剪除与前移后的顺序。覆盖头部部分写出时的剪除、越过多条音频的前移、
+ * 写出后的偏移修正与控制消息时延，以及 TLS 连接不改写缓冲区。
+ */
+
+#include "linx_send_backlog.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define BUF_SIZE 256
+
+typedef struct {
+    uint8_t data[BUF_SIZE + 1];
+    size_t len;
+} buffer_t;
+
+// 追加 length 个字母 c，返回消息的起始偏移
+static size_t append(buffer_t* buf, char c, size_t length) {
+    size_t offset = buf->len;
+    memset(buf->data + offset, c, length);
+    buf->len += length;
+    buf->data[buf->len] = '\0';
+    return offset;
+}
+
+// 模拟套接字从头部写出 written 字节
+static void write_out(buffer_t* buf, linx_send_backlog_t* backlog, size_t written, uint64_t now_us,
+                      linx_send_backlog_written_t* done) {
+    memmove(buf->data, buf->data + written, buf->len - written);
+    buf->len -= written;
+    buf->data[buf->len] = '\0';
+    linx_send_backlog_on_written(backlog, written, now_us, done);
+}
+
+static void append_audio(buffer_t* buf, linx_send_backlog_t* backlog, char c, size_t length, uint32_t frames) {
+    size_t offset = append(buf, c, length);
+    linx_send_backlog_track_audio(backlog, offset, length, frames);
+}
+
+// 追加文本消息并前移，控制消息记录其末尾位置
+static void append_text(buffer_t* buf, linx_send_backlog_t* backlog, char c, size_t length, bool control,
+                        uint64_t submit_us) {
+    size_t offset = append(buf, c, length);
+    size_t end = linx_send_backlog_promote(backlog, buf->data, offset, length);
+    if (control) {
+        linx_send_backlog_track_control(backlog, end, submit_us);
+    }
+}
+
+static const char* text(const buffer_t* buf) {
+    return (const char*)buf->data;
+}
+
+// 测试头部消息部分写出后只剪除之后的音频，控制消息末尾随之前移
+static void test_evict_partial_head(void) {
+    printf("Testing eviction with a partially written head...\n");
+
+    linx_send_backlog_t backlog;
+    linx_send_backlog_reset(&backlog, true);
+    buffer_t buf = { .len = 0 };
+    linx_send_backlog_written_t done;
+
+    append_audio(&buf, &backlog, 'A', 4, 1);
+    append_audio(&buf, &backlog, 'B', 4, 3);
+    append_audio(&buf, &backlog, 'C', 4, 2);
+    assert(backlog.audio_count == 3);
+
+    // A 已开始写出，不能再剪除
+    write_out(&buf, &backlog, 2, 0, &done);
+    assert(strcmp(text(&buf), "AABBBBCCCC") == 0);
+    assert(backlog.audio_count == 2);
+    assert(backlog.audio[backlog.audio_head].offset == 2);
+
+    // 控制消息越过 B、C，位于 A 的剩余字节之后
+    append_text(&buf, &backlog, 'T', 3, true, 1000);
+    assert(strcmp(text(&buf), "AATTTBBBBCCCC") == 0);
+    assert(backlog.control_count == 1 && backlog.control[backlog.control_head].end == 5);
+
+    // 剪除按帧计数：B 是三帧打包消息
+    size_t len = buf.len;
+    assert(linx_send_backlog_evict_oldest(&backlog, buf.data, &len) == 3);
+    buf.len = len;
+    buf.data[buf.len] = '\0';
+    assert(strcmp(text(&buf), "AATTTCCCC") == 0);
+    assert(backlog.audio_count == 1 && backlog.audio[backlog.audio_head].offset == 5);
+    assert(backlog.control[backlog.control_head].end == 5);
+
+    assert(linx_send_backlog_evict_oldest(&backlog, buf.data, &len) == 2);
+    buf.len = len;
+    buf.data[buf.len] = '\0';
+    assert(strcmp(text(&buf), "AATTT") == 0);
+    assert(linx_send_backlog_evict_oldest(&backlog, buf.data, &len) == 0);
+    assert(len == 5);
+
+    // 控制消息末尾写出时才统计时延
+    write_out(&buf, &backlog, 4, 1500, &done);
+    assert(done.control_frames == 0 && backlog.control_count == 1);
+    assert(backlog.control[backlog.control_head].end == 1);
+    write_out(&buf, &backlog, 1, 1800, &done);
+    assert(done.control_frames == 1 && done.total_latency_us == 800 && done.max_latency_us == 800);
+    assert(backlog.control_count == 0 && buf.len == 0);
+
+    printf("Partial head eviction test passed!\n");
+}
+
+// 测试文本消息越过多条排队音频，依次前移的文本保持先后顺序
+static void test_promote_many(void) {
+    printf("Testing promotion across queued audio...\n");
+
+    linx_send_backlog_t backlog;
+    linx_send_backlog_reset(&backlog, true);
+    buffer_t buf = { .len = 0 };
+    linx_send_backlog_written_t done;
+
+    // 没有排队的音频时原地不动
+    append_text(&buf, &backlog, 'H', 2, false, 0);
+    assert(strcmp(text(&buf), "HH") == 0);
+
+    append_audio(&buf, &backlog, 'A', 3, 1);
+    append_audio(&buf, &backlog, 'B', 5, 1);
+    append_audio(&buf, &backlog, 'C', 2, 1);
+    append_text(&buf, &backlog, 'X', 4, true, 100);
+    append_text(&buf, &backlog, 'M', 1, false, 0);
+    append_text(&buf, &backlog, 'Y', 2, true, 200);
+    assert(strcmp(text(&buf), "HHXXXXMYYAAABBBBBCC") == 0);
+
+    // 音频偏移整体后移，控制消息末尾指向各自的新位置
+    assert(backlog.audio_count == 3);
+    assert(backlog.audio[backlog.audio_head].offset == 9);
+    assert(backlog.audio[(backlog.audio_head + 1) % LINX_SEND_BACKLOG_AUDIO_MAX].offset == 12);
+    assert(backlog.audio[(backlog.audio_head + 2) % LINX_SEND_BACKLOG_AUDIO_MAX].offset == 17);
+    assert(backlog.control_count == 2);
+    assert(backlog.control[backlog.control_head].end == 6);
+    assert(backlog.control[(backlog.control_head + 1) % LINX_SEND_BACKLOG_CONTROL_MAX].end == 9);
+
+    // 前移后仍能按偏移剪除正确的音频
+    size_t len = buf.len;
+    assert(linx_send_backlog_evict_oldest(&backlog, buf.data, &len) == 1);
+    buf.len = len;
+    buf.data[buf.len] = '\0';
+    assert(strcmp(text(&buf), "HHXXXXMYYBBBBBCC") == 0);
+
+    // 一次写出两条控制消息，并越过 B 的起点
+    write_out(&buf, &backlog, 10, 250, &done);
+    assert(done.control_frames == 2 && done.total_latency_us == 150 + 50 && done.max_latency_us == 150);
+    assert(backlog.audio_count == 1 && backlog.audio[backlog.audio_head].offset == 4);
+
+    // B 已开始写出，新文本只能越过 C
+    append_text(&buf, &backlog, 'Z', 2, false, 0);
+    assert(strcmp(text(&buf), "BBBBZZCC") == 0);
+
+    printf("Promotion test passed!\n");
+}
+
+// 测试 TLS 连接不剪除也不重排，但仍跟踪写出进度
+static void test_tls_bypass(void) {
+    printf("Testing TLS bypass...\n");
+
+    linx_send_backlog_t backlog;
+    linx_send_backlog_reset(&backlog, false);
+    buffer_t buf = { .len = 0 };
+    linx_send_backlog_written_t done;
+
+    append_audio(&buf, &backlog, 'A', 3, 1);
+    append_audio(&buf, &backlog, 'B', 3, 1);
+    append_text(&buf, &backlog, 'T', 2, true, 10);
+    assert(strcmp(text(&buf), "AAABBBTT") == 0);
+    assert(backlog.control[backlog.control_head].end == 8);
+
+    size_t len = buf.len;
+    assert(linx_send_backlog_evict_oldest(&backlog, buf.data, &len) == 0);
+    assert(len == 8 && strcmp(text(&buf), "AAABBBTT") == 0);
+
+    write_out(&buf, &backlog, 8, 40, &done);
+    assert(done.control_frames == 1 && done.max_latency_us == 30);
+    assert(backlog.audio_count == 0 && backlog.control_count == 0);
+
+    // 重新建立明文连接后恢复改写
+    linx_send_backlog_reset(&backlog, true);
+    append_audio(&buf, &backlog, 'A', 3, 1);
+    append_text(&buf, &backlog, 'T', 1, false, 0);
+    assert(strcmp(text(&buf), "TAAA") == 0);
+
+    printf("TLS bypass test passed!\n");
+}
+
+// 测试记录满后新消息不被跟踪，也就不会被剪除
+static void test_full(void) {
+    printf("Testing full backlog...\n");
+
+    linx_send_backlog_t backlog;
+    linx_send_backlog_reset(&backlog, true);
+    for (size_t i = 0; i <= LINX_SEND_BACKLOG_AUDIO_MAX; i++) {
+        linx_send_backlog_track_audio(&backlog, i, 1, 1);
+    }
+    assert(backlog.audio_count == LINX_SEND_BACKLOG_AUDIO_MAX);
+    assert(backlog.audio[(backlog.audio_head + LINX_SEND_BACKLOG_AUDIO_MAX - 1) %
+                         LINX_SEND_BACKLOG_AUDIO_MAX].offset == LINX_SEND_BACKLOG_AUDIO_MAX - 1);
+
+    for (size_t i = 0; i <= LINX_SEND_BACKLOG_CONTROL_MAX; i++) {
+        linx_send_backlog_track_control(&backlog, i + 1, 0);
+    }
+    assert(backlog.control_count == LINX_SEND_BACKLOG_CONTROL_MAX);
+
+    printf("Full backlog test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx_send_backlog tests ===\n");
+
+    test_evict_partial_head();
+    test_promote_many();
+    test_tls_bypass();
+    test_full();
+
+    printf("All send backlog tests passed!\n");
+    return 0;
+}
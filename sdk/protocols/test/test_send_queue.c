@@ -0,0 +1,203 @@
+/**
+ * linx_send_queue 单元测试
+ *
+ * 覆盖单线程入队/出队语义、队满行为、缓冲区扩容、预留/发布，
+ * 以及多生产者并发入队时每个生产者内部的顺序保持。
+ */
+
+#include "linx_send_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define PRODUCER_COUNT      4
+#define FRAMES_PER_PRODUCER 20000
+
+typedef struct {
+    linx_send_queue_t* queue;
+    uint32_t producer_id;
+} producer_args_t;
+
+// 测试基本的入队出队
+static void test_push_pop(void) {
+    printf("Testing push/pop...\n");
+
+    linx_send_queue_t* queue = linx_send_queue_create(4);
+    assert(queue != NULL);
+    assert(linx_send_queue_capacity(queue) == 4);
+    assert(linx_send_queue_peek(queue) == NULL);
+
+    assert(linx_send_queue_push(queue, LINX_SEND_FRAME_AUDIO, "abc", 3, 100));
+    assert(linx_send_queue_push(queue, LINX_SEND_FRAME_TEXT, "{}", 2, 0));
+    assert(linx_send_queue_depth(queue) == 2);
+
+    linx_send_frame_t* frame = linx_send_queue_peek(queue);
+    assert(frame != NULL);
+    assert(frame->type == LINX_SEND_FRAME_AUDIO);
+    assert(frame->timestamp == 100);
+    assert(frame->size == 3 && memcmp(frame->data, "abc", 3) == 0);
+    linx_send_queue_pop(queue);
+
+    frame = linx_send_queue_peek(queue);
+    assert(frame != NULL);
+    assert(frame->type == LINX_SEND_FRAME_TEXT);
+    assert(frame->size == 2 && memcmp(frame->data, "{}", 2) == 0);
+    linx_send_queue_pop(queue);
+
+    assert(linx_send_queue_peek(queue) == NULL);
+    assert(linx_send_queue_depth(queue) == 0);
+
+    linx_send_queue_destroy(queue);
+    printf("Push/pop test passed!\n");
+}
+
+// 测试队满与槽位复用
+static void test_full_and_wrap(void) {
+    printf("Testing full queue and wrap-around...\n");
+
+    linx_send_queue_t* queue = linx_send_queue_create(3);   // 向上取整为4
+    assert(linx_send_queue_capacity(queue) == 4);
+
+    for (uint32_t round = 0; round < 10; round++) {
+        for (uint32_t i = 0; i < 4; i++) {
+            assert(linx_send_queue_push(queue, LINX_SEND_FRAME_AUDIO, &i, sizeof(i), round));
+        }
+        assert(!linx_send_queue_push(queue, LINX_SEND_FRAME_AUDIO, "x", 1, 0));
+
+        for (uint32_t i = 0; i < 4; i++) {
+            linx_send_frame_t* frame = linx_send_queue_peek(queue);
+            assert(frame != NULL);
+            assert(frame->timestamp == round);
+            assert(memcmp(frame->data, &i, sizeof(i)) == 0);
+            linx_send_queue_pop(queue);
+        }
+    }
+
+    // 超过初始槽位大小的帧会扩容槽位缓冲区
+    size_t big_size = LINX_SEND_QUEUE_DEFAULT_SLOT_SIZE * 3;
+    char* big = malloc(big_size);
+    memset(big, 0x5a, big_size);
+    assert(linx_send_queue_push(queue, LINX_SEND_FRAME_TEXT, big, big_size, 0));
+    linx_send_frame_t* frame = linx_send_queue_peek(queue);
+    assert(frame->size == big_size && frame->capacity >= big_size);
+    assert(memcmp(frame->data, big, big_size) == 0);
+    linx_send_queue_pop(queue);
+    free(big);
+
+    assert(linx_send_queue_push(queue, LINX_SEND_FRAME_TEXT, "a", 1, 0));
+    assert(linx_send_queue_push(queue, LINX_SEND_FRAME_TEXT, "b", 1, 0));
+    assert(linx_send_queue_clear(queue) == 2);
+    assert(linx_send_queue_peek(queue) == NULL);
+
+    linx_send_queue_destroy(queue);
+    printf("Full queue test passed!\n");
+}
+
+// 测试预留槽位原地写入后发布
+static void test_reserve_commit(void) {
+    printf("Testing reserve/commit...\n");
+
+    linx_send_queue_t* queue = linx_send_queue_create(2);
+
+    linx_send_frame_t* first = linx_send_queue_reserve(queue, LINX_SEND_FRAME_AUDIO, 1000);
+    assert(first != NULL && first->capacity >= 1000);
+    // 未发布前消费者看不到该帧，也看不到其后已发布的帧
+    assert(linx_send_queue_peek(queue) == NULL);
+
+    linx_send_frame_t* second = linx_send_queue_reserve(queue, LINX_SEND_FRAME_AUDIO, 4);
+    assert(second != NULL && second != first);
+    assert(linx_send_queue_reserve(queue, LINX_SEND_FRAME_AUDIO, 4) == NULL);   // 队满
+    memcpy(second->data, "late", 4);
+    linx_send_queue_commit(queue, second, 4, 2);
+    assert(linx_send_queue_peek(queue) == NULL);
+
+    memset(first->data, 0x11, 1000);
+    linx_send_queue_commit(queue, first, 1000, 1);
+
+    linx_send_frame_t* frame = linx_send_queue_peek(queue);
+    assert(frame == first && frame->size == 1000 && frame->timestamp == 1 && frame->data[999] == 0x11);
+    linx_send_queue_pop(queue);
+    frame = linx_send_queue_peek(queue);
+    assert(frame == second && frame->size == 4 && frame->timestamp == 2);
+    linx_send_queue_pop(queue);
+
+    // 以0长度发布表示放弃，消费者得到一个空帧
+    frame = linx_send_queue_reserve(queue, LINX_SEND_FRAME_AUDIO, 16);
+    assert(frame != NULL);
+    linx_send_queue_commit(queue, frame, 0, 0);
+    frame = linx_send_queue_peek(queue);
+    assert(frame != NULL && frame->size == 0);
+    linx_send_queue_pop(queue);
+    assert(linx_send_queue_depth(queue) == 0);
+
+    linx_send_queue_destroy(queue);
+    printf("Reserve/commit test passed!\n");
+}
+
+static void* producer_thread(void* arg) {
+    producer_args_t* args = (producer_args_t*)arg;
+    for (uint32_t seq = 0; seq < FRAMES_PER_PRODUCER; seq++) {
+        uint32_t payload[2] = { args->producer_id, seq };
+        while (!linx_send_queue_push(args->queue, LINX_SEND_FRAME_AUDIO, payload, sizeof(payload), seq)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// 测试多生产者并发入队，单消费者出队
+static void test_concurrent_producers(void) {
+    printf("Testing %d concurrent producers...\n", PRODUCER_COUNT);
+
+    linx_send_queue_t* queue = linx_send_queue_create(64);
+    pthread_t threads[PRODUCER_COUNT];
+    producer_args_t args[PRODUCER_COUNT];
+    uint32_t next_seq[PRODUCER_COUNT] = {0};
+
+    for (uint32_t i = 0; i < PRODUCER_COUNT; i++) {
+        args[i].queue = queue;
+        args[i].producer_id = i;
+        assert(pthread_create(&threads[i], NULL, producer_thread, &args[i]) == 0);
+    }
+
+    size_t received = 0;
+    while (received < (size_t)PRODUCER_COUNT * FRAMES_PER_PRODUCER) {
+        linx_send_frame_t* frame = linx_send_queue_peek(queue);
+        if (!frame) {
+            sched_yield();
+            continue;
+        }
+        uint32_t payload[2];
+        assert(frame->size == sizeof(payload));
+        memcpy(payload, frame->data, sizeof(payload));
+        assert(payload[0] < PRODUCER_COUNT);
+        assert(payload[1] == next_seq[payload[0]]);   // 每个生产者内部保持顺序
+        next_seq[payload[0]]++;
+        linx_send_queue_pop(queue);
+        received++;
+    }
+
+    for (uint32_t i = 0; i < PRODUCER_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        assert(next_seq[i] == FRAMES_PER_PRODUCER);
+    }
+    assert(linx_send_queue_peek(queue) == NULL);
+
+    linx_send_queue_destroy(queue);
+    printf("Concurrent producers test passed!\n");
+}
+
+int main(void) {
+    printf("=== linx_send_queue tests ===\n");
+
+    test_push_pop();
+    test_full_and_wrap();
+    test_reserve_commit();
+    test_concurrent_producers();
+
+    printf("All send queue tests passed!\n");
+    return 0;
+}